@@ -0,0 +1,430 @@
+/**
+ * @file batched_inference.h
+ * @brief Inference of several independent samples with shared projections.
+ * @kaspersky_support Artiom N.
+ * @date 18.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <knp/backends/cpu-library/blifat_population.h>
+#include <knp/backends/cpu-library/delta_synapse_projection.h>
+#include <knp/backends/cpu-library/dynamic_state.h>
+#include <knp/backends/cpu-library/impact_accumulator.h>
+#include <knp/core/batch.h>
+#include <knp/core/message_endpoint.h>
+#include <knp/core/uid.h>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+
+/**
+ * @brief Namespace for CPU backends.
+ */
+namespace knp::backends::cpu
+{
+
+/**
+ * @brief Connections of backend entities used by batched inference.
+ */
+struct BatchPlan
+{
+    /**
+     * @brief Projection that impacts a backend population.
+     */
+    struct Link
+    {
+        /**
+         * @brief Index of the projection in the backend container.
+         */
+        size_t projection_index_ = 0;
+
+        /**
+         * @brief Index of the postsynaptic population in the backend container.
+         */
+        size_t postsynaptic_index_ = 0;
+
+        /**
+         * @brief Index of the presynaptic population if it is located in the backend.
+         */
+        std::optional<size_t> presynaptic_index_;
+
+        /**
+         * @brief Indexes of inputs that send spikes to the projection.
+         */
+        std::vector<size_t> input_indexes_;
+    };
+
+    /**
+     * @brief Projections that impact backend populations.
+     */
+    std::vector<Link> links_;
+
+    /**
+     * @brief Input spike generators.
+     */
+    std::vector<core::BatchInputGenerator> inputs_;
+
+    /**
+     * @brief Flags of populations which spikes are returned, one per population in the same order.
+     */
+    std::vector<bool> is_output_;
+};
+
+
+/**
+ * @brief Find projections that impact backend populations and inputs that send spikes to these projections.
+ * @details Inputs are linked to projections subscribed to them. Projections which postsynaptic population isn't
+ * located in the backend are skipped.
+ * @tparam PopulationContainer type of population container.
+ * @tparam ProjectionContainer type of projection container.
+ * @param populations backend populations.
+ * @param projections backend projections.
+ * @param endpoint backend message endpoint.
+ * @param inputs input spike generators by sender UIDs.
+ * @param output_uids UIDs of populations which spikes are returned.
+ * @return batched inference plan.
+ */
+template <typename PopulationContainer, typename ProjectionContainer>
+BatchPlan make_batch_plan(
+    const PopulationContainer &populations, const ProjectionContainer &projections,
+    const core::MessageEndpoint &endpoint, const core::BatchInputMap &inputs, const std::vector<core::UID> &output_uids)
+{
+    BatchPlan plan;
+    std::unordered_map<core::UID, size_t, core::uid_hash> population_indexes;
+    for (const auto &population : populations)
+    {
+        const auto uid = std::visit([](const auto &pop) { return pop.get_uid(); }, population);
+        population_indexes.emplace(uid, plan.is_output_.size());
+        plan.is_output_.push_back(std::find(output_uids.begin(), output_uids.end(), uid) != output_uids.end());
+    }
+
+    std::unordered_map<core::UID, size_t, core::uid_hash> input_indexes;
+    for (const auto &[sender_uid, generator] : inputs)
+    {
+        input_indexes.emplace(sender_uid, plan.inputs_.size());
+        plan.inputs_.push_back(generator);
+    }
+
+    // Inputs of every receiver.
+    std::unordered_map<core::UID, std::vector<size_t>, core::uid_hash> receiver_inputs;
+    for (const auto &[key, subscription] : endpoint.get_endpoint_subscriptions())
+    {
+        const auto *spike_subscription = std::get_if<core::Subscription<core::messaging::SpikeMessage>>(&subscription);
+        if (!spike_subscription) continue;
+        for (const auto &sender : spike_subscription->get_senders())
+        {
+            const auto input = input_indexes.find(core::UID(sender));
+            if (input_indexes.end() == input) continue;
+            receiver_inputs[spike_subscription->get_receiver_uid()].push_back(input->second);
+        }
+    }
+
+    for (size_t projection_index = 0; projection_index < projections.size(); ++projection_index)
+    {
+        const auto [uid, pre_uid, post_uid] = std::visit(
+            [](const auto &proj)
+            { return std::make_tuple(proj.get_uid(), proj.get_presynaptic(), proj.get_postsynaptic()); },
+            projections[projection_index].arg_);
+        const auto post_iter = population_indexes.find(post_uid);
+        if (population_indexes.end() == post_iter)
+        {
+            SPDLOG_WARN(
+                "Projection {} is skipped by batched inference: its postsynaptic population isn't in the backend.",
+                std::string(uid));
+            continue;
+        }
+
+        BatchPlan::Link link{projection_index, post_iter->second, std::nullopt, {}};
+        const auto pre_iter = population_indexes.find(pre_uid);
+        if (population_indexes.end() != pre_iter) link.presynaptic_index_ = pre_iter->second;
+        const auto inputs_iter = receiver_inputs.find(uid);
+        if (receiver_inputs.end() != inputs_iter) link.input_indexes_ = inputs_iter->second;
+        plan.links_.push_back(std::move(link));
+    }
+
+    return plan;
+}
+
+
+/**
+ * @brief Add impacts of presynaptic spikes of several samples to sample accumulators.
+ * @details All samples that spiked on a presynaptic neuron are processed by a single pass over the neuron synapses.
+ * @tparam ProjectionType projection type.
+ * @param projection projection that is shared by all samples.
+ * @param spikes sorted pairs of presynaptic neuron index and sample index.
+ * @param impacts impact accumulators of sample populations indexed by sample and population.
+ * @param population_index index of the postsynaptic population.
+ * @param step_n step at which spikes are sent.
+ */
+template <typename ProjectionType>
+void add_batch_impacts(
+    const ProjectionType &projection, const std::vector<std::pair<size_t, size_t>> &spikes,
+    std::vector<std::vector<ImpactAccumulator>> &impacts, size_t population_index, core::Step step_n)
+{
+    constexpr bool forcing = is_forcing<ProjectionType>();
+
+    for (auto group_begin = spikes.begin(); group_begin != spikes.end();)
+    {
+        const size_t neuron_index = group_begin->first;
+        const auto group_end = std::find_if(
+            group_begin, spikes.end(), [neuron_index](const auto &spike) { return spike.first != neuron_index; });
+        const auto for_each_sample = [&](const auto &function)
+        {
+            for (auto spike = group_begin; spike != group_end; ++spike)
+            {
+                function(impacts[spike->second][population_index]);
+            }
+        };
+
+        if (projection.is_compact())
+        {
+            const auto &parameters = projection.get_block_parameters();
+            const auto &weights = projection.get_block_weights();
+            const auto &delays = projection.get_block_delays();
+            std::visit(
+                [&](const auto &block)
+                {
+                    if constexpr (std::is_same_v<std::decay_t<decltype(block)>, core::DenseBlock>)
+                    {
+                        if (delays.empty() && neuron_index < block.presynaptic_size_)
+                        {
+                            const float *row = weights.data() + neuron_index * block.postsynaptic_size_;
+                            for_each_sample(
+                                [&](ImpactAccumulator &accumulator)
+                                {
+                                    accumulator.add_row(
+                                        parameters.delay_ + step_n, 0, parameters.output_type_, row,
+                                        block.postsynaptic_size_, forcing);
+                                });
+                            return;
+                        }
+                    }
+
+                    block.for_each_postsynaptic(
+                        neuron_index,
+                        [&](size_t, size_t weight_index, size_t target)
+                        {
+                            const core::Step delivery_step =
+                                (delays.empty() ? parameters.delay_ : delays[weight_index]) + step_n;
+                            for_each_sample(
+                                [&](ImpactAccumulator &accumulator)
+                                {
+                                    accumulator.add(
+                                        delivery_step, static_cast<uint32_t>(target), parameters.output_type_,
+                                        weights[weight_index], forcing);
+                                });
+                        });
+                },
+                *projection.get_synapse_block());
+        }
+        else
+        {
+            for (const auto synapse_index :
+                 projection.get_synapse_indexes(neuron_index, ProjectionType::Search::by_presynaptic))
+            {
+                const auto &synapse = projection[synapse_index];
+                const auto &synapse_params = std::get<core::synapse_data>(synapse);
+                const auto target = static_cast<uint32_t>(std::get<core::target_neuron_id>(synapse));
+                for_each_sample(
+                    [&](ImpactAccumulator &accumulator)
+                    {
+                        accumulator.add(
+                            synapse_params.delay_ + step_n, target, synapse_params.output_type_,
+                            synapse_params.weight_, forcing);
+                    });
+            }
+        }
+
+        group_begin = group_end;
+    }
+}
+
+
+/**
+ * @brief Get impacts that backend populations will receive, so that a batch starts with them.
+ * @details The result contains impacts accumulated by the backend, impact messages that populations received but
+ * didn't process yet and impact messages that projections queued for sending through the message bus.
+ * @tparam PopulationContainer type of population container.
+ * @tparam ProjectionContainer type of projection container.
+ * @param populations backend populations.
+ * @param projections backend projections.
+ * @param local_impacts impact accumulators of backend populations. Empty if the backend isn't initialized.
+ * @param endpoint backend message endpoint.
+ * @param first_step step from which the batch starts.
+ * @return impact accumulators of backend populations.
+ */
+template <typename PopulationContainer, typename ProjectionContainer>
+std::vector<ImpactAccumulator> get_batch_impacts(
+    const PopulationContainer &populations, const ProjectionContainer &projections,
+    const std::vector<ImpactAccumulator> &local_impacts, core::MessageEndpoint &endpoint, core::Step first_step)
+{
+    std::vector<ImpactAccumulator> result;
+    if (local_impacts.size() == populations.size())
+    {
+        result = local_impacts;
+    }
+    else
+    {
+        result.reserve(populations.size());
+        for (const auto &population : populations)
+        {
+            result.emplace_back(std::visit([](const auto &pop) { return pop.size(); }, population)).reset(first_step);
+        }
+    }
+
+    std::unordered_map<core::UID, size_t, core::uid_hash> population_indexes;
+    for (size_t index = 0; index < populations.size(); ++index)
+    {
+        const auto uid = std::visit([](const auto &pop) { return pop.get_uid(); }, populations[index]);
+        population_indexes.emplace(uid, index);
+        // Received messages are processed at the next step.
+        const auto *messages = endpoint.get_received_messages<core::messaging::SynapticImpactMessage>(uid);
+        if (!messages) continue;
+        for (const auto &message : *messages) add_accumulated_impacts(result[index], first_step, message);
+    }
+
+    for (const auto &wrapper : projections)
+    {
+        const auto population = population_indexes.find(
+            std::visit([](const auto &proj) { return proj.get_postsynaptic(); }, wrapper.arg_));
+        if (population == population_indexes.end()) continue;
+        // A queued message is sent at the step of its key and is processed at the next step.
+        for (const auto &[send_step, message] : wrapper.messages_)
+        {
+            add_accumulated_impacts(result[population->second], send_step + 1, message);
+        }
+    }
+    return result;
+}
+
+
+/**
+ * @brief Run inference of consecutive samples starting from the current state of backend populations.
+ * @details Every sample gets its own copy of population states and impact accumulators, projections are shared.
+ * Sample accumulators start with `local_impacts`, use `get_batch_impacts()` to deliver impacts sent before the
+ * batch to every sample. The method doesn't change backend entities, so several parts can be calculated in
+ * parallel. Plasticity isn't applied.
+ * @tparam PopulationContainer type of population container.
+ * @tparam ProjectionContainer type of projection container.
+ * @param plan batched inference plan.
+ * @param populations backend populations.
+ * @param projections backend projections.
+ * @param local_impacts impact accumulators with which samples start. Empty if samples start without impacts.
+ * @param first_step step from which inference starts.
+ * @param steps_count number of steps to execute.
+ * @param first_sample index of the first sample of the part.
+ * @param samples_count number of samples in the part.
+ * @param output spike messages by sample index. The vector must contain all samples of the part.
+ */
+template <typename PopulationContainer, typename ProjectionContainer>
+void calculate_batch_part(
+    const BatchPlan &plan, const PopulationContainer &populations, const ProjectionContainer &projections,
+    const std::vector<ImpactAccumulator> &local_impacts, core::Step first_step, size_t steps_count,
+    size_t first_sample, size_t samples_count, core::BatchOutput &output)
+{
+    std::vector<PopulationContainer> states(samples_count, populations);
+    std::vector<std::vector<ImpactAccumulator>> impacts(samples_count);
+    for (auto &sample_impacts : impacts)
+    {
+        if (local_impacts.size() == populations.size())
+        {
+            sample_impacts = local_impacts;
+            continue;
+        }
+        sample_impacts.reserve(populations.size());
+        for (const auto &population : populations)
+        {
+            sample_impacts.emplace_back(std::visit([](const auto &pop) { return pop.size(); }, population))
+                .reset(first_step);
+        }
+    }
+
+    // Spikes indexed by sample and population or input.
+    std::vector<std::vector<core::messaging::SpikeData>> population_spikes(
+        samples_count, std::vector<core::messaging::SpikeData>(populations.size()));
+    std::vector<std::vector<core::messaging::SpikeData>> input_spikes(
+        samples_count, std::vector<core::messaging::SpikeData>(plan.inputs_.size()));
+    std::vector<std::pair<size_t, size_t>> link_spikes;
+
+    for (core::Step step = first_step; step < first_step + steps_count; ++step)
+    {
+        for (size_t sample = 0; sample < samples_count; ++sample)
+        {
+            for (size_t population_index = 0; population_index < populations.size(); ++population_index)
+            {
+                auto &spikes = population_spikes[sample][population_index];
+                spikes.clear();
+                std::visit(
+                    [&](auto &pop)
+                    {
+                        calculate_neurons_state_part(pop, 0, pop.size());
+                        process_local_inputs(pop, impacts[sample][population_index], step);
+                        calculate_neurons_post_input_state(pop, spikes);
+                        if (plan.is_output_[population_index] && !spikes.empty())
+                        {
+                            output[first_sample + sample].push_back(
+                                core::messaging::SpikeMessage{{pop.get_uid(), step}, spikes});
+                        }
+                    },
+                    states[sample][population_index]);
+            }
+
+            for (size_t input_index = 0; input_index < plan.inputs_.size(); ++input_index)
+            {
+                input_spikes[sample][input_index] = plan.inputs_[input_index](first_sample + sample, step);
+            }
+        }
+
+        for (const auto &link : plan.links_)
+        {
+            link_spikes.clear();
+            for (size_t sample = 0; sample < samples_count; ++sample)
+            {
+                if (link.presynaptic_index_)
+                {
+                    for (const auto neuron_index : population_spikes[sample][*link.presynaptic_index_])
+                        link_spikes.emplace_back(neuron_index, sample);
+                }
+                for (const auto input_index : link.input_indexes_)
+                {
+                    for (const auto neuron_index : input_spikes[sample][input_index])
+                        link_spikes.emplace_back(neuron_index, sample);
+                }
+            }
+            if (link_spikes.empty()) continue;
+
+            std::sort(link_spikes.begin(), link_spikes.end());
+            std::visit(
+                [&](const auto &proj)
+                { add_batch_impacts(proj, link_spikes, impacts, link.postsynaptic_index_, step); },
+                projections[link.projection_index_].arg_);
+        }
+    }
+}
+
+}  // namespace knp::backends::cpu
@@ -33,13 +33,15 @@ namespace knp::backends::cpu
  * @param population population to update.
  * @param endpoint message endpoint used for message exchange.
  * @param step_n execution step.
+ * @param local_impacts impact accumulator of the population or `nullptr` if there are no local projections.
  * @return indexes of spiked neurons.
  */
 template <class BlifatLikeNeuron>
 std::optional<core::messaging::SpikeMessage> calculate_blifat_population(
-    knp::core::Population<BlifatLikeNeuron> &population, knp::core::MessageEndpoint &endpoint, size_t step_n)
+    knp::core::Population<BlifatLikeNeuron> &population, knp::core::MessageEndpoint &endpoint, size_t step_n,
+    ImpactAccumulator *local_impacts = nullptr)
 {
-    return calculate_blifat_population_impl(population, endpoint, step_n);
+    return calculate_blifat_population_impl(population, endpoint, step_n, local_impacts);
 }
 
 
@@ -52,15 +54,17 @@ std::optional<core::messaging::SpikeMessage> calculate_blifat_population(
  * @param container projection container from backend.
  * @param endpoint message endpoint used for message exchange.
  * @param step_n execution step.
+ * @param local_impacts impact accumulator of the population or `nullptr` if there are no local projections.
  * @return message containing indexes of spiked neurons.
  */
 template <class BlifatLikeNeuron, class BaseSynapseType, class ProjectionContainer>
 std::optional<core::messaging::SpikeMessage> calculate_resource_stdp_population(
     knp::core::Population<neuron_traits::SynapticResourceSTDPNeuron<BlifatLikeNeuron>> &population,
-    ProjectionContainer &container, knp::core::MessageEndpoint &endpoint, size_t step_n)
+    ProjectionContainer &container, knp::core::MessageEndpoint &endpoint, size_t step_n,
+    ImpactAccumulator *local_impacts = nullptr)
 {
     using StdpSynapseType = synapse_traits::STDP<synapse_traits::STDPSynapticResourceRule, BaseSynapseType>;
-    auto message_opt = calculate_blifat_population_impl(population, endpoint, step_n);
+    auto message_opt = calculate_blifat_population_impl(population, endpoint, step_n, local_impacts);
     auto working_projections = find_projection_by_type_and_postsynaptic<StdpSynapseType, ProjectionContainer>(
         container, population.get_uid(), true);
     do_STDP_resource_plasticity(population, working_projections, message_opt, step_n);
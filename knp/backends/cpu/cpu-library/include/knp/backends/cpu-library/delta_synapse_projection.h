@@ -34,13 +34,15 @@ namespace knp::backends::cpu
  * @param endpoint message endpoint used for message exchange.
  * @param future_messages message queue to process via endpoint.
  * @param step_n execution step.
+ * @param local_impacts impact accumulator of the postsynaptic population or `nullptr` to send impact messages.
  */
 template <class DeltaLikeSynapseType>
 void calculate_delta_synapse_projection(
     knp::core::Projection<DeltaLikeSynapseType> &projection, knp::core::MessageEndpoint &endpoint,
-    MessageQueue &future_messages, size_t step_n)
+    MessageQueue &future_messages, size_t step_n, ImpactAccumulator *local_impacts = nullptr)
 {
-    calculate_delta_synapse_projection_impl<DeltaLikeSynapseType>(projection, endpoint, future_messages, step_n);
+    calculate_delta_synapse_projection_impl<DeltaLikeSynapseType>(
+        projection, endpoint, future_messages, step_n, local_impacts);
 }
 
 
@@ -54,13 +56,16 @@ void calculate_delta_synapse_projection(
  * @param part_start index of the starting synapse.
  * @param part_size number of synapses to process.
  * @param mutex mutex.
+ * @param local_impacts impact accumulator of the postsynaptic population or `nullptr` to send impact messages.
  */
 template <class DeltaLikeSynapse>
 void calculate_projection_part(
     knp::core::Projection<DeltaLikeSynapse> &projection, const std::unordered_map<size_t, size_t> &message_in_data,
-    MessageQueue &future_messages, uint64_t step_n, size_t part_start, size_t part_size, std::mutex &mutex)
+    MessageQueue &future_messages, uint64_t step_n, size_t part_start, size_t part_size, std::mutex &mutex,
+    ImpactAccumulator *local_impacts = nullptr)
 {
-    calculate_projection_part_impl(projection, message_in_data, future_messages, step_n, part_start, part_size, mutex);
+    calculate_projection_part_impl(
+        projection, message_in_data, future_messages, step_n, part_start, part_size, mutex, local_impacts);
 }
 
 }  // namespace knp::backends::cpu
@@ -0,0 +1,245 @@
+/**
+ * @file dynamic_state.h
+ * @brief Getting and restoring mutable state of CPU backends.
+ * @kaspersky_support Artiom N.
+ * @date 18.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <knp/backends/cpu-library/impact_accumulator.h>
+#include <knp/backends/cpu-library/init.h>
+#include <knp/core/dynamic_state.h>
+#include <knp/core/messaging/messaging.h>
+#include <knp/core/uid.h>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+
+/**
+ * @brief Namespace for CPU backends.
+ */
+namespace knp::backends::cpu
+{
+
+/**
+ * @brief Convert impacts accumulated for a population into impact messages.
+ * @details Impacts are summed by the accumulator, so every message contains one impact for each neuron and output
+ * type. Excitatory impacts of neurons that received forcing impacts are sent in a separate forcing message.
+ * @param accumulator impact accumulator of the population.
+ * @param population_uid UID of the population.
+ * @return impact messages with steps at which they are delivered.
+ */
+inline std::vector<std::pair<uint64_t, core::messaging::SynapticImpactMessage>> get_accumulated_impacts(
+    const ImpactAccumulator &accumulator, const core::UID &population_uid)
+{
+    std::vector<std::pair<uint64_t, core::messaging::SynapticImpactMessage>> result;
+    for (const auto *impacts : accumulator.get_pending_impacts())
+    {
+        // Regular and forcing messages.
+        std::array<core::messaging::SynapticImpactMessage, 2> messages;
+        for (size_t type_index = 0; type_index < impacts->values_.size(); ++type_index)
+        {
+            const auto output_type = static_cast<synapse_traits::OutputType>(type_index);
+            const auto &values = impacts->values_[type_index];
+            for (size_t neuron_index = 0; neuron_index < values.size(); ++neuron_index)
+            {
+                const uint8_t flags = impacts->flags_.empty() ? 0 : impacts->flags_[neuron_index];
+                const bool is_blocking = synapse_traits::OutputType::BLOCKING == output_type;
+                if (is_blocking ? !(flags & ImpactAccumulator::blocking_flag) : values[neuron_index] == 0) continue;
+
+                const bool is_forcing = synapse_traits::OutputType::EXCITATORY == output_type &&
+                                        (flags & ImpactAccumulator::forcing_flag);
+                messages[is_forcing].impacts_.push_back(core::messaging::SynapticImpact{
+                    0, values[neuron_index], output_type, 0, static_cast<uint32_t>(neuron_index)});
+            }
+        }
+
+        for (size_t i = 0; i < messages.size(); ++i)
+        {
+            if (messages[i].impacts_.empty()) continue;
+            messages[i].header_ = core::messaging::MessageHeader{population_uid, impacts->step_};
+            messages[i].postsynaptic_population_uid_ = population_uid;
+            messages[i].is_forcing_ = static_cast<bool>(i);
+            result.emplace_back(impacts->step_, std::move(messages[i]));
+        }
+    }
+
+    std::sort(
+        result.begin(), result.end(), [](const auto &first, const auto &second) { return first.first < second.first; });
+    return result;
+}
+
+
+/**
+ * @brief Add impacts of a message to an impact accumulator.
+ * @param accumulator impact accumulator of the population.
+ * @param step step at which the message is delivered.
+ * @param message impact message.
+ * @throw std::logic_error if an impact is sent to a neuron that doesn't exist.
+ */
+inline void add_accumulated_impacts(
+    ImpactAccumulator &accumulator, uint64_t step, const core::messaging::SynapticImpactMessage &message)
+{
+    for (const auto &impact : message.impacts_)
+    {
+        if (impact.postsynaptic_neuron_index_ >= accumulator.get_neurons_count())
+        {
+            throw std::logic_error(
+                "Impact on neuron " + std::to_string(impact.postsynaptic_neuron_index_) +
+                " of population with UID \"" + std::string(message.postsynaptic_population_uid_) +
+                "\" is out of range.");
+        }
+        accumulator.add(
+            step, impact.postsynaptic_neuron_index_, impact.synapse_type_, impact.impact_value_, message.is_forcing_);
+    }
+}
+
+
+/**
+ * @brief Add impacts of messages to an impact accumulator.
+ * @param accumulator impact accumulator of the population.
+ * @param messages impact messages with steps at which they are delivered.
+ * @throw std::logic_error if an impact is sent to a neuron that doesn't exist.
+ */
+inline void add_accumulated_impacts(
+    ImpactAccumulator &accumulator,
+    const std::vector<std::pair<uint64_t, core::messaging::SynapticImpactMessage>> &messages)
+{
+    for (const auto &[step, message] : messages) add_accumulated_impacts(accumulator, step, message);
+}
+
+
+/**
+ * @brief Get mutable state of a CPU backend network.
+ * @details Only dynamic parameters are copied. Pending impacts of projections are taken from their message
+ * queues, impacts already accumulated for populations are stored as pending impacts of populations.
+ * @tparam PopulationContainer type of population container.
+ * @tparam ProjectionContainer type of projection container.
+ * @param populations backend populations.
+ * @param projections backend projections.
+ * @param local_impacts impact accumulators of backend populations. Empty if the backend isn't initialized.
+ * @param step current backend step.
+ * @return dynamic state of the network.
+ */
+template <typename PopulationContainer, typename ProjectionContainer>
+core::DynamicState get_dynamic_state(
+    const PopulationContainer &populations, const ProjectionContainer &projections,
+    const std::vector<ImpactAccumulator> &local_impacts, core::Step step)
+{
+    SPDLOG_TRACE("Getting dynamic state at step {}...", step);
+    core::DynamicState result;
+    result.step_ = step;
+    result.populations_.reserve(populations.size());
+    for (size_t index = 0; index < populations.size(); ++index)
+    {
+        auto &state = result.populations_.emplace_back(
+            std::visit([](const auto &pop) { return core::get_dynamic_state(pop); }, populations[index]));
+        if (local_impacts.size() == populations.size())
+        {
+            state.pending_impacts_ = get_accumulated_impacts(local_impacts[index], state.uid_);
+        }
+    }
+
+    result.projections_.reserve(projections.size());
+    for (const auto &wrapper : projections)
+    {
+        auto &state = result.projections_.emplace_back(
+            std::visit([](const auto &proj) { return core::get_dynamic_state(proj); }, wrapper.arg_));
+        state.pending_impacts_.assign(wrapper.messages_.begin(), wrapper.messages_.end());
+        std::sort(
+            state.pending_impacts_.begin(), state.pending_impacts_.end(),
+            [](const auto &first, const auto &second) { return first.first < second.first; });
+    }
+    return result;
+}
+
+
+/**
+ * @brief Restore mutable state of a CPU backend network.
+ * @details Impact accumulators are created if the backend isn't initialized yet. All accumulators are reset to
+ * the state step, including accumulators of populations that are not in the state.
+ * @tparam PopulationContainer type of population container.
+ * @tparam ProjectionContainer type of projection container.
+ * @param populations backend populations.
+ * @param projections backend projections.
+ * @param local_impacts impact accumulators of backend populations.
+ * @param state dynamic state of the network.
+ * @throw std::logic_error if the state contains an entity that isn't loaded to the backend or doesn't match it.
+ */
+template <typename PopulationContainer, typename ProjectionContainer>
+void set_dynamic_state(
+    PopulationContainer &populations, ProjectionContainer &projections, std::vector<ImpactAccumulator> &local_impacts,
+    const core::DynamicState &state)
+{
+    SPDLOG_DEBUG("Restoring dynamic state of step {}...", state.step_);
+    if (local_impacts.size() != populations.size()) init_local_impacts(populations, projections, local_impacts);
+    for (auto &accumulator : local_impacts) accumulator.reset(state.step_);
+
+    std::unordered_map<core::UID, size_t, core::uid_hash> population_indexes;
+    for (size_t index = 0; index < populations.size(); ++index)
+    {
+        population_indexes.emplace(
+            std::visit([](const auto &pop) { return pop.get_uid(); }, populations[index]), index);
+    }
+    for (const auto &population_state : state.populations_)
+    {
+        const auto iter = population_indexes.find(population_state.uid_);
+        if (iter == population_indexes.end())
+        {
+            throw std::logic_error(
+                "Cannot restore state of non-existent population with UID \"" + std::string(population_state.uid_) +
+                "\".");
+        }
+        std::visit(
+            [&population_state](auto &pop) { core::set_dynamic_state(pop, population_state); },
+            populations[iter->second]);
+        add_accumulated_impacts(local_impacts[iter->second], population_state.pending_impacts_);
+    }
+
+    std::unordered_map<core::UID, size_t, core::uid_hash> projection_indexes;
+    for (size_t index = 0; index < projections.size(); ++index)
+    {
+        projection_indexes.emplace(
+            std::visit([](const auto &proj) { return proj.get_uid(); }, projections[index].arg_), index);
+    }
+    for (const auto &projection_state : state.projections_)
+    {
+        const auto iter = projection_indexes.find(projection_state.uid_);
+        if (iter == projection_indexes.end())
+        {
+            throw std::logic_error(
+                "Cannot restore state of non-existent projection with UID \"" + std::string(projection_state.uid_) +
+                "\".");
+        }
+        auto &wrapper = projections[iter->second];
+        std::visit([&projection_state](auto &proj) { core::set_dynamic_state(proj, projection_state); }, wrapper.arg_);
+        wrapper.messages_.clear();
+        wrapper.messages_.insert(projection_state.pending_impacts_.begin(), projection_state.pending_impacts_.end());
+    }
+}
+
+}  // namespace knp::backends::cpu
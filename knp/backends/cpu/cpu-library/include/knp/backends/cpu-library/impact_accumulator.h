@@ -0,0 +1,315 @@
+/**
+ * @file impact_accumulator.h
+ * @brief Dense accumulator of synaptic impacts delivered inside a backend.
+ * @kaspersky_support Artiom N.
+ * @date 18.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <knp/core/core.h>
+#include <knp/synapse-traits/output_types.h>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+
+/**
+ * @brief Namespace for CPU backends.
+ */
+namespace knp::backends::cpu
+{
+/**
+ * @brief The ImpactAccumulator class is a definition of dense per-neuron sums of synaptic impacts sent to a
+ * single population.
+ * @details Projections located in the same backend as their postsynaptic population add impacts to the accumulator
+ * instead of sending `SynapticImpactMessage` messages. Impacts are stored in a ring of slots, one slot per
+ * delivery step, so impacts with different delays don't mix.
+ */
+class ImpactAccumulator
+{
+public:
+    /**
+     * @brief Number of synapse output types.
+     */
+    static constexpr size_t output_type_count = static_cast<size_t>(synapse_traits::OutputType::BLOCKING) + 1;
+
+    /**
+     * @brief Flag of the neuron that received an excitatory impact from a forcing projection.
+     */
+    static constexpr uint8_t forcing_flag = 1;
+
+    /**
+     * @brief Flag of the neuron that received a blocking impact.
+     */
+    static constexpr uint8_t blocking_flag = 2;
+
+    /**
+     * @brief Impacts received by a population at a single step.
+     */
+    struct Impacts
+    {
+        /**
+         * @brief Delivery step.
+         */
+        core::Step step_ = 0;
+
+        /**
+         * @brief `true` if there are no impacts.
+         */
+        bool empty_ = true;
+
+        /**
+         * @brief Sums of impact values indexed by output type and neuron index.
+         * @details Blocking impacts are not summed, the last received value is stored. Vectors of output types that
+         * weren't received are empty.
+         */
+        std::array<std::vector<float>, output_type_count> values_;
+
+        /**
+         * @brief Forcing and blocking flags of neurons. Empty if no neuron has flags.
+         */
+        std::vector<uint8_t> flags_;
+    };
+
+public:
+    /**
+     * @brief Constructor.
+     * @param neurons_count number of neurons in the population.
+     */
+    explicit ImpactAccumulator(size_t neurons_count) : neurons_count_(neurons_count), slots_(2) {}
+
+    /**
+     * @brief Get number of neurons in the population.
+     * @return number of neurons.
+     */
+    [[nodiscard]] size_t get_neurons_count() const { return neurons_count_; }
+
+    /**
+     * @brief Add impact.
+     * @details Impacts for steps that are already finished are dropped the same way as messages that are never
+     * delivered.
+     * @param step step at which the population receives the impact.
+     * @param neuron_index index of the postsynaptic neuron.
+     * @param output_type synapse output type.
+     * @param value impact value.
+     * @param is_forcing `true` if impact is sent by a forcing projection.
+     */
+    void add(
+        core::Step step, uint32_t neuron_index, synapse_traits::OutputType output_type, float value, bool is_forcing)
+    {
+        auto *slot = get_slot(step);
+        if (!slot) return;
+
+        auto &values = slot->values_[static_cast<size_t>(output_type)];
+        if (values.empty()) values.resize(neurons_count_, 0);
+
+        if (synapse_traits::OutputType::BLOCKING == output_type)
+        {
+            values[neuron_index] = value;
+            set_flag(*slot, neuron_index, blocking_flag);
+            return;
+        }
+
+        values[neuron_index] += value;
+        if (is_forcing && synapse_traits::OutputType::EXCITATORY == output_type)
+        {
+            set_flag(*slot, neuron_index, forcing_flag);
+        }
+    }
+
+    /**
+     * @brief Add impacts to consecutive neurons.
+     * @details The method is equivalent to calling `add()` for every value, but values are added in a single loop
+     * that can be vectorized. It is used for rows of dense synapse blocks.
+     * @param step step at which the population receives impacts.
+     * @param first_neuron_index index of the neuron that receives the first value.
+     * @param output_type synapse output type.
+     * @param values impact values.
+     * @param values_count number of values.
+     * @param is_forcing `true` if impacts are sent by a forcing projection.
+     */
+    void add_row(
+        core::Step step, size_t first_neuron_index, synapse_traits::OutputType output_type, const float *values,
+        size_t values_count, bool is_forcing)
+    {
+        if (!values_count) return;
+        auto *slot = get_slot(step);
+        if (!slot) return;
+
+        auto &sums = slot->values_[static_cast<size_t>(output_type)];
+        if (sums.empty()) sums.resize(neurons_count_, 0);
+        float *first_sum = sums.data() + first_neuron_index;
+
+        uint8_t flag = 0;
+        if (synapse_traits::OutputType::BLOCKING == output_type)
+        {
+            std::copy(values, values + values_count, first_sum);
+            flag = blocking_flag;
+        }
+        else
+        {
+            for (size_t i = 0; i < values_count; ++i) first_sum[i] += values[i];
+            if (is_forcing && synapse_traits::OutputType::EXCITATORY == output_type) flag = forcing_flag;
+        }
+
+        if (!flag) return;
+        if (slot->flags_.empty()) slot->flags_.resize(neurons_count_, 0);
+        for (size_t i = 0; i < values_count; ++i) slot->flags_[first_neuron_index + i] |= flag;
+    }
+
+    /**
+     * @brief Get impacts received at the step.
+     * @param step step number.
+     * @return pointer to impacts or `nullptr` if there are no impacts.
+     */
+    [[nodiscard]] const Impacts *get_impacts(core::Step step) const
+    {
+        const auto &slot = slots_[step % slots_.size()];
+        return (!slot.empty_ && slot.step_ == step) ? &slot : nullptr;
+    }
+
+    /**
+     * @brief Get impacts of all steps that are not finished.
+     * @return pointers to impacts in arbitrary order.
+     */
+    [[nodiscard]] std::vector<const Impacts *> get_pending_impacts() const
+    {
+        std::vector<const Impacts *> result;
+        for (const auto &slot : slots_)
+        {
+            if (!slot.empty_ && slot.step_ >= next_step_) result.push_back(&slot);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Remove impacts received at the step and finish the step.
+     * @param step step number.
+     */
+    void finish_step(core::Step step)
+    {
+        auto &slot = slots_[step % slots_.size()];
+        if (!slot.empty_ && slot.step_ == step) clear_slot(slot);
+        next_step_ = std::max(next_step_, step + 1);
+    }
+
+    /**
+     * @brief Remove all impacts and set the first step that is not finished.
+     * @details Call the method before adding impacts at absolute steps, for example when dynamic state is restored.
+     * Otherwise the ring grows to cover all steps from the previous first step.
+     * @param first_step first step that is not finished.
+     */
+    void reset(core::Step first_step)
+    {
+        for (auto &slot : slots_)
+        {
+            if (!slot.empty_) clear_slot(slot);
+        }
+        next_step_ = first_step;
+    }
+
+    /**
+     * @brief Remove neurons from the accumulator.
+     * @details Pending impacts of removed neurons are dropped, pending impacts of the remaining neurons are moved to
+     * their new indexes.
+     * @param neuron_indexes sorted unique indexes of neurons to remove.
+     */
+    void remove_neurons(const std::vector<size_t> &neuron_indexes)
+    {
+        if (neuron_indexes.empty()) return;
+
+        for (auto &slot : slots_)
+        {
+            for (auto &values : slot.values_) remove_values(values, neuron_indexes);
+            remove_values(slot.flags_, neuron_indexes);
+        }
+        neurons_count_ -= neuron_indexes.size();
+    }
+
+private:
+    Impacts *get_slot(core::Step step)
+    {
+        if (step < next_step_)
+        {
+            SPDLOG_TRACE("Impact for the finished step #{} is dropped.", step);
+            return nullptr;
+        }
+        if (step - next_step_ >= slots_.size()) grow(step - next_step_ + 1);
+
+        auto &slot = slots_[step % slots_.size()];
+        slot.step_ = step;
+        slot.empty_ = false;
+        return &slot;
+    }
+
+    static void clear_slot(Impacts &slot)
+    {
+        // Buffers are kept to avoid allocations at the next steps.
+        for (auto &values : slot.values_) std::fill(values.begin(), values.end(), 0.F);
+        std::fill(slot.flags_.begin(), slot.flags_.end(), 0);
+        slot.empty_ = true;
+    }
+
+    template <typename ValueType>
+    static void remove_values(std::vector<ValueType> &values, const std::vector<size_t> &neuron_indexes)
+    {
+        if (values.empty()) return;
+
+        auto next_to_remove = neuron_indexes.begin();
+        size_t write_index = *next_to_remove;
+        for (size_t read_index = write_index; read_index < values.size(); ++read_index)
+        {
+            if (next_to_remove != neuron_indexes.end() && *next_to_remove == read_index)
+            {
+                ++next_to_remove;
+                continue;
+            }
+            values[write_index++] = values[read_index];
+        }
+        values.resize(write_index);
+    }
+
+    void set_flag(Impacts &slot, uint32_t neuron_index, uint8_t flag)
+    {
+        if (slot.flags_.empty()) slot.flags_.resize(neurons_count_, 0);
+        slot.flags_[neuron_index] |= flag;
+    }
+
+    void grow(size_t min_size)
+    {
+        // Pending slots belong to different steps in the range of the old ring, so they don't collide.
+        std::vector<Impacts> slots(std::max(min_size, slots_.size() * 2));
+        for (auto &slot : slots_)
+        {
+            if (!slot.empty_) slots[slot.step_ % slots.size()] = std::move(slot);
+        }
+        slots_ = std::move(slots);
+    }
+
+private:
+    // cppcheck-suppress unusedStructMember
+    size_t neurons_count_;
+    std::vector<Impacts> slots_;
+    core::Step next_step_ = 0;
+};
+
+}  // namespace knp::backends::cpu
@@ -21,6 +21,7 @@
 
 #pragma once
 
+#include <knp/backends/cpu-library/impact_accumulator.h>
 #include <knp/core/message_bus.h>
 #include <knp/core/population.h>
 #include <knp/core/projection.h>
@@ -139,6 +140,68 @@ void process_inputs(
 }
 
 
+/**
+ * @brief Apply impacts that were added to the dense accumulator by local projections and finish the step.
+ * @tparam BlifatLikeNeuron type of neuron which inference can be calculated as for a BLIFAT neuron.
+ * @param population population to update.
+ * @param local_impacts impact accumulator of the population.
+ * @param step_n execution step.
+ */
+template <class BlifatLikeNeuron>
+void process_local_inputs(
+    knp::core::Population<BlifatLikeNeuron> &population, ImpactAccumulator &local_impacts, core::Step step_n)
+{
+    const auto *impacts = local_impacts.get_impacts(step_n);
+    if (impacts)
+    {
+        SPDLOG_TRACE("Process local inputs.");
+        for (size_t type_index = 0; type_index < impacts->values_.size(); ++type_index)
+        {
+            const auto &values = impacts->values_[type_index];
+            if (values.empty()) continue;
+
+            const auto output_type = static_cast<synapse_traits::OutputType>(type_index);
+            const bool is_blocking = synapse_traits::OutputType::BLOCKING == output_type;
+            for (size_t neuron_index = 0; neuron_index < values.size(); ++neuron_index)
+            {
+                if (is_blocking && !(impacts->flags_[neuron_index] & ImpactAccumulator::blocking_flag)) continue;
+                impact_neuron<BlifatLikeNeuron>(population[neuron_index], output_type, values[neuron_index]);
+            }
+        }
+
+        if constexpr (has_dopamine_plasticity<BlifatLikeNeuron>())
+        {
+            for (size_t neuron_index = 0; neuron_index < impacts->flags_.size(); ++neuron_index)
+            {
+                if (impacts->flags_[neuron_index] & ImpactAccumulator::forcing_flag)
+                {
+                    population[neuron_index].is_being_forced_ = true;
+                }
+            }
+        }
+    }
+    local_impacts.finish_step(step_n);
+}
+
+
+/**
+ * @brief Process messages and local impacts sent to the current population.
+ * @param population population to update.
+ * @param messages synaptic impact messages sent to the population.
+ * @param local_impacts impact accumulator of the population or `nullptr` if there are no local projections.
+ * @param step_n execution step.
+ */
+template <class BlifatLikeNeuron>
+void process_all_inputs(
+    knp::core::Population<BlifatLikeNeuron> &population,
+    const std::vector<core::messaging::SynapticImpactMessage> &messages, ImpactAccumulator *local_impacts,
+    core::Step step_n)
+{
+    process_inputs(population, messages);
+    if (local_impacts) process_local_inputs(population, *local_impacts, step_n);
+}
+
+
 /**
  * @brief Calculate a single neuron state before impacts.
  * @tparam BlifatLikeNeuron type of neuron which inference can be calculated as for a BLIFAT neuron.
@@ -195,14 +258,17 @@ void calculate_neurons_state_part(
  * @tparam BlifatLikeNeuron type of neuron which inference can be calculated as for a BLIFAT neuron.
  * @param population neurons population.
  * @param messages messages from the projection to the populations.
+ * @param local_impacts impact accumulator of the population or `nullptr` if there are no local projections.
+ * @param step_n execution step.
  */
 template <class BlifatLikeNeuron>
 void calculate_neurons_state(
     knp::core::Population<BlifatLikeNeuron> &population,
-    const std::vector<core::messaging::SynapticImpactMessage> &messages)
+    const std::vector<core::messaging::SynapticImpactMessage> &messages, ImpactAccumulator *local_impacts = nullptr,
+    core::Step step_n = 0)
 {
     calculate_neurons_state_part(population, 0, population.size());
-    process_inputs(population, messages);
+    process_all_inputs(population, messages, local_impacts, step_n);
 }
 
 
@@ -318,18 +384,21 @@ void calculate_neurons_post_input_state_part(
  * @tparam BlifatLikeNeuron type of neuron which inference can be calculated the same as BLIFAT.
  * @param population population of BLIFAT-like neurons.
  * @param endpoint message endpoint.
+ * @param local_impacts impact accumulator of the population or `nullptr` if there are no local projections.
+ * @param step_n execution step.
  * @return indexes of spiked neurons.
  */
 template <class BlifatLikeNeuron>
 knp::core::messaging::SpikeData calculate_blifat_population_data(
-    knp::core::Population<BlifatLikeNeuron> &population, knp::core::MessageEndpoint &endpoint)
+    knp::core::Population<BlifatLikeNeuron> &population, knp::core::MessageEndpoint &endpoint,
+    ImpactAccumulator *local_impacts = nullptr, core::Step step_n = 0)
 {
     SPDLOG_DEBUG("Calculating BLIFAT population {}...", std::string{population.get_uid()});
     // This whole function might be optimizable if we find a way to not loop over the whole population.
     std::vector<core::messaging::SynapticImpactMessage> messages =
         endpoint.unload_messages<core::messaging::SynapticImpactMessage>(population.get_uid());
 
-    calculate_neurons_state(population, messages);
+    calculate_neurons_state(population, messages, local_impacts, step_n);
     knp::core::messaging::SpikeData neuron_indexes;
     calculate_neurons_post_input_state(population, neuron_indexes);
 
@@ -339,9 +408,10 @@ knp::core::messaging::SpikeData calculate_blifat_population_data(
 
 template <class BlifatLikeNeuron>
 std::optional<core::messaging::SpikeMessage> calculate_blifat_population_impl(
-    knp::core::Population<BlifatLikeNeuron> &population, knp::core::MessageEndpoint &endpoint, size_t step_n)
+    knp::core::Population<BlifatLikeNeuron> &population, knp::core::MessageEndpoint &endpoint, size_t step_n,
+    ImpactAccumulator *local_impacts = nullptr)
 {
-    auto neuron_indexes{calculate_blifat_population_data(population, endpoint)};
+    auto neuron_indexes{calculate_blifat_population_data(population, endpoint, local_impacts, step_n)};
     std::optional<knp::core::messaging::SpikeMessage> message_opt = {};
     if (!neuron_indexes.empty())
     {
@@ -21,6 +21,7 @@
 
 #pragma once
 
+#include <knp/backends/cpu-library/impact_accumulator.h>
 #include <knp/core/message_bus.h>
 #include <knp/core/projection.h>
 #include <knp/synapse-traits/delta.h>
@@ -29,8 +30,10 @@
 
 #include <algorithm>
 #include <mutex>
+#include <type_traits>
 #include <unordered_map>
 #include <utility>
+#include <variant>
 #include <vector>
 
 #include "additive_stdp_impl.h"
@@ -50,13 +53,14 @@ using MessageQueue = std::unordered_map<uint64_t, knp::core::messaging::Synaptic
 template <class DeltaLikeSynapse>
 void calculate_projection_part_impl(
     knp::core::Projection<DeltaLikeSynapse> &projection, const std::unordered_map<size_t, size_t> &message_in_data,
-    MessageQueue &future_messages, uint64_t step_n, size_t part_start, size_t part_size, std::mutex &mutex);
+    MessageQueue &future_messages, uint64_t step_n, size_t part_start, size_t part_size, std::mutex &mutex,
+    ImpactAccumulator *local_impacts);
 
 
 template <class DeltaLikeSynapse>
 void calculate_delta_synapse_projection_impl(
     knp::core::Projection<DeltaLikeSynapse> &projection, knp::core::MessageEndpoint &endpoint,
-    MessageQueue &future_messages, size_t step_n);
+    MessageQueue &future_messages, size_t step_n, ImpactAccumulator *local_impacts);
 
 
 template <class ProjectionType>
@@ -73,15 +77,108 @@ constexpr bool is_forcing<knp::core::Projection<synapse_traits::DeltaSynapse>>()
 }
 
 
+template <typename ProjectionType>
+void add_impact_to_queue(
+    const ProjectionType &projection, MessageQueue &future_messages, uint64_t future_step, uint64_t step_n,
+    const knp::core::messaging::SynapticImpact &impact)
+{
+    auto iter = future_messages.find(future_step);
+    if (iter != future_messages.end())
+    {
+        iter->second.impacts_.push_back(impact);
+        return;
+    }
+
+    knp::core::messaging::SynapticImpactMessage message_out{
+        {projection.get_uid(), step_n},
+        projection.get_postsynaptic(),
+        projection.get_presynaptic(),
+        is_forcing<ProjectionType>(),
+        {impact}};
+    future_messages.insert(std::make_pair(future_step, message_out));
+}
+
+
+// Spikes of a presynaptic neuron are delivered by a dense block with the shared delay as a single weight row.
+template <typename ProjectionType, typename Block>
+bool is_row_delivery(const ProjectionType &projection, const Block &, const ImpactAccumulator *local_impacts)
+{
+    return std::is_same_v<Block, core::DenseBlock> && local_impacts && projection.get_block_delays().empty();
+}
+
+
+template <typename ProjectionType>
+void calculate_block_projection_data(
+    const ProjectionType &projection, const std::vector<core::messaging::SpikeMessage> &messages,
+    MessageQueue &future_messages, uint64_t step_n, ImpactAccumulator *local_impacts)
+{
+    SPDLOG_TRACE("Calculating compact projection data...");
+    const auto &parameters = projection.get_block_parameters();
+    const auto &weights = projection.get_block_weights();
+    const auto &delays = projection.get_block_delays();
+
+    std::visit(
+        [&](const auto &block)
+        {
+            const bool by_rows = is_row_delivery(projection, block, local_impacts);
+            for (const auto &message : messages)
+            {
+                for (const auto spiked_neuron_index : message.neuron_indexes_)
+                {
+                    if constexpr (std::is_same_v<std::decay_t<decltype(block)>, core::DenseBlock>)
+                    {
+                        if (by_rows && spiked_neuron_index < block.presynaptic_size_)
+                        {
+                            local_impacts->add_row(
+                                parameters.delay_ + step_n, 0, parameters.output_type_,
+                                weights.data() + spiked_neuron_index * block.postsynaptic_size_,
+                                block.postsynaptic_size_, is_forcing<ProjectionType>());
+                            continue;
+                        }
+                    }
+
+                    block.for_each_postsynaptic(
+                        spiked_neuron_index,
+                        [&](size_t synapse_index, size_t weight_index, size_t target)
+                        {
+                            // The message is sent on step N - 1, received on step N.
+                            const uint64_t future_step =
+                                (delays.empty() ? parameters.delay_ : delays[weight_index]) + step_n - 1;
+                            if (local_impacts)
+                            {
+                                local_impacts->add(
+                                    future_step + 1, static_cast<uint32_t>(target), parameters.output_type_,
+                                    weights[weight_index], is_forcing<ProjectionType>());
+                                return;
+                            }
+                            add_impact_to_queue(
+                                projection, future_messages, future_step, step_n,
+                                knp::core::messaging::SynapticImpact{
+                                    synapse_index, weights[weight_index], parameters.output_type_,
+                                    static_cast<uint32_t>(spiked_neuron_index), static_cast<uint32_t>(target)});
+                        });
+                }
+            }
+        },
+        *projection.get_synapse_block());
+}
+
+
 template <typename ProjectionType>
 MessageQueue::const_iterator calculate_delta_synapse_projection_data(
     ProjectionType &projection, std::vector<core::messaging::SpikeMessage> &messages, MessageQueue &future_messages,
-    size_t step_n,
+    size_t step_n, ImpactAccumulator *local_impacts,
     std::function<knp::synapse_traits::synapse_parameters<knp::synapse_traits::DeltaSynapse>(
         const typename ProjectionType::SynapseParameters &)>
         sp_getter = [](const typename ProjectionType::SynapseParameters &synapse_params) { return synapse_params; })
 {
     SPDLOG_TRACE("Calculating delta synapse projection data...");
+    if (projection.is_compact())
+    {
+        calculate_block_projection_data(projection, messages, future_messages, step_n, local_impacts);
+        return future_messages.find(step_n);
+    }
+
     using SynapseType = typename ProjectionType::ProjectionSynapseType;
     WeightUpdateSTDP<SynapseType>::init_projection(projection, messages, step_n);
 
@@ -90,7 +187,8 @@ MessageQueue::const_iterator calculate_delta_synapse_projection_data(
         const auto &message_data = message.neuron_indexes_;
         for (const auto &spiked_neuron_index : message_data)
         {
-            auto synapses = projection.find_synapses(spiked_neuron_index, ProjectionType::Search::by_presynaptic);
+            const auto &synapses =
+                projection.get_synapse_indexes(spiked_neuron_index, ProjectionType::Search::by_presynaptic);
             for (auto synapse_index : synapses)
             {
                 auto &synapse = projection[synapse_index];
@@ -99,26 +197,19 @@ MessageQueue::const_iterator calculate_delta_synapse_projection_data(
 
                 // The message is sent on step N - 1, received on step N.
                 size_t future_step = synapse_params.delay_ + step_n - 1;
+                if (local_impacts)
+                {
+                    local_impacts->add(
+                        future_step + 1, static_cast<uint32_t>(std::get<core::target_neuron_id>(synapse)),
+                        synapse_params.output_type_, synapse_params.weight_, is_forcing<ProjectionType>());
+                    continue;
+                }
+
                 knp::core::messaging::SynapticImpact impact{
                     synapse_index, synapse_params.weight_, synapse_params.output_type_,
                     static_cast<uint32_t>(std::get<core::source_neuron_id>(synapse)),
                     static_cast<uint32_t>(std::get<core::target_neuron_id>(synapse))};
-
-                auto iter = future_messages.find(future_step);
-                if (iter != future_messages.end())
-                {
-                    iter->second.impacts_.push_back(impact);
-                }
-                else
-                {
-                    knp::core::messaging::SynapticImpactMessage message_out{
-                        {projection.get_uid(), step_n},
-                        projection.get_postsynaptic(),
-                        projection.get_presynaptic(),
-                        is_forcing<ProjectionType>(),
-                        {impact}};
-                    future_messages.insert(std::make_pair(future_step, message_out));
-                }
+                add_impact_to_queue(projection, future_messages, future_step, step_n, impact);
             }
         }
     }
@@ -127,12 +218,107 @@ MessageQueue::const_iterator calculate_delta_synapse_projection_data(
 }
 
 
+template <class DeltaLikeSynapse>
+void add_projection_part_impacts(
+    const knp::core::Projection<DeltaLikeSynapse> &projection,
+    const std::vector<std::pair<uint64_t, knp::core::messaging::SynapticImpact>> &container,
+    MessageQueue &future_messages, uint64_t step_n, std::mutex &mutex, ImpactAccumulator *local_impacts)
+{
+    // Add impacts to future messages queue, it is a shared resource.
+    const std::lock_guard lock_guard(mutex);
+    if (local_impacts)
+    {
+        for (const auto &[key, impact] : container)
+        {
+            local_impacts->add(
+                key + 1, impact.postsynaptic_neuron_index_, impact.synapse_type_, impact.impact_value_,
+                is_forcing<core::Projection<DeltaLikeSynapse>>());
+        }
+        return;
+    }
+
+    for (const auto &[key, impact] : container)
+    {
+        add_impact_to_queue(projection, future_messages, key, step_n, impact);
+    }
+}
+
+
+template <class DeltaLikeSynapse>
+void calculate_block_projection_part(
+    const knp::core::Projection<DeltaLikeSynapse> &projection,
+    const std::unordered_map<size_t, size_t> &message_in_data, MessageQueue &future_messages, uint64_t step_n,
+    size_t part_start, size_t part_end, std::mutex &mutex, ImpactAccumulator *local_impacts)
+{
+    const auto &parameters = projection.get_block_parameters();
+    const auto &weights = projection.get_block_weights();
+    const auto &delays = projection.get_block_delays();
+    std::vector<std::pair<uint64_t, knp::core::messaging::SynapticImpact>> container;
+
+    std::visit(
+        [&](const auto &block)
+        {
+            if constexpr (std::is_same_v<std::decay_t<decltype(block)>, core::DenseBlock>)
+            {
+                if (is_row_delivery(projection, block, local_impacts))
+                {
+                    // Synapse indexes of a dense block are weight indexes, the part contains parts of weight rows.
+                    const std::lock_guard lock_guard(mutex);
+                    for (const auto &[neuron_index, spike_count] : message_in_data)
+                    {
+                        if (neuron_index >= block.presynaptic_size_) continue;
+                        const size_t row_start = neuron_index * block.postsynaptic_size_;
+                        const size_t first = std::max(row_start, part_start);
+                        const size_t last = std::min(row_start + block.postsynaptic_size_, part_end);
+                        if (first >= last) continue;
+                        for (size_t spike = 0; spike < spike_count; ++spike)
+                        {
+                            local_impacts->add_row(
+                                parameters.delay_ + step_n, first - row_start, parameters.output_type_,
+                                weights.data() + first, last - first,
+                                is_forcing<core::Projection<DeltaLikeSynapse>>());
+                        }
+                    }
+                    return;
+                }
+            }
+
+            // Only synapses of the part are visited, so parts don't scan synapses of each other.
+            for (const auto &[neuron_index, spike_count] : message_in_data)
+            {
+                block.for_each_postsynaptic(
+                    neuron_index, part_start, part_end,
+                    [&, neuron_index = neuron_index, spike_count = spike_count](
+                        size_t synapse_index, size_t weight_index, size_t target)
+                    {
+                        // The message is sent on step N - 1, received on step N.
+                        const uint64_t key = (delays.empty() ? parameters.delay_ : delays[weight_index]) + step_n - 1;
+                        container.emplace_back(
+                            key, knp::core::messaging::SynapticImpact{
+                                     synapse_index, weights[weight_index] * spike_count, parameters.output_type_,
+                                     static_cast<uint32_t>(neuron_index), static_cast<uint32_t>(target)});
+                    });
+            }
+            add_projection_part_impacts(projection, container, future_messages, step_n, mutex, local_impacts);
+        },
+        *projection.get_synapse_block());
+}
+
+
 template <class DeltaLikeSynapse>
 void calculate_projection_part_impl(
     knp::core::Projection<DeltaLikeSynapse> &projection, const std::unordered_map<size_t, size_t> &message_in_data,
-    MessageQueue &future_messages, uint64_t step_n, size_t part_start, size_t part_size, std::mutex &mutex)
+    MessageQueue &future_messages, uint64_t step_n, size_t part_start, size_t part_size, std::mutex &mutex,
+    ImpactAccumulator *local_impacts)
 {
     size_t part_end = std::min(part_start + part_size, projection.size());
+    if (projection.is_compact())
+    {
+        calculate_block_projection_part(
+            projection, message_in_data, future_messages, step_n, part_start, part_end, mutex, local_impacts);
+        return;
+    }
+
     std::vector<std::pair<uint64_t, knp::core::messaging::SynapticImpact>> container;
     for (size_t synapse_index = part_start; synapse_index < part_end; ++synapse_index)
     {
@@ -157,30 +343,7 @@ void calculate_projection_part_impl(
 
         container.emplace_back(key, impact);
     }
-    // Add impacts to future messages queue, it is a shared resource.
-    const std::lock_guard lock_guard(mutex);
-    const auto &projection_uid = projection.get_uid();
-    const auto &presynaptic_uid = projection.get_presynaptic();
-    const auto &postsynaptic_uid = projection.get_postsynaptic();
-
-    for (auto value : container)
-    {
-        auto iter = future_messages.find(value.first);
-        if (iter != future_messages.end())
-        {
-            iter->second.impacts_.push_back(value.second);
-        }
-        else
-        {
-            knp::core::messaging::SynapticImpactMessage message_out{
-                {projection_uid, step_n},
-                postsynaptic_uid,
-                presynaptic_uid,
-                is_forcing<core::Projection<DeltaLikeSynapse>>(),
-                {value.second}};
-            future_messages.insert(std::make_pair(value.first, message_out));
-        }
-    }
+    add_projection_part_impacts(projection, container, future_messages, step_n, mutex, local_impacts);
 }
 
 
@@ -211,12 +374,14 @@ inline std::unordered_map<uint64_t, size_t> convert_spikes(const core::messaging
 template <class DeltaLikeSynapseType>
 void calculate_delta_synapse_projection_impl(
     knp::core::Projection<DeltaLikeSynapseType> &projection, knp::core::MessageEndpoint &endpoint,
-    MessageQueue &future_messages, size_t step_n)
+    MessageQueue &future_messages, size_t step_n, ImpactAccumulator *local_impacts)
 {
     SPDLOG_DEBUG("Calculating delta synapse projection...");
 
     auto messages = endpoint.unload_messages<core::messaging::SpikeMessage>(projection.get_uid());
-    auto out_iter = calculate_delta_synapse_projection_data(projection, messages, future_messages, step_n);
+    auto out_iter =
+        calculate_delta_synapse_projection_data(projection, messages, future_messages, step_n, local_impacts);
+    // With local impacts the queue contains only messages that were added before the projection started using them.
     if (out_iter != future_messages.end())
     {
         SPDLOG_TRACE("Projection is sending an impact message.");
@@ -126,7 +126,8 @@ std::vector<synapse_traits::synapse_parameters<SynapseType> *> get_all_connected
     std::vector<synapse_traits::synapse_parameters<SynapseType> *> result;
     for (auto *projection : projections_to_neuron)
     {
-        auto synapses = projection->find_synapses(neuron_index, core::Projection<SynapseType>::Search::by_postsynaptic);
+        const auto &synapses =
+            projection->get_synapse_indexes(neuron_index, core::Projection<SynapseType>::Search::by_postsynaptic);
         std::transform(
             synapses.begin(), synapses.end(), std::back_inserter(result),
             [&projection](auto const &index) { return &std::get<core::synapse_data>((*projection)[index]); });
@@ -21,6 +21,8 @@
 
 #pragma once
 
+#include <knp/backends/cpu-library/impact_accumulator.h>
+#include <knp/core/backend.h>
 #include <knp/core/message_endpoint.h>
 #include <knp/core/messaging/messaging.h>
 #include <knp/core/projection.h>
@@ -29,7 +31,10 @@
 
 #include <string>
 #include <tuple>
+#include <unordered_map>
+#include <utility>
 #include <variant>
+#include <vector>
 
 
 /**
@@ -104,4 +109,67 @@ void init(const ProjectionContainer &projections, knp::core::MessageEndpoint &me
     }
 }
 
+
+/**
+ * @brief Create impact accumulators for backend populations and link them to the projections that impact these
+ * populations.
+ * @details Projections which postsynaptic population isn't located in the backend get `nullptr` and send impact
+ * messages.
+ * @tparam PopulationContainer type of population container.
+ * @tparam ProjectionContainer type of projection container.
+ * @param populations backend populations.
+ * @param projections backend projections.
+ * @param local_impacts vector that receives impact accumulators, one per population in the same order.
+ */
+template <typename PopulationContainer, typename ProjectionContainer>
+void init_local_impacts(
+    const PopulationContainer &populations, ProjectionContainer &projections,
+    std::vector<ImpactAccumulator> &local_impacts)
+{
+    std::unordered_map<core::UID, size_t, core::uid_hash> population_indexes;
+    local_impacts.clear();
+    local_impacts.reserve(populations.size());
+    for (const auto &population : populations)
+    {
+        const auto [uid, size] = std::visit(
+            [](const auto &pop) { return std::make_pair(pop.get_uid(), pop.size()); }, population);
+        population_indexes.emplace(uid, local_impacts.size());
+        local_impacts.emplace_back(size);
+    }
+
+    for (auto &p : projections)
+    {
+        const auto post_uid = std::visit([](const auto &proj) { return proj.get_postsynaptic(); }, p.arg_);
+        const auto iter = population_indexes.find(post_uid);
+        p.local_impacts_ = (population_indexes.end() == iter) ? nullptr : &local_impacts[iter->second];
+    }
+}
+
+
+/**
+ * @brief Find projections with local postsynaptic populations that must still send impact messages to the bus.
+ * @details The check locks subscriptions of all bus endpoints, so backends call the function at initialization and
+ * then only after the bus message version of the backend changes.
+ * @tparam ProjectionContainer type of projection container.
+ * @param projections backend projections linked to impact accumulators.
+ * @param backend backend that contains the projections.
+ * @param version variable that receives the bus message version for which the flags are found.
+ */
+template <typename ProjectionContainer>
+void init_bus_message_flags(ProjectionContainer &projections, const core::Backend &backend, uint64_t &version)
+{
+    // The version is read first, so changes made during the search are found at the next call.
+    version = backend.get_bus_message_version();
+    for (auto &p : projections)
+    {
+        // Projections without local accumulators send impact messages anyway.
+        p.is_bus_message_required_ = false;
+        if (!p.local_impacts_) continue;
+        const auto [uid, post_uid] = std::visit(
+            [](const auto &proj) { return std::make_pair(proj.get_uid(), proj.get_postsynaptic()); }, p.arg_);
+        p.is_bus_message_required_ =
+            backend.is_bus_message_required<core::messaging::SynapticImpactMessage>(uid, post_uid);
+    }
+}
+
 }  // namespace knp::backends::cpu
@@ -0,0 +1,216 @@
+/**
+ * @file structural_plasticity.h
+ * @brief Routines that change structure of a network loaded to a CPU backend.
+ * @kaspersky_support Artiom N.
+ * @date 18.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <knp/backends/cpu-library/impact_accumulator.h>
+#include <knp/core/message_endpoint.h>
+#include <knp/core/messaging/messaging.h>
+#include <knp/core/uid.h>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+
+/**
+ * @brief Namespace for CPU backends.
+ */
+namespace knp::backends::cpu
+{
+
+/**
+ * @brief Remove neurons from an impact message.
+ * @details Impacts on removed neurons are dropped, impacts on the remaining neurons are moved to their new indexes.
+ * @param message impact message.
+ * @param neuron_indexes sorted unique indexes of removed postsynaptic neurons.
+ */
+inline void remove_neurons_from_impacts(
+    knp::core::messaging::SynapticImpactMessage &message, const std::vector<size_t> &neuron_indexes)
+{
+    auto &impacts = message.impacts_;
+    size_t write_index = 0;
+    for (size_t read_index = 0; read_index < impacts.size(); ++read_index)
+    {
+        const size_t neuron_index = impacts[read_index].postsynaptic_neuron_index_;
+        const auto removed = std::lower_bound(neuron_indexes.begin(), neuron_indexes.end(), neuron_index);
+        if (removed != neuron_indexes.end() && *removed == neuron_index) continue;
+
+        impacts[read_index].postsynaptic_neuron_index_ -=
+            static_cast<uint32_t>(std::distance(neuron_indexes.begin(), removed));
+        impacts[write_index++] = impacts[read_index];
+    }
+    impacts.erase(impacts.begin() + write_index, impacts.end());
+}
+
+
+/**
+ * @brief Remove neurons from pending impact messages.
+ * @details Impacts on removed neurons are dropped, impacts on the remaining neurons are moved to their new indexes.
+ * @param messages pending impact messages of a projection.
+ * @param neuron_indexes sorted unique indexes of removed postsynaptic neurons.
+ */
+inline void remove_neurons_from_impacts(
+    std::unordered_map<uint64_t, knp::core::messaging::SynapticImpactMessage> &messages,
+    const std::vector<size_t> &neuron_indexes)
+{
+    for (auto &[step, message] : messages) remove_neurons_from_impacts(message, neuron_indexes);
+}
+
+
+/**
+ * @brief Remove neurons from a spike message.
+ * @details Spikes of removed neurons are dropped, spikes of the remaining neurons are moved to their new indexes.
+ * @param message spike message.
+ * @param neuron_indexes sorted unique indexes of removed neurons.
+ */
+inline void remove_neurons_from_spikes(
+    knp::core::messaging::SpikeMessage &message, const std::vector<size_t> &neuron_indexes)
+{
+    auto &spikes = message.neuron_indexes_;
+    size_t write_index = 0;
+    for (size_t read_index = 0; read_index < spikes.size(); ++read_index)
+    {
+        const size_t neuron_index = spikes[read_index];
+        const auto removed = std::lower_bound(neuron_indexes.begin(), neuron_indexes.end(), neuron_index);
+        if (removed != neuron_indexes.end() && *removed == neuron_index) continue;
+
+        spikes[write_index++] = static_cast<knp::core::messaging::SpikeIndex>(
+            neuron_index - std::distance(neuron_indexes.begin(), removed));
+    }
+    spikes.erase(spikes.begin() + write_index, spikes.end());
+}
+
+
+/**
+ * @brief Remove neurons from messages that a backend endpoint received but didn't process yet.
+ * @details Impact messages received by the population and spike messages of the population received by projections
+ * are updated.
+ * @tparam ProjectionContainer type of projection container.
+ * @param endpoint backend message endpoint.
+ * @param projections backend projections.
+ * @param population_uid UID of the population.
+ * @param neuron_indexes sorted unique indexes of removed neurons.
+ */
+template <typename ProjectionContainer>
+void remove_neurons_from_received_messages(
+    core::MessageEndpoint &endpoint, const ProjectionContainer &projections, const core::UID &population_uid,
+    const std::vector<size_t> &neuron_indexes)
+{
+    // The population is subscribed only to projections that send impacts to it.
+    if (auto *messages = endpoint.get_received_messages<core::messaging::SynapticImpactMessage>(population_uid))
+    {
+        for (auto &message : *messages) remove_neurons_from_impacts(message, neuron_indexes);
+    }
+
+    for (const auto &wrapper : projections)
+    {
+        const auto projection_uid = std::visit([](const auto &proj) { return proj.get_uid(); }, wrapper.arg_);
+        const auto presynaptic_uid = std::visit([](const auto &proj) { return proj.get_presynaptic(); }, wrapper.arg_);
+        if (presynaptic_uid != population_uid) continue;
+        auto *messages = endpoint.get_received_messages<core::messaging::SpikeMessage>(projection_uid);
+        if (!messages) continue;
+        // A projection can also receive spikes from input channels.
+        for (auto &message : *messages)
+        {
+            if (message.header_.sender_uid_ == population_uid) remove_neurons_from_spikes(message, neuron_indexes);
+        }
+    }
+}
+
+
+/**
+ * @brief Remove neurons from a backend population together with all synapses attached to them.
+ * @details Neuron indexes of synapses in the projections connected to the population are decreased accordingly.
+ * Pending impacts and messages received by the backend endpoint are updated, so the function can be called between
+ * steps of a running backend.
+ * @tparam PopulationContainer type of population container.
+ * @tparam ProjectionContainer type of projection container.
+ * @param populations backend populations.
+ * @param projections backend projections.
+ * @param local_impacts impact accumulators of backend populations. Empty if the backend isn't initialized.
+ * @param endpoint backend message endpoint.
+ * @param population_uid UID of the population.
+ * @param neuron_indexes indexes of neurons to remove in any order. Indexes out of range are ignored.
+ * @throw std::logic_error if the population isn't loaded to the backend.
+ * @return number of deleted synapses.
+ */
+template <typename PopulationContainer, typename ProjectionContainer>
+size_t remove_neurons(
+    PopulationContainer &populations, ProjectionContainer &projections, std::vector<ImpactAccumulator> &local_impacts,
+    core::MessageEndpoint &endpoint, const core::UID &population_uid, std::vector<size_t> neuron_indexes)
+{
+    SPDLOG_DEBUG(
+        "Removing {} neurons from population with UID {}...", neuron_indexes.size(), std::string(population_uid));
+    const auto population = std::find_if(
+        populations.begin(), populations.end(),
+        [&population_uid](const auto &pop_variant)
+        { return std::visit([](const auto &pop) { return pop.get_uid(); }, pop_variant) == population_uid; });
+
+    if (population == populations.end())
+    {
+        throw std::logic_error(
+            "Cannot remove neurons from non-existent population with UID \"" + std::string(population_uid) + "\".");
+    }
+
+    const size_t population_size = std::visit([](const auto &pop) { return pop.size(); }, *population);
+    std::sort(neuron_indexes.begin(), neuron_indexes.end());
+    neuron_indexes.erase(std::unique(neuron_indexes.begin(), neuron_indexes.end()), neuron_indexes.end());
+    neuron_indexes.erase(
+        std::lower_bound(neuron_indexes.begin(), neuron_indexes.end(), population_size), neuron_indexes.end());
+    if (neuron_indexes.empty()) return 0;
+
+    std::visit([&neuron_indexes](auto &pop) { pop.remove_neurons(neuron_indexes); }, *population);
+    if (local_impacts.size() == populations.size())
+    {
+        local_impacts[std::distance(populations.begin(), population)].remove_neurons(neuron_indexes);
+    }
+    remove_neurons_from_received_messages(endpoint, projections, population_uid, neuron_indexes);
+
+    size_t removed_synapses = 0;
+    for (auto &wrapper : projections)
+    {
+        removed_synapses += std::visit(
+            [&population_uid, &neuron_indexes, &wrapper](auto &proj)
+            {
+                size_t result = 0;
+                if (proj.get_presynaptic() == population_uid) result += proj.remove_presynaptic_neurons(neuron_indexes);
+                if (proj.get_postsynaptic() == population_uid)
+                {
+                    result += proj.remove_postsynaptic_neurons(neuron_indexes);
+                    remove_neurons_from_impacts(wrapper.messages_, neuron_indexes);
+                }
+                return result;
+            },
+            wrapper.arg_);
+    }
+
+    return removed_synapses;
+}
+
+}  // namespace knp::backends::cpu
@@ -19,9 +19,13 @@
  * limitations under the License.
  */
 
+#include <knp/backends/cpu-library/batched_inference.h>
 #include <knp/backends/cpu-library/blifat_population.h>
 #include <knp/backends/cpu-library/delta_synapse_projection.h>
+#include <knp/backends/cpu-library/dynamic_state.h>
+#include <knp/backends/cpu-library/impact_accumulator.h>
 #include <knp/backends/cpu-library/init.h>
+#include <knp/backends/cpu-library/structural_plasticity.h>
 #include <knp/backends/cpu-multi-threaded/backend.h>
 #include <knp/backends/thread_pool/thread_pool.h>
 #include <knp/devices/cpu.h>
@@ -31,8 +35,11 @@
 
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
+#include <exception>
 #include <functional>
 #include <optional>
+#include <stdexcept>
 #include <vector>
 
 #include <boost/mp11.hpp>
@@ -44,15 +51,16 @@ MultiThreadedCPUBackend::MultiThreadedCPUBackend(
     size_t thread_count, size_t population_part_size, size_t projection_part_size)
     : population_part_size_(population_part_size),
       projection_part_size_(projection_part_size),
-      calc_pool_(std::make_unique<cpu_executors::ThreadPool>(
-          thread_count ? thread_count : std::thread::hardware_concurrency()))
+      thread_count_(std::max<size_t>(thread_count ? thread_count : std::thread::hardware_concurrency(), 1)),
+      calc_pool_(std::make_unique<cpu_executors::ThreadPool>(thread_count_))
 {
-    SPDLOG_INFO(
-        "Multi-threaded CPU backend instance created, thread count = {}.",
-        thread_count ? thread_count : std::thread::hardware_concurrency());
+    SPDLOG_INFO("Multi-threaded CPU backend instance created, thread count = {}.", thread_count_);
 }
 
 
+MultiThreadedCPUBackend::~MultiThreadedCPUBackend() = default;
+
+
 std::shared_ptr<MultiThreadedCPUBackend> MultiThreadedCPUBackend::create()
 {
     SPDLOG_DEBUG("Creating multi-threaded CPU backend instance...");
@@ -109,17 +117,18 @@ void MultiThreadedCPUBackend::calculate_populations_pre_impact()
 
 void MultiThreadedCPUBackend::calculate_populations_impact()
 {
-    for (auto &population : populations_)
+    for (size_t pop_index = 0; pop_index < populations_.size(); ++pop_index)
     {
+        auto &population = populations_[pop_index];
         auto uid = std::visit([](auto &population) { return population.get_uid(); }, population);
         auto messages = get_message_endpoint().unload_messages<knp::core::messaging::SynapticImpactMessage>(uid);
         std::visit(
-            [this, &messages](auto &pop)
+            [this, &messages, pop_index](auto &pop)
             {
                 using T = std::decay_t<decltype(pop)>;
                 calc_pool_->post(
-                    knp::backends::cpu::process_inputs<typename T::PopulationNeuronType>, std::ref(pop),
-                    std::move(messages));
+                    knp::backends::cpu::process_all_inputs<typename T::PopulationNeuronType>, std::ref(pop),
+                    std::move(messages), &local_impacts_[pop_index], get_step());
             },
             population);
     }
@@ -199,6 +208,10 @@ void send_message(ProjectionWrapper &projection, core::MessageEndpoint &endpoint
 void MultiThreadedCPUBackend::calculate_projections()
 {
     SPDLOG_DEBUG("Calculating projections...");
+    if (get_bus_message_version() != bus_message_version_)
+    {
+        knp::backends::cpu::init_bus_message_flags(projections_, *this, bus_message_version_);
+    }
     std::vector<std::unordered_map<uint64_t, size_t>> converted_message_buffer;
     converted_message_buffer.reserve(projections_.size());
 
@@ -212,19 +225,22 @@ void MultiThreadedCPUBackend::calculate_projections()
             continue;
         }
 
+        // Projections with subscribers besides the postsynaptic population send impact messages to the bus.
+        auto *local_impacts = projection.is_bus_message_required_ ? nullptr : projection.local_impacts_;
+
         // Looping over synapses.
         converted_message_buffer.emplace_back(cpu::convert_spikes(msg_buf[0]));
         const auto proj_size = std::visit([](const auto &proj) { return proj.size(); }, projection.arg_);
         for (size_t synapse_index = 0; synapse_index < proj_size; synapse_index += projection_part_size_)
         {
             std::visit(
-                [this, synapse_index, &converted_message_buffer, &projection](auto &proj)
+                [this, synapse_index, &converted_message_buffer, &projection, local_impacts](auto &proj)
                 {
                     using T = std::decay_t<decltype(proj)>;
                     calc_pool_->post(
                         knp::backends::cpu::calculate_projection_part<typename T::ProjectionSynapseType>,
                         std::ref(proj), std::ref(converted_message_buffer.back()), std::ref(projection.messages_),
-                        get_step(), synapse_index, projection_part_size_, std::ref(ep_mutex_));
+                        get_step(), synapse_index, projection_part_size_, std::ref(ep_mutex_), local_impacts);
                 },
                 projection.arg_);
         }
@@ -259,6 +275,11 @@ std::vector<size_t> MultiThreadedCPUBackend::get_supported_population_indexes()
 void MultiThreadedCPUBackend::_step()
 {
     SPDLOG_DEBUG("Starting step #{}...", get_step());
+    // Readers of network data check the update sequence to skip half-updated steps.
+    const UpdateGuard update_guard{*this};
+    // Restored accumulators are in use now, the next initialization must recreate them.
+    is_state_restored_ = false;
+    deliver_bulk_inputs();
     calculate_populations();
     get_message_bus().route_messages();
     get_message_endpoint().receive_all_messages();
@@ -309,6 +330,14 @@ void MultiThreadedCPUBackend::load_all_projections(const std::vector<knp::core::
 }
 
 
+void MultiThreadedCPUBackend::load_all_projections(std::vector<knp::core::AllProjectionsVariant> &&projections)
+{
+    SPDLOG_DEBUG("Moving projections [{}]...", projections.size());
+    knp::meta::load_from_container<SupportedProjections>(std::move(projections), projections_);
+    SPDLOG_DEBUG("All projections loaded.");
+}
+
+
 void MultiThreadedCPUBackend::load_all_populations(const std::vector<knp::core::AllPopulationsVariant> &populations)
 {
     SPDLOG_DEBUG("Loading populations [{}]...", populations.size());
@@ -317,6 +346,14 @@ void MultiThreadedCPUBackend::load_all_populations(const std::vector<knp::core::
 }
 
 
+void MultiThreadedCPUBackend::load_all_populations(std::vector<knp::core::AllPopulationsVariant> &&populations)
+{
+    SPDLOG_DEBUG("Moving populations [{}]...", populations.size());
+    knp::meta::load_from_container<SupportedPopulations>(std::move(populations), populations_);
+    SPDLOG_DEBUG("All populations loaded.");
+}
+
+
 std::vector<std::unique_ptr<knp::core::Device>> MultiThreadedCPUBackend::get_devices() const
 {
     std::vector<std::unique_ptr<knp::core::Device>> result;
@@ -340,6 +377,13 @@ void MultiThreadedCPUBackend::_init()
     SPDLOG_DEBUG("Initializing multi-threaded CPU backend...");
 
     knp::backends::cpu::init(projections_, get_message_endpoint());
+    // Accumulators are already created if dynamic state was restored before the start.
+    if (!is_state_restored_)
+    {
+        knp::backends::cpu::init_local_impacts(populations_, projections_, local_impacts_);
+    }
+    is_state_restored_ = false;
+    knp::backends::cpu::init_bus_message_flags(projections_, *this, bus_message_version_);
 
     SPDLOG_DEBUG("Initialization finished.");
 }
@@ -393,6 +437,99 @@ MultiThreadedCPUBackend::ProjectionConstIterator MultiThreadedCPUBackend::end_pr
 }
 
 
+size_t MultiThreadedCPUBackend::remove_neurons(
+    const core::UID &population_uid, const std::vector<size_t> &neuron_indexes)
+{
+    const UpdateGuard update_guard{*this};
+    return knp::backends::cpu::remove_neurons(
+        populations_, projections_, local_impacts_, get_message_endpoint(), population_uid, neuron_indexes);
+}
+
+
+knp::core::BatchOutput MultiThreadedCPUBackend::run_batch(
+    const knp::core::BatchInputMap &inputs, size_t samples_count, size_t steps_count,
+    const std::vector<knp::core::UID> &output_uids)
+{
+    if (running()) throw std::logic_error("Cannot run a batch while the backend is running.");
+    SPDLOG_DEBUG("Running batch of {} sample(s) for {} step(s)...", samples_count, steps_count);
+    const auto plan = knp::backends::cpu::make_batch_plan(
+        populations_, projections_, get_message_endpoint(), inputs, output_uids);
+    knp::core::BatchOutput output(samples_count);
+    if (!samples_count) return output;
+    const auto batch_impacts = knp::backends::cpu::get_batch_impacts(
+        populations_, projections_, local_impacts_, get_message_endpoint(), get_step());
+
+    // Every thread processes its own part of samples. Parts write to different elements of the output.
+    const size_t part_size = (samples_count + thread_count_ - 1) / thread_count_;
+    std::vector<std::exception_ptr> errors((samples_count + part_size - 1) / part_size);
+    for (size_t part_index = 0; part_index < errors.size(); ++part_index)
+    {
+        const size_t first_sample = part_index * part_size;
+        calc_pool_->post(
+            [this, &plan, &batch_impacts, &output, &errors, part_index, first_sample, steps_count,
+             part_samples = std::min(part_size, samples_count - first_sample)]()
+            {
+                try
+                {
+                    knp::backends::cpu::calculate_batch_part(
+                        plan, populations_, projections_, batch_impacts, get_step(), steps_count, first_sample,
+                        part_samples, output);
+                }
+                catch (...)
+                {
+                    errors[part_index] = std::current_exception();
+                }
+            });
+    }
+    calc_pool_->join();
+
+    for (const auto &error : errors)
+    {
+        if (error) std::rethrow_exception(error);
+    }
+    return output;
+}
+
+
+knp::core::DynamicState MultiThreadedCPUBackend::get_dynamic_state() const
+{
+    return knp::backends::cpu::get_dynamic_state(populations_, projections_, local_impacts_, get_step());
+}
+
+
+void MultiThreadedCPUBackend::set_dynamic_state(const knp::core::DynamicState &state)
+{
+    const UpdateGuard update_guard{*this};
+    knp::backends::cpu::set_dynamic_state(populations_, projections_, local_impacts_, state);
+    is_state_restored_ = true;
+    set_step(state.step_);
+}
+
+
+std::optional<knp::core::Backend::PopulationConstPointer> MultiThreadedCPUBackend::get_population_pointer(
+    const knp::core::UID &uid) const
+{
+    for (const auto &population : populations_)
+    {
+        if (std::visit([](const auto &pop) { return pop.get_uid(); }, population) != uid) continue;
+        return std::visit([](const auto &pop) -> PopulationConstPointer { return &pop; }, population);
+    }
+    return std::nullopt;
+}
+
+
+std::optional<knp::core::Backend::ProjectionConstPointer> MultiThreadedCPUBackend::get_projection_pointer(
+    const knp::core::UID &uid) const
+{
+    for (const auto &wrapper : projections_)
+    {
+        if (std::visit([](const auto &proj) { return proj.get_uid(); }, wrapper.arg_) != uid) continue;
+        return std::visit([](const auto &proj) -> ProjectionConstPointer { return &proj; }, wrapper.arg_);
+    }
+    return std::nullopt;
+}
+
+
 BOOST_DLL_ALIAS(knp::backends::multi_threaded_cpu::MultiThreadedCPUBackend::create, create_knp_backend)
 
 }  // namespace knp::backends::multi_threaded_cpu
@@ -20,9 +20,13 @@
  */
 
 
+#include <knp/backends/cpu-library/batched_inference.h>
 #include <knp/backends/cpu-library/blifat_population.h>
 #include <knp/backends/cpu-library/delta_synapse_projection.h>
+#include <knp/backends/cpu-library/dynamic_state.h>
+#include <knp/backends/cpu-library/impact_accumulator.h>
 #include <knp/backends/cpu-library/init.h>
+#include <knp/backends/cpu-library/structural_plasticity.h>
 #include <knp/backends/cpu-single-threaded/backend.h>
 #include <knp/devices/cpu.h>
 #include <knp/meta/assert_helpers.h>
@@ -32,6 +36,7 @@
 
 #include <spdlog/spdlog.h>
 
+#include <stdexcept>
 #include <vector>
 
 #include <boost/mp11.hpp>
@@ -45,6 +50,9 @@ SingleThreadedCPUBackend::SingleThreadedCPUBackend()
 }
 
 
+SingleThreadedCPUBackend::~SingleThreadedCPUBackend() = default;
+
+
 std::shared_ptr<SingleThreadedCPUBackend> SingleThreadedCPUBackend::create()
 {
     SPDLOG_DEBUG("Creating single-threaded CPU backend instance...");
@@ -89,14 +97,19 @@ SupportedVariants convert_variant(const AllVariants &input)
 void SingleThreadedCPUBackend::_step()
 {
     SPDLOG_DEBUG("Starting step #{}...", get_step());
+    // Readers of network data check the update sequence to skip half-updated steps.
+    const UpdateGuard update_guard{*this};
+    // Restored accumulators are in use now, the next initialization must recreate them.
+    is_state_restored_ = false;
+    deliver_bulk_inputs();
     get_message_bus().route_messages();
     get_message_endpoint().receive_all_messages();
     // Calculate populations. This is the same as inference.
     std::vector<std::optional<knp::core::messaging::SpikeMessage>> messages;
-    for (auto &population : populations_)
+    for (size_t population_index = 0; population_index < populations_.size(); ++population_index)
     {
         std::visit(
-            [this, &messages](auto &arg)
+            [this, &messages, population_index](auto &arg)
             {
                 using T = std::decay_t<decltype(arg)>;
                 if constexpr (
@@ -106,15 +119,19 @@ void SingleThreadedCPUBackend::_step()
                         knp::meta::always_false_v<T>,
                         "Population is not supported by the single-threaded CPU backend.");
                 }
-                auto message_opt = calculate_population(arg);
+                auto message_opt = calculate_population(arg, local_impacts_[population_index]);
                 messages.push_back(std::move(message_opt));
             },
-            population);
+            populations_[population_index]);
     }
 
     // Continue inference.
     get_message_bus().route_messages();
     get_message_endpoint().receive_all_messages();
+    if (get_bus_message_version() != bus_message_version_)
+    {
+        knp::backends::cpu::init_bus_message_flags(projections_, *this, bus_message_version_);
+    }
     // Calculate projections.
     for (auto &projection : projections_)
     {
@@ -129,7 +146,9 @@ void SingleThreadedCPUBackend::_step()
                         knp::meta::always_false_v<T>,
                         "Projection is not supported by the single-threaded CPU backend.");
                 }
-                calculate_projection(arg, projection.messages_);
+                // Projections with subscribers besides the postsynaptic population send impact messages to the bus.
+                auto *local_impacts = projection.is_bus_message_required_ ? nullptr : projection.local_impacts_;
+                calculate_projection(arg, projection.messages_, local_impacts);
             },
             projection.arg_);
     }
@@ -180,6 +199,14 @@ void SingleThreadedCPUBackend::load_all_projections(const std::vector<knp::core:
 }
 
 
+void SingleThreadedCPUBackend::load_all_projections(std::vector<knp::core::AllProjectionsVariant> &&projections)
+{
+    SPDLOG_DEBUG("Moving projections [{}]...", projections.size());
+    knp::meta::load_from_container<SupportedProjections>(std::move(projections), projections_);
+    SPDLOG_DEBUG("All projections loaded.");
+}
+
+
 void SingleThreadedCPUBackend::load_all_populations(const std::vector<knp::core::AllPopulationsVariant> &populations)
 {
     SPDLOG_DEBUG("Loading populations [{}]...", populations.size());
@@ -188,6 +215,14 @@ void SingleThreadedCPUBackend::load_all_populations(const std::vector<knp::core:
 }
 
 
+void SingleThreadedCPUBackend::load_all_populations(std::vector<knp::core::AllPopulationsVariant> &&populations)
+{
+    SPDLOG_DEBUG("Moving populations [{}]...", populations.size());
+    knp::meta::load_from_container<SupportedPopulations>(std::move(populations), populations_);
+    SPDLOG_DEBUG("All populations loaded.");
+}
+
+
 std::vector<std::unique_ptr<knp::core::Device>> SingleThreadedCPUBackend::get_devices() const
 {
     std::vector<std::unique_ptr<knp::core::Device>> result;
@@ -211,55 +246,65 @@ void SingleThreadedCPUBackend::_init()
     SPDLOG_DEBUG("Initializing single-threaded CPU backend...");
 
     knp::backends::cpu::init(projections_, get_message_endpoint());
+    // Accumulators are already created if dynamic state was restored before the start.
+    if (!is_state_restored_)
+    {
+        knp::backends::cpu::init_local_impacts(populations_, projections_, local_impacts_);
+    }
+    is_state_restored_ = false;
+    knp::backends::cpu::init_bus_message_flags(projections_, *this, bus_message_version_);
 
     SPDLOG_DEBUG("Initialization finished.");
 }
 
 
 std::optional<core::messaging::SpikeMessage> SingleThreadedCPUBackend::calculate_population(
-    core::Population<knp::neuron_traits::BLIFATNeuron> &population)
+    core::Population<knp::neuron_traits::BLIFATNeuron> &population, cpu::ImpactAccumulator &local_impacts)
 {
     SPDLOG_TRACE("Calculate BLIFAT population {}.", std::string(population.get_uid()));
-    return knp::backends::cpu::calculate_blifat_population(population, get_message_endpoint(), get_step());
+    return knp::backends::cpu::calculate_blifat_population(
+        population, get_message_endpoint(), get_step(), &local_impacts);
 }
 
 
 std::optional<core::messaging::SpikeMessage> SingleThreadedCPUBackend::calculate_population(
-    knp::core::Population<knp::neuron_traits::SynapticResourceSTDPBLIFATNeuron> &population)
+    knp::core::Population<knp::neuron_traits::SynapticResourceSTDPBLIFATNeuron> &population,
+    cpu::ImpactAccumulator &local_impacts)
 {
     SPDLOG_TRACE("Calculate resource-based STDP-compatible BLIFAT population {}.", std::string(population.get_uid()));
     return knp::backends::cpu::calculate_resource_stdp_population<
         neuron_traits::BLIFATNeuron, synapse_traits::DeltaSynapse, ProjectionContainer>(
-        population, projections_, get_message_endpoint(), get_step());
+        population, projections_, get_message_endpoint(), get_step(), &local_impacts);
 }
 
 
 void SingleThreadedCPUBackend::calculate_projection(
-    knp::core::Projection<knp::synapse_traits::DeltaSynapse> &projection, SynapticMessageQueue &message_queue)
+    knp::core::Projection<knp::synapse_traits::DeltaSynapse> &projection, SynapticMessageQueue &message_queue,
+    cpu::ImpactAccumulator *local_impacts)
 {
     SPDLOG_TRACE("Calculate delta synapse projection {}.", std::string(projection.get_uid()));
     knp::backends::cpu::calculate_delta_synapse_projection(
-        projection, get_message_endpoint(), message_queue, get_step());
+        projection, get_message_endpoint(), message_queue, get_step(), local_impacts);
 }
 
 
 void SingleThreadedCPUBackend::calculate_projection(
     knp::core::Projection<knp::synapse_traits::AdditiveSTDPDeltaSynapse> &projection,
-    SynapticMessageQueue &message_queue)
+    SynapticMessageQueue &message_queue, cpu::ImpactAccumulator *local_impacts)
 {
     SPDLOG_TRACE("Calculate AdditiveSTDPDelta synapse projection {}.", std::string(projection.get_uid()));
     knp::backends::cpu::calculate_delta_synapse_projection(
-        projection, get_message_endpoint(), message_queue, get_step());
+        projection, get_message_endpoint(), message_queue, get_step(), local_impacts);
 }
 
 
 void SingleThreadedCPUBackend::calculate_projection(
     knp::core::Projection<knp::synapse_traits::SynapticResourceSTDPDeltaSynapse> &projection,
-    SynapticMessageQueue &message_queue)
+    SynapticMessageQueue &message_queue, cpu::ImpactAccumulator *local_impacts)
 {
     SPDLOG_TRACE("Calculate STDPSynapticResource synapse projection {}.", std::string(projection.get_uid()));
     knp::backends::cpu::calculate_delta_synapse_projection(
-        projection, get_message_endpoint(), message_queue, get_step());
+        projection, get_message_endpoint(), message_queue, get_step(), local_impacts);
 }
 
 
@@ -311,6 +356,71 @@ SingleThreadedCPUBackend::ProjectionConstIterator SingleThreadedCPUBackend::end_
 }
 
 
+size_t SingleThreadedCPUBackend::remove_neurons(
+    const core::UID &population_uid, const std::vector<size_t> &neuron_indexes)
+{
+    const UpdateGuard update_guard{*this};
+    return knp::backends::cpu::remove_neurons(
+        populations_, projections_, local_impacts_, get_message_endpoint(), population_uid, neuron_indexes);
+}
+
+
+knp::core::BatchOutput SingleThreadedCPUBackend::run_batch(
+    const knp::core::BatchInputMap &inputs, size_t samples_count, size_t steps_count,
+    const std::vector<knp::core::UID> &output_uids)
+{
+    if (running()) throw std::logic_error("Cannot run a batch while the backend is running.");
+    SPDLOG_DEBUG("Running batch of {} sample(s) for {} step(s)...", samples_count, steps_count);
+    const auto plan = knp::backends::cpu::make_batch_plan(
+        populations_, projections_, get_message_endpoint(), inputs, output_uids);
+    const auto batch_impacts = knp::backends::cpu::get_batch_impacts(
+        populations_, projections_, local_impacts_, get_message_endpoint(), get_step());
+    knp::core::BatchOutput output(samples_count);
+    knp::backends::cpu::calculate_batch_part(
+        plan, populations_, projections_, batch_impacts, get_step(), steps_count, 0, samples_count, output);
+    return output;
+}
+
+
+knp::core::DynamicState SingleThreadedCPUBackend::get_dynamic_state() const
+{
+    return knp::backends::cpu::get_dynamic_state(populations_, projections_, local_impacts_, get_step());
+}
+
+
+void SingleThreadedCPUBackend::set_dynamic_state(const knp::core::DynamicState &state)
+{
+    const UpdateGuard update_guard{*this};
+    knp::backends::cpu::set_dynamic_state(populations_, projections_, local_impacts_, state);
+    is_state_restored_ = true;
+    set_step(state.step_);
+}
+
+
+std::optional<knp::core::Backend::PopulationConstPointer> SingleThreadedCPUBackend::get_population_pointer(
+    const knp::core::UID &uid) const
+{
+    for (const auto &population : populations_)
+    {
+        if (std::visit([](const auto &pop) { return pop.get_uid(); }, population) != uid) continue;
+        return std::visit([](const auto &pop) -> PopulationConstPointer { return &pop; }, population);
+    }
+    return std::nullopt;
+}
+
+
+std::optional<knp::core::Backend::ProjectionConstPointer> SingleThreadedCPUBackend::get_projection_pointer(
+    const knp::core::UID &uid) const
+{
+    for (const auto &wrapper : projections_)
+    {
+        if (std::visit([](const auto &proj) { return proj.get_uid(); }, wrapper.arg_) != uid) continue;
+        return std::visit([](const auto &proj) -> ProjectionConstPointer { return &proj; }, wrapper.arg_);
+    }
+    return std::nullopt;
+}
+
+
 BOOST_DLL_ALIAS(knp::backends::single_threaded_cpu::SingleThreadedCPUBackend::create, create_knp_backend)
 
 }  // namespace knp::backends::single_threaded_cpu
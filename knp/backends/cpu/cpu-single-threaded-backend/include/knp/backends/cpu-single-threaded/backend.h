@@ -22,6 +22,7 @@
 #pragma once
 
 #include <knp/core/backend.h>
+#include <knp/core/batch.h>
 #include <knp/core/impexp.h>
 #include <knp/core/population.h>
 #include <knp/core/projection.h>
@@ -30,6 +31,7 @@
 #include <knp/synapse-traits/all_traits.h>
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -41,6 +43,18 @@
 #include <boost/mp11.hpp>
 
 
+/**
+ * @brief Namespace for CPU backends.
+ */
+namespace knp::backends::cpu
+{
+/**
+ * @brief The ImpactAccumulator class is an internal class used to deliver impacts inside a backend.
+ */
+class ImpactAccumulator;
+}  // namespace knp::backends::cpu
+
+
 /**
  * @brief Namespace for single-threaded backend.
  */
@@ -103,6 +117,12 @@ private:
         ProjectionVariants arg_;
         // cppcheck-suppress unusedStructMember
         std::unordered_map<uint64_t, knp::core::messaging::SynapticImpactMessage> messages_;
+        // Accumulator of the postsynaptic population if it is located in the backend.
+        // cppcheck-suppress unusedStructMember
+        cpu::ImpactAccumulator *local_impacts_ = nullptr;
+        // `true` if impacts are sent to the bus because other receivers besides the local population need them.
+        // cppcheck-suppress unusedStructMember
+        bool is_bus_message_required_ = false;
     };
 
 public:
@@ -142,7 +162,7 @@ public:
     /**
      * @brief Destructor for single-threaded CPU backend.
      */
-    ~SingleThreadedCPUBackend() override = default;
+    ~SingleThreadedCPUBackend() override;
 
 public:
     /**
@@ -198,6 +218,13 @@ public:
      */
     void load_all_projections(const std::vector<knp::core::AllProjectionsVariant> &projections) override;
 
+    /**
+     * @brief Move projections to backend.
+     * @throw exception if the `projections` parameter contains unsupported projection types.
+     * @param projections projections to add. The container is empty after the call.
+     */
+    void load_all_projections(std::vector<knp::core::AllProjectionsVariant> &&projections) override;
+
     /**
      * @brief Add populations to backend.
      * @throw exception if the `populations` parameter contains unsupported population types.
@@ -205,6 +232,13 @@ public:
      */
     void load_all_populations(const std::vector<knp::core::AllPopulationsVariant> &populations) override;
 
+    /**
+     * @brief Move populations to backend.
+     * @throw exception if the `populations` parameter contains unsupported population types.
+     * @param populations populations to add. The container is empty after the call.
+     */
+    void load_all_populations(std::vector<knp::core::AllPopulationsVariant> &&populations) override;
+
 public:
     /**
      * @brief Get an iterator pointing to the first element of the population loaded to backend.
@@ -265,6 +299,18 @@ public:
      */
     void remove_populations(const std::vector<knp::core::UID> &uids) override {}
 
+    /**
+     * @brief Remove neurons from a population together with all synapses attached to them.
+     * @details Neuron indexes of synapses in the projections connected to the population are decreased accordingly.
+     * Pending impacts and received messages that are not processed yet are updated, so the method can be called
+     * between steps.
+     * @param population_uid UID of the population.
+     * @param neuron_indexes indexes of neurons to remove in any order. Indexes out of range are ignored.
+     * @throw std::logic_error if the population isn't loaded to the backend.
+     * @return number of deleted synapses.
+     */
+    size_t remove_neurons(const knp::core::UID &population_uid, const std::vector<size_t> &neuron_indexes);
+
 public:
     /**
      * @brief Get a list of devices supported by the backend.
@@ -279,6 +325,24 @@ public:
      */
     void _step() override;
 
+    /**
+     * @brief Run inference of several independent samples.
+     * @details Every sample starts from the current state of backend populations and gets its own copy of it, while
+     * projections are shared by all samples. Spikes of all samples sent by the same presynaptic neuron are processed
+     * by a single pass over its synapses. The backend state isn't changed and plasticity isn't applied. Impacts
+     * accumulated by the backend before the call, including impact messages received or queued for sending through
+     * the message bus, are delivered to every sample.
+     * @param inputs input spike generators by UIDs of senders to which projections are subscribed.
+     * @param samples_count number of samples.
+     * @param steps_count number of steps to execute for every sample.
+     * @param output_uids UIDs of populations which spikes are returned.
+     * @return spike messages of output populations by sample index.
+     * @throw std::logic_error if the backend is running.
+     */
+    [[nodiscard]] knp::core::BatchOutput run_batch(
+        const knp::core::BatchInputMap &inputs, size_t samples_count, size_t steps_count,
+        const std::vector<knp::core::UID> &output_uids);
+
     /**
      * @brief Stop training by locking all projections.
      */
@@ -307,6 +371,29 @@ public:
      */
     [[nodiscard]] DataRanges get_network_data() const override;
 
+    /**
+     * @brief Get mutable state of populations and projections without copying static parameters.
+     * @return dynamic state at the current step.
+     */
+    [[nodiscard]] knp::core::DynamicState get_dynamic_state() const override;
+
+    /**
+     * @copydoc knp::core::Backend::set_dynamic_state()
+     */
+    void set_dynamic_state(const knp::core::DynamicState &state) override;
+
+    /**
+     * @copydoc knp::core::Backend::get_population_pointer()
+     */
+    [[nodiscard]] std::optional<PopulationConstPointer> get_population_pointer(
+        const knp::core::UID &uid) const override;
+
+    /**
+     * @copydoc knp::core::Backend::get_projection_pointer()
+     */
+    [[nodiscard]] std::optional<ProjectionConstPointer> get_projection_pointer(
+        const knp::core::UID &uid) const override;
+
 protected:
     /**
      * @brief Map used for message construction. It maps a message to its future output step.
@@ -322,50 +409,63 @@ protected:
      * @brief Calculate population of BLIFAT neurons.
      * @note Population will be changed during calculation.
      * @param population population to calculate.
+     * @param local_impacts impacts sent to the population by projections located in the backend.
      * @return copy of a spike message if population is emitting one.
      */
     std::optional<core::messaging::SpikeMessage> calculate_population(
-        knp::core::Population<knp::neuron_traits::BLIFATNeuron> &population);
+        knp::core::Population<knp::neuron_traits::BLIFATNeuron> &population, cpu::ImpactAccumulator &local_impacts);
 
     /**
      * @brief Calculate population of `SynapticResourceSTDPNeuron` neurons.
      * @note Population will be changed during calculation.
      * @param population population to calculate.
+     * @param local_impacts impacts sent to the population by projections located in the backend.
      * @return optional `SpikeMessage`.
      */
     std::optional<core::messaging::SpikeMessage> calculate_population(
-        knp::core::Population<knp::neuron_traits::SynapticResourceSTDPBLIFATNeuron> &population);
+        knp::core::Population<knp::neuron_traits::SynapticResourceSTDPBLIFATNeuron> &population,
+        cpu::ImpactAccumulator &local_impacts);
     /**
      * @brief Calculate projection of delta synapses.
      * @note Projection will be changed during calculation.
      * @param projection projection to calculate.
      * @param message_queue message queue to send to projection for calculation.
+     * @param local_impacts impact accumulator of the postsynaptic population or `nullptr` to send impact messages.
      */
     void calculate_projection(
-        knp::core::Projection<knp::synapse_traits::DeltaSynapse> &projection, SynapticMessageQueue &message_queue);
+        knp::core::Projection<knp::synapse_traits::DeltaSynapse> &projection, SynapticMessageQueue &message_queue,
+        cpu::ImpactAccumulator *local_impacts);
     /**
      * @brief Calculate projection of `AdditiveSTDPDeltaSynapse` synapses.
      * @note Projection will be changed during calculation.
      * @param projection projection to calculate.
      * @param message_queue message queue to send to projection for calculation.
+     * @param local_impacts impact accumulator of the postsynaptic population or `nullptr` to send impact messages.
      */
     void calculate_projection(
         knp::core::Projection<knp::synapse_traits::AdditiveSTDPDeltaSynapse> &projection,
-        SynapticMessageQueue &message_queue);
+        SynapticMessageQueue &message_queue, cpu::ImpactAccumulator *local_impacts);
     /**
      * @brief Calculate projection of `SynapticResourceSTDPDeltaSynapse` synapses.
      * @note Projection will be changed during calculation.
      * @param projection projection to calculate.
      * @param message_queue message queue to send to projection for calculation.
+     * @param local_impacts impact accumulator of the postsynaptic population or `nullptr` to send impact messages.
      */
     void calculate_projection(
         knp::core::Projection<knp::synapse_traits::SynapticResourceSTDPDeltaSynapse> &projection,
-        SynapticMessageQueue &message_queue);
+        SynapticMessageQueue &message_queue, cpu::ImpactAccumulator *local_impacts);
 
 private:
     // cppcheck-suppress unusedStructMember
     PopulationContainer populations_;
     ProjectionContainer projections_;
+    // Impacts of local projections, one accumulator per population.
+    std::vector<cpu::ImpactAccumulator> local_impacts_;
+    // Dynamic state was restored, so accumulators contain pending impacts. Cleared by initialization or a step.
+    bool is_state_restored_ = false;
+    // Bus message version for which bus message flags of projections are found.
+    uint64_t bus_message_version_ = 0;
 };
 
 }  // namespace knp::backends::single_threaded_cpu
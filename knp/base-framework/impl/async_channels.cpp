@@ -0,0 +1,220 @@
+/**
+ * @file async_channels.cpp
+ * @brief Lock-free queues that pass spikes between threads and a running model.
+ * @kaspersky_support Artiom N.
+ * @date 18.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <knp/framework/io/async_channels.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+
+namespace knp::framework::io
+{
+
+// Cells are taken by producers in turn. Cell sequence shows whether the cell can be written or read for the
+// current position, so producers and the consumer never access the same cell data at the same time.
+struct SpikeInputQueue::Cell
+{
+    std::atomic<size_t> sequence_ = 0;
+    core::Step step_ = 0;
+    core::messaging::SpikeData spikes_;
+};
+
+
+SpikeInputQueue::SpikeInputQueue(size_t capacity) : capacity_(capacity)
+{
+    if (!capacity_) throw std::invalid_argument("Spike input queue capacity must be non-zero.");
+    cells_ = std::make_unique<Cell[]>(capacity_);
+    for (size_t index = 0; index < capacity_; ++index) cells_[index].sequence_.store(index, std::memory_order_relaxed);
+}
+
+
+SpikeInputQueue::~SpikeInputQueue() = default;
+
+
+bool SpikeInputQueue::push(core::Step step, core::messaging::SpikeData spikes)
+{
+    size_t position = push_position_.load(std::memory_order_relaxed);
+    Cell *cell = nullptr;
+    while (true)
+    {
+        cell = &cells_[position % capacity_];
+        const size_t sequence = cell->sequence_.load(std::memory_order_acquire);
+        const auto difference = static_cast<std::ptrdiff_t>(sequence - position);
+        if (0 == difference)
+        {
+            if (push_position_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+        }
+        else if (difference < 0)
+        {
+            // The consumer hasn't read the cell yet.
+            return false;
+        }
+        else
+        {
+            position = push_position_.load(std::memory_order_relaxed);
+        }
+    }
+
+    cell->step_ = step;
+    cell->spikes_ = std::move(spikes);
+    cell->sequence_.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+
+bool SpikeInputQueue::pop(core::Step &step, core::messaging::SpikeData &spikes)
+{
+    Cell &cell = cells_[pop_position_ % capacity_];
+    if (cell.sequence_.load(std::memory_order_acquire) != pop_position_ + 1) return false;
+
+    step = cell.step_;
+    spikes = std::move(cell.spikes_);
+    cell.sequence_.store(pop_position_ + capacity_, std::memory_order_release);
+    ++pop_position_;
+    return true;
+}
+
+
+// Slot data are atomics read with relaxed order: a reader can read a slot while the writer overwrites it, then
+// the changed sequence shows that the copy must be dropped.
+struct SpikeOutputRing::Ring
+{
+    struct Slot
+    {
+        // 2 * n + 1 while message n is written, 2 * n + 2 after it is written.
+        std::atomic<uint64_t> sequence_ = 0;
+        std::atomic<core::Step> step_ = 0;
+        std::atomic<uint32_t> sender_index_ = 0;
+        std::atomic<uint32_t> size_ = 0;
+        std::unique_ptr<std::atomic<core::messaging::SpikeIndex>[]> indexes_;
+    };
+
+    Ring(std::vector<core::UID> senders, size_t max_spikes, size_t capacity)
+        : senders_(std::move(senders)), max_spikes_(max_spikes), capacity_(capacity)
+    {
+        if (!capacity_) throw std::invalid_argument("Spike output ring capacity must be non-zero.");
+        slots_ = std::make_unique<Slot[]>(capacity_);
+        for (size_t index = 0; index < capacity_; ++index)
+        {
+            slots_[index].indexes_ = std::make_unique<std::atomic<core::messaging::SpikeIndex>[]>(max_spikes_);
+        }
+    }
+
+    const std::vector<core::UID> senders_;
+    const size_t max_spikes_;
+    const size_t capacity_;
+    std::unique_ptr<Slot[]> slots_;
+    alignas(64) std::atomic<uint64_t> write_position_ = 0;
+};
+
+
+SpikeOutputRing::SpikeOutputRing(std::vector<core::UID> senders, size_t max_spikes, size_t capacity)
+    : ring_(std::make_shared<Ring>(std::move(senders), max_spikes, capacity))
+{
+}
+
+
+void SpikeOutputRing::write(const core::messaging::SpikeMessage &message)
+{
+    const auto sender_iter =
+        std::find(ring_->senders_.begin(), ring_->senders_.end(), message.header_.sender_uid_);
+    if (ring_->senders_.end() == sender_iter)
+    {
+        throw std::logic_error("Sender " + std::string(message.header_.sender_uid_) + " isn't an output ring sender.");
+    }
+    if (message.neuron_indexes_.size() > ring_->max_spikes_)
+    {
+        throw std::logic_error("Message has more spikes than an output ring slot can keep.");
+    }
+
+    const uint64_t position = ring_->write_position_.load(std::memory_order_relaxed);
+    auto &slot = ring_->slots_[position % ring_->capacity_];
+    slot.sequence_.store(2 * position + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.step_.store(message.header_.send_time_, std::memory_order_relaxed);
+    slot.sender_index_.store(
+        static_cast<uint32_t>(sender_iter - ring_->senders_.begin()), std::memory_order_relaxed);
+    slot.size_.store(static_cast<uint32_t>(message.neuron_indexes_.size()), std::memory_order_relaxed);
+    for (size_t index = 0; index < message.neuron_indexes_.size(); ++index)
+    {
+        slot.indexes_[index].store(message.neuron_indexes_[index], std::memory_order_relaxed);
+    }
+
+    slot.sequence_.store(2 * position + 2, std::memory_order_release);
+    ring_->write_position_.store(position + 1, std::memory_order_release);
+}
+
+
+SpikeOutputRing::Reader SpikeOutputRing::create_reader() const
+{
+    return Reader(ring_, ring_->write_position_.load(std::memory_order_acquire));
+}
+
+
+size_t SpikeOutputRing::get_capacity() const
+{
+    return ring_->capacity_;
+}
+
+
+bool SpikeOutputRing::Reader::read(core::messaging::SpikeMessage &message)
+{
+    const Ring &ring = *ring_;
+    while (true)
+    {
+        const uint64_t written = ring.write_position_.load(std::memory_order_acquire);
+        if (position_ >= written) return false;
+        if (written - position_ > ring.capacity_)
+        {
+            lost_count_ += written - ring.capacity_ - position_;
+            position_ = written - ring.capacity_;
+        }
+
+        const auto &slot = ring.slots_[position_ % ring.capacity_];
+        const uint64_t sequence = 2 * position_ + 2;
+        // The writer is overwriting the slot, the next iteration skips it.
+        if (slot.sequence_.load(std::memory_order_acquire) != sequence) continue;
+
+        const auto step = slot.step_.load(std::memory_order_relaxed);
+        const auto sender_index = std::min<size_t>(
+            slot.sender_index_.load(std::memory_order_relaxed), ring.senders_.size() - 1);
+        const auto size = std::min<size_t>(slot.size_.load(std::memory_order_relaxed), ring.max_spikes_);
+        message.neuron_indexes_.resize(size);
+        for (size_t index = 0; index < size; ++index)
+        {
+            message.neuron_indexes_[index] = slot.indexes_[index].load(std::memory_order_relaxed);
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence_.load(std::memory_order_relaxed) != sequence) continue;
+
+        message.header_.sender_uid_ = ring.senders_[sender_index];
+        message.header_.send_time_ = step;
+        ++position_;
+        return true;
+    }
+}
+
+}  // namespace knp::framework::io
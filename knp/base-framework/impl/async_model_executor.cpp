@@ -0,0 +1,341 @@
+/**
+ * @file async_model_executor.cpp
+ * @brief Executor that runs a model in its own thread.
+ * @kaspersky_support Artiom N.
+ * @date 18.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <knp/framework/async_model_executor.h>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <utility>
+
+
+namespace knp::framework
+{
+
+// Spikes pushed by other threads wait in the queue until the backend asks for spikes of a step.
+class AsyncModelExecutor::InputState
+{
+public:
+    explicit InputState(size_t capacity) : queue_(capacity) {}
+
+    void collect(core::Step step, core::messaging::SpikeData &spikes);
+
+    io::SpikeInputQueue queue_;
+
+    // Number of spike vectors pushed for steps that had already started.
+    std::atomic<uint64_t> late_count_ = 0;
+
+private:
+    std::vector<std::pair<core::Step, core::messaging::SpikeData>> pending_;
+};
+
+
+void AsyncModelExecutor::InputState::collect(core::Step step, core::messaging::SpikeData &spikes)
+{
+    core::Step pushed_step = 0;
+    core::messaging::SpikeData pushed_spikes;
+    while (queue_.pop(pushed_step, pushed_spikes)) pending_.emplace_back(pushed_step, std::move(pushed_spikes));
+
+    // Spikes pushed for future steps stay pending. Spikes pushed for earlier steps are sent now.
+    size_t write_index = 0;
+    size_t late_count = 0;
+    for (size_t read_index = 0; read_index < pending_.size(); ++read_index)
+    {
+        auto &pending = pending_[read_index];
+        if (next_step_ == pending.first || pending.first <= step)
+        {
+            if (next_step_ != pending.first && pending.first < step) ++late_count;
+            spikes.insert(spikes.end(), pending.second.begin(), pending.second.end());
+            continue;
+        }
+        if (read_index != write_index) pending_[write_index] = std::move(pending);
+        ++write_index;
+    }
+    pending_.resize(write_index);
+
+    if (late_count)
+    {
+        late_count_.fetch_add(late_count, std::memory_order_relaxed);
+        SPDLOG_WARN("{} spike vector(s) pushed for earlier steps are sent at step {}.", late_count, step);
+    }
+}
+
+
+AsyncModelExecutor::AsyncModelExecutor(
+    knp::framework::Model &model, std::shared_ptr<core::Backend> backend, size_t input_capacity,
+    size_t output_capacity)
+    : executor_(model, std::move(backend), {}, create_inputs(model, input_capacity, inputs_))
+{
+    create_outputs(model, output_capacity);
+}
+
+
+AsyncModelExecutor::~AsyncModelExecutor()
+{
+    try
+    {
+        stop();
+    }
+    catch (const std::exception &e)
+    {
+        SPDLOG_ERROR("Model execution failed: {}.", e.what());
+    }
+}
+
+
+ModelLoader::BulkInputMap AsyncModelExecutor::create_inputs(
+    const knp::framework::Model &model, size_t input_capacity,
+    std::unordered_map<core::UID, std::shared_ptr<InputState>, core::uid_hash> &inputs)
+{
+    ModelLoader::BulkInputMap result;
+    for (const auto &[channel_uid, projection_uid] : model.get_input_channels())
+    {
+        if (inputs.count(channel_uid)) continue;
+        auto state = std::make_shared<InputState>(input_capacity);
+        inputs.emplace(channel_uid, state);
+        // Window of one step: pushed spikes are read before every step.
+        result.emplace(
+            channel_uid,
+            core::BulkSpikeInput{
+                [state](core::Step step, std::vector<core::messaging::SpikeData> &window)
+                { state->collect(step, window.front()); },
+                1});
+    }
+    return result;
+}
+
+
+void AsyncModelExecutor::create_outputs(const knp::framework::Model &model, size_t output_capacity)
+{
+    const auto &network = model.get_network();
+    for (const auto &channel : model.get_output_channels())
+    {
+        if (outputs_.count(channel.first)) continue;
+
+        std::vector<core::UID> senders;
+        size_t max_spikes = 0;
+        const auto population_uids = model.get_output_channels().equal_range(channel.first);
+        for (auto iter = population_uids.first; iter != population_uids.second; ++iter)
+        {
+            senders.push_back(iter->second);
+            const auto &population = network.get_population(network.get_population_handle(iter->second));
+            max_spikes = std::max(max_spikes, std::visit([](const auto &pop) { return pop.size(); }, population));
+        }
+        outputs_.emplace(channel.first, io::SpikeOutputRing(std::move(senders), max_spikes, output_capacity));
+    }
+}
+
+
+void AsyncModelExecutor::start(bool paused)
+{
+    std::lock_guard lock(control_mutex_);
+    if (thread_.joinable()) throw std::logic_error("Model is already running.");
+
+    SPDLOG_INFO("Starting asynchronous model execution...");
+    stop_requested_ = false;
+    pause_requested_ = paused;
+    steps_to_run_ = 0;
+    is_paused_ = paused;
+    is_finished_ = false;
+    is_pacing_started_ = false;
+    error_ = nullptr;
+    thread_ = std::thread([this] { run(); });
+}
+
+
+void AsyncModelExecutor::stop()
+{
+    {
+        std::lock_guard lock(control_mutex_);
+        stop_requested_ = true;
+    }
+    control_cv_.notify_all();
+
+    if (thread_.joinable()) thread_.join();
+    if (error_) std::rethrow_exception(std::exchange(error_, nullptr));
+}
+
+
+void AsyncModelExecutor::pause()
+{
+    std::unique_lock lock(control_mutex_);
+    if (is_finished_) return;
+    pause_requested_ = true;
+    control_cv_.wait(lock, [this] { return is_paused_ || is_finished_; });
+}
+
+
+void AsyncModelExecutor::resume()
+{
+    {
+        std::lock_guard lock(control_mutex_);
+        pause_requested_ = false;
+        steps_to_run_ = 0;
+    }
+    control_cv_.notify_all();
+}
+
+
+void AsyncModelExecutor::step_n(size_t steps_count)
+{
+    std::unique_lock lock(control_mutex_);
+    if (!is_paused_) throw std::logic_error("Model execution must be paused to execute a number of steps.");
+    if (!steps_count) return;
+
+    steps_to_run_ = steps_count;
+    control_cv_.notify_all();
+    control_cv_.wait(lock, [this] { return (is_paused_ && !steps_to_run_) || is_finished_; });
+}
+
+
+bool AsyncModelExecutor::is_paused() const
+{
+    std::lock_guard lock(control_mutex_);
+    return is_paused_;
+}
+
+
+bool AsyncModelExecutor::push_spikes(
+    const core::UID &channel_uid, core::Step step, core::messaging::SpikeData spikes)
+{
+    const auto input = inputs_.find(channel_uid);
+    if (inputs_.end() == input) throw std::runtime_error("Wrong input channel UID.");
+    return input->second->queue_.push(step, std::move(spikes));
+}
+
+
+io::SpikeOutputRing::Reader AsyncModelExecutor::create_output_reader(const core::UID &channel_uid) const
+{
+    const auto output = outputs_.find(channel_uid);
+    if (outputs_.end() == output) throw std::runtime_error("Wrong output channel UID.");
+    return output->second.create_reader();
+}
+
+
+PacingStatistics AsyncModelExecutor::get_pacing_statistics() const
+{
+    PacingStatistics result;
+    result.steps_ = steps_count_.load(std::memory_order_relaxed);
+    result.overruns_ = overruns_count_.load(std::memory_order_relaxed);
+    result.max_overrun_ = std::chrono::nanoseconds(max_overrun_.load(std::memory_order_relaxed));
+    result.total_overrun_ = std::chrono::nanoseconds(total_overrun_.load(std::memory_order_relaxed));
+    for (const auto &input : inputs_) result.late_inputs_ += input.second->late_count_.load(std::memory_order_relaxed);
+    return result;
+}
+
+
+void AsyncModelExecutor::run()
+{
+    try
+    {
+        executor_.start(
+            [this](core::Step step)
+            {
+                // Output spikes of the previous step are written before the executor pauses or stops.
+                write_outputs(step);
+                return wait_for_step();
+            });
+        write_outputs(executor_.get_backend()->get_step());
+    }
+    catch (...)
+    {
+        error_ = std::current_exception();
+    }
+
+    {
+        std::lock_guard lock(control_mutex_);
+        is_finished_ = true;
+        is_paused_ = false;
+    }
+    control_cv_.notify_all();
+    SPDLOG_INFO("Asynchronous model execution stopped.");
+}
+
+
+bool AsyncModelExecutor::wait_for_step()
+{
+    if (pause_requested_.load(std::memory_order_acquire))
+    {
+        std::unique_lock lock(control_mutex_);
+        if (pause_requested_ && !steps_to_run_ && !stop_requested_)
+        {
+            is_paused_ = true;
+            control_cv_.notify_all();
+            control_cv_.wait(lock, [this] { return stop_requested_ || !pause_requested_ || steps_to_run_; });
+            // Time spent in pause isn't an overrun.
+            is_pacing_started_ = false;
+        }
+        is_paused_ = false;
+        if (steps_to_run_) --steps_to_run_;
+    }
+
+    if (stop_requested_.load(std::memory_order_acquire)) return false;
+
+    pace_step();
+    steps_count_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+
+void AsyncModelExecutor::pace_step()
+{
+    const std::chrono::nanoseconds period{step_period_.load(std::memory_order_relaxed)};
+    if (period.count() <= 0)
+    {
+        is_pacing_started_ = false;
+        return;
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    if (!is_pacing_started_)
+    {
+        is_pacing_started_ = true;
+        next_step_time_ = now + period;
+        return;
+    }
+    if (now <= next_step_time_)
+    {
+        std::this_thread::sleep_until(next_step_time_);
+        next_step_time_ += period;
+        return;
+    }
+
+    // The step is late: the following steps are planned from now instead of catching up.
+    const int64_t overrun = std::chrono::duration_cast<std::chrono::nanoseconds>(now - next_step_time_).count();
+    overruns_count_.fetch_add(1, std::memory_order_relaxed);
+    total_overrun_.fetch_add(overrun, std::memory_order_relaxed);
+    if (overrun > max_overrun_.load(std::memory_order_relaxed)) max_overrun_.store(overrun, std::memory_order_relaxed);
+    next_step_time_ = now + period;
+}
+
+
+void AsyncModelExecutor::write_outputs(core::Step step)
+{
+    for (auto &[channel_uid, ring] : outputs_)
+    {
+        auto &channel = executor_.get_loader().get_output_channel(channel_uid);
+        for (const auto &message : channel.read_some_from_buffer(0, step)) ring.write(message);
+    }
+}
+
+}  // namespace knp::framework
@@ -0,0 +1,461 @@
+/**
+ * @file checkpoint.cpp
+ * @brief Checkpoint writing and reading implementation.
+ * @kaspersky_support Artiom N.
+ * @date 18.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <knp/framework/checkpoint.h>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <regex>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <boost/lexical_cast.hpp>
+#include <boost/uuid/uuid.hpp>
+
+#include "sonata/highfive.h"
+#include "sonata/load_network.h"
+
+
+namespace knp::framework
+{
+namespace fs = std::filesystem;
+
+namespace
+{
+using PendingImpacts = std::vector<std::pair<uint64_t, core::messaging::SynapticImpactMessage>>;
+
+const std::string impacts_group_name = "pending_impacts";
+// Group of indexes of values written to an incremental checkpoint, one dataset per parameter.
+const std::string changed_indexes_group_name = "changed_indexes";
+
+
+fs::path get_checkpoint_path(const fs::path &directory, core::Step step)
+{
+    return directory / ("checkpoint_" + std::to_string(step) + ".h5");
+}
+
+
+// Type names of `StateValues` alternatives.
+template <typename Value>
+std::string get_type_name()
+{
+    if constexpr (std::is_same_v<Value, double>) return "double";
+    if constexpr (std::is_same_v<Value, float>) return "float";
+    if constexpr (std::is_same_v<Value, int64_t>) return "int64";
+    if constexpr (std::is_same_v<Value, uint64_t>) return "uint64";
+}
+
+
+template <typename Value>
+std::vector<Value> read_dataset(const HighFive::Group &group, const std::string &name)
+{
+    std::vector<Value> result;
+    group.getDataSet(name).read(result);
+    return result;
+}
+
+
+core::StateValues read_values(const HighFive::Group &group, const std::string &name)
+{
+    const auto dataset = group.getDataSet(name);
+    const auto type_name = dataset.getAttribute("type").read<std::string>();
+    if (get_type_name<double>() == type_name) return read_dataset<double>(group, name);
+    if (get_type_name<float>() == type_name) return read_dataset<float>(group, name);
+    if (get_type_name<int64_t>() == type_name) return read_dataset<int64_t>(group, name);
+    if (get_type_name<uint64_t>() == type_name) return read_dataset<uint64_t>(group, name);
+    throw std::runtime_error("Unknown type \"" + type_name + "\" of state parameter \"" + name + "\".");
+}
+
+
+void write_impacts(HighFive::Group &entity_group, const PendingImpacts &messages)
+{
+    if (messages.empty()) return;
+
+    std::vector<uint64_t> steps, send_times, sizes, connection_indexes;
+    std::vector<int> forcing_flags, synapse_types;
+    std::vector<float> values;
+    std::vector<uint32_t> presynaptic_indexes, postsynaptic_indexes;
+    for (const auto &[step, message] : messages)
+    {
+        steps.push_back(step);
+        send_times.push_back(message.header_.send_time_);
+        sizes.push_back(message.impacts_.size());
+        forcing_flags.push_back(message.is_forcing_);
+        for (const auto &impact : message.impacts_)
+        {
+            connection_indexes.push_back(impact.connection_index_);
+            values.push_back(impact.impact_value_);
+            synapse_types.push_back(static_cast<int>(impact.synapse_type_));
+            presynaptic_indexes.push_back(impact.presynaptic_neuron_index_);
+            postsynaptic_indexes.push_back(impact.postsynaptic_neuron_index_);
+        }
+    }
+
+    // Messages of the same entity have the same sender and populations.
+    const auto &first_message = messages.front().second;
+    auto group = entity_group.createGroup(impacts_group_name);
+    group.createAttribute("sender_uid", std::string(first_message.header_.sender_uid_));
+    group.createAttribute("presynaptic_uid", std::string(first_message.presynaptic_population_uid_));
+    group.createAttribute("postsynaptic_uid", std::string(first_message.postsynaptic_population_uid_));
+    group.createDataSet("step", steps);
+    group.createDataSet("send_time", send_times);
+    group.createDataSet("size", sizes);
+    group.createDataSet("is_forcing", forcing_flags);
+    group.createDataSet("connection_index", connection_indexes);
+    group.createDataSet("impact_value", values);
+    group.createDataSet("synapse_type", synapse_types);
+    group.createDataSet("presynaptic_neuron_index", presynaptic_indexes);
+    group.createDataSet("postsynaptic_neuron_index", postsynaptic_indexes);
+}
+
+
+core::UID read_uid(const HighFive::Group &group, const std::string &name)
+{
+    return core::UID{boost::lexical_cast<boost::uuids::uuid>(group.getAttribute(name).read<std::string>())};
+}
+
+
+PendingImpacts read_impacts(const HighFive::Group &entity_group)
+{
+    PendingImpacts result;
+    if (!entity_group.exist(impacts_group_name)) return result;
+
+    const auto group = entity_group.getGroup(impacts_group_name);
+    const auto sender_uid = read_uid(group, "sender_uid");
+    const auto presynaptic_uid = read_uid(group, "presynaptic_uid");
+    const auto postsynaptic_uid = read_uid(group, "postsynaptic_uid");
+    const auto steps = read_dataset<uint64_t>(group, "step");
+    const auto send_times = read_dataset<uint64_t>(group, "send_time");
+    const auto sizes = read_dataset<uint64_t>(group, "size");
+    const auto forcing_flags = read_dataset<int>(group, "is_forcing");
+    const auto connection_indexes = read_dataset<uint64_t>(group, "connection_index");
+    const auto values = read_dataset<float>(group, "impact_value");
+    const auto synapse_types = read_dataset<int>(group, "synapse_type");
+    const auto presynaptic_indexes = read_dataset<uint32_t>(group, "presynaptic_neuron_index");
+    const auto postsynaptic_indexes = read_dataset<uint32_t>(group, "postsynaptic_neuron_index");
+
+    size_t impact_index = 0;
+    for (size_t message_index = 0; message_index < steps.size(); ++message_index)
+    {
+        core::messaging::SynapticImpactMessage message{
+            {sender_uid, send_times.at(message_index)}, presynaptic_uid, postsynaptic_uid,
+            static_cast<bool>(forcing_flags.at(message_index)), {}};
+        message.impacts_.reserve(sizes.at(message_index));
+        for (size_t i = 0; i < sizes[message_index]; ++i, ++impact_index)
+        {
+            message.impacts_.push_back(core::messaging::SynapticImpact{
+                connection_indexes.at(impact_index), values.at(impact_index),
+                static_cast<synapse_traits::OutputType>(synapse_types.at(impact_index)),
+                presynaptic_indexes.at(impact_index), postsynaptic_indexes.at(impact_index)});
+        }
+        result.emplace_back(steps[message_index], std::move(message));
+    }
+    return result;
+}
+
+
+// Find indexes of changed values. Return `std::nullopt` if it is cheaper to write all values.
+std::optional<std::vector<uint64_t>> find_changed_indexes(
+    const core::StateValues &values, const core::StateValues &previous_values)
+{
+    if (values.index() != previous_values.index()) return std::nullopt;
+    return std::visit(
+        [&previous_values](const auto &vector) -> std::optional<std::vector<uint64_t>>
+        {
+            using Vector = std::decay_t<decltype(vector)>;
+            const auto &previous_vector = std::get<Vector>(previous_values);
+            if (vector.size() != previous_vector.size()) return std::nullopt;
+
+            constexpr size_t value_size = sizeof(typename Vector::value_type);
+            std::vector<uint64_t> result;
+            for (size_t index = 0; index < vector.size(); ++index)
+            {
+                if (vector[index] == previous_vector[index]) continue;
+                // Every changed value is written together with its index.
+                if ((result.size() + 1) * (value_size + sizeof(uint64_t)) >= vector.size() * value_size)
+                    return std::nullopt;
+                result.push_back(index);
+            }
+            return result;
+        },
+        values);
+}
+
+
+// Apply values of an incremental checkpoint to the values read from the previous files.
+void apply_changed_values(
+    core::StateValues &values, const core::StateValues &changed_values, const std::vector<uint64_t> &indexes,
+    const std::string &name)
+{
+    if (values.index() != changed_values.index() ||
+        std::visit([](const auto &vector) { return vector.size(); }, changed_values) != indexes.size())
+    {
+        throw std::runtime_error("Changed values of state parameter \"" + name + "\" don't match previous values.");
+    }
+    std::visit(
+        [&changed_values, &indexes, &name](auto &vector)
+        {
+            const auto &changed_vector = std::get<std::decay_t<decltype(vector)>>(changed_values);
+            for (size_t i = 0; i < indexes.size(); ++i)
+            {
+                if (indexes[i] >= vector.size())
+                {
+                    throw std::runtime_error(
+                        "Index of changed value of state parameter \"" + name + "\" is out of range.");
+                }
+                vector[indexes[i]] = changed_vector[i];
+            }
+        },
+        values);
+}
+
+
+// Write entity states. Parameters equal to the ones of the previous states are skipped, if only some values of a
+// parameter changed, the changed values are written with their indexes.
+void write_entities(
+    HighFive::Group &&group, const std::vector<core::EntityState> &states,
+    const std::vector<core::EntityState> *previous_states)
+{
+    std::unordered_map<core::UID, const core::EntityState *, core::uid_hash> previous;
+    if (previous_states)
+    {
+        for (const auto &state : *previous_states) previous.emplace(state.uid_, &state);
+    }
+
+    for (const auto &state : states)
+    {
+        // Every checkpoint contains all entities, so pending impacts of an entity are always up to date.
+        auto entity_group = group.createGroup(std::string(state.uid_));
+        const auto previous_state = previous.find(state.uid_);
+        for (const auto &[name, values] : state.values_)
+        {
+            std::optional<std::vector<uint64_t>> changed_indexes;
+            if (previous_state != previous.end())
+            {
+                const auto previous_values = previous_state->second->values_.find(name);
+                if (previous_values != previous_state->second->values_.end())
+                {
+                    changed_indexes = find_changed_indexes(values, previous_values->second);
+                    if (changed_indexes && changed_indexes->empty()) continue;
+                }
+            }
+            std::visit(
+                [&entity_group, &name = name, &changed_indexes](const auto &vector)
+                {
+                    using Value = typename std::decay_t<decltype(vector)>::value_type;
+                    if (!changed_indexes)
+                    {
+                        entity_group.createDataSet(name, vector).createAttribute("type", get_type_name<Value>());
+                        return;
+                    }
+                    std::vector<Value> changed_values;
+                    changed_values.reserve(changed_indexes->size());
+                    for (const auto index : *changed_indexes) changed_values.push_back(vector[index]);
+                    entity_group.createDataSet(name, changed_values).createAttribute("type", get_type_name<Value>());
+                    auto indexes_group = entity_group.exist(changed_indexes_group_name)
+                                             ? entity_group.getGroup(changed_indexes_group_name)
+                                             : entity_group.createGroup(changed_indexes_group_name);
+                    indexes_group.createDataSet(name, *changed_indexes);
+                },
+                values);
+        }
+        write_impacts(entity_group, state.pending_impacts_);
+    }
+}
+
+
+// Apply entity states from a checkpoint file to the states read from the previous files.
+void read_entities(const HighFive::Group &group, std::vector<core::EntityState> &states)
+{
+    std::unordered_map<core::UID, size_t, core::uid_hash> indexes;
+    for (size_t index = 0; index < states.size(); ++index) indexes.emplace(states[index].uid_, index);
+
+    for (const auto &entity_name : group.listObjectNames())
+    {
+        const core::UID uid{boost::lexical_cast<boost::uuids::uuid>(entity_name)};
+        auto index = indexes.find(uid);
+        if (index == indexes.end())
+        {
+            index = indexes.emplace(uid, states.size()).first;
+            states.emplace_back().uid_ = uid;
+        }
+
+        auto &state = states[index->second];
+        const auto entity_group = group.getGroup(entity_name);
+        const bool has_changed_indexes = entity_group.exist(changed_indexes_group_name);
+        for (const auto &name : entity_group.listObjectNames())
+        {
+            if (impacts_group_name == name || changed_indexes_group_name == name) continue;
+            auto values = read_values(entity_group, name);
+            if (!has_changed_indexes || !entity_group.getGroup(changed_indexes_group_name).exist(name))
+            {
+                state.values_[name] = std::move(values);
+                continue;
+            }
+            const auto indexes = read_dataset<uint64_t>(entity_group.getGroup(changed_indexes_group_name), name);
+            apply_changed_values(state.values_[name], values, indexes, name);
+        }
+        state.pending_impacts_ = read_impacts(entity_group);
+    }
+}
+
+
+std::map<core::Step, fs::path> find_checkpoints(const fs::path &directory)
+{
+    const std::regex name_regex{R"(checkpoint_(\d+)\.h5)"};
+    std::map<core::Step, fs::path> result;
+    if (!fs::is_directory(directory)) return result;
+    for (const auto &entry : fs::directory_iterator(directory))
+    {
+        std::smatch match;
+        const auto file_name = entry.path().filename().string();
+        if (!entry.is_regular_file() || !std::regex_match(file_name, match, name_regex)) continue;
+        result.emplace(std::stoull(match[1].str()), entry.path());
+    }
+    return result;
+}
+}  // namespace
+
+
+CheckpointWriter::CheckpointWriter(fs::path directory, CheckpointOptions options)
+    : directory_(std::move(directory)), options_(options)
+{
+    fs::create_directories(directory_);
+}
+
+
+CheckpointWriter::~CheckpointWriter()
+{
+    try
+    {
+        wait();
+    }
+    catch (const std::exception &exc)
+    {
+        SPDLOG_ERROR("Checkpoint writing failed: {}.", exc.what());
+    }
+}
+
+
+void CheckpointWriter::save(const core::Backend &backend)
+{
+    wait();
+    // The backend state is copied here, so the backend can continue execution while the copy is written.
+    auto state = std::make_shared<const core::DynamicState>(backend.get_dynamic_state());
+    // A checkpoint of the same step overwrites the previous file, so it can't be incremental.
+    const size_t period = options_.full_checkpoint_period_;
+    const bool is_full = !options_.incremental_ || !last_state_ || last_state_->step_ == state->step_ ||
+                         (period && 0 == checkpoint_count_ % period);
+    ++checkpoint_count_;
+
+    if (!options_.write_in_background_)
+    {
+        write(std::move(state), is_full);
+        return;
+    }
+    pending_write_ = std::async(
+        std::launch::async, [this, state = std::move(state), is_full]() mutable { write(std::move(state), is_full); });
+}
+
+
+void CheckpointWriter::wait()
+{
+    if (!pending_write_.valid()) return;
+    // Future becomes invalid after `get()`, so an error is reported once.
+    pending_write_.get();
+}
+
+
+void CheckpointWriter::write(std::shared_ptr<const core::DynamicState> state, bool is_full)
+{
+    const auto path = get_checkpoint_path(directory_, state->step_);
+    SPDLOG_DEBUG("Writing {} checkpoint {}...", is_full ? "full" : "incremental", path.string());
+
+    {
+        const std::lock_guard lock{sonata::get_hdf5_mutex()};
+        HighFive::File file(path.string(), HighFive::File::Create | HighFive::File::Overwrite);
+        file.createAttribute("step", static_cast<uint64_t>(state->step_));
+        if (!is_full) file.createAttribute("base_step", static_cast<uint64_t>(last_state_->step_));
+        write_entities(
+            file.createGroup("populations"), state->populations_, is_full ? nullptr : &last_state_->populations_);
+        write_entities(
+            file.createGroup("projections"), state->projections_, is_full ? nullptr : &last_state_->projections_);
+    }
+
+    last_state_ = std::move(state);
+}
+
+
+core::DynamicState read_checkpoint(const fs::path &directory, std::optional<core::Step> step)
+{
+    const auto checkpoints = find_checkpoints(directory);
+    if (checkpoints.empty()) throw std::runtime_error("No checkpoints in \"" + directory.string() + "\".");
+    if (!step) step = checkpoints.rbegin()->first;
+
+    // Find the full checkpoint, then apply incremental checkpoints in the order of writing.
+    std::vector<fs::path> chain;
+    const std::lock_guard lock{sonata::get_hdf5_mutex()};
+    for (std::optional<core::Step> current = step; current;)
+    {
+        const auto checkpoint = checkpoints.find(*current);
+        if (checkpoint == checkpoints.end())
+        {
+            throw std::runtime_error(
+                "Cannot find checkpoint of step " + std::to_string(*current) + " in \"" + directory.string() + "\".");
+        }
+        chain.push_back(checkpoint->second);
+        const HighFive::File file(checkpoint->second.string(), HighFive::File::ReadOnly);
+        if (!file.hasAttribute("base_step")) break;
+        const core::Step base_step = file.getAttribute("base_step").read<uint64_t>();
+        if (base_step >= *current)
+        {
+            throw std::runtime_error("Wrong base step of checkpoint \"" + checkpoint->second.string() + "\".");
+        }
+        current = base_step;
+    }
+
+    core::DynamicState result;
+    result.step_ = *step;
+    for (auto path = chain.rbegin(); path != chain.rend(); ++path)
+    {
+        SPDLOG_DEBUG("Reading checkpoint {}...", path->string());
+        const HighFive::File file(path->string(), HighFive::File::ReadOnly);
+        read_entities(file.getGroup("populations"), result.populations_);
+        read_entities(file.getGroup("projections"), result.projections_);
+    }
+    return result;
+}
+
+
+void restore_checkpoint(core::Backend &backend, const fs::path &directory, std::optional<core::Step> step)
+{
+    backend.set_dynamic_state(read_checkpoint(directory, step));
+}
+
+}  // namespace knp::framework
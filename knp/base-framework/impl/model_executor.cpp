@@ -23,6 +23,8 @@
 
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
+
 
 namespace knp::framework
 {
@@ -73,13 +75,23 @@ void ModelExecutor::SpikeMessageHandler::update(size_t step)
 
 
 ModelExecutor::ModelExecutor(
-    knp::framework::Model &model, std::shared_ptr<core::Backend> backend, ModelLoader::InputChannelMap i_map)
-    : loader_(backend, i_map)
+    knp::framework::Model &model, std::shared_ptr<core::Backend> backend, ModelLoader::InputChannelMap i_map,
+    ModelLoader::BulkInputMap b_map)
+    : loader_(backend, i_map, std::move(b_map))
 {
     loader_.load(model);
 }
 
 
+ModelExecutor::ModelExecutor(
+    knp::framework::Model &&model, std::shared_ptr<core::Backend> backend, ModelLoader::InputChannelMap i_map,
+    ModelLoader::BulkInputMap b_map)
+    : loader_(std::move(backend), std::move(i_map), std::move(b_map))
+{
+    loader_.load(std::move(model));
+}
+
+
 ModelExecutor::~ModelExecutor() = default;
 
 
@@ -96,44 +108,96 @@ void ModelExecutor::start(core::Backend::RunPredicate run_predicate)
     get_backend()->start(
         [this, run_predicate](knp::core::Step step)
         {
-            // Sending inputs from the channels.
-            for (auto &i_ch : loader_.get_inputs())
-            {
-                i_ch.send(step);
-            }
+            send_inputs(step);
             // Run user predicate.
             return run_predicate(step);
         },
         [this](knp::core::Step)
         {
-            // Loading spikes into output channels.
-            for (auto &o_ch : loader_.get_outputs())
-            {
-                o_ch.update();
-            }
-            // Running handlers
-            for (auto &handler : message_handlers_)
-            {
-                handler->update(get_backend()->get_step());
-            }
-            // Run monitoring observers.
-            for (auto &observer : observers_)
-            {
-                std::visit([](auto &entity) { entity.update(); }, observer);
-            }
-
+            process_outputs();
             return true;
         });
+
+    // Observers with update period greater than one can still hold messages.
+    for (auto &observer : observers_)
+    {
+        std::visit([](auto &entity) { entity.flush(); }, observer);
+    }
     SPDLOG_INFO("Model execution stopped.");
 }
 
 
+void ModelExecutor::fast_forward(size_t steps_count, std::vector<core::Step> sync_steps)
+{
+    auto backend = get_backend();
+    const core::Step final_step = backend->get_step() + steps_count;
+    SPDLOG_INFO("Fast-forwarding model execution to step {}...", final_step);
+
+    std::sort(sync_steps.begin(), sync_steps.end());
+    auto sync_iter = std::lower_bound(sync_steps.begin(), sync_steps.end(), backend->get_step());
+    while (backend->get_step() < final_step)
+    {
+        const core::Step sync_step = (sync_steps.end() != sync_iter) ? std::min(*sync_iter, final_step) : final_step;
+        backend->run_steps(sync_step - backend->get_step());
+        // Execution was stopped.
+        if (!backend->running() || backend->get_step() != sync_step) break;
+        if (final_step == sync_step) break;
+
+        send_inputs(sync_step);
+        backend->run_steps(1);
+        if (!backend->running()) break;
+        process_outputs();
+        // A message handler or an observer stopped execution. Running further steps would restart the backend.
+        if (!backend->running()) break;
+        sync_iter = std::upper_bound(sync_iter, sync_steps.end(), sync_step);
+    }
+
+    process_outputs();
+    // Observers with update period greater than one can still hold messages.
+    for (auto &observer : observers_)
+    {
+        std::visit([](auto &entity) { entity.flush(); }, observer);
+    }
+    SPDLOG_INFO("Model execution stopped at step {}.", backend->get_step());
+}
+
+
 void ModelExecutor::stop()
 {
     get_backend()->stop();
 }
 
 
+void ModelExecutor::send_inputs(core::Step step)
+{
+    // Sending inputs from the channels.
+    for (auto &i_ch : loader_.get_inputs())
+    {
+        i_ch.send(step);
+    }
+}
+
+
+void ModelExecutor::process_outputs()
+{
+    // Loading spikes into output channels.
+    for (auto &o_ch : loader_.get_outputs())
+    {
+        o_ch.update();
+    }
+    // Running handlers
+    for (auto &handler : message_handlers_)
+    {
+        handler->update(get_backend()->get_step());
+    }
+    // Run monitoring observers.
+    for (auto &observer : observers_)
+    {
+        std::visit([](auto &entity) { entity.update(); }, observer);
+    }
+}
+
+
 void ModelExecutor::add_spike_message_handler(
     typename SpikeMessageHandler::FunctionType &&message_handler_function, const std::vector<core::UID> &senders,
     const std::vector<core::UID> &receivers, const knp::core::UID &uid)
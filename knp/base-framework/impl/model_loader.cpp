@@ -34,17 +34,17 @@ void ModelLoader::init_channels(
     knp::framework::Model &model, const std::unordered_multimap<core::UID, core::UID, core::uid_hash> &channels,
     GenType channel_gen)
 {
-    for (size_t i = 0; i < channels.bucket_count(); ++i)
+    // A bucket can contain several channels, so channels are iterated by key ranges.
+    for (auto channel_iter = channels.begin(); channel_iter != channels.end();)
     {
-        auto bucket_iter = channels.begin(i);
-        if (channels.end(i) == bucket_iter) continue;
-        auto channel_uid = bucket_iter->first;
+        const auto [range_begin, range_end] = channels.equal_range(channel_iter->first);
+        auto channel_uid = channel_iter->first;
+        channel_iter = range_end;
 
         std::vector<core::UID> p_uids;
-        p_uids.reserve(channels.bucket_size(i));
 
         std::transform(
-            bucket_iter, channels.end(i), std::back_inserter(p_uids),
+            range_begin, range_end, std::back_inserter(p_uids),
             [&channel_uid](const auto &bucket)
             {
                 SPDLOG_TRACE(
@@ -60,15 +60,24 @@ void ModelLoader::init_channels(
 void ModelLoader::gen_input_channel(
     knp::framework::Model &model, const core::UID &channel_uid, const std::vector<core::UID> &p_uids)
 {
-    try
+    if (const auto bulk_iter = b_map_.find(channel_uid); bulk_iter != b_map_.end())
     {
-        in_channels_.emplace_back(channel_uid, backend_->get_message_bus().create_endpoint(), i_map_.at(channel_uid));
+        SPDLOG_TRACE("Adding bulk input {}...", std::string(channel_uid));
+        backend_->add_bulk_input(channel_uid, bulk_iter->second);
     }
-    catch (const std::out_of_range &)
+    else
     {
-        const std::string msg = "Incorrect input channel UID = " + std::string(channel_uid) + ".";
-        SPDLOG_ERROR("{}", msg);
-        throw std::logic_error(msg);
+        try
+        {
+            in_channels_.emplace_back(
+                channel_uid, backend_->get_message_bus().create_endpoint(), i_map_.at(channel_uid));
+        }
+        catch (const std::out_of_range &)
+        {
+            const std::string msg = "Incorrect input channel UID = " + std::string(channel_uid) + ".";
+            SPDLOG_ERROR("{}", msg);
+            throw std::logic_error(msg);
+        }
     }
     auto &network = model.get_network();
 
@@ -113,7 +122,7 @@ void ModelLoader::gen_output_channel(
 }
 
 
-void ModelLoader::load(knp::framework::Model &model)
+void ModelLoader::init_all_channels(knp::framework::Model &model)
 {
     SPDLOG_DEBUG("Model loader initializing...");
 
@@ -124,6 +133,12 @@ void ModelLoader::load(knp::framework::Model &model)
     // Create output.
     SPDLOG_TRACE("Output channels initializing...");
     init_channels(model, model.get_output_channels(), &ModelLoader::gen_output_channel);
+}
+
+
+void ModelLoader::load(knp::framework::Model &model)
+{
+    init_all_channels(model);
 
     const auto &network = model.get_network();
 
@@ -134,6 +149,18 @@ void ModelLoader::load(knp::framework::Model &model)
 }
 
 
+void ModelLoader::load(knp::framework::Model &&model)
+{
+    init_all_channels(model);
+
+    auto &network = model.get_network();
+
+    // Tags were added to the network by `init_all_channels()`, so the network can be released now.
+    backend_->load_all_populations(network.release_populations());
+    backend_->load_all_projections(network.release_projections());
+}
+
+
 const io::input::InputChannel &ModelLoader::get_input_channel(const core::UID &channel_uid) const
 {
     auto result = std::find_if(
@@ -24,6 +24,10 @@
 #include <spdlog/spdlog.h>
 
 #include <algorithm>
+#include <iterator>
+#include <string>
+#include <unordered_map>
+#include <utility>
 
 #include <boost/preprocessor.hpp>
 
@@ -79,25 +83,78 @@ Network::ProjectionConstIterator Network::end_projections() const
 }
 
 
+using UIDIndexMap = std::unordered_map<knp::core::UID, size_t, knp::core::uid_hash>;
+
+
+template <typename VT>
+const knp::core::UID &get_variant_uid(const VT &p_variant)
+{
+    return std::visit([](const auto &var_val) -> const knp::core::UID & { return var_val.get_uid(); }, p_variant);
+}
+
+
+template <typename VT>
+typename std::vector<VT>::iterator find_variant(
+    const knp::core::UID &uid, std::vector<VT> &container, const UIDIndexMap &index)
+{
+    const auto index_iter = index.find(uid);
+    if (index.end() == index_iter) return container.end();
+    return container.begin() + static_cast<std::ptrdiff_t>(index_iter->second);
+}
+
+
+template <typename VT>
+typename std::vector<VT>::const_iterator find_cvariant(
+    const knp::core::UID &uid, const std::vector<VT> &container, const UIDIndexMap &index)
+{
+    const auto index_iter = index.find(uid);
+    if (index.end() == index_iter) return container.cend();
+    return container.cbegin() + static_cast<std::ptrdiff_t>(index_iter->second);
+}
+
+
+template <typename VT>
+void add_variant(VT &&p_variant, std::vector<VT> &container, UIDIndexMap &index, const char *entity_name)
+{
+    const auto &uid = get_variant_uid(p_variant);
+    if (!index.emplace(uid, container.size()).second)
+    {
+        const std::string msg =
+            std::string(entity_name) + " with UID = " + std::string(uid) + " already exists in the network.";
+        SPDLOG_ERROR("{}", msg);
+        throw std::logic_error(msg);
+    }
+    container.emplace_back(std::move(p_variant));
+}
+
+
 template <typename VT>
-typename std::vector<VT>::iterator find_variant(const knp::core::UID &uid, std::vector<VT> &container)
+void remove_variant(typename std::vector<VT>::iterator position, std::vector<VT> &container, UIDIndexMap &index)
 {
-    auto result = std::find_if(
-        container.begin(), container.end(),
-        [&uid](VT &p_variant) -> bool
-        { return std::visit([&uid](auto &var_val) { return var_val.get_uid() == uid; }, p_variant); });
-    return result;
+    // The last element is moved to the place of the removed one, so only one index entry is updated.
+    index.erase(get_variant_uid(*position));
+    if (std::next(position) != container.end())
+    {
+        *position = std::move(container.back());
+        index[get_variant_uid(*position)] = static_cast<size_t>(position - container.begin());
+    }
+    container.pop_back();
 }
 
 
 template <typename VT>
-typename std::vector<VT>::const_iterator find_cvariant(const knp::core::UID &uid, const std::vector<VT> &container)
+size_t find_handle_index(
+    const knp::core::UID &uid, size_t index_hint, const std::vector<VT> &container, const UIDIndexMap &index,
+    const char *entity_name)
 {
-    auto result = std::find_if(
-        container.cbegin(), container.cend(),
-        [&uid](const VT &p_variant) -> bool
-        { return std::visit([&uid](const auto &var_val) { return var_val.get_uid() == uid; }, p_variant); });
-    return result;
+    if (index_hint < container.size() && get_variant_uid(container[index_hint]) == uid) return index_hint;
+
+    const auto index_iter = index.find(uid);
+    if (index.end() == index_iter)
+    {
+        throw std::logic_error("Cannot find " + std::string(entity_name) + " with UID \"" + std::string(uid) + "\".");
+    }
+    return index_iter->second;
 }
 
 
@@ -105,9 +162,7 @@ void Network::add_population(core::AllPopulationsVariant &&population)
 {
     SPDLOG_DEBUG("Adding population variant...");
 
-    // check_population_constraints(std::visit([](const auto &var_val) { return var_val; }, population));
-
-    populations_.emplace_back(population);
+    add_variant(std::move(population), populations_, population_index_, "Population");
 }
 
 
@@ -118,7 +173,7 @@ void Network::add_population(typename std::decay<PopulationType>::type &&populat
 
     check_population_constraints(population);
 
-    add_population(population);
+    add_population(core::AllPopulationsVariant(std::move(population)));
 }
 
 
@@ -128,14 +183,13 @@ void Network::add_population(typename std::decay<PopulationType>::type &populati
     SPDLOG_DEBUG("Adding population [copy]...");
 
     check_population_constraints(population);
-    add_population(population);
+    add_population(core::AllPopulationsVariant(population));
 }
 
 
 bool Network::is_population_exists(const knp::core::UID &population_uid) const
 {
-    const auto pop_iterator = find_cvariant<core::AllPopulationsVariant>(population_uid, populations_);
-    return pop_iterator != populations_.cend();
+    return population_index_.count(population_uid) > 0;
 }
 
 
@@ -147,7 +201,7 @@ knp::core::Population<NeuronType> &Network::get_population(const knp::core::UID
         "This population type is not supported by the Network class. Add type to the population type list.");
 
     SPDLOG_DEBUG("Getting population {}...", std::string(population_uid));
-    if (auto pop_iterator = find_variant<core::AllPopulationsVariant>(population_uid, populations_);
+    if (auto pop_iterator = find_variant(population_uid, populations_, population_index_);
         pop_iterator != populations_.end())
     {
         return std::get<knp::core::Population<NeuronType>>(*pop_iterator);
@@ -160,7 +214,7 @@ template <typename NeuronType>
 const knp::core::Population<NeuronType> &Network::get_population(const knp::core::UID &population_uid) const
 {
     SPDLOG_DEBUG("Getting population {}...", std::string(population_uid));
-    if (const auto pop_iterator = find_cvariant<core::AllPopulationsVariant>(population_uid, populations_);
+    if (const auto pop_iterator = find_cvariant(population_uid, populations_, population_index_);
         pop_iterator != populations_.cend())
     {
         return std::get<knp::core::Population<NeuronType>>(*pop_iterator);
@@ -173,7 +227,7 @@ core::AllPopulationsVariant &Network::get_population(const knp::core::UID &popul
 {
     SPDLOG_DEBUG("Getting projection {}...", std::string(population_uid));
 
-    auto iter = find_variant<core::AllPopulationsVariant>(population_uid, populations_);
+    auto iter = find_variant(population_uid, populations_, population_index_);
 
     if (populations_.end() == iter)
     {
@@ -187,14 +241,74 @@ core::AllPopulationsVariant &Network::get_population(const knp::core::UID &popul
 void Network::remove_population(const core::UID &population_uid)
 {
     SPDLOG_DEBUG("Removing population with UID {}...", std::string(population_uid));
-    auto result = find_variant<core::AllPopulationsVariant>(population_uid, populations_);
+    auto result = find_variant(population_uid, populations_, population_index_);
 
     if (result == populations_.end())
     {
         throw std::logic_error(
             "Cannot remove non-existent population with UID \"" + std::string(population_uid) + "\".");
     }
-    populations_.erase(result);
+    remove_variant(result, populations_, population_index_);
+}
+
+
+size_t Network::remove_neurons(const core::UID &population_uid, std::vector<size_t> neuron_indexes)
+{
+    SPDLOG_DEBUG(
+        "Removing {} neurons from population with UID {}...", neuron_indexes.size(), std::string(population_uid));
+    auto population = find_variant(population_uid, populations_, population_index_);
+
+    if (population == populations_.end())
+    {
+        throw std::logic_error(
+            "Cannot remove neurons from non-existent population with UID \"" + std::string(population_uid) + "\".");
+    }
+
+    const size_t population_size = std::visit([](const auto &pop) { return pop.size(); }, *population);
+    std::sort(neuron_indexes.begin(), neuron_indexes.end());
+    neuron_indexes.erase(std::unique(neuron_indexes.begin(), neuron_indexes.end()), neuron_indexes.end());
+    neuron_indexes.erase(
+        std::lower_bound(neuron_indexes.begin(), neuron_indexes.end(), population_size), neuron_indexes.end());
+    if (neuron_indexes.empty()) return 0;
+
+    std::visit([&neuron_indexes](auto &pop) { pop.remove_neurons(neuron_indexes); }, *population);
+
+    size_t removed_synapses = 0;
+    for (auto &projection : projections_)
+    {
+        removed_synapses += std::visit(
+            [&population_uid, &neuron_indexes](auto &proj)
+            {
+                size_t result = 0;
+                if (proj.get_presynaptic() == population_uid) result += proj.remove_presynaptic_neurons(neuron_indexes);
+                if (proj.get_postsynaptic() == population_uid)
+                    result += proj.remove_postsynaptic_neurons(neuron_indexes);
+                return result;
+            },
+            projection);
+    }
+
+    return removed_synapses;
+}
+
+
+Network::PopulationHandle Network::get_population_handle(const knp::core::UID &population_uid) const
+{
+    return {population_uid, find_handle_index(population_uid, 0, populations_, population_index_, "population")};
+}
+
+
+core::AllPopulationsVariant &Network::get_population(const PopulationHandle &handle)
+{
+    handle.index_ = find_handle_index(handle.uid_, handle.index_, populations_, population_index_, "population");
+    return populations_[handle.index_];
+}
+
+
+const core::AllPopulationsVariant &Network::get_population(const PopulationHandle &handle) const
+{
+    handle.index_ = find_handle_index(handle.uid_, handle.index_, populations_, population_index_, "population");
+    return populations_[handle.index_];
 }
 
 
@@ -202,8 +316,7 @@ void Network::add_projection(core::AllProjectionsVariant &&projection)
 {
     SPDLOG_DEBUG("Adding projection variant...");
 
-    // check_projection_constraints(std::visit([](const auto &var_val) { return var_val; }, projection));
-    projections_.emplace_back(projection);
+    add_variant(std::move(projection), projections_, projection_index_, "Projection");
 }
 
 
@@ -213,7 +326,7 @@ void Network::add_projection(typename std::decay<ProjectionType>::type &&project
     SPDLOG_DEBUG("Adding projection [move] {}...", std::string(projection.get_uid()));
 
     check_projection_constraints(projection);
-    projections_.emplace_back(std::move(projection));
+    add_projection(core::AllProjectionsVariant(std::move(projection)));
 }
 
 
@@ -223,7 +336,7 @@ void Network::add_projection(typename std::decay<ProjectionType>::type &projecti
     SPDLOG_DEBUG("Adding projection [copy] {}...", std::string(projection.get_uid()));
 
     check_projection_constraints(projection);
-    projections_.emplace_back(projection);
+    add_projection(core::AllProjectionsVariant(projection));
 }
 
 
@@ -244,8 +357,7 @@ void Network::add_projection(
 
 bool Network::is_projection_exists(const knp::core::UID &projection_uid) const
 {
-    const auto proj_iterator = find_cvariant<core::AllProjectionsVariant>(projection_uid, projections_);
-    return proj_iterator != projections_.cend();
+    return projection_index_.count(projection_uid) > 0;
 }
 
 
@@ -258,7 +370,7 @@ knp::core::Projection<SynapseType> &Network::get_projection(const knp::core::UID
 
     SPDLOG_DEBUG("Getting projection {}...", std::string(projection_uid));
 
-    auto proj_iterator = find_variant<core::AllProjectionsVariant>(projection_uid, projections_);
+    auto proj_iterator = find_variant(projection_uid, projections_, projection_index_);
     if (proj_iterator != projections_.end())
     {
         return std::get<knp::core::Projection<SynapseType>>(*proj_iterator);
@@ -273,7 +385,7 @@ const knp::core::Projection<SynapseType> &Network::get_projection(const knp::cor
 {
     SPDLOG_DEBUG("Getting projection {}...", std::string(projection_uid));
 
-    auto proj_iterator = find_cvariant<core::AllProjectionsVariant>(projection_uid, projections_);
+    auto proj_iterator = find_cvariant(projection_uid, projections_, projection_index_);
     if (proj_iterator != projections_.cend())
     {
         return std::get<knp::core::Projection<SynapseType>>(*proj_iterator);
@@ -287,7 +399,7 @@ core::AllProjectionsVariant &Network::get_projection(const knp::core::UID &proje
 {
     SPDLOG_DEBUG("Getting projection {}...", std::string(projection_uid));
 
-    auto iter = find_variant<core::AllProjectionsVariant>(projection_uid, projections_);
+    auto iter = find_variant(projection_uid, projections_, projection_index_);
 
     if (projections_.end() == iter)
     {
@@ -301,14 +413,50 @@ core::AllProjectionsVariant &Network::get_projection(const knp::core::UID &proje
 void Network::remove_projection(const core::UID &projection_uid)
 {
     SPDLOG_DEBUG("Removing projection with UID {}", std::string(projection_uid));
-    auto result = find_variant<core::AllProjectionsVariant>(projection_uid, projections_);
+    auto result = find_variant(projection_uid, projections_, projection_index_);
 
     if (result == projections_.end())
     {
         throw std::logic_error(
             "Cannot remove non-existent projection with UID \"" + std::string(projection_uid) + "\".");
     }
-    projections_.erase(result);
+    remove_variant(result, projections_, projection_index_);
+}
+
+
+Network::ProjectionHandle Network::get_projection_handle(const knp::core::UID &projection_uid) const
+{
+    return {projection_uid, find_handle_index(projection_uid, 0, projections_, projection_index_, "projection")};
+}
+
+
+core::AllProjectionsVariant &Network::get_projection(const ProjectionHandle &handle)
+{
+    handle.index_ = find_handle_index(handle.uid_, handle.index_, projections_, projection_index_, "projection");
+    return projections_[handle.index_];
+}
+
+
+const core::AllProjectionsVariant &Network::get_projection(const ProjectionHandle &handle) const
+{
+    handle.index_ = find_handle_index(handle.uid_, handle.index_, projections_, projection_index_, "projection");
+    return projections_[handle.index_];
+}
+
+
+Network::PopulationContainer Network::release_populations()
+{
+    SPDLOG_DEBUG("Releasing {} populations...", populations_.size());
+    population_index_.clear();
+    return std::exchange(populations_, {});
+}
+
+
+Network::ProjectionContainer Network::release_projections()
+{
+    SPDLOG_DEBUG("Releasing {} projections...", projections_.size());
+    projection_index_.clear();
+    return std::exchange(projections_, {});
 }
 
 
@@ -43,9 +43,25 @@ std::vector<core::messaging::SpikeMessage> OutputChannel::update()
     message_buffer_.reserve(message_buffer_.size() + messages.size());
     for (auto &&message : messages)
     {
+        const auto original_indexes = original_neuron_indexes_.find(message.header_.sender_uid_);
+        if (original_indexes != original_neuron_indexes_.end())
+        {
+            for (auto &index : message.neuron_indexes_)
+            {
+                index = static_cast<core::messaging::SpikeIndex>(original_indexes->second.at(index));
+            }
+            std::sort(message.neuron_indexes_.begin(), message.neuron_indexes_.end());
+        }
         // cppcheck-suppress useStlAlgorithm
         message_buffer_.push_back(std::move(message));
     }
+    // Messages of several steps are received at once after fast-forward execution.
+    auto step_less = [](const core::messaging::SpikeMessage &message1, const core::messaging::SpikeMessage &message2)
+    { return message1.header_.send_time_ < message2.header_.send_time_; };
+    if (!std::is_sorted(message_buffer_.begin(), message_buffer_.end(), step_less))
+    {
+        std::stable_sort(message_buffer_.begin(), message_buffer_.end(), step_less);
+    }
 
     return message_buffer_;
 }
@@ -54,14 +70,12 @@ std::vector<core::messaging::SpikeMessage> OutputChannel::update()
 std::vector<core::messaging::SpikeMessage> OutputChannel::read_some_from_buffer(
     core::Step starting_step, core::Step final_step)
 {
-    std::vector<core::messaging::SpikeMessage> result;
-
-    result.reserve(starting_step + final_step + 1);
     // Here we assume that buffer is sorted.
     auto begin_iter = std::lower_bound(message_buffer_.begin(), message_buffer_.end(), starting_step, comp_lower);
     auto end_iter = std::upper_bound(message_buffer_.begin(), message_buffer_.end(), final_step, comp_upper);
 
-    std::move(begin_iter, end_iter, std::back_inserter(result));
+    std::vector<core::messaging::SpikeMessage> result(
+        std::make_move_iterator(begin_iter), std::make_move_iterator(end_iter));
     message_buffer_.erase(begin_iter, end_iter);
     return result;
 }
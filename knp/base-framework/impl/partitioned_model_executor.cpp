@@ -0,0 +1,360 @@
+/**
+ * @file partitioned_model_executor.cpp
+ * @brief Partitioned model executor implementation.
+ * @kaspersky_support Artiom N.
+ * @date 18.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <knp/framework/partitioned_model_executor.h>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+
+namespace knp::framework
+{
+
+/**
+ * @brief Barrier that makes one decision for all partitions about running the next step.
+ */
+class PartitionedModelExecutor::StepBarrier
+{
+public:
+    using CompletionFunction = std::function<bool()>;
+
+    StepBarrier(size_t count, CompletionFunction &&completion) : count_(count), completion_(std::move(completion)) {}
+
+    // Return `true` if partitions must run the next step.
+    bool arrive_and_wait()
+    {
+        std::unique_lock lock(mutex_);
+        if (cancelled_) return false;
+
+        if (++arrived_ == count_)
+        {
+            arrived_ = 0;
+            ++generation_;
+            try
+            {
+                proceed_ = completion_();
+            }
+            catch (...)
+            {
+                cancelled_ = true;
+                cv_.notify_all();
+                throw;
+            }
+            cv_.notify_all();
+            return proceed_;
+        }
+
+        const auto generation = generation_;
+        cv_.wait(lock, [this, generation] { return generation_ != generation || cancelled_; });
+        return !cancelled_ && proceed_;
+    }
+
+    // Release all waiting partitions, for example, if one of them failed.
+    void cancel()
+    {
+        const std::lock_guard lock(mutex_);
+        cancelled_ = true;
+        cv_.notify_all();
+    }
+
+    void reset()
+    {
+        const std::lock_guard lock(mutex_);
+        arrived_ = 0;
+        cancelled_ = false;
+    }
+
+private:
+    size_t count_;
+    CompletionFunction completion_;
+    size_t arrived_ = 0;
+    size_t generation_ = 0;
+    bool proceed_ = false;
+    bool cancelled_ = false;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+};
+
+
+namespace
+{
+using ChannelMap = std::unordered_multimap<core::UID, core::UID, core::uid_hash>;
+
+
+std::unordered_map<core::UID, std::vector<core::UID>, core::uid_hash> group_channel_populations(
+    Network &network, const ChannelMap &input_channels, const ChannelMap &output_channels)
+{
+    std::unordered_map<core::UID, std::vector<core::UID>, core::uid_hash> result;
+
+    for (const auto &[channel_uid, projection_uid] : input_channels)
+    {
+        result[channel_uid].push_back(std::visit(
+            [](const auto &proj) { return proj.get_postsynaptic(); }, network.get_projection(projection_uid)));
+    }
+
+    for (const auto &[channel_uid, population_uid] : output_channels)
+    {
+        result[channel_uid].push_back(population_uid);
+    }
+
+    return result;
+}
+}  // namespace
+
+
+PartitionedModelExecutor::PartitionedModelExecutor(
+    knp::framework::Model &model, std::vector<std::shared_ptr<core::Backend>> backends,
+    const ModelLoader::InputChannelMap &i_map)
+{
+    if (backends.empty())
+    {
+        throw std::logic_error("Partitioned model executor needs at least one backend.");
+    }
+
+    const size_t partition_count = backends.size();
+    auto &network = model.get_network();
+
+    std::vector<std::vector<core::UID>> colocated_populations;
+    for (auto &&[_, populations] :
+         group_channel_populations(network, model.get_input_channels(), model.get_output_channels()))
+    {
+        colocated_populations.push_back(std::move(populations));
+    }
+
+    partitions_ = partitioning::partition_network(network, partition_count, colocated_populations);
+    auto networks = partitioning::split_network(network, partitions_);
+
+    for (size_t partition_index = 0; partition_index < partition_count; ++partition_index)
+    {
+        SPDLOG_DEBUG("Loading partition #{}...", partition_index);
+
+        knp::framework::Model partition_model(std::move(networks[partition_index]));
+        for (const auto &[channel_uid, projection_uid] : model.get_input_channels())
+        {
+            if (partitions_.projection_partitions_.at(projection_uid) == partition_index)
+            {
+                partition_model.add_input_channel(channel_uid, projection_uid);
+            }
+        }
+        for (const auto &[channel_uid, population_uid] : model.get_output_channels())
+        {
+            if (partitions_.population_partitions_.at(population_uid) == partition_index)
+            {
+                partition_model.add_output_channel(channel_uid, population_uid);
+            }
+        }
+
+        loaders_.push_back(std::make_unique<ModelLoader>(backends[partition_index], i_map));
+        loaders_.back()->load(std::move(partition_model));
+        bridges_.push_back(backends[partition_index]->get_message_bus().create_endpoint());
+    }
+
+    // Impacts of a cut projection are collected from the source backend and are sent to the target backend.
+    std::vector<std::set<std::pair<core::UID, size_t>>> cut_targets(partition_count);
+    for (const auto &projection : network.get_projections())
+    {
+        const auto [projection_uid, post_uid] = std::visit(
+            [](const auto &proj) { return std::make_pair(proj.get_uid(), proj.get_postsynaptic()); }, projection);
+        const auto post_iter = partitions_.population_partitions_.find(post_uid);
+        if (post_iter == partitions_.population_partitions_.end()) continue;
+
+        const size_t source = partitions_.projection_partitions_.at(projection_uid);
+        const size_t target = post_iter->second;
+        if (source == target) continue;
+
+        SPDLOG_TRACE(
+            "Projection {} is cut between partitions #{} and #{}.", std::string(projection_uid), source, target);
+        cut_targets[source].emplace(post_uid, target);
+        backends[target]->subscribe<core::messaging::SynapticImpactMessage>(post_uid, {projection_uid});
+    }
+
+    for (auto &targets : cut_targets)
+    {
+        cut_targets_.emplace_back(targets.begin(), targets.end());
+    }
+
+    mailboxes_.resize(2 * partition_count * partition_count);
+    barrier_ = std::make_unique<StepBarrier>(
+        partition_count, [this]() { return !stop_requested_ && run_predicate_(get_backend(0)->get_step()); });
+}
+
+
+PartitionedModelExecutor::~PartitionedModelExecutor() = default;
+
+
+void PartitionedModelExecutor::start()
+{
+    start([](knp::core::Step) { return true; });
+}
+
+
+void PartitionedModelExecutor::start(core::Backend::RunPredicate run_predicate)
+{
+    SPDLOG_INFO("Starting partitioned model execution, {} partition(s)...", loaders_.size());
+
+    run_predicate_ = std::move(run_predicate);
+    stop_requested_ = false;
+    barrier_->reset();
+
+    std::vector<std::exception_ptr> errors(loaders_.size());
+    auto run = [this, &errors](size_t partition_index)
+    {
+        try
+        {
+            run_partition(partition_index);
+        }
+        catch (...)
+        {
+            errors[partition_index] = std::current_exception();
+            barrier_->cancel();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(loaders_.size() - 1);
+    for (size_t partition_index = 1; partition_index < loaders_.size(); ++partition_index)
+    {
+        threads.emplace_back(run, partition_index);
+    }
+    run(0);
+
+    for (auto &thread : threads) thread.join();
+
+    for (const auto &error : errors)
+    {
+        if (error) std::rethrow_exception(error);
+    }
+
+    SPDLOG_INFO("Partitioned model execution stopped.");
+}
+
+
+void PartitionedModelExecutor::stop()
+{
+    stop_requested_ = true;
+}
+
+
+void PartitionedModelExecutor::start_learning()
+{
+    for (auto &loader : loaders_) loader->get_backend()->start_learning();
+}
+
+
+void PartitionedModelExecutor::stop_learning()
+{
+    for (auto &loader : loaders_) loader->get_backend()->stop_learning();
+}
+
+
+io::output::OutputChannel &PartitionedModelExecutor::get_output_channel(const core::UID &channel_uid)
+{
+    for (auto &loader : loaders_)
+    {
+        auto &outputs = loader->get_outputs();
+        auto result = std::find_if(
+            outputs.begin(), outputs.end(),
+            [&channel_uid](const auto &output_channel) { return output_channel.get_uid() == channel_uid; });
+        if (outputs.end() != result) return *result;
+    }
+    throw std::runtime_error("Wrong output channel UID.");
+}
+
+
+void PartitionedModelExecutor::run_partition(size_t partition_index)
+{
+    auto &loader = *loaders_[partition_index];
+
+    loader.get_backend()->start(
+        [this, partition_index, &loader](knp::core::Step step)
+        {
+            // All partitions finish the previous step before any of them starts the next one.
+            if (!barrier_->arrive_and_wait()) return false;
+
+            receive_cut_impacts(partition_index, step);
+            for (auto &i_ch : loader.get_inputs())
+            {
+                i_ch.send(step);
+            }
+            return true;
+        },
+        [this, partition_index, &loader](knp::core::Step step)
+        {
+            for (auto &o_ch : loader.get_outputs())
+            {
+                o_ch.update();
+            }
+            send_cut_impacts(partition_index, step);
+            return true;
+        });
+}
+
+
+void PartitionedModelExecutor::send_cut_impacts(size_t partition_index, core::Step step)
+{
+    const size_t partition_count = loaders_.size();
+    auto &endpoint = loaders_[partition_index]->get_backend()->get_message_endpoint();
+
+    for (const auto &[post_uid, target] : cut_targets_[partition_index])
+    {
+        auto messages = endpoint.unload_messages<core::messaging::SynapticImpactMessage>(post_uid);
+        auto &mailbox = mailboxes_[((step % 2) * partition_count + target) * partition_count + partition_index];
+        mailbox.insert(mailbox.end(), std::make_move_iterator(messages.begin()), std::make_move_iterator(messages.end()));
+    }
+}
+
+
+void PartitionedModelExecutor::receive_cut_impacts(size_t partition_index, core::Step step)
+{
+    const size_t partition_count = loaders_.size();
+    auto &bridge = bridges_[partition_index];
+    bool received = false;
+
+    // Mailboxes are read in the order of the source partitions, so the result doesn't depend on thread timings.
+    for (size_t source = 0; source < partition_count; ++source)
+    {
+        auto &mailbox = mailboxes_[((step % 2) * partition_count + partition_index) * partition_count + source];
+        for (const auto &message : mailbox)
+        {
+            bridge.send_message(message);
+        }
+        received = received || !mailbox.empty();
+        mailbox.clear();
+    }
+
+    if (!received) return;
+
+    auto backend = loaders_[partition_index]->get_backend();
+    backend->get_message_bus().route_messages();
+    backend->get_message_endpoint().receive_all_messages();
+}
+
+}  // namespace knp::framework
@@ -0,0 +1,358 @@
+/**
+ * @file partitioning.cpp
+ * @brief Network partitioning routines implementation.
+ * @kaspersky_support Artiom N.
+ * @date 18.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <knp/framework/partitioning.h>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+
+
+namespace knp::framework::partitioning
+{
+
+namespace
+{
+// Allowed excess of the partition neuron count over the average.
+constexpr double max_imbalance = 0.05;
+// Maximum number of refinement passes.
+constexpr size_t max_refinement_passes = 8;
+constexpr size_t no_partition = std::numeric_limits<size_t>::max();
+
+
+template <typename SynapseType>
+struct is_stdp : std::false_type
+{
+};
+
+
+template <template <typename> typename Rule, typename SynapseType>
+struct is_stdp<knp::synapse_traits::STDP<Rule, SynapseType>> : std::true_type
+{
+};
+
+
+class DisjointSet
+{
+public:
+    explicit DisjointSet(size_t size) : parents_(size) { std::iota(parents_.begin(), parents_.end(), 0); }
+
+    size_t find(size_t index)
+    {
+        while (parents_[index] != index)
+        {
+            parents_[index] = parents_[parents_[index]];
+            index = parents_[index];
+        }
+        return index;
+    }
+
+    void unite(size_t first, size_t second)
+    {
+        first = find(first);
+        second = find(second);
+        if (first != second) parents_[std::max(first, second)] = std::min(first, second);
+    }
+
+private:
+    std::vector<size_t> parents_;
+};
+
+
+// Population graph where groups of populations that can't be separated are contracted to single nodes.
+struct PopulationGraph
+{
+    std::vector<size_t> population_nodes_;
+    std::vector<size_t> node_weights_;
+    std::vector<std::vector<std::pair<size_t, size_t>>> adjacency_;
+};
+
+
+PopulationGraph build_graph(
+    const Network &network, const std::unordered_map<core::UID, size_t, core::uid_hash> &population_indexes,
+    const std::vector<std::vector<core::UID>> &colocated_populations)
+{
+    DisjointSet groups(population_indexes.size());
+
+    auto unite_populations = [&groups, &population_indexes](const core::UID &first_uid, const core::UID &second_uid)
+    {
+        const auto first_iter = population_indexes.find(first_uid);
+        const auto second_iter = population_indexes.find(second_uid);
+        if (first_iter != population_indexes.end() && second_iter != population_indexes.end())
+        {
+            groups.unite(first_iter->second, second_iter->second);
+        }
+    };
+
+    for (const auto &group : colocated_populations)
+    {
+        for (const auto &population_uid : group) unite_populations(group.front(), population_uid);
+    }
+
+    // STDP projections need spikes of the linked populations at the same step, so they are never cut.
+    for (const auto &projection : network.get_projections())
+    {
+        std::visit(
+            [&unite_populations](const auto &proj)
+            {
+                using SynapseType = typename std::decay_t<decltype(proj)>::ProjectionSynapseType;
+                if constexpr (is_stdp<SynapseType>::value)
+                {
+                    unite_populations(proj.get_presynaptic(), proj.get_postsynaptic());
+                    for (const auto &[population_uid, _] : proj.get_shared_parameters().stdp_populations_)
+                    {
+                        unite_populations(proj.get_postsynaptic(), population_uid);
+                    }
+                }
+            },
+            projection);
+    }
+
+    PopulationGraph graph;
+    graph.population_nodes_.resize(population_indexes.size());
+
+    std::unordered_map<size_t, size_t> root_nodes;
+    const auto &populations = network.get_populations();
+    for (size_t index = 0; index < populations.size(); ++index)
+    {
+        const auto [iter, inserted] = root_nodes.emplace(groups.find(index), graph.node_weights_.size());
+        if (inserted) graph.node_weights_.push_back(0);
+        graph.population_nodes_[index] = iter->second;
+        // Empty populations also have weight, otherwise they could be moved for free.
+        graph.node_weights_[iter->second] +=
+            std::max<size_t>(std::visit([](const auto &pop) { return pop.size(); }, populations[index]), 1);
+    }
+
+    std::map<std::pair<size_t, size_t>, size_t> edges;
+    for (const auto &projection : network.get_projections())
+    {
+        std::visit(
+            [&edges, &graph, &population_indexes](const auto &proj)
+            {
+                const auto pre_iter = population_indexes.find(proj.get_presynaptic());
+                const auto post_iter = population_indexes.find(proj.get_postsynaptic());
+                if (pre_iter == population_indexes.end() || post_iter == population_indexes.end()) return;
+
+                const size_t pre_node = graph.population_nodes_[pre_iter->second];
+                const size_t post_node = graph.population_nodes_[post_iter->second];
+                if (pre_node == post_node) return;
+
+                edges[std::minmax(pre_node, post_node)] += proj.size();
+            },
+            projection);
+    }
+
+    graph.adjacency_.resize(graph.node_weights_.size());
+    for (const auto &[nodes, weight] : edges)
+    {
+        graph.adjacency_[nodes.first].emplace_back(nodes.second, weight);
+        graph.adjacency_[nodes.second].emplace_back(nodes.first, weight);
+    }
+
+    return graph;
+}
+
+
+// Greedy graph growing: every partition starts from the heaviest free node and takes the most connected nodes.
+std::vector<size_t> grow_partitions(const PopulationGraph &graph, size_t partition_count, double target_weight)
+{
+    const size_t node_count = graph.node_weights_.size();
+    std::vector<size_t> node_partitions(node_count, no_partition);
+    size_t free_count = node_count;
+
+    for (size_t partition = 0; partition < partition_count && free_count; ++partition)
+    {
+        std::vector<size_t> connections(node_count, 0);
+        size_t partition_weight = 0;
+
+        while (free_count && (partition + 1 == partition_count || partition_weight < target_weight))
+        {
+            size_t best_node = no_partition;
+            for (size_t node = 0; node < node_count; ++node)
+            {
+                if (node_partitions[node] != no_partition) continue;
+                if (best_node == no_partition || connections[node] > connections[best_node] ||
+                    (connections[node] == connections[best_node] &&
+                     graph.node_weights_[node] > graph.node_weights_[best_node]))
+                {
+                    best_node = node;
+                }
+            }
+
+            node_partitions[best_node] = partition;
+            partition_weight += graph.node_weights_[best_node];
+            --free_count;
+            for (const auto &[neighbor, weight] : graph.adjacency_[best_node]) connections[neighbor] += weight;
+        }
+    }
+
+    return node_partitions;
+}
+
+
+// Move nodes to the partitions they are connected to most, while this reduces the cut and keeps the balance.
+void refine_partitions(
+    const PopulationGraph &graph, size_t partition_count, double target_weight, std::vector<size_t> &node_partitions)
+{
+    const size_t node_count = graph.node_weights_.size();
+    const double max_weight = target_weight * (1 + max_imbalance);
+
+    std::vector<size_t> partition_weights(partition_count, 0);
+    std::vector<size_t> partition_sizes(partition_count, 0);
+    for (size_t node = 0; node < node_count; ++node)
+    {
+        partition_weights[node_partitions[node]] += graph.node_weights_[node];
+        ++partition_sizes[node_partitions[node]];
+    }
+
+    for (size_t pass = 0; pass < max_refinement_passes; ++pass)
+    {
+        bool moved = false;
+        for (size_t node = 0; node < node_count; ++node)
+        {
+            const size_t current = node_partitions[node];
+            if (partition_sizes[current] == 1) continue;
+
+            std::vector<size_t> connections(partition_count, 0);
+            for (const auto &[neighbor, weight] : graph.adjacency_[node])
+            {
+                connections[node_partitions[neighbor]] += weight;
+            }
+
+            size_t best = current;
+            for (size_t partition = 0; partition < partition_count; ++partition)
+            {
+                if (connections[partition] <= connections[best]) continue;
+                if (static_cast<double>(partition_weights[partition] + graph.node_weights_[node]) > max_weight)
+                {
+                    continue;
+                }
+                best = partition;
+            }
+
+            if (best == current) continue;
+
+            partition_weights[current] -= graph.node_weights_[node];
+            --partition_sizes[current];
+            partition_weights[best] += graph.node_weights_[node];
+            ++partition_sizes[best];
+            node_partitions[node] = best;
+            moved = true;
+        }
+        if (!moved) break;
+    }
+}
+}  // namespace
+
+
+PartitionMap partition_network(
+    const Network &network, size_t partition_count, const std::vector<std::vector<core::UID>> &colocated_populations)
+{
+    if (!partition_count)
+    {
+        throw std::logic_error("Number of partitions must be non-zero.");
+    }
+
+    SPDLOG_DEBUG("Partitioning network {} into {} part(s)...", std::string(network.get_uid()), partition_count);
+
+    std::unordered_map<core::UID, size_t, core::uid_hash> population_indexes;
+    const auto &populations = network.get_populations();
+    for (size_t index = 0; index < populations.size(); ++index)
+    {
+        population_indexes.emplace(std::visit([](const auto &pop) { return pop.get_uid(); }, populations[index]), index);
+    }
+
+    const auto graph = build_graph(network, population_indexes, colocated_populations);
+    const double target_weight =
+        static_cast<double>(std::accumulate(graph.node_weights_.begin(), graph.node_weights_.end(), size_t{0})) /
+        static_cast<double>(partition_count);
+
+    auto node_partitions = grow_partitions(graph, partition_count, target_weight);
+    refine_partitions(graph, partition_count, target_weight, node_partitions);
+
+    PartitionMap result;
+    result.partition_count_ = partition_count;
+
+    for (const auto &[population_uid, index] : population_indexes)
+    {
+        result.population_partitions_.emplace(population_uid, node_partitions[graph.population_nodes_[index]]);
+    }
+
+    for (const auto &projection : network.get_projections())
+    {
+        std::visit(
+            [&result](const auto &proj)
+            {
+                const auto pre_iter = result.population_partitions_.find(proj.get_presynaptic());
+                const auto post_iter = result.population_partitions_.find(proj.get_postsynaptic());
+                size_t partition = 0;
+
+                if (pre_iter != result.population_partitions_.end())
+                {
+                    partition = pre_iter->second;
+                    if (post_iter != result.population_partitions_.end() && post_iter->second != partition)
+                    {
+                        result.cut_synapse_count_ += proj.size();
+                    }
+                }
+                else if (post_iter != result.population_partitions_.end())
+                {
+                    partition = post_iter->second;
+                }
+
+                result.projection_partitions_.emplace(proj.get_uid(), partition);
+            },
+            projection);
+    }
+
+    SPDLOG_DEBUG("Network partitioned, {} synapse(s) cut.", result.cut_synapse_count_);
+
+    return result;
+}
+
+
+std::vector<Network> split_network(const Network &network, const PartitionMap &partitions)
+{
+    std::vector<Network> result(partitions.partition_count_);
+
+    for (const auto &population : network.get_populations())
+    {
+        const auto &population_uid = std::visit([](const auto &pop) { return pop.get_uid(); }, population);
+        result[partitions.population_partitions_.at(population_uid)].add_population(
+            core::AllPopulationsVariant(population));
+    }
+
+    for (const auto &projection : network.get_projections())
+    {
+        const auto &projection_uid = std::visit([](const auto &proj) { return proj.get_uid(); }, projection);
+        result[partitions.projection_partitions_.at(projection_uid)].add_projection(
+            core::AllProjectionsVariant(projection));
+    }
+
+    return result;
+}
+
+}  // namespace knp::framework::partitioning
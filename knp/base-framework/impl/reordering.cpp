@@ -0,0 +1,334 @@
+/**
+ * @file reordering.cpp
+ * @brief Network reordering routines implementation.
+ * @kaspersky_support Artiom N.
+ * @date 18.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <knp/framework/reordering.h>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+
+namespace knp::framework::reordering
+{
+
+namespace
+{
+template <typename SynapseParameters, typename = void>
+struct has_delay : std::false_type
+{
+};
+
+
+template <typename SynapseParameters>
+struct has_delay<SynapseParameters, std::void_t<decltype(std::declval<SynapseParameters>().delay_)>> : std::true_type
+{
+};
+
+
+template <typename Synapse>
+auto get_sort_key(const Synapse &synapse)
+{
+    using SynapseParameters = std::decay_t<decltype(std::get<core::synapse_data>(synapse))>;
+    size_t delay = 0;
+    if constexpr (has_delay<SynapseParameters>::value) delay = std::get<core::synapse_data>(synapse).delay_;
+    return std::make_tuple(delay, std::get<core::source_neuron_id>(synapse), std::get<core::target_neuron_id>(synapse));
+}
+
+
+// Neurons of all populations numbered one population after another.
+struct NeuronNumbering
+{
+    // Population UIDs in the network order.
+    std::vector<core::UID> uids_;
+    // Global index of the first neuron of every population, the last element is the number of neurons.
+    std::vector<size_t> offsets_{0};
+    // Population indexes by UIDs.
+    std::unordered_map<core::UID, size_t, core::uid_hash> indexes_;
+};
+
+
+NeuronNumbering number_neurons(const Network &network)
+{
+    NeuronNumbering result;
+    for (const auto &population : network.get_populations())
+    {
+        const auto [uid, size] =
+            std::visit([](const auto &pop) { return std::make_pair(pop.get_uid(), pop.size()); }, population);
+        result.indexes_.emplace(uid, result.uids_.size());
+        result.uids_.push_back(uid);
+        result.offsets_.push_back(result.offsets_.back() + size);
+    }
+    return result;
+}
+
+
+// Call a function for every synapse that connects two network neurons.
+template <typename Function>
+void for_each_connection(const Network &network, const NeuronNumbering &numbering, Function function)
+{
+    for (const auto &projection : network.get_projections())
+    {
+        std::visit(
+            [&numbering, &function](const auto &proj)
+            {
+                if (proj.is_compact()) return;
+                const auto pre = numbering.indexes_.find(proj.get_presynaptic());
+                const auto post = numbering.indexes_.find(proj.get_postsynaptic());
+                if (pre == numbering.indexes_.end() || post == numbering.indexes_.end()) return;
+
+                const size_t pre_offset = numbering.offsets_[pre->second];
+                const size_t pre_size = numbering.offsets_[pre->second + 1] - pre_offset;
+                const size_t post_offset = numbering.offsets_[post->second];
+                const size_t post_size = numbering.offsets_[post->second + 1] - post_offset;
+                for (const auto &synapse : proj)
+                {
+                    const size_t source = std::get<core::source_neuron_id>(synapse);
+                    const size_t target = std::get<core::target_neuron_id>(synapse);
+                    if (source >= pre_size || target >= post_size) continue;
+                    // Loops don't affect the order.
+                    if (pre_offset + source == post_offset + target) continue;
+                    function(pre_offset + source, post_offset + target);
+                }
+            },
+            projection);
+    }
+}
+
+
+// Undirected graph of neurons in the compressed sparse row format.
+struct NeuronGraph
+{
+    std::vector<size_t> offsets_;
+    std::vector<size_t> neighbors_;
+
+    [[nodiscard]] size_t get_degree(size_t node) const { return offsets_[node + 1] - offsets_[node]; }
+};
+
+
+NeuronGraph make_graph(const Network &network, const NeuronNumbering &numbering)
+{
+    const size_t neuron_count = numbering.offsets_.back();
+    NeuronGraph graph;
+    graph.offsets_.assign(neuron_count + 1, 0);
+    for_each_connection(
+        network, numbering,
+        [&graph](size_t source, size_t target)
+        {
+            ++graph.offsets_[source + 1];
+            ++graph.offsets_[target + 1];
+        });
+    std::partial_sum(graph.offsets_.begin(), graph.offsets_.end(), graph.offsets_.begin());
+
+    graph.neighbors_.resize(graph.offsets_.back());
+    std::vector<size_t> positions(graph.offsets_.begin(), graph.offsets_.end() - 1);
+    for_each_connection(
+        network, numbering,
+        [&graph, &positions](size_t source, size_t target)
+        {
+            graph.neighbors_[positions[source]++] = target;
+            graph.neighbors_[positions[target]++] = source;
+        });
+    return graph;
+}
+
+
+// Reverse Cuthill-McKee order of connected nodes followed by isolated nodes in the original order.
+std::vector<size_t> make_rcm_order(const NeuronGraph &graph)
+{
+    const size_t node_count = graph.offsets_.size() - 1;
+    const auto by_degree = [&graph](size_t first, size_t second)
+    { return std::make_pair(graph.get_degree(first), first) < std::make_pair(graph.get_degree(second), second); };
+
+    std::vector<size_t> start_nodes;
+    std::vector<size_t> isolated_nodes;
+    for (size_t node = 0; node < node_count; ++node)
+    {
+        (graph.get_degree(node) ? start_nodes : isolated_nodes).push_back(node);
+    }
+    std::sort(start_nodes.begin(), start_nodes.end(), by_degree);
+
+    std::vector<bool> visited(node_count, false);
+    std::vector<size_t> order;
+    order.reserve(node_count);
+    for (const auto start_node : start_nodes)
+    {
+        if (visited[start_node]) continue;
+        visited[start_node] = true;
+        order.push_back(start_node);
+        // Breadth-first search, the order vector is used as a queue.
+        for (size_t head = order.size() - 1; head < order.size(); ++head)
+        {
+            const size_t node = order[head];
+            const size_t first_added = order.size();
+            for (size_t i = graph.offsets_[node]; i < graph.offsets_[node + 1]; ++i)
+            {
+                const size_t neighbor = graph.neighbors_[i];
+                if (visited[neighbor]) continue;
+                visited[neighbor] = true;
+                order.push_back(neighbor);
+            }
+            std::sort(order.begin() + first_added, order.end(), by_degree);
+        }
+    }
+
+    std::reverse(order.begin(), order.end());
+    order.insert(order.end(), isolated_nodes.begin(), isolated_nodes.end());
+    return order;
+}
+
+}  // namespace
+
+
+NeuronIndexMap make_neuron_order(const Network &network)
+{
+    SPDLOG_DEBUG("Calculating neuron order for network {}...", std::string(network.get_uid()));
+    const auto numbering = number_neurons(network);
+    const auto order = make_rcm_order(make_graph(network, numbering));
+
+    NeuronIndexMap result;
+    for (size_t population_index = 0; population_index < numbering.uids_.size(); ++population_index)
+    {
+        const size_t size = numbering.offsets_[population_index + 1] - numbering.offsets_[population_index];
+        result.new_indexes_[numbering.uids_[population_index]].resize(size);
+        result.original_indexes_[numbering.uids_[population_index]].reserve(size);
+    }
+
+    for (const auto node : order)
+    {
+        const auto next_offset = std::upper_bound(numbering.offsets_.begin(), numbering.offsets_.end(), node);
+        const size_t population_index = std::distance(numbering.offsets_.begin(), next_offset) - 1;
+        const auto &uid = numbering.uids_[population_index];
+        auto &original_indexes = result.original_indexes_[uid];
+        const size_t original_index = node - numbering.offsets_[population_index];
+        result.new_indexes_[uid][original_index] = original_indexes.size();
+        original_indexes.push_back(original_index);
+    }
+
+    // Synapse indexes of compact projections depend on neuron indexes, so their populations keep the order.
+    for (const auto &projection : network.get_projections())
+    {
+        std::visit(
+            [&result](const auto &proj)
+            {
+                if (!proj.is_compact()) return;
+                for (const auto &uid : {proj.get_presynaptic(), proj.get_postsynaptic()})
+                {
+                    result.new_indexes_.erase(uid);
+                    result.original_indexes_.erase(uid);
+                }
+            },
+            projection);
+    }
+
+    return result;
+}
+
+
+void reorder_neurons(Network &network, const NeuronIndexMap &index_map)
+{
+    SPDLOG_DEBUG("Reordering neurons of network {}...", std::string(network.get_uid()));
+    for (auto population = network.begin_populations(); population != network.end_populations(); ++population)
+    {
+        std::visit(
+            [&index_map](auto &pop)
+            {
+                const auto original_indexes = index_map.original_indexes_.find(pop.get_uid());
+                if (original_indexes == index_map.original_indexes_.end()) return;
+                if (original_indexes->second.size() != pop.size())
+                {
+                    throw std::logic_error(
+                        "Neuron index map size doesn't match size of population \"" + std::string(pop.get_uid()) +
+                        "\".");
+                }
+
+                using NeuronParameters = typename std::decay_t<decltype(pop)>::NeuronParameters;
+                std::vector<NeuronParameters> neurons(
+                    std::make_move_iterator(pop.begin()), std::make_move_iterator(pop.end()));
+                for (size_t index = 0; index < neurons.size(); ++index)
+                {
+                    pop[index] = std::move(neurons[original_indexes->second[index]]);
+                }
+            },
+            *population);
+    }
+
+    const std::vector<size_t> unchanged;
+    for (auto projection = network.begin_projections(); projection != network.end_projections(); ++projection)
+    {
+        std::visit(
+            [&index_map, &unchanged](auto &proj)
+            {
+                const auto pre = index_map.new_indexes_.find(proj.get_presynaptic());
+                const auto post = index_map.new_indexes_.find(proj.get_postsynaptic());
+                if (pre == index_map.new_indexes_.end() && post == index_map.new_indexes_.end()) return;
+                proj.renumber_neurons(
+                    pre == index_map.new_indexes_.end() ? unchanged : pre->second,
+                    post == index_map.new_indexes_.end() ? unchanged : post->second);
+            },
+            *projection);
+    }
+}
+
+
+void sort_synapses(Network &network)
+{
+    SPDLOG_DEBUG("Sorting synapses of network {}...", std::string(network.get_uid()));
+    for (auto projection = network.begin_projections(); projection != network.end_projections(); ++projection)
+    {
+        std::visit(
+            [](auto &proj)
+            {
+                // Compact projections are ordered by their blocks.
+                if (proj.is_compact()) return;
+                using Synapse = typename std::decay_t<decltype(proj)>::Synapse;
+                proj.sort_synapses([](const Synapse &first, const Synapse &second)
+                                   { return get_sort_key(first) < get_sort_key(second); });
+            },
+            *projection);
+    }
+}
+
+
+NeuronIndexMap optimize_locality(Network &network)
+{
+    auto result = make_neuron_order(network);
+    reorder_neurons(network, result);
+    sort_synapses(network);
+    return result;
+}
+
+
+void restore_original_indexes(io::output::OutputChannel &channel, const NeuronIndexMap &index_map)
+{
+    for (const auto &[uid, original_indexes] : index_map.original_indexes_)
+    {
+        channel.set_original_neuron_indexes(uid, original_indexes);
+    }
+}
+
+}  // namespace knp::framework::reordering
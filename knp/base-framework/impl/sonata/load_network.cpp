@@ -25,12 +25,18 @@
 #include <knp/core/projection.h>
 #include <knp/core/uid.h>
 #include <knp/framework/network.h>
+#include <knp/framework/sonata/network_io.h>
+#include <knp/framework/sonata/network_reader.h>
 
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
+#include <chrono>
 #include <cstdio>
 #include <filesystem>
 #include <fstream>
+#include <mutex>
+#include <optional>
 #include <regex>
 
 #include <boost/format.hpp>
@@ -38,6 +44,7 @@
 #include <boost/uuid/uuid.hpp>
 
 #include "highfive.h"
+#include "parallel.h"
 #include "types/type_id_defines.h"
 
 
@@ -46,6 +53,34 @@ namespace knp::framework::sonata
 namespace fs = std::filesystem;
 
 
+std::mutex &get_hdf5_mutex()
+{
+    static std::mutex hdf5_mutex;
+    return hdf5_mutex;
+}
+
+
+void LoadingTimer::mark(std::chrono::steady_clock::duration &stage)
+{
+    const auto now = std::chrono::steady_clock::now();
+    stage += now - last_mark_;
+    last_mark_ = now;
+}
+
+
+void LoadingTimer::log(const std::string &projection_name) const
+{
+    using std::chrono::duration_cast;
+    using std::chrono::milliseconds;
+    SPDLOG_DEBUG(
+        "Projection {} loaded: waiting for HDF5 {} ms, reading {} ms, converting {} ms.", projection_name,
+        duration_cast<milliseconds>(waiting_).count(), duration_cast<milliseconds>(reading_).count(),
+        duration_cast<milliseconds>(converting_).count());
+}
+
+
+
+
 std::vector<std::string> get_projection_names(const HighFive::File &file)
 {
     auto edges_group = file.getGroup("edges");
@@ -60,67 +95,101 @@ std::vector<std::string> get_projection_names(const HighFive::File &file)
 }
 
 
-std::vector<core::AllProjectionsVariant> load_projections(const fs::path &proj_h5_file)
+int read_type_id(const HighFive::Group &entities_group, const std::string &name, const std::string &dataset_name)
 {
-    if (!fs::is_regular_file(proj_h5_file))
-        throw std::runtime_error("Could not open file \"" + proj_h5_file.string() + "\".");
-    HighFive::File storage{proj_h5_file.string()};
-    auto group = storage.getGroup("edges");
-    size_t num_projections = group.getNumberObjects();
-    std::vector<core::AllProjectionsVariant> result;
+    auto dataset = entities_group.getGroup(name).getDataSet(dataset_name);
+    if (dataset.getDimensions().at(0) == 0) return -1;
+    return dataset.select({0}, {1}).read<std::vector<int>>()[0];  // One type only.
+}
 
-    for (size_t i = 0; i < num_projections; ++i)
-    {
-        std::string proj_name = group.getObjectName(i);
-        int proj_type =
-            group.getGroup(proj_name).getDataSet("edge_type_id").read<std::vector<int>>()[0];  // One type only.
-        // TODO: Check if type is in type_file.
-        if (proj_type == get_synapse_type_id<synapse_traits::DeltaSynapse>())
-            result.emplace_back(load_projection<synapse_traits::DeltaSynapse>(group, proj_name));
-        else if (proj_type == get_synapse_type_id<synapse_traits::SynapticResourceSTDPDeltaSynapse>())
-            result.emplace_back(load_projection<synapse_traits::SynapticResourceSTDPDeltaSynapse>(group, proj_name));
-        // TODO: Add other supported types or better use a template.
-    }
-    return result;
+
+std::string get_population_type_name(int type_id)
+{
+    if (type_id == get_neuron_type_id<neuron_traits::BLIFATNeuron>())
+        return get_neuron_type_name<neuron_traits::BLIFATNeuron>();
+    if (type_id == get_neuron_type_id<neuron_traits::SynapticResourceSTDPBLIFATNeuron>())
+        return get_neuron_type_name<neuron_traits::SynapticResourceSTDPBLIFATNeuron>();
+    // TODO: Add other supported types or better use a template.
+    return "";
+}
+
+
+std::string get_projection_type_name(int type_id)
+{
+    if (type_id == get_synapse_type_id<synapse_traits::DeltaSynapse>())
+        return get_synapse_type_name<synapse_traits::DeltaSynapse>();
+    if (type_id == get_synapse_type_id<synapse_traits::SynapticResourceSTDPDeltaSynapse>())
+        return get_synapse_type_name<synapse_traits::SynapticResourceSTDPDeltaSynapse>();
+    // TODO: Add other supported types or better use a template.
+    return "";
 }
 
 
-std::vector<core::AllPopulationsVariant> load_populations(const fs::path &pop_h5_file)
+std::vector<core::AllProjectionsVariant> load_projections(
+    const HighFive::Group &edges_group, const std::vector<std::string> &proj_names)
 {
-    if (!fs::is_regular_file(pop_h5_file))
+    std::vector<int> proj_types;
+    proj_types.reserve(proj_names.size());
     {
-        throw std::runtime_error("Could not open file \"" + pop_h5_file.string() + "\".");
+        const std::lock_guard lock{get_hdf5_mutex()};
+        for (const auto &proj_name : proj_names)
+        {
+            proj_types.push_back(read_type_id(edges_group, proj_name, "edge_type_id"));
+        }
     }
 
-    const HighFive::File storage{pop_h5_file.string()};
-    auto group = storage.getGroup("nodes");
-    const size_t num_projections = group.getNumberObjects();
-    std::vector<core::AllPopulationsVariant> result;
+    // Projections are independent, loaders lock the HDF5 mutex only to read data.
+    const auto start_time = std::chrono::steady_clock::now();
+    std::vector<std::optional<core::AllProjectionsVariant>> projections(proj_names.size());
+    run_in_parallel(
+        proj_names.size(),
+        [&edges_group, &proj_names, &proj_types, &projections](size_t index)
+        {
+            const auto &proj_name = proj_names[index];
+            const int proj_type = proj_types[index];
+            // TODO: Check if type is in type_file.
+            if (proj_type == get_synapse_type_id<synapse_traits::DeltaSynapse>())
+                projections[index] = load_projection<synapse_traits::DeltaSynapse>(edges_group, proj_name);
+            else if (proj_type == get_synapse_type_id<synapse_traits::SynapticResourceSTDPDeltaSynapse>())
+                projections[index] =
+                    load_projection<synapse_traits::SynapticResourceSTDPDeltaSynapse>(edges_group, proj_name);
+            // TODO: Add other supported types or better use a template.
+        });
+    SPDLOG_DEBUG(
+        "{} projection(s) loaded in {} ms.", proj_names.size(),
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start_time).count());
 
-    for (size_t i = 0; i < num_projections; ++i)
+    std::vector<core::AllProjectionsVariant> result;
+    result.reserve(proj_names.size());
+    for (auto &projection : projections)
     {
-        const std::string proj_name = group.getObjectName(i);
-        const int proj_type =
-            group.getGroup(proj_name).getDataSet("node_type_id").read<std::vector<int>>()[0];  // One type only.
-        // Check if type is in type_file.
-        if (proj_type == get_neuron_type_id<neuron_traits::BLIFATNeuron>())
-            result.emplace_back(load_population<neuron_traits::BLIFATNeuron>(group, proj_name));
-        else if (proj_type == get_neuron_type_id<neuron_traits::SynapticResourceSTDPBLIFATNeuron>())
-            result.emplace_back(load_population<neuron_traits::SynapticResourceSTDPBLIFATNeuron>(group, proj_name));
-        // TODO: Add other supported types or better use a template.
+        if (projection) result.push_back(std::move(*projection));
     }
     return result;
 }
 
 
-struct NetworkConfig
+std::vector<core::AllPopulationsVariant> load_populations(
+    const HighFive::Group &nodes_group, const std::vector<std::string> &pop_names)
 {
-    const fs::path config_path;
-    const fs::path edges_storage;
-    const fs::path nodes_storage;
-    const fs::path edges_types;
-    const fs::path nodes_types;
-};
+    // Population loaders read all data at once, so populations are loaded sequentially.
+    const std::lock_guard lock{get_hdf5_mutex()};
+    std::vector<core::AllPopulationsVariant> result;
+    result.reserve(pop_names.size());
+
+    for (const auto &pop_name : pop_names)
+    {
+        const int pop_type = read_type_id(nodes_group, pop_name, "node_type_id");
+        // Check if type is in type_file.
+        if (pop_type == get_neuron_type_id<neuron_traits::BLIFATNeuron>())
+            result.emplace_back(load_population<neuron_traits::BLIFATNeuron>(nodes_group, pop_name));
+        else if (pop_type == get_neuron_type_id<neuron_traits::SynapticResourceSTDPBLIFATNeuron>())
+            result.emplace_back(
+                load_population<neuron_traits::SynapticResourceSTDPBLIFATNeuron>(nodes_group, pop_name));
+        // TODO: Add other supported types or better use a template.
+    }
+    return result;
+}
 
 
 NetworkConfig read_config_file(const fs::path &config_path)
@@ -135,38 +204,9 @@ NetworkConfig read_config_file(const fs::path &config_path)
 }
 
 
-core::UID get_network_uid(const fs::path &nodes_path)
-{
-    const HighFive::File h5_file(nodes_path.string());
-    if (h5_file.hasAttribute("network_uid"))
-    {
-        auto uid_str = h5_file.getAttribute("network_uid").read<std::string>();
-        return core::UID{boost::lexical_cast<boost::uuids::uuid>(uid_str)};
-    }
-    return core::UID{};
-}
-
-
 KNP_DECLSPEC Network load_network(const fs::path &config_path)
 {
-    // TODO: Get this value from config file at config_path.
-    const std::string config_path_suffix = "network/network_config.json";
-    // Open and read config files.
-    auto config = read_config_file(config_path / config_path_suffix);
-    Network network{get_network_uid(config.nodes_storage)};
-    auto populations = load_populations(config.nodes_storage);
-    auto projections = load_projections(config.edges_storage);
-    for (auto &pop : populations)
-    {
-        std::visit([&network](auto &population) { network.add_population(population); }, pop);
-    }
-
-    for (auto &proj : projections)
-    {
-        std::visit([&network](auto &projection) { network.add_projection(projection); }, proj);
-    }
-
-    return network;
+    return NetworkReader{config_path}.load_network();
 }
 
 }  // namespace knp::framework::sonata
@@ -25,7 +25,9 @@
 #include <knp/core/projection.h>
 
 #include <algorithm>
+#include <chrono>
 #include <filesystem>
+#include <mutex>
 #include <stdexcept>
 #include <string>
 #include <vector>
@@ -43,6 +45,82 @@ core::Population<Neuron> load_population(const HighFive::Group &nodes_group, con
 template <class Synapse>
 core::Projection<Synapse> load_projection(const HighFive::Group &edges_group, const std::string &projection_name);
 
+
+struct NetworkConfig
+{
+    const fs::path config_path;
+    const fs::path edges_storage;
+    const fs::path nodes_storage;
+    const fs::path edges_types;
+    const fs::path nodes_types;
+};
+
+
+NetworkConfig read_config_file(const fs::path &config_path);
+
+
+// Read type ID of a population or a projection, -1 is returned for an empty entity. The caller locks HDF5 mutex.
+int read_type_id(const HighFive::Group &entities_group, const std::string &name, const std::string &dataset_name);
+
+
+// Get type names of supported populations and projections, an empty string is returned for other types.
+std::string get_population_type_name(int type_id);
+std::string get_projection_type_name(int type_id);
+
+
+// Load populations and projections of supported types. The caller must not lock HDF5 mutex.
+std::vector<core::AllPopulationsVariant> load_populations(
+    const HighFive::Group &nodes_group, const std::vector<std::string> &pop_names);
+std::vector<core::AllProjectionsVariant> load_projections(
+    const HighFive::Group &edges_group, const std::vector<std::string> &proj_names);
+
+
+// Number of synapses read from projection datasets at once.
+constexpr size_t projection_read_chunk_size = 1 << 16;
+
+
+// HDF5 library is not thread-safe by default, so parallel loaders call HighFive only while holding this mutex.
+// All HDF5 reads are serialized, only conversion and indexing of loaded data run in parallel with them.
+std::mutex &get_hdf5_mutex();
+
+
+// Durations of projection loading stages, they show which part of loading is serialized by the HDF5 mutex.
+struct LoadingTimer
+{
+    // Add time passed since the previous mark to a stage duration.
+    void mark(std::chrono::steady_clock::duration &stage);
+
+    // Log stage durations of a loaded projection.
+    void log(const std::string &projection_name) const;
+
+    std::chrono::steady_clock::duration waiting_{};
+    std::chrono::steady_clock::duration reading_{};
+    std::chrono::steady_clock::duration converting_{};
+    std::chrono::steady_clock::time_point last_mark_ = std::chrono::steady_clock::now();
+};
+
+
+// Read a range of parameter values, the range is filled with the default value if there is no such dataset.
+// Parameters can be stored as scalar attributes. Errors of reading an existing dataset are propagated.
+template <class Attr>
+void read_parameter_chunk(
+    const HighFive::Group &group, const std::string &param_name, size_t offset, size_t count,
+    const Attr &default_value, std::vector<Attr> &result)
+{
+    if (group.hasAttribute(param_name))
+    {
+        result.assign(count, group.getAttribute(param_name).read<Attr>());
+        return;
+    }
+    if (!group.exist(param_name))
+    {
+        result.assign(count, default_value);
+        return;
+    }
+    result.resize(count);
+    group.getDataSet(param_name).select({offset}, {count}).read(result);
+}
+
 }  // namespace knp::framework::sonata
 
 
@@ -0,0 +1,278 @@
+/**
+ * @file network_reader.cpp
+ * @brief Selective SONATA network reader implementation.
+ * @kaspersky_support Artiom N.
+ * @date 18.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <knp/framework/sonata/network_reader.h>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+#include <boost/lexical_cast.hpp>
+#include <boost/uuid/uuid.hpp>
+
+#include "highfive.h"
+#include "load_network.h"
+#include "save_network.h"
+
+
+namespace knp::framework::sonata
+{
+
+namespace impl
+{
+class NetworkFiles
+{
+public:
+    explicit NetworkFiles(const NetworkConfig &config)
+    {
+        for (const auto &path : {config.nodes_storage, config.edges_storage})
+        {
+            if (!fs::is_regular_file(path)) throw std::runtime_error("Could not open file \"" + path.string() + "\".");
+        }
+        const std::lock_guard lock{get_hdf5_mutex()};
+        nodes_file_.emplace(config.nodes_storage.string());
+        edges_file_.emplace(config.edges_storage.string());
+        nodes_group_.emplace(nodes_file_->getGroup("nodes"));
+        edges_group_.emplace(edges_file_->getGroup("edges"));
+    }
+
+    NetworkFiles(const NetworkFiles &) = delete;
+    NetworkFiles &operator=(const NetworkFiles &) = delete;
+
+    ~NetworkFiles()
+    {
+        // HighFive objects are closed while HDF5 mutex is locked.
+        const std::lock_guard lock{get_hdf5_mutex()};
+        nodes_group_.reset();
+        edges_group_.reset();
+        nodes_file_.reset();
+        edges_file_.reset();
+    }
+
+    // Read a whole projection parameter, synapse parameters are stored in the synapse group.
+    template <class Attr>
+    std::vector<Attr> read_projection_array(
+        const EntityInfo &info, const std::string &param_name, bool is_synapse_parameter,
+        const Attr &default_value) const
+    {
+        SPDLOG_TRACE("Reading {} of projection {}...", param_name, std::string(info.uid_));
+        const std::lock_guard lock{get_hdf5_mutex()};
+        auto group = edges_group_->getGroup(std::string(info.uid_));
+        if (is_synapse_parameter) group = group.getGroup("0");
+        return read_parameter(group, param_name, info.size_, default_value);
+    }
+
+    std::optional<HighFive::File> nodes_file_;
+    std::optional<HighFive::File> edges_file_;
+    std::optional<HighFive::Group> nodes_group_;
+    std::optional<HighFive::Group> edges_group_;
+};
+}  // namespace impl
+
+
+namespace
+{
+const EntityInfo &find_entity(
+    const std::vector<EntityInfo> &entities, const core::UID &uid, const std::string &entity_name)
+{
+    const auto result =
+        std::find_if(entities.begin(), entities.end(), [&uid](const EntityInfo &info) { return info.uid_ == uid; });
+    if (result == entities.end())
+    {
+        throw std::logic_error("Cannot find " + entity_name + " with UID \"" + std::string(uid) + "\".");
+    }
+    return *result;
+}
+
+
+std::vector<std::string> get_names(const std::vector<const EntityInfo *> &entities)
+{
+    std::vector<std::string> result;
+    result.reserve(entities.size());
+    for (const auto *info : entities) result.push_back(std::string(info->uid_));
+    return result;
+}
+}  // namespace
+
+
+ProjectionArrays::ProjectionArrays(std::shared_ptr<const impl::NetworkFiles> files, EntityInfo info)
+    : files_(std::move(files)), info_(std::move(info))
+{
+}
+
+
+const std::vector<size_t> &ProjectionArrays::get_source_ids()
+{
+    if (!source_ids_) source_ids_ = files_->read_projection_array<size_t>(info_, "source_node_id", false, 0);
+    return *source_ids_;
+}
+
+
+const std::vector<size_t> &ProjectionArrays::get_target_ids()
+{
+    if (!target_ids_) target_ids_ = files_->read_projection_array<size_t>(info_, "target_node_id", false, 0);
+    return *target_ids_;
+}
+
+
+const std::vector<float> &ProjectionArrays::get_weights()
+{
+    if (!weights_)
+    {
+        weights_ = files_->read_projection_array(
+            info_, "syn_weight", true, synapse_traits::default_values<synapse_traits::DeltaSynapse>::weight_);
+    }
+    return *weights_;
+}
+
+
+const std::vector<uint32_t> &ProjectionArrays::get_delays()
+{
+    if (!delays_)
+    {
+        delays_ = files_->read_projection_array(
+            info_, "delay", true, synapse_traits::default_values<synapse_traits::DeltaSynapse>::delay_);
+    }
+    return *delays_;
+}
+
+
+NetworkReader::NetworkReader(const fs::path &config_path)
+{
+    // TODO: Get this value from config file at config_path.
+    const std::string config_path_suffix = "network/network_config.json";
+    const auto config = read_config_file(config_path / config_path_suffix);
+    files_ = std::make_shared<const impl::NetworkFiles>(config);
+
+    SPDLOG_DEBUG("Reading network description from {}...", config_path.string());
+    const std::lock_guard lock{get_hdf5_mutex()};
+    if (files_->nodes_file_->hasAttribute("network_uid"))
+    {
+        const auto uid_str = files_->nodes_file_->getAttribute("network_uid").read<std::string>();
+        network_uid_ = core::UID{boost::lexical_cast<boost::uuids::uuid>(uid_str)};
+    }
+    else
+    {
+        network_uid_ = core::UID{};
+    }
+
+    const auto &nodes_group = *files_->nodes_group_;
+    for (size_t i = 0; i < nodes_group.getNumberObjects(); ++i)
+    {
+        const std::string pop_name = nodes_group.getObjectName(i);
+        EntityInfo info;
+        info.type_name_ = get_population_type_name(read_type_id(nodes_group, pop_name, "node_type_id"));
+        if (info.type_name_.empty()) continue;
+        info.uid_ = core::UID{boost::lexical_cast<boost::uuids::uuid>(pop_name)};
+        info.size_ = nodes_group.getGroup(pop_name).getDataSet("node_id").getDimensions().at(0);
+        populations_.push_back(std::move(info));
+    }
+
+    const auto &edges_group = *files_->edges_group_;
+    for (size_t i = 0; i < edges_group.getNumberObjects(); ++i)
+    {
+        const std::string proj_name = edges_group.getObjectName(i);
+        EntityInfo info;
+        info.type_name_ = get_projection_type_name(read_type_id(edges_group, proj_name, "edge_type_id"));
+        if (info.type_name_.empty()) continue;
+        const auto proj_group = edges_group.getGroup(proj_name);
+        info.uid_ = core::UID{boost::lexical_cast<boost::uuids::uuid>(proj_name)};
+        info.size_ = proj_group.getDataSet("edge_group_id").getDimensions().at(0);
+        info.presynaptic_uid_ = core::UID{boost::lexical_cast<boost::uuids::uuid>(
+            proj_group.getDataSet("source_node_id").getAttribute("node_population").read<std::string>())};
+        info.postsynaptic_uid_ = core::UID{boost::lexical_cast<boost::uuids::uuid>(
+            proj_group.getDataSet("target_node_id").getAttribute("node_population").read<std::string>())};
+        projections_.push_back(std::move(info));
+    }
+}
+
+
+core::AllPopulationsVariant NetworkReader::load_population(const core::UID &uid) const
+{
+    const auto &info = find_entity(populations_, uid, "population");
+    return std::move(load_populations(*files_->nodes_group_, {std::string(info.uid_)}).at(0));
+}
+
+
+core::AllProjectionsVariant NetworkReader::load_projection(const core::UID &uid) const
+{
+    const auto &info = find_entity(projections_, uid, "projection");
+    return std::move(load_projections(*files_->edges_group_, {std::string(info.uid_)}).at(0));
+}
+
+
+ProjectionArrays NetworkReader::get_projection_arrays(const core::UID &uid) const
+{
+    return ProjectionArrays{files_, find_entity(projections_, uid, "projection")};
+}
+
+
+Network NetworkReader::load_network() const
+{
+    std::vector<core::UID> uids;
+    uids.reserve(populations_.size() + projections_.size());
+    for (const auto &info : populations_) uids.push_back(info.uid_);
+    for (const auto &info : projections_) uids.push_back(info.uid_);
+    return load_network(uids);
+}
+
+
+Network NetworkReader::load_network(const std::vector<core::UID> &uids) const
+{
+    std::vector<const EntityInfo *> selected_populations, selected_projections;
+    for (const auto &uid : uids)
+    {
+        const auto is_same_uid = [&uid](const EntityInfo &info) { return info.uid_ == uid; };
+        const auto population = std::find_if(populations_.begin(), populations_.end(), is_same_uid);
+        if (population != populations_.end())
+        {
+            selected_populations.push_back(&*population);
+            continue;
+        }
+        selected_projections.push_back(&find_entity(projections_, uid, "population or projection"));
+    }
+
+    // Populations are loaded while projection data is converted and indexed.
+    auto populations_future = std::async(
+        std::launch::async, [this, names = get_names(selected_populations)]()
+        { return load_populations(*files_->nodes_group_, names); });
+    auto projections = load_projections(*files_->edges_group_, get_names(selected_projections));
+    auto populations = populations_future.get();
+
+    Network network{network_uid_};
+    for (auto &pop : populations)
+    {
+        network.add_population(std::move(pop));
+    }
+
+    for (auto &proj : projections)
+    {
+        network.add_projection(std::move(proj));
+    }
+
+    return network;
+}
+
+}  // namespace knp::framework::sonata
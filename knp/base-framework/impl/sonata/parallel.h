@@ -0,0 +1,68 @@
+/**
+ * @file parallel.h
+ * @brief Parallel processing of SONATA entities.
+ * @kaspersky_support Artiom N.
+ * @date 18.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace knp::framework::sonata
+{
+// Call a function for every task index on worker threads, the first exception is rethrown after workers stop.
+template <class Function>
+void run_in_parallel(size_t task_count, Function function)
+{
+    const size_t thread_count =
+        std::min<size_t>(task_count, std::max<size_t>(1, std::thread::hardware_concurrency()));
+    std::atomic<size_t> next_task{0};
+    std::exception_ptr error;
+    std::mutex error_mutex;
+
+    auto worker = [&]()
+    {
+        for (size_t task = next_task++; task < task_count; task = next_task++)
+        {
+            try
+            {
+                function(task);
+            }
+            catch (...)
+            {
+                const std::lock_guard lock{error_mutex};
+                if (!error) error = std::current_exception();
+                next_task = task_count;
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < thread_count; ++i) threads.emplace_back(worker);
+    worker();
+    for (auto &thread : threads) thread.join();
+    if (error) std::rethrow_exception(error);
+}
+
+}  // namespace knp::framework::sonata
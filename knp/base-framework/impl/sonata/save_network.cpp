@@ -29,12 +29,16 @@
 
 #include <spdlog/spdlog.h>
 
+#include <exception>
 #include <filesystem>
+#include <thread>
 
 #include <boost/format.hpp>
 
 #include "csv_content.h"
 #include "highfive.h"
+#include "load_network.h"
+#include "parallel.h"
 #include "types/type_id_defines.h"
 
 
@@ -43,6 +47,137 @@ namespace knp::framework::sonata
 namespace fs = std::filesystem;
 
 
+namespace
+{
+// Dataset creation property that enables an HDF5 filter plugin.
+class PluginFilter
+{
+public:
+    PluginFilter(unsigned filter_id, std::vector<unsigned> parameters)
+        : filter_id_(filter_id), parameters_(std::move(parameters))
+    {
+    }
+
+    void apply(hid_t list_id) const
+    {
+        if (H5Pset_filter(list_id, filter_id_, H5Z_FLAG_MANDATORY, parameters_.size(), parameters_.data()) < 0)
+        {
+            throw std::runtime_error("Could not set HDF5 filter " + std::to_string(filter_id_) + ".");
+        }
+    }
+
+private:
+    unsigned filter_id_;
+    std::vector<unsigned> parameters_;
+};
+}  // namespace
+
+
+FileWriter::FileWriter(const fs::path &path, SaveOptions options) : options_(std::move(options))
+{
+    const std::lock_guard lock{get_hdf5_mutex()};
+    file_.emplace(path.string(), HighFive::File::Create | HighFive::File::Overwrite);
+}
+
+
+FileWriter::~FileWriter()
+{
+    const std::lock_guard lock{get_hdf5_mutex()};
+    file_.reset();
+}
+
+
+GroupWriter FileWriter::get_root()
+{
+    return GroupWriter{*this, ""};
+}
+
+
+void FileWriter::push(std::function<void(HighFive::File &)> operation, size_t data_size)
+{
+    std::unique_lock lock{mutex_};
+    condition_.wait(lock, [this]() { return is_failed_ || queue_.empty() || queued_size_ < max_queued_size_; });
+    // Operations are dropped after a write error, the error is reported by `write()`.
+    if (is_failed_) return;
+    queue_.push_back(Operation{std::move(operation), data_size});
+    queued_size_ += data_size;
+    condition_.notify_all();
+}
+
+
+void FileWriter::write(size_t task_count, const std::function<void(size_t)> &serialize)
+{
+    std::exception_ptr serialization_error;
+    std::thread serialization_thread(
+        [this, task_count, &serialize, &serialization_error]()
+        {
+            try
+            {
+                run_in_parallel(task_count, serialize);
+            }
+            catch (...)
+            {
+                serialization_error = std::current_exception();
+            }
+            const std::lock_guard lock{mutex_};
+            is_serialized_ = true;
+            condition_.notify_all();
+        });
+
+    std::exception_ptr write_error;
+    try
+    {
+        while (true)
+        {
+            Operation operation{};
+            {
+                std::unique_lock lock{mutex_};
+                condition_.wait(lock, [this]() { return is_serialized_ || !queue_.empty(); });
+                if (queue_.empty()) break;
+                operation = std::move(queue_.front());
+                queue_.pop_front();
+            }
+            {
+                const std::lock_guard hdf5_lock{get_hdf5_mutex()};
+                operation.function_(*file_);
+            }
+            const std::lock_guard lock{mutex_};
+            queued_size_ -= operation.data_size_;
+            condition_.notify_all();
+        }
+    }
+    catch (...)
+    {
+        write_error = std::current_exception();
+        const std::lock_guard lock{mutex_};
+        is_failed_ = true;
+        queue_.clear();
+        queued_size_ = 0;
+        condition_.notify_all();
+    }
+
+    serialization_thread.join();
+    if (write_error) std::rethrow_exception(write_error);
+    if (serialization_error) std::rethrow_exception(serialization_error);
+}
+
+
+HighFive::DataSetCreateProps FileWriter::make_dataset_props(size_t size) const
+{
+    HighFive::DataSetCreateProps props;
+    const bool has_filters = options_.deflate_level_ || options_.shuffle_ || options_.filter_id_;
+    size_t chunk_size = options_.chunk_size_;
+    if (!chunk_size && has_filters) chunk_size = SaveOptions::default_chunk_size;
+    if (!chunk_size || !size) return props;
+
+    props.add(HighFive::Chunking(std::vector<hsize_t>{static_cast<hsize_t>(std::min(chunk_size, size))}));
+    if (options_.shuffle_) props.add(HighFive::Shuffle());
+    if (options_.deflate_level_) props.add(HighFive::Deflate(options_.deflate_level_));
+    if (options_.filter_id_) props.add(PluginFilter{options_.filter_id_, options_.filter_parameters_});
+    return props;
+}
+
+
 void write_base_config(const fs::path &config_dir, const fs::path &net_config_dir)
 {
     auto net_config_path = net_config_dir / "network_config.json";
@@ -144,6 +279,12 @@ void write_network_config(
 
 
 KNP_DECLSPEC void save_network(const Network &network, const fs::path &dir)
+{
+    save_network(network, dir, SaveOptions{});
+}
+
+
+KNP_DECLSPEC void save_network(const Network &network, const fs::path &dir, const SaveOptions &options)
 {
     auto net_dir = dir / "network";
     if (!is_directory(net_dir)) fs::create_directory(net_dir);
@@ -156,12 +297,10 @@ KNP_DECLSPEC void save_network(const Network &network, const fs::path &dir)
     fs::path path_to_projections(net_dir / projections_filename);
     fs::path path_to_synapse_csv(net_dir / synapse_type_filename);
 
-    HighFive::File h5_proj_file(path_to_projections.string(), HighFive::File::Create | HighFive::File::Overwrite);
-    h5_proj_file.createGroup("edges");
-
+    std::vector<const core::AllProjectionsVariant *> projections;
     for (auto iter = network.begin_projections(); iter != network.end_projections(); ++iter)
     {
-        std::visit([&h5_proj_file](const auto &projection) { add_projection_to_h5(h5_proj_file, projection); }, *iter);
+        projections.push_back(&*iter);
         std::visit(
             [&path_to_synapse_csv](const auto &projection) {
                 add_synapse_type_to_csv<typename std::decay_t<decltype(projection)>::ProjectionSynapseType>(
@@ -170,13 +309,25 @@ KNP_DECLSPEC void save_network(const Network &network, const fs::path &dir)
             *iter);
     }
 
+    {
+        FileWriter proj_writer{path_to_projections, options};
+        const auto edges_group = proj_writer.get_root().create_group("edges");
+        proj_writer.write(
+            projections.size(),
+            [&edges_group, &projections](size_t index)
+            {
+                std::visit(
+                    [&edges_group](const auto &projection) { add_projection_to_h5(edges_group, projection); },
+                    *projections[index]);
+            });
+    }
+
     fs::path path_to_populations(net_dir / populations_filename);
     fs::path path_to_neurons_csv(net_dir / neuron_type_filename);
-    HighFive::File h5_pop_file(path_to_populations.string(), HighFive::File::Create | HighFive::File::Overwrite);
-    h5_pop_file.createGroup("nodes");
+    std::vector<const core::AllPopulationsVariant *> populations;
     for (auto iter = network.begin_populations(); iter != network.end_populations(); ++iter)
     {
-        std::visit([&h5_pop_file](const auto &population) { add_population_to_h5(h5_pop_file, population); }, *iter);
+        populations.push_back(&*iter);
         std::visit(
             [&path_to_neurons_csv](const auto &population)
             {
@@ -185,7 +336,20 @@ KNP_DECLSPEC void save_network(const Network &network, const fs::path &dir)
             },
             *iter);
     }
-    h5_pop_file.createAttribute("network_uid", std::string{network.get_uid()});
+
+    {
+        FileWriter pop_writer{path_to_populations, options};
+        const auto nodes_group = pop_writer.get_root().create_group("nodes");
+        pop_writer.get_root().create_attribute("network_uid", std::string{network.get_uid()});
+        pop_writer.write(
+            populations.size(),
+            [&nodes_group, &populations](size_t index)
+            {
+                std::visit(
+                    [&nodes_group](const auto &population) { add_population_to_h5(nodes_group, population); },
+                    *populations[index]);
+            });
+    }
     // TODO: Move this inside add_population or add more neurons.
     add_neuron_type_to_csv<neuron_traits::BLIFATNeuron>(path_to_neurons_csv);
 
@@ -23,11 +23,18 @@
 
 #include <knp/core/population.h>
 #include <knp/core/projection.h>
+#include <knp/framework/sonata/network_io.h>
 
 #include <algorithm>
+#include <condition_variable>
+#include <deque>
 #include <filesystem>
+#include <functional>
+#include <mutex>
+#include <optional>
 #include <stdexcept>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "highfive.h"
@@ -37,15 +44,132 @@ namespace knp::framework::sonata
 {
 namespace fs = std::filesystem;
 
+class GroupWriter;
+
+
+// Writer of an HDF5 network file. Worker threads serialize entities and queue operations with the file, a single
+// thread performs queued operations in the order of queuing.
+class FileWriter
+{
+public:
+    FileWriter(const fs::path &path, SaveOptions options);
+    FileWriter(const FileWriter &) = delete;
+    FileWriter &operator=(const FileWriter &) = delete;
+    ~FileWriter();
+
+    GroupWriter get_root();
+
+    // Call the serialization function for every entity on worker threads and perform queued operations.
+    void write(size_t task_count, const std::function<void(size_t)> &serialize);
+
+    // Queue an operation, queuing is blocked while the size of queued data exceeds the limit.
+    void push(std::function<void(HighFive::File &)> operation, size_t data_size);
+
+    [[nodiscard]] HighFive::DataSetCreateProps make_dataset_props(size_t size) const;
+
+    [[nodiscard]] const SaveOptions &get_options() const { return options_; }
+
+private:
+    struct Operation
+    {
+        std::function<void(HighFive::File &)> function_;
+        size_t data_size_;
+    };
+
+    // Maximum size of data in queued operations.
+    static constexpr size_t max_queued_size_ = 1 << 28;
+
+    std::optional<HighFive::File> file_;
+    const SaveOptions options_;
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    std::deque<Operation> queue_;
+    size_t queued_size_ = 0;
+    bool is_serialized_ = false;
+    bool is_failed_ = false;
+};
+
+
+// Group of an HDF5 network file which objects are created by a file writer.
+class GroupWriter
+{
+public:
+    GroupWriter(FileWriter &writer, std::string path) : writer_(&writer), path_(std::move(path)) {}
+
+    [[nodiscard]] GroupWriter create_group(const std::string &name) const
+    {
+        GroupWriter result{*writer_, get_path(name)};
+        writer_->push([path = result.path_](HighFive::File &file) { file.createGroup(path); }, 0);
+        return result;
+    }
+
+    template <class Attr>
+    void create_dataset(const std::string &name, std::vector<Attr> data) const
+    {
+        const size_t data_size = data.size() * sizeof(Attr);
+        writer_->push(
+            [writer = writer_, path = get_path(name), data = std::move(data)](HighFive::File &file)
+            { file.createDataSet(path, data, writer->make_dataset_props(data.size())); },
+            data_size);
+    }
+
+    // Values that are the same for all elements are stored as a scalar attribute of the group if the save options
+    // allow it.
+    template <class Attr>
+    void write_parameter(const std::string &name, std::vector<Attr> data) const
+    {
+        if (writer_->get_options().collapse_uniform_parameters_ && !data.empty() &&
+            std::adjacent_find(data.begin(), data.end(), std::not_equal_to<>()) == data.end())
+        {
+            create_attribute(name, static_cast<Attr>(data.front()));
+            return;
+        }
+        create_dataset(name, std::move(data));
+    }
+
+    template <class Attr>
+    void create_attribute(const std::string &name, Attr value) const
+    {
+        writer_->push(
+            [path = path_, name, value = std::move(value)](HighFive::File &file)
+            {
+                if (path.empty())
+                    file.createAttribute(name, value);
+                else
+                    file.getGroup(path).createAttribute(name, value);
+            },
+            0);
+    }
+
+    template <class Attr>
+    void create_dataset_attribute(const std::string &dataset_name, const std::string &name, Attr value) const
+    {
+        writer_->push(
+            [path = get_path(dataset_name), name, value = std::move(value)](HighFive::File &file)
+            { file.getDataSet(path).createAttribute(name, value); },
+            0);
+    }
+
+private:
+    [[nodiscard]] std::string get_path(const std::string &name) const
+    {
+        return path_.empty() ? name : path_ + "/" + name;
+    }
+
+    FileWriter *writer_;
+    std::string path_;
+};
+
+
 template <class Projection>
-void add_projection_to_h5(HighFive::File &, const Projection &);
+void add_projection_to_h5(const GroupWriter &, const Projection &);
 
 
 template <class Population>
-void add_population_to_h5(HighFive::File &, const Population &);
+void add_population_to_h5(const GroupWriter &, const Population &);
 
 
-// Read parameter values for both projections and populations.
+// Read parameter values for both projections and populations. Parameters can be stored as scalar attributes.
 template <class Attr>
 std::vector<Attr> read_parameter(
     const HighFive::Group &population_group, const std::string &param_name, size_t pop_size, const Attr &default_value)
@@ -53,6 +177,10 @@ std::vector<Attr> read_parameter(
     std::vector<Attr> result(pop_size);
     try
     {
+        if (population_group.hasAttribute(param_name))
+        {
+            return std::vector<Attr>(pop_size, population_group.getAttribute(param_name).read<Attr>());
+        }
         auto dataset = population_group.getDataSet(param_name);
         dataset.read(result);
     }
@@ -73,5 +201,5 @@ std::vector<Attr> read_parameter(
         data.reserve(pop.size());                                                                               \
         std::transform(                                                                                         \
             pop.begin(), pop.end(), std::back_inserter(data), [](const auto &neuron) { return neuron.param; }); \
-        group.createDataSet(#param, data);                                                                      \
+        group.write_parameter(#param, std::move(data));                                                         \
     } while (false)
@@ -51,8 +51,7 @@ std::string get_synapse_type_name<AdditiveDeltaSynapse>()
 
 template <>
 void add_projection_to_h5<core::Projection<AdditiveDeltaSynapse>>(
-    // cppcheck-suppress constParameterReference
-    HighFive::File &file_h5, const knp::core::Projection<AdditiveDeltaSynapse> &projection)
+    const GroupWriter &edges_group, const knp::core::Projection<AdditiveDeltaSynapse> &projection)
 {
     throw std::runtime_error("AdditiveDeltaSynapse saving unimplemented.");
 }
@@ -45,8 +45,7 @@ std::string get_neuron_type_name<neuron_traits::AltAILIF>()
 
 template <>
 void add_population_to_h5<core::Population<knp::neuron_traits::AltAILIF>>(
-    // cppcheck-suppress constParameterReference
-    HighFive::File &file_h5, const core::Population<knp::neuron_traits::AltAILIF> &population)
+    const GroupWriter &nodes_group, const core::Population<knp::neuron_traits::AltAILIF> &population)
 {
     SPDLOG_TRACE("Adding population {} to HDF5...", std::string(population.get_uid()));
     throw std::runtime_error("AltAILIF neuron saving unimplemented.");
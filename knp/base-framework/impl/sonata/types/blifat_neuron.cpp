@@ -44,9 +44,9 @@ std::string get_neuron_type_name<neuron_traits::BLIFATNeuron>()
 }
 
 
-void save_static(const core::Population<knp::neuron_traits::BLIFATNeuron> &population, HighFive::Group &group)
+void save_static(const core::Population<knp::neuron_traits::BLIFATNeuron> &population, const GroupWriter &group)
 {
-    // TODO: Need to check if all parameters are the same. If not, save them into h5.
+    // Parameters that are the same for all neurons are saved as attributes.
     // Static.
     PUT_NEURON_TO_DATASET(population, n_time_steps_since_last_firing_, group);
     PUT_NEURON_TO_DATASET(population, activation_threshold_, group);
@@ -67,7 +67,7 @@ void save_static(const core::Population<knp::neuron_traits::BLIFATNeuron> &popul
 }
 
 
-void save_dynamic(const core::Population<knp::neuron_traits::BLIFATNeuron> &population, HighFive::Group &group)
+void save_dynamic(const core::Population<knp::neuron_traits::BLIFATNeuron> &population, const GroupWriter &group)
 {
     PUT_NEURON_TO_DATASET(population, dynamic_threshold_, group);
     PUT_NEURON_TO_DATASET(population, potential_, group);
@@ -80,33 +80,27 @@ void save_dynamic(const core::Population<knp::neuron_traits::BLIFATNeuron> &popu
 
 template <>
 void add_population_to_h5<core::Population<knp::neuron_traits::BLIFATNeuron>>(
-    HighFive::File &file_h5, const core::Population<knp::neuron_traits::BLIFATNeuron> &population)
+    const GroupWriter &nodes_group, const core::Population<knp::neuron_traits::BLIFATNeuron> &population)
 {
     SPDLOG_TRACE("Adding population {} to HDF5...", std::string(population.get_uid()));
 
-    // Check that an external function has created "nodes" group.
-    if (!file_h5.exist("nodes"))
-    {
-        throw std::runtime_error("File does not contain the \"nodes\" group.");
-    }
-
-    HighFive::Group population_group = file_h5.createGroup("nodes/" + std::string{population.get_uid()});
+    const auto population_group = nodes_group.create_group(std::string{population.get_uid()});
 
     std::vector<size_t> neuron_ids;
     // std::vector<int> neuron_type_ids(population.size(), get_neuron_type_id<neuron_traits::BLIFATNeuron>());
     neuron_ids.reserve(population.size());
     for (size_t i = 0; i < population.size(); ++i) neuron_ids.push_back(i);
 
-    population_group.createDataSet("node_id", neuron_ids);
-    population_group.createDataSet("node_group_index", neuron_ids);
-    population_group.createDataSet("node_group_id", std::vector<size_t>(population.size(), 0));
-    population_group.createDataSet(
+    population_group.create_dataset("node_id", neuron_ids);
+    population_group.create_dataset("node_group_index", std::move(neuron_ids));
+    population_group.create_dataset("node_group_id", std::vector<size_t>(population.size(), 0));
+    population_group.create_dataset(
         "node_type_id", std::vector<size_t>(population.size(), get_neuron_type_id<neuron_traits::BLIFATNeuron>()));
-    auto group0 = population_group.createGroup("0");
+    const auto group0 = population_group.create_group("0");
 
     save_static(population, group0);
 
-    auto dynamic_group0 = group0.createGroup("dynamics_params");
+    const auto dynamic_group0 = group0.create_group("dynamics_params");
     // Dynamic.
     save_dynamic(population, dynamic_group0);
 }
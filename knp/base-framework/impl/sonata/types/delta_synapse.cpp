@@ -24,7 +24,13 @@
 
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
 #include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include <boost/lexical_cast.hpp>
 #include <boost/uuid/uuid.hpp>
@@ -51,49 +57,72 @@ core::Projection<knp::synapse_traits::DeltaSynapse> load_projection(
     const HighFive::Group &edges_group, const std::string &projection_name)
 {
     SPDLOG_DEBUG("Loading edges for projection {}...", projection_name);
-    auto projection_group = edges_group.getGroup(projection_name);
-    auto group = projection_group.getGroup("0");
-    size_t group_size = edges_group.getGroup(projection_name).getDataSet("edge_group_id").getDimensions().at(0);
     using SynapseParams = core::Projection<synapse_traits::DeltaSynapse>::SynapseParameters;
     using Synapse = core::Projection<synapse_traits::DeltaSynapse>::Synapse;
+    using Defaults = synapse_traits::default_values<synapse_traits::DeltaSynapse>;
 
-    std::vector<Synapse> target(group_size);
-    const auto weights = read_parameter<decltype(SynapseParams::weight_)>(
-        group, "syn_weight", group_size, synapse_traits::default_values<synapse_traits::DeltaSynapse>::weight_);
-    const auto delays = read_parameter<decltype(SynapseParams::delay_)>(
-        group, "delay", group_size, synapse_traits::default_values<synapse_traits::DeltaSynapse>::delay_);
-    const auto out_types = read_parameter<int>(
-        group, "output_type_", group_size,
-        static_cast<size_t>(synapse_traits::default_values<synapse_traits::DeltaSynapse>::output_type_));
-    const auto source_ids = read_parameter<size_t>(projection_group, "source_node_id", group_size, 0);
-    const auto target_ids = read_parameter<size_t>(projection_group, "target_node_id", group_size, 0);
-
-    const core::UID uid_from{boost::lexical_cast<boost::uuids::uuid>(
-        projection_group.getDataSet("source_node_id").getAttribute("node_population").read<std::string>())};
-    const core::UID uid_to{boost::lexical_cast<boost::uuids::uuid>(
-        projection_group.getDataSet("target_node_id").getAttribute("node_population").read<std::string>())};
     const core::UID uid_own{boost::lexical_cast<boost::uuids::uuid>(projection_name)};
-
-
+    std::string uid_from, uid_to;
+    std::optional<bool> is_locked;
+    LoadingTimer timer;
     std::vector<Synapse> synapses;
-    synapses.reserve(group_size);
-    for (size_t i = 0; i < weights.size(); ++i)
     {
-        synapse_traits::synapse_parameters<synapse_traits::DeltaSynapse> syn;
-        syn.weight_ = weights[i];
-        syn.delay_ = delays[i];
-        syn.output_type_ = static_cast<synapse_traits::OutputType>(out_types[i]);
-        const size_t id_from = source_ids[i];
-        const size_t id_to = target_ids[i];
-        synapses.emplace_back(syn, id_from, id_to);
+        // The lock is declared before HighFive objects, so it is held while they are destroyed.
+        std::unique_lock lock{get_hdf5_mutex()};
+        timer.mark(timer.waiting_);
+        auto projection_group = edges_group.getGroup(projection_name);
+        auto group = projection_group.getGroup("0");
+        const size_t group_size = projection_group.getDataSet("edge_group_id").getDimensions().at(0);
+        uid_from = projection_group.getDataSet("source_node_id").getAttribute("node_population").read<std::string>();
+        uid_to = projection_group.getDataSet("target_node_id").getAttribute("node_population").read<std::string>();
+        if (projection_group.hasAttribute("is_locked"))
+        {
+            is_locked = projection_group.getAttribute("is_locked").read<bool>();
+        }
+
+        // Datasets are read by chunks directly to the final synapse storage.
+        synapses.resize(group_size);
+        std::vector<decltype(SynapseParams::weight_)> weights;
+        std::vector<decltype(SynapseParams::delay_)> delays;
+        std::vector<int> out_types;
+        std::vector<size_t> source_ids, target_ids;
+        for (size_t offset = 0; offset < group_size; offset += projection_read_chunk_size)
+        {
+            const size_t count = std::min(projection_read_chunk_size, group_size - offset);
+            read_parameter_chunk(group, "syn_weight", offset, count, Defaults::weight_, weights);
+            read_parameter_chunk(group, "delay", offset, count, Defaults::delay_, delays);
+            read_parameter_chunk(
+                group, "output_type_", offset, count, static_cast<int>(Defaults::output_type_), out_types);
+            read_parameter_chunk<size_t>(projection_group, "source_node_id", offset, count, 0, source_ids);
+            read_parameter_chunk<size_t>(projection_group, "target_node_id", offset, count, 0, target_ids);
+
+            // Other projections are read while the chunk is converted.
+            timer.mark(timer.reading_);
+            lock.unlock();
+            for (size_t i = 0; i < count; ++i)
+            {
+                auto &[syn, id_from, id_to] = synapses[offset + i];
+                syn.weight_ = weights[i];
+                syn.delay_ = delays[i];
+                syn.output_type_ = static_cast<synapse_traits::OutputType>(out_types[i]);
+                id_from = source_ids[i];
+                id_to = target_ids[i];
+            }
+            timer.mark(timer.converting_);
+            lock.lock();
+            timer.mark(timer.waiting_);
+        }
     }
+    timer.mark(timer.reading_);
+    timer.log(projection_name);
 
     core::Projection<synapse_traits::DeltaSynapse> proj(
-        uid_own, uid_from, uid_to, [&synapses](size_t syn_num) { return synapses[syn_num]; }, synapses.size());
+        uid_own, core::UID{boost::lexical_cast<boost::uuids::uuid>(uid_from)},
+        core::UID{boost::lexical_cast<boost::uuids::uuid>(uid_to)}, std::move(synapses));
 
-    if (projection_group.hasAttribute("is_locked"))
+    if (is_locked)
     {
-        if (projection_group.getAttribute("is_locked").read<bool>())
+        if (*is_locked)
         {
             proj.lock_weights();
         }
@@ -109,11 +138,18 @@ core::Projection<knp::synapse_traits::DeltaSynapse> load_projection(
 
 template <>
 void add_projection_to_h5<core::Projection<synapse_traits::DeltaSynapse>>(
-    HighFive::File &file_h5, const knp::core::Projection<synapse_traits::DeltaSynapse> &projection)
+    const GroupWriter &edges_group, const knp::core::Projection<synapse_traits::DeltaSynapse> &projection)
 {
     using SynapseParams = synapse_traits::synapse_parameters<synapse_traits::DeltaSynapse>;
 
-    if (!file_h5.exist("edges")) throw std::runtime_error("File does not contain the \"edges\" group.");
+    if (projection.is_compact())
+    {
+        // SONATA stores edges explicitly.
+        auto explicit_projection = projection;
+        explicit_projection.materialize();
+        add_projection_to_h5(edges_group, explicit_projection);
+        return;
+    }
 
     std::vector<uint64_t> source_ids, target_ids;
     std::vector<decltype(SynapseParams::delay_)> delays;
@@ -135,29 +171,32 @@ void add_projection_to_h5<core::Projection<synapse_traits::DeltaSynapse>>(
         out_types.push_back(static_cast<int>(std::get<knp::core::synapse_data>(v).output_type_));
     }
 
-    HighFive::Group proj_group = file_h5.createGroup("edges/" + std::string(projection.get_uid()));
-    HighFive::DataSet source_node_dataset = proj_group.createDataSet("source_node_id", source_ids);
-    source_node_dataset.createAttribute("node_population", std::string(projection.get_presynaptic()));
+    const auto proj_group = edges_group.create_group(std::string(projection.get_uid()));
+    proj_group.create_dataset("source_node_id", std::move(source_ids));
+    proj_group.create_dataset_attribute(
+        "source_node_id", "node_population", std::string(projection.get_presynaptic()));
 
-    HighFive::DataSet target_node_dataset = proj_group.createDataSet("target_node_id", target_ids);
-    target_node_dataset.createAttribute("node_population", std::string(projection.get_postsynaptic()));
+    proj_group.create_dataset("target_node_id", std::move(target_ids));
+    proj_group.create_dataset_attribute(
+        "target_node_id", "node_population", std::string(projection.get_postsynaptic()));
 
     // At the moment we support only one synapse group.
-    proj_group.createDataSet("edge_group_id", std::vector(projection.size(), 0));
-    proj_group.createDataSet(
+    proj_group.create_dataset("edge_group_id", std::vector(projection.size(), 0));
+    proj_group.create_dataset(
         "edge_type_id", std::vector(projection.size(), get_synapse_type_id<synapse_traits::DeltaSynapse>()));
 
     std::vector<uint64_t> group_index;
     group_index.reserve(projection.size());
     for (size_t i = 0; i < projection.size(); ++i) group_index.push_back(i);
 
-    proj_group.createDataSet("edge_group_index", group_index);
+    proj_group.create_dataset("edge_group_index", std::move(group_index));
 
-    HighFive::Group syn_group = proj_group.createGroup("0");
-    syn_group.createDataSet("syn_weight", weights);
-    syn_group.createDataSet("delay", delays);
-    syn_group.createDataSet("output_type_", out_types);
-    proj_group.createAttribute("is_locked", projection.is_locked());
+    // Parameters that are the same for all synapses are saved as attributes.
+    const auto syn_group = proj_group.create_group("0");
+    syn_group.write_parameter("syn_weight", std::move(weights));
+    syn_group.write_parameter("delay", std::move(delays));
+    syn_group.write_parameter("output_type_", std::move(out_types));
+    proj_group.create_attribute("is_locked", projection.is_locked());
 }
 
 }  // namespace knp::framework::sonata
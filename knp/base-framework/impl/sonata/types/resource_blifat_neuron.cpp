@@ -47,14 +47,13 @@ std::string get_neuron_type_name<neuron_traits::SynapticResourceSTDPBLIFATNeuron
 
 template <>
 void add_population_to_h5<core::Population<knp::neuron_traits::SynapticResourceSTDPBLIFATNeuron>>(
-    HighFive::File &file_h5, const core::Population<knp::neuron_traits::SynapticResourceSTDPBLIFATNeuron> &population)
+    const GroupWriter &nodes_group,
+    const core::Population<knp::neuron_traits::SynapticResourceSTDPBLIFATNeuron> &population)
 {
     // TODO: It would be better if such functions were generated automatically.
     SPDLOG_TRACE("Adding population {} to HDF5...", std::string(population.get_uid()));
 
-    if (!file_h5.exist("nodes")) throw std::runtime_error("File does not contain the \"nodes\" group.");
-
-    HighFive::Group population_group = file_h5.createGroup("nodes/" + std::string{population.get_uid()});
+    const auto population_group = nodes_group.create_group(std::string{population.get_uid()});
 
     std::vector<size_t> neuron_ids;
     // std::vector<int> neuron_type_ids(
@@ -64,15 +63,15 @@ void add_population_to_h5<core::Population<knp::neuron_traits::SynapticResourceS
 
     for (size_t i = 0; i < population.size(); ++i) neuron_ids.push_back(i);
 
-    population_group.createDataSet("node_id", neuron_ids);
-    population_group.createDataSet("node_group_index", neuron_ids);
-    population_group.createDataSet("node_group_id", std::vector<size_t>(population.size(), 0));
-    population_group.createDataSet(
+    population_group.create_dataset("node_id", neuron_ids);
+    population_group.create_dataset("node_group_index", std::move(neuron_ids));
+    population_group.create_dataset("node_group_id", std::vector<size_t>(population.size(), 0));
+    population_group.create_dataset(
         "node_type_id",
         std::vector<size_t>(population.size(), get_neuron_type_id<neuron_traits::SynapticResourceSTDPBLIFATNeuron>()));
-    auto group0 = population_group.createGroup("0");
+    const auto group0 = population_group.create_group("0");
 
-    // TODO: Need to check if all parameters are the same. If not, then save them into h5.
+    // Parameters that are the same for all neurons are saved as attributes.
     // Static parameters, they don't change during inference.
     PUT_NEURON_TO_DATASET(population, n_time_steps_since_last_firing_, group0);
     PUT_NEURON_TO_DATASET(population, activation_threshold_, group0);
@@ -110,12 +109,12 @@ void add_population_to_h5<core::Population<knp::neuron_traits::SynapticResourceS
         std::transform(
             population.begin(), population.end(), std::back_inserter(data),
             [](const auto &neuron) { return static_cast<int>(neuron.isi_status_); });
-        group0.createDataSet("isi_status_", data);
+        group0.write_parameter("isi_status_", std::move(data));
     }
 
     // Dynamic parameters.
     // They describe the current neuron state. They can change at inference.
-    auto dynamic_group0 = group0.createGroup("dynamics_params");
+    const auto dynamic_group0 = group0.create_group("dynamics_params");
     PUT_NEURON_TO_DATASET(population, dynamic_threshold_, dynamic_group0);
     PUT_NEURON_TO_DATASET(population, potential_, dynamic_group0);
     PUT_NEURON_TO_DATASET(population, pre_impact_potential_, dynamic_group0);
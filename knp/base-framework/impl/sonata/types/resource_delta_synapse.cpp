@@ -23,7 +23,14 @@
 #include <knp/synapse-traits/delta.h>
 #include <knp/synapse-traits/stdp_synaptic_resource_rule.h>
 
+#include <algorithm>
 #include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #include <boost/format.hpp>
 #include <boost/lexical_cast.hpp>
@@ -56,28 +63,24 @@ std::string get_synapse_type_name<ResourceDeltaSynapse>()
         std::transform(                                                            \
             proj.begin(), proj.end(), std::back_inserter(data),                    \
             [](const auto &synapse) { return std::get<0>(synapse).rule_.param; }); \
-        group.createDataSet(std::string("rule_") + #param, data);                  \
+        group.write_parameter(std::string("rule_") + #param, std::move(data));     \
     }                                                                              \
     static_assert(true, "")
 
 
-#define READ_SYNAPSE_RULE_PARAMETER(target, parameter, h5_group, proj_size, def_value)                         \
-    {                                                                                                          \
-        const auto values = read_parameter(h5_group, std::string("rule_") + #parameter, proj_size, def_value); \
-        for (size_t i = 0; i < target.size(); ++i) std::get<0>(target[i]).rule_.parameter = values[i];         \
-    }                                                                                                          \
+#define READ_SYNAPSE_RULE_PARAMETER(target, parameter, h5_group, offset, count, def_value)                   \
+    {                                                                                                        \
+        std::vector<std::decay_t<decltype(def_value)>> values;                                               \
+        read_parameter_chunk(h5_group, std::string("rule_") + #parameter, offset, count, def_value, values); \
+        for (size_t i = 0; i < count; ++i) std::get<0>(target[offset + i]).rule_.parameter = values[i];      \
+    }                                                                                                        \
     static_assert(true, "")
 
 
 template <>
 void add_projection_to_h5<core::Projection<ResourceDeltaSynapse>>(
-    HighFive::File &file_h5, const knp::core::Projection<ResourceDeltaSynapse> &projection)
+    const GroupWriter &edges_group, const knp::core::Projection<ResourceDeltaSynapse> &projection)
 {
-    if (!file_h5.exist("edges"))
-    {
-        throw std::runtime_error("File does not contain the \"edges\" group.");
-    }
-
     std::vector<uint64_t> source_ids, target_ids;
     std::vector<decltype(synapse_traits::synapse_parameters<ResourceDeltaSynapse>::delay_)> delays;
     std::vector<decltype(synapse_traits::synapse_parameters<ResourceDeltaSynapse>::weight_)> weights;
@@ -98,24 +101,27 @@ void add_projection_to_h5<core::Projection<ResourceDeltaSynapse>>(
         out_types.push_back(static_cast<int>(std::get<knp::core::synapse_data>(v).output_type_));
     }
 
-    HighFive::Group proj_group = file_h5.createGroup("edges/" + std::string(projection.get_uid()));
-    HighFive::DataSet source_node_dataset = proj_group.createDataSet("source_node_id", source_ids);
-    source_node_dataset.createAttribute("node_population", std::string(projection.get_presynaptic()));
+    const auto proj_group = edges_group.create_group(std::string(projection.get_uid()));
+    proj_group.create_dataset("source_node_id", std::move(source_ids));
+    proj_group.create_dataset_attribute(
+        "source_node_id", "node_population", std::string(projection.get_presynaptic()));
 
-    HighFive::DataSet target_node_dataset = proj_group.createDataSet("target_node_id", target_ids);
-    target_node_dataset.createAttribute("node_population", std::string(projection.get_postsynaptic()));
+    proj_group.create_dataset("target_node_id", std::move(target_ids));
+    proj_group.create_dataset_attribute(
+        "target_node_id", "node_population", std::string(projection.get_postsynaptic()));
 
-    proj_group.createDataSet("edge_group_id", std::vector(projection.size(), 0));
-    proj_group.createDataSet(
+    proj_group.create_dataset("edge_group_id", std::vector(projection.size(), 0));
+    proj_group.create_dataset(
         "edge_type_id", std::vector(projection.size(), get_synapse_type_id<ResourceDeltaSynapse>()));
 
     std::vector<uint64_t> group_index;
     group_index.reserve(projection.size());
     for (size_t i = 0; i < projection.size(); ++i) group_index.push_back(i);
 
-    proj_group.createDataSet("edge_group_index", group_index);
+    proj_group.create_dataset("edge_group_index", std::move(group_index));
 
-    HighFive::Group syn_group = proj_group.createGroup("0");
+    // Parameters that are the same for all synapses are saved as attributes.
+    const auto syn_group = proj_group.create_group("0");
     PUT_SYNAPSE_RULE_TO_DATASET(projection, d_u_, syn_group);
     PUT_SYNAPSE_RULE_TO_DATASET(projection, had_hebbian_update_, syn_group);
     PUT_SYNAPSE_RULE_TO_DATASET(projection, synaptic_resource_, syn_group);
@@ -123,11 +129,11 @@ void add_projection_to_h5<core::Projection<ResourceDeltaSynapse>>(
     PUT_SYNAPSE_RULE_TO_DATASET(projection, dopamine_plasticity_period_, syn_group);
     PUT_SYNAPSE_RULE_TO_DATASET(projection, w_max_, syn_group);
     PUT_SYNAPSE_RULE_TO_DATASET(projection, w_min_, syn_group);
-    proj_group.createAttribute("is_locked", projection.is_locked());
+    proj_group.create_attribute("is_locked", projection.is_locked());
 
-    syn_group.createDataSet("syn_weight", weights);
-    syn_group.createDataSet("delay", delays);
-    syn_group.createDataSet("output_type_", out_types);
+    syn_group.write_parameter("syn_weight", std::move(weights));
+    syn_group.write_parameter("delay", std::move(delays));
+    syn_group.write_parameter("output_type_", std::move(out_types));
 }
 
 
@@ -135,59 +141,84 @@ template <>
 core::Projection<ResourceDeltaSynapse> load_projection(
     const HighFive::Group &edges_group, const std::string &projection_name)
 {
-    auto projection_group = edges_group.getGroup(projection_name);
-    auto group = projection_group.getGroup("0");
-    size_t group_size = edges_group.getGroup(projection_name).getDataSet("edge_group_id").getDimensions().at(0);
-
-    // std::vector<core::Projection<ResourceDeltaSynapse>::Synapse> target(group_size);
-
-    const auto weights = read_parameter<decltype(synapse_traits::synapse_parameters<ResourceDeltaSynapse>::weight_)>(
-        group, "syn_weight", group_size, synapse_traits::default_values<synapse_traits::DeltaSynapse>::weight_);
+    using SynapseParams = synapse_traits::synapse_parameters<ResourceDeltaSynapse>;
+    using Defaults = synapse_traits::default_values<synapse_traits::DeltaSynapse>;
+    static const SynapseParams def_params;
 
-    const auto delays = read_parameter<decltype(synapse_traits::synapse_parameters<ResourceDeltaSynapse>::delay_)>(
-        group, "delay", group_size, synapse_traits::default_values<synapse_traits::DeltaSynapse>::delay_);
-
-    const auto out_types = read_parameter<int>(
-        group, "output_type_", group_size,
-        static_cast<int>(synapse_traits::default_values<synapse_traits::DeltaSynapse>::output_type_));
-
-    const auto source_ids = read_parameter<size_t>(projection_group, "source_node_id", group_size, 0);
-    const auto target_ids = read_parameter<size_t>(projection_group, "target_node_id", group_size, 0);
-
-    const core::UID uid_from{boost::lexical_cast<boost::uuids::uuid>(
-        projection_group.getDataSet("source_node_id").getAttribute("node_population").read<std::string>())};
-    const core::UID uid_to{boost::lexical_cast<boost::uuids::uuid>(
-        projection_group.getDataSet("target_node_id").getAttribute("node_population").read<std::string>())};
     const core::UID uid_own{boost::lexical_cast<boost::uuids::uuid>(projection_name)};
-
-    std::vector<std::tuple<synapse_traits::synapse_parameters<ResourceDeltaSynapse>, size_t, size_t>> synapses;
-    synapses.reserve(group_size);
-
-    for (size_t i = 0; i < weights.size(); ++i)
+    std::string uid_from, uid_to;
+    std::optional<bool> is_locked;
+    LoadingTimer timer;
+    std::vector<core::Projection<ResourceDeltaSynapse>::Synapse> synapses;
     {
-        synapse_traits::synapse_parameters<ResourceDeltaSynapse> syn;
-        syn.weight_ = weights[i];
-        syn.delay_ = delays[i];
-        syn.output_type_ = static_cast<synapse_traits::OutputType>(out_types[i]);
-        synapses.emplace_back(syn, source_ids[i], target_ids[i]);
-    }
-    static const synapse_traits::synapse_parameters<synapse_traits::SynapticResourceSTDPDeltaSynapse> def_params;
-
-    READ_SYNAPSE_RULE_PARAMETER(synapses, d_u_, group, group_size, def_params.rule_.d_u_);
-    READ_SYNAPSE_RULE_PARAMETER(synapses, had_hebbian_update_, group, group_size, def_params.rule_.had_hebbian_update_);
-    READ_SYNAPSE_RULE_PARAMETER(synapses, synaptic_resource_, group, group_size, def_params.rule_.synaptic_resource_);
-    READ_SYNAPSE_RULE_PARAMETER(synapses, last_spike_step_, group, group_size, def_params.rule_.last_spike_step_);
-    READ_SYNAPSE_RULE_PARAMETER(
-        synapses, dopamine_plasticity_period_, group, group_size, def_params.rule_.dopamine_plasticity_period_);
-    READ_SYNAPSE_RULE_PARAMETER(synapses, w_max_, group, group_size, def_params.rule_.w_max_);
-    READ_SYNAPSE_RULE_PARAMETER(synapses, w_min_, group, group_size, def_params.rule_.w_min_);
+        // The lock is declared before HighFive objects, so it is held while they are destroyed.
+        std::unique_lock lock{get_hdf5_mutex()};
+        timer.mark(timer.waiting_);
+        auto projection_group = edges_group.getGroup(projection_name);
+        auto group = projection_group.getGroup("0");
+        const size_t group_size = projection_group.getDataSet("edge_group_id").getDimensions().at(0);
+        uid_from = projection_group.getDataSet("source_node_id").getAttribute("node_population").read<std::string>();
+        uid_to = projection_group.getDataSet("target_node_id").getAttribute("node_population").read<std::string>();
+        if (projection_group.hasAttribute("is_locked"))
+        {
+            is_locked = projection_group.getAttribute("is_locked").read<bool>();
+        }
 
+        // Datasets are read by chunks directly to the final synapse storage.
+        synapses.resize(group_size);
+        std::vector<decltype(SynapseParams::weight_)> weights;
+        std::vector<decltype(SynapseParams::delay_)> delays;
+        std::vector<int> out_types;
+        std::vector<size_t> source_ids, target_ids;
+        for (size_t offset = 0; offset < group_size; offset += projection_read_chunk_size)
+        {
+            const size_t count = std::min(projection_read_chunk_size, group_size - offset);
+            read_parameter_chunk(group, "syn_weight", offset, count, Defaults::weight_, weights);
+            read_parameter_chunk(group, "delay", offset, count, Defaults::delay_, delays);
+            read_parameter_chunk(
+                group, "output_type_", offset, count, static_cast<int>(Defaults::output_type_), out_types);
+            read_parameter_chunk<size_t>(projection_group, "source_node_id", offset, count, 0, source_ids);
+            read_parameter_chunk<size_t>(projection_group, "target_node_id", offset, count, 0, target_ids);
+
+            READ_SYNAPSE_RULE_PARAMETER(synapses, d_u_, group, offset, count, def_params.rule_.d_u_);
+            READ_SYNAPSE_RULE_PARAMETER(
+                synapses, had_hebbian_update_, group, offset, count, def_params.rule_.had_hebbian_update_);
+            READ_SYNAPSE_RULE_PARAMETER(
+                synapses, synaptic_resource_, group, offset, count, def_params.rule_.synaptic_resource_);
+            READ_SYNAPSE_RULE_PARAMETER(
+                synapses, last_spike_step_, group, offset, count, def_params.rule_.last_spike_step_);
+            READ_SYNAPSE_RULE_PARAMETER(
+                synapses, dopamine_plasticity_period_, group, offset, count,
+                def_params.rule_.dopamine_plasticity_period_);
+            READ_SYNAPSE_RULE_PARAMETER(synapses, w_max_, group, offset, count, def_params.rule_.w_max_);
+            READ_SYNAPSE_RULE_PARAMETER(synapses, w_min_, group, offset, count, def_params.rule_.w_min_);
+
+            // Other projections are read while the chunk is converted.
+            timer.mark(timer.reading_);
+            lock.unlock();
+            for (size_t i = 0; i < count; ++i)
+            {
+                auto &[syn, id_from, id_to] = synapses[offset + i];
+                syn.weight_ = weights[i];
+                syn.delay_ = delays[i];
+                syn.output_type_ = static_cast<synapse_traits::OutputType>(out_types[i]);
+                id_from = source_ids[i];
+                id_to = target_ids[i];
+            }
+            timer.mark(timer.converting_);
+            lock.lock();
+            timer.mark(timer.waiting_);
+        }
+    }
+    timer.mark(timer.reading_);
+    timer.log(projection_name);
 
     core::Projection<ResourceDeltaSynapse> proj(
-        uid_own, uid_from, uid_to, [&synapses](size_t index) { return synapses[index]; }, synapses.size());
-    if (projection_group.hasAttribute("is_locked"))
+        uid_own, core::UID{boost::lexical_cast<boost::uuids::uuid>(uid_from)},
+        core::UID{boost::lexical_cast<boost::uuids::uuid>(uid_to)}, std::move(synapses));
+    if (is_locked)
     {
-        if (projection_group.getAttribute("is_locked").read<bool>())
+        if (*is_locked)
         {
             proj.lock_weights();
         }
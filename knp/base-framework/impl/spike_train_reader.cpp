@@ -0,0 +1,123 @@
+/**
+ * @file spike_train_reader.cpp
+ * @brief Reader of spikes from memory-mapped binary spike train files.
+ * @kaspersky_support Artiom N.
+ * @date 18.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <knp/framework/io/in_converters/spike_train_reader.h>
+
+#include <spdlog/spdlog.h>
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include "storage/native/data_storage_common.h"
+
+
+namespace knp::framework::io::input
+{
+namespace bip = boost::interprocess;
+
+
+struct SpikeTrainReader::MappedFile
+{
+    bip::file_mapping mapping_;
+    bip::mapped_region region_;
+};
+
+
+SpikeTrainReader::SpikeTrainReader(const std::filesystem::path &path, bool loop) : loop_(loop)
+{
+    SPDLOG_DEBUG("Mapping spike train file \"{}\"...", path.string());
+    if (!std::filesystem::is_regular_file(path))
+    {
+        throw std::runtime_error("Spike train file \"" + path.string() + "\" doesn't exist.");
+    }
+
+    auto file = std::make_shared<MappedFile>();
+    try
+    {
+        file->mapping_ = bip::file_mapping(path.string().c_str(), bip::read_only);
+        file->region_ = bip::mapped_region(file->mapping_, bip::read_only);
+    }
+    catch (const bip::interprocess_exception &e)
+    {
+        throw std::runtime_error("Can't map spike train file \"" + path.string() + "\": " + e.what());
+    }
+    // Steps are read one after another, the system reads next pages in advance.
+    file->region_.advise(bip::mapped_region::advice_sequential);
+
+    const auto *data = static_cast<const char *>(file->region_.get_address());
+    const size_t file_size = file->region_.get_size();
+    const storage::native::SpikeTrainHeader expected_header;
+    storage::native::SpikeTrainHeader header;
+    if (file_size < sizeof(header)) throw std::runtime_error("File \"" + path.string() + "\" is too small.");
+    std::memcpy(&header, data, sizeof(header));
+
+    if (header.magic_ != expected_header.magic_)
+        throw std::runtime_error("File \"" + path.string() + "\" is not a spike train file.");
+    if (header.byte_order_mark_ != expected_header.byte_order_mark_)
+        throw std::runtime_error("Spike train file \"" + path.string() + "\" has a different byte order.");
+    if (header.version_ != expected_header.version_)
+        throw std::runtime_error("Unsupported spike train file version " + std::to_string(header.version_) + ".");
+
+    // Counts are compared with the file size by division, so huge counts from a broken header can't overflow.
+    const size_t body_size = file_size - sizeof(header);
+    if (header.steps_count_ >= body_size / sizeof(uint64_t))
+        throw std::runtime_error("Spike train file \"" + path.string() + "\" has a wrong size.");
+    const size_t offsets_size = (header.steps_count_ + 1) * sizeof(uint64_t);
+    const size_t spikes_size = body_size - offsets_size;
+    if (spikes_size % sizeof(core::messaging::SpikeIndex) ||
+        header.spikes_count_ != spikes_size / sizeof(core::messaging::SpikeIndex))
+        throw std::runtime_error("Spike train file \"" + path.string() + "\" has a wrong size.");
+
+    offsets_ = reinterpret_cast<const uint64_t *>(data + sizeof(header));
+    spikes_ = reinterpret_cast<const core::messaging::SpikeIndex *>(data + sizeof(header) + offsets_size);
+    if (offsets_[header.steps_count_] != header.spikes_count_)
+        throw std::runtime_error("Spike train file \"" + path.string() + "\" has wrong offsets.");
+
+    steps_count_ = header.steps_count_;
+    file_ = std::move(file);
+    SPDLOG_DEBUG("Spike train file mapped: {} steps, {} spikes.", steps_count_, header.spikes_count_);
+}
+
+
+SpikeTrainReader::SpikeRange SpikeTrainReader::get_spikes(core::Step step) const
+{
+    if (loop_ && steps_count_ > 0) step %= steps_count_;
+    if (step >= steps_count_) return {spikes_, spikes_};
+
+    const uint64_t begin = offsets_[step];
+    const uint64_t end = offsets_[step + 1];
+    if (begin > end || end > offsets_[steps_count_])
+        throw std::runtime_error("Wrong offsets of step " + std::to_string(step) + " in spike train file.");
+    return {spikes_ + begin, spikes_ + end};
+}
+
+
+core::messaging::SpikeData SpikeTrainReader::operator()(core::Step step) const
+{
+    const auto [begin, end] = get_spikes(step);
+    return core::messaging::SpikeData(begin, end);
+}
+
+}  // namespace knp::framework::io::input
@@ -0,0 +1,113 @@
+/**
+ * @file data_storage_binary.cpp
+ * @brief Save and load spike messages in the binary spike train format.
+ * @kaspersky_support Artiom N.
+ * @date 18.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <knp/framework/io/in_converters/spike_train_reader.h>
+#include <knp/framework/io/storage/native/data_storage_binary.h>
+#include <knp/framework/io/storage/native/data_storage_hdf5.h>
+#include <knp/framework/io/storage/native/data_storage_json.h>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+#include "data_storage_common.h"
+
+
+namespace knp::framework::io::storage::native
+{
+namespace fs = std::filesystem;
+
+
+void save_messages_to_binary(std::vector<core::messaging::SpikeMessage> messages, const fs::path &path_to_save)
+{
+    SPDLOG_DEBUG("Saving {} messages to spike train file \"{}\"...", messages.size(), path_to_save.string());
+    std::stable_sort(
+        messages.begin(), messages.end(),
+        [](const auto &msg1, const auto &msg2) { return msg1.header_.send_time_ < msg2.header_.send_time_; });
+
+    SpikeTrainHeader header;
+    header.steps_count_ = messages.empty() ? 0 : messages.back().header_.send_time_ + 1;
+    std::vector<uint64_t> offsets;
+    offsets.reserve(header.steps_count_ + 1);
+    std::vector<core::messaging::SpikeIndex> spikes;
+
+    auto message_iter = messages.begin();
+    for (uint64_t step = 0; step < header.steps_count_; ++step)
+    {
+        offsets.push_back(spikes.size());
+        for (; message_iter != messages.end() && message_iter->header_.send_time_ == step; ++message_iter)
+        {
+            spikes.insert(spikes.end(), message_iter->neuron_indexes_.begin(), message_iter->neuron_indexes_.end());
+        }
+    }
+    offsets.push_back(spikes.size());
+    header.spikes_count_ = spikes.size();
+
+    std::ofstream out_stream(path_to_save, std::ios::binary | std::ios::trunc);
+    if (!out_stream) throw std::runtime_error("Can't open file \"" + path_to_save.string() + "\" for writing.");
+    out_stream.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    out_stream.write(reinterpret_cast<const char *>(offsets.data()), offsets.size() * sizeof(uint64_t));
+    out_stream.write(
+        reinterpret_cast<const char *>(spikes.data()), spikes.size() * sizeof(core::messaging::SpikeIndex));
+    if (!out_stream) throw std::runtime_error("Can't write file \"" + path_to_save.string() + "\".");
+}
+
+
+std::vector<core::messaging::SpikeMessage> load_messages_from_binary(
+    const fs::path &path_to_binary, const knp::core::UID &uid)
+{
+    const io::input::SpikeTrainReader reader{path_to_binary};
+    std::vector<core::messaging::SpikeMessage> result;
+    for (core::Step step = 0; step < reader.get_steps_count(); ++step)
+    {
+        const auto [begin, end] = reader.get_spikes(step);
+        if (begin == end) continue;
+        result.push_back(core::messaging::SpikeMessage{{uid, step}, core::messaging::SpikeData(begin, end)});
+    }
+    return result;
+}
+
+
+void convert_messages_to_binary(const fs::path &input_path, const fs::path &output_path, float time_per_step)
+{
+    SPDLOG_INFO("Converting \"{}\" to spike train file \"{}\"...", input_path.string(), output_path.string());
+    // Sender UID isn't saved to the binary file.
+    const knp::core::UID uid{false};
+    const auto extension = input_path.extension();
+    if (".h5" == extension)
+    {
+        save_messages_to_binary(load_messages_from_h5(input_path, uid, time_per_step), output_path);
+    }
+    else if (".json" == extension)
+    {
+        save_messages_to_binary(load_messages_from_json(input_path, uid), output_path);
+    }
+    else
+    {
+        throw std::runtime_error("Unsupported spike file format \"" + extension.string() + "\".");
+    }
+}
+
+}  // namespace knp::framework::io::storage::native
@@ -22,6 +22,7 @@
 #include <knp/core/messaging/messaging.h>
 
 #include <array>
+#include <cstdint>
 #include <vector>
 
 
@@ -31,6 +32,20 @@ constexpr int MAGIC_NUMBER = 2682;
 constexpr std::array<int64_t, 2> VERSION{0, 1};
 
 
+// Header of a binary spike train file. The header is followed by `steps_count_ + 1` offsets of step spikes
+// as `uint64_t` values and `spikes_count_` spiked neuron indexes as `uint32_t` values. Spikes of step `s` are
+// placed between offsets `s` and `s + 1`.
+struct SpikeTrainHeader
+{
+    std::array<char, 8> magic_{'K', 'N', 'P', 'S', 'P', 'I', 'K', 'E'};
+    uint32_t version_ = 1;
+    // Used to detect files written on a machine with a different byte order.
+    uint32_t byte_order_mark_ = 0x01020304;
+    uint64_t steps_count_ = 0;
+    uint64_t spikes_count_ = 0;
+};
+
+
 std::vector<knp::core::messaging::SpikeMessage> convert_node_time_arrays_to_messages(
     const std::vector<int64_t> &nodes, const std::vector<float> &timestamps, const knp::core::UID &uid,
     float time_per_step);
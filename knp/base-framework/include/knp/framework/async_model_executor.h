@@ -0,0 +1,248 @@
+/**
+ * @file async_model_executor.h
+ * @brief Executor that runs a model in its own thread.
+ * @kaspersky_support Artiom N.
+ * @date 18.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <knp/core/impexp.h>
+#include <knp/framework/io/async_channels.h>
+#include <knp/framework/model.h>
+#include <knp/framework/model_executor.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+
+/**
+ * @brief Framework namespace.
+ */
+namespace knp::framework
+{
+/**
+ * @brief Step pacing statistics.
+ */
+struct PacingStatistics
+{
+    /**
+     * @brief Number of executed steps.
+     */
+    uint64_t steps_ = 0;
+
+    /**
+     * @brief Number of steps that started later than planned.
+     */
+    uint64_t overruns_ = 0;
+
+    /**
+     * @brief Maximum delay of a step start.
+     */
+    std::chrono::nanoseconds max_overrun_{0};
+
+    /**
+     * @brief Sum of step start delays.
+     */
+    std::chrono::nanoseconds total_overrun_{0};
+
+    /**
+     * @brief Number of spike vectors pushed for steps that had already started. They are sent at the next step.
+     */
+    uint64_t late_inputs_ = 0;
+};
+
+
+/**
+ * @brief The AsyncModelExecutor class is a definition of an executor that runs the model in its own thread.
+ * @details Other threads push spikes to the model input channels and read spikes of the model output channels
+ * while the model runs, without waiting for step boundaries. Spikes pushed for a step are sent to the network
+ * at that step. Output spikes are written to ring buffers that every reader reads at its own pace.
+ * Execution can be paused, resumed and advanced by a given number of steps, and steps can be paced to a wall-clock
+ * period.
+ */
+class KNP_DECLSPEC AsyncModelExecutor
+{
+public:
+    /**
+     * @brief AsyncModelExecutor constructor.
+     * @param model model to run.
+     * @param backend pointer to backend on which you want to run the model.
+     * @param input_capacity number of spike vectors that every input queue keeps.
+     * @param output_capacity number of messages that every output ring keeps.
+     */
+    AsyncModelExecutor(
+        knp::framework::Model &model, std::shared_ptr<core::Backend> backend, size_t input_capacity = 1024,
+        size_t output_capacity = 1024);
+
+    /**
+     * @brief AsyncModelExecutor destructor.
+     * @details The destructor stops model execution.
+     */
+    ~AsyncModelExecutor();
+
+public:
+    /**
+     * @brief Start model execution in the executor thread.
+     * @param paused if `true`, the executor waits for `resume()` or `step_n()` before the first step.
+     * @throw std::logic_error if the model is already running.
+     */
+    void start(bool paused = false);
+
+    /**
+     * @brief Stop model execution and wait for the executor thread.
+     * @throw any exception thrown during model execution.
+     */
+    void stop();
+
+    /**
+     * @brief Pause model execution after the current step.
+     * @details The method returns when the executor is paused.
+     */
+    void pause();
+
+    /**
+     * @brief Resume paused model execution.
+     */
+    void resume();
+
+    /**
+     * @brief Execute a number of steps and pause again.
+     * @details The method returns when all steps are executed and their output spikes are written to output rings.
+     * @param steps_count number of steps to execute.
+     * @throw std::logic_error if the executor isn't paused.
+     */
+    void step_n(size_t steps_count);
+
+    /**
+     * @brief Check if model execution is paused.
+     * @return `true` if the executor is paused.
+     */
+    [[nodiscard]] bool is_paused() const;
+
+public:
+    /**
+     * @brief Push spikes to an input channel.
+     * @details The method can be called from any thread. Spikes pushed for a step that has already started are sent
+     * at the next step, such pushes are logged and counted in pacing statistics.
+     * @param channel_uid input channel UID.
+     * @param step step at which the spikes are sent to the network.
+     * @param spikes spiked neuron indexes.
+     * @return `false` if the channel input queue is full and spikes weren't pushed.
+     * @throw std::runtime_error if there is no input channel with a given UID.
+     */
+    bool push_spikes(const core::UID &channel_uid, core::Step step, core::messaging::SpikeData spikes);
+
+    /**
+     * @brief Push spikes to an input channel for the next step.
+     * @param channel_uid input channel UID.
+     * @param spikes spiked neuron indexes.
+     * @return `false` if the channel input queue is full and spikes weren't pushed.
+     * @throw std::runtime_error if there is no input channel with a given UID.
+     */
+    bool push_spikes(const core::UID &channel_uid, core::messaging::SpikeData spikes)
+    {
+        return push_spikes(channel_uid, next_step_, std::move(spikes));
+    }
+
+    /**
+     * @brief Create a reader of output channel spikes.
+     * @details The method can be called from any thread. The reader reads messages sent after the call.
+     * @param channel_uid output channel UID.
+     * @return output ring reader.
+     * @throw std::runtime_error if there is no output channel with a given UID.
+     */
+    [[nodiscard]] io::SpikeOutputRing::Reader create_output_reader(const core::UID &channel_uid) const;
+
+public:
+    /**
+     * @brief Set wall-clock period of a step.
+     * @details If a step starts later than planned, the delay is counted as an overrun and the following steps
+     * are planned from the actual start time. Pacing restarts after a pause.
+     * @param period step period. Zero period disables pacing.
+     */
+    void set_step_period(std::chrono::nanoseconds period) { step_period_ = period.count(); }
+
+    /**
+     * @brief Get step pacing statistics.
+     * @return pacing statistics.
+     */
+    [[nodiscard]] PacingStatistics get_pacing_statistics() const;
+
+    /**
+     * @brief Get executor that runs the model.
+     * @details Use the executor to add observers and message handlers before model execution starts. Observers and
+     * handlers run in the executor thread.
+     * @return reference to `ModelExecutor` object.
+     */
+    ModelExecutor &get_executor() { return executor_; }
+
+    /**
+     * @brief Get pointer to backend object.
+     * @return shared pointer to `Backend` object.
+     */
+    std::shared_ptr<core::Backend> get_backend() { return executor_.get_backend(); }
+
+private:
+    class InputState;
+
+    // Step of spikes pushed for the next step, they are never late.
+    static constexpr core::Step next_step_ = std::numeric_limits<core::Step>::max();
+
+    static ModelLoader::BulkInputMap create_inputs(
+        const knp::framework::Model &model, size_t input_capacity,
+        std::unordered_map<core::UID, std::shared_ptr<InputState>, core::uid_hash> &inputs);
+    void create_outputs(const knp::framework::Model &model, size_t output_capacity);
+    void run();
+    bool wait_for_step();
+    void pace_step();
+    void write_outputs(core::Step step);
+
+    std::unordered_map<core::UID, std::shared_ptr<InputState>, core::uid_hash> inputs_;
+    ModelExecutor executor_;
+    std::unordered_map<core::UID, io::SpikeOutputRing, core::uid_hash> outputs_;
+
+    std::thread thread_;
+    std::exception_ptr error_;
+    mutable std::mutex control_mutex_;
+    std::condition_variable control_cv_;
+    std::atomic<bool> stop_requested_ = false;
+    std::atomic<bool> pause_requested_ = false;
+    size_t steps_to_run_ = 0;
+    bool is_paused_ = false;
+    bool is_finished_ = true;
+
+    std::atomic<int64_t> step_period_ = 0;
+    std::chrono::steady_clock::time_point next_step_time_;
+    bool is_pacing_started_ = false;
+    std::atomic<uint64_t> steps_count_ = 0;
+    std::atomic<uint64_t> overruns_count_ = 0;
+    std::atomic<int64_t> max_overrun_ = 0;
+    std::atomic<int64_t> total_overrun_ = 0;
+};
+
+}  // namespace knp::framework
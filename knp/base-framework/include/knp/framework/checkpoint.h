@@ -0,0 +1,149 @@
+/**
+ * @file checkpoint.h
+ * @brief Saving and restoring dynamic state of networks loaded to backends.
+ * @kaspersky_support Artiom N.
+ * @date 18.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <knp/core/backend.h>
+#include <knp/core/dynamic_state.h>
+#include <knp/core/impexp.h>
+
+#include <filesystem>
+#include <future>
+#include <memory>
+#include <optional>
+
+
+/**
+ * @brief Framework namespace.
+ */
+namespace knp::framework
+{
+
+/**
+ * @brief The CheckpointOptions structure contains parameters of checkpoint writing.
+ */
+struct KNP_DECLSPEC CheckpointOptions
+{
+    /**
+     * @brief Write only parameter values that changed since the previous checkpoint.
+     * @details Unchanged parameters are skipped. If a small part of parameter values changed, only these values are
+     * written together with their indexes. Incremental checkpoints can't be restored without the previous
+     * checkpoints up to the full one.
+     */
+    bool incremental_ = true;
+
+    /**
+     * @brief Number of checkpoints after which a full checkpoint is written. `0` if only the first checkpoint is full.
+     */
+    size_t full_checkpoint_period_ = 0;
+
+    /**
+     * @brief Write checkpoint files in a background thread.
+     */
+    bool write_in_background_ = true;
+};
+
+
+/**
+ * @brief The CheckpointWriter class is a definition of a writer that saves dynamic state of a backend network.
+ * @details A checkpoint contains only the state returned by `Backend::get_dynamic_state()`, static parameters are
+ * not written, so a checkpoint is restored to a backend that has the network loaded. Every checkpoint is written
+ * to the `checkpoint_<step>.h5` file in the checkpoint directory. The backend state is copied when `save()` is
+ * called, comparison with the previous checkpoint and writing are done in a background thread while the backend
+ * continues execution.
+ */
+class KNP_DECLSPEC CheckpointWriter
+{
+public:
+    /**
+     * @brief Create a checkpoint writer.
+     * @param directory directory for checkpoint files. The directory is created if it doesn't exist.
+     * @param options checkpoint options.
+     */
+    explicit CheckpointWriter(std::filesystem::path directory, CheckpointOptions options = {});
+
+    /**
+     * @brief Wait for the last checkpoint to be written.
+     * @details Errors of writing are logged.
+     */
+    ~CheckpointWriter();
+
+    CheckpointWriter(const CheckpointWriter &) = delete;
+    CheckpointWriter &operator=(const CheckpointWriter &) = delete;
+
+    /**
+     * @brief Save a checkpoint of the backend state at the current step.
+     * @details The method waits until the previous checkpoint is written. The backend must not execute a step
+     * during the call, for example the method can be called from the post-step predicate.
+     * @param backend backend with a loaded network.
+     * @throw std::runtime_error if the previous checkpoint couldn't be written.
+     */
+    void save(const core::Backend &backend);
+
+    /**
+     * @brief Wait until the last checkpoint is written.
+     * @throw std::runtime_error if the checkpoint couldn't be written.
+     */
+    void wait();
+
+    /**
+     * @brief Get directory of checkpoint files.
+     * @return checkpoint directory.
+     */
+    [[nodiscard]] const std::filesystem::path &get_directory() const { return directory_; }
+
+private:
+    void write(std::shared_ptr<const core::DynamicState> state, bool is_full);
+
+private:
+    std::filesystem::path directory_;
+    CheckpointOptions options_;
+    // State written by the last checkpoint, used to find changed parameters.
+    std::shared_ptr<const core::DynamicState> last_state_;
+    size_t checkpoint_count_ = 0;
+    std::future<void> pending_write_;
+};
+
+
+/**
+ * @brief Read network dynamic state from checkpoint files.
+ * @details Incremental checkpoints are applied to the last full checkpoint written before them.
+ * @param directory directory of checkpoint files.
+ * @param step step of the checkpoint to read. The last checkpoint is read if the step is not specified.
+ * @return dynamic state of the network.
+ * @throw std::runtime_error if there is no such checkpoint or some of checkpoints it depends on.
+ */
+KNP_DECLSPEC core::DynamicState read_checkpoint(
+    const std::filesystem::path &directory, std::optional<core::Step> step = std::nullopt);
+
+
+/**
+ * @brief Restore backend state from checkpoint files.
+ * @param backend backend with the network loaded.
+ * @param directory directory of checkpoint files.
+ * @param step step of the checkpoint to restore. The last checkpoint is restored if the step is not specified.
+ * @throw std::runtime_error if there is no such checkpoint.
+ * @throw std::logic_error if the checkpoint doesn't match the backend network.
+ */
+KNP_DECLSPEC void restore_checkpoint(
+    core::Backend &backend, const std::filesystem::path &directory, std::optional<core::Step> step = std::nullopt);
+
+}  // namespace knp::framework
@@ -0,0 +1,174 @@
+/**
+ * @file async_channels.h
+ * @brief Lock-free queues that pass spikes between threads and a running model.
+ * @kaspersky_support Artiom N.
+ * @date 18.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <knp/core/core.h>
+#include <knp/core/impexp.h>
+#include <knp/core/messaging/spike_message.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+
+/**
+ * @brief Input and output namespace.
+ */
+namespace knp::framework::io
+{
+/**
+ * @brief The SpikeInputQueue class is a definition of a bounded lock-free queue of spikes sent to a model from
+ * several threads.
+ * @details Any number of threads can push spikes concurrently. Only one thread can pop spikes. Memory for queue
+ * cells is allocated once, so pushing doesn't allocate memory except for the spike vectors passed by the caller.
+ */
+class KNP_DECLSPEC SpikeInputQueue
+{
+public:
+    /**
+     * @brief Create a queue.
+     * @param capacity maximum number of queued spike vectors.
+     * @throw std::invalid_argument if the capacity is zero.
+     */
+    explicit SpikeInputQueue(size_t capacity);
+
+    /**
+     * @brief Queue destructor.
+     */
+    ~SpikeInputQueue();
+
+public:
+    /**
+     * @brief Push spikes to the queue.
+     * @details The method can be called from several threads concurrently.
+     * @param step step at which the spikes are sent.
+     * @param spikes spiked neuron indexes.
+     * @return `false` if the queue is full and spikes weren't pushed.
+     */
+    bool push(core::Step step, core::messaging::SpikeData spikes);
+
+    /**
+     * @brief Pop the oldest spikes from the queue.
+     * @details Only one thread can call the method at the same time.
+     * @param step step at which the spikes are sent.
+     * @param spikes spiked neuron indexes.
+     * @return `false` if the queue is empty.
+     */
+    bool pop(core::Step &step, core::messaging::SpikeData &spikes);
+
+    /**
+     * @brief Get queue capacity.
+     * @return maximum number of queued spike vectors.
+     */
+    [[nodiscard]] size_t get_capacity() const { return capacity_; }
+
+private:
+    struct Cell;
+    std::unique_ptr<Cell[]> cells_;
+    size_t capacity_;
+    alignas(64) std::atomic<size_t> push_position_ = 0;
+    alignas(64) size_t pop_position_ = 0;
+};
+
+
+/**
+ * @brief The SpikeOutputRing class is a definition of a lock-free ring buffer of spike messages read by
+ * several threads.
+ * @details One thread writes messages to the ring. Every reader reads all messages on its own and never blocks
+ * the writer: if a reader is too slow, the writer overwrites the oldest messages and the reader skips them.
+ * Memory for all messages is allocated when the ring is created, so neither the writer nor the readers
+ * allocate memory.
+ */
+class KNP_DECLSPEC SpikeOutputRing
+{
+private:
+    struct Ring;
+
+public:
+    /**
+     * @brief The Reader class is a definition of a ring reader that keeps its own reading position.
+     * @details A reader must be used by one thread at the same time. The reader keeps the ring data alive.
+     */
+    class KNP_DECLSPEC Reader
+    {
+    public:
+        /**
+         * @brief Read the next message.
+         * @details If the writer has overwritten unread messages, the reader skips them and continues from the oldest
+         * message in the ring.
+         * @param message message to fill. The vector of neuron indexes keeps its capacity.
+         * @return `false` if there are no new messages.
+         */
+        bool read(core::messaging::SpikeMessage &message);
+
+        /**
+         * @brief Get number of messages skipped because the writer overwrote them.
+         * @return number of lost messages.
+         */
+        [[nodiscard]] uint64_t get_lost_count() const { return lost_count_; }
+
+    private:
+        friend class SpikeOutputRing;
+        Reader(std::shared_ptr<const Ring> ring, uint64_t position) : ring_(std::move(ring)), position_(position) {}
+
+        std::shared_ptr<const Ring> ring_;
+        uint64_t position_;
+        uint64_t lost_count_ = 0;
+    };
+
+public:
+    /**
+     * @brief Create a ring.
+     * @param senders UIDs of entities that send messages to the ring.
+     * @param max_spikes maximum number of neuron indexes in a message.
+     * @param capacity number of messages that the ring keeps.
+     * @throw std::invalid_argument if the capacity is zero.
+     */
+    SpikeOutputRing(std::vector<core::UID> senders, size_t max_spikes, size_t capacity);
+
+public:
+    /**
+     * @brief Write a message to the ring.
+     * @details Only one thread can call the method at the same time.
+     * @param message message to write.
+     * @throw std::logic_error if the message sender isn't a ring sender or the message contains too many spikes.
+     */
+    void write(const core::messaging::SpikeMessage &message);
+
+    /**
+     * @brief Create a reader that reads messages written after the call.
+     * @details The method can be called from any thread.
+     * @return ring reader.
+     */
+    [[nodiscard]] Reader create_reader() const;
+
+    /**
+     * @brief Get ring capacity.
+     * @return number of messages that the ring keeps.
+     */
+    [[nodiscard]] size_t get_capacity() const;
+
+private:
+    std::shared_ptr<Ring> ring_;
+};
+
+}  // namespace knp::framework::io
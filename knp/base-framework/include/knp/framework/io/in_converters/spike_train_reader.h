@@ -0,0 +1,93 @@
+/**
+ * @file spike_train_reader.h
+ * @brief Reader of spikes from memory-mapped binary spike train files.
+ * @kaspersky_support Artiom N.
+ * @date 18.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <knp/core/core.h>
+#include <knp/core/impexp.h>
+#include <knp/core/messaging/spike_message.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <utility>
+
+
+/**
+ * @brief Input channel namespace.
+ */
+namespace knp::framework::io::input
+{
+/**
+ * @brief The SpikeTrainReader class is a definition of a data generator that reads spikes from a binary spike train
+ * file.
+ * @details The file is mapped to memory and read sequentially, so spikes of a step are read without parsing and
+ * the operating system reads next pages of the file in advance. Binary spike train files are written by
+ * `storage::native::save_messages_to_binary()` and `storage::native::convert_messages_to_binary()`. Copies of the
+ * reader share the mapped file, so the reader can be used as `DataGenerator` of an input channel.
+ */
+class KNP_DECLSPEC SpikeTrainReader
+{
+public:
+    /**
+     * @brief Range of spiked neuron indexes in the mapped file.
+     */
+    using SpikeRange = std::pair<const core::messaging::SpikeIndex *, const core::messaging::SpikeIndex *>;
+
+public:
+    /**
+     * @brief Map a binary spike train file.
+     * @param path path to binary spike train file.
+     * @param loop if `true`, steps after the last step of the file repeat the file from the beginning.
+     * @throw std::runtime_error if the file can't be mapped or has a wrong format.
+     */
+    explicit SpikeTrainReader(const std::filesystem::path &path, bool loop = false);
+
+    /**
+     * @brief Get spiked neuron indexes of a step.
+     * @param step current step.
+     * @return vector of spiked neuron indexes. The vector is empty if the file doesn't contain the step.
+     */
+    core::messaging::SpikeData operator()(core::Step step) const;
+
+    /**
+     * @brief Get spiked neuron indexes of a step without copying.
+     * @details The range is valid while the reader or its copies exist.
+     * @param step current step.
+     * @return range of spiked neuron indexes. The range is empty if the file doesn't contain the step.
+     */
+    [[nodiscard]] SpikeRange get_spikes(core::Step step) const;
+
+    /**
+     * @brief Get number of steps stored in the file.
+     * @return number of steps.
+     */
+    [[nodiscard]] uint64_t get_steps_count() const { return steps_count_; }
+
+private:
+    struct MappedFile;
+    std::shared_ptr<const MappedFile> file_;
+    const uint64_t *offsets_ = nullptr;
+    const core::messaging::SpikeIndex *spikes_ = nullptr;
+    uint64_t steps_count_ = 0;
+    bool loop_ = false;
+};
+
+}  // namespace knp::framework::io::input
@@ -26,6 +26,7 @@
 #include <knp/core/messaging/messaging.h>
 
 #include <algorithm>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -87,6 +88,18 @@ public:
      */
     std::vector<core::messaging::SpikeMessage> read_some_from_buffer(core::Step starting_step, core::Step final_step);
 
+    /**
+     * @brief Set original indexes of neurons of a population which neurons were reordered.
+     * @details Neuron indexes of spike messages received from the population are replaced with the original indexes.
+     * @param population_uid population UID.
+     * @param original_indexes original neuron indexes by the current neuron indexes.
+     * @see knp::framework::reordering::NeuronIndexMap.
+     */
+    void set_original_neuron_indexes(const core::UID &population_uid, std::vector<size_t> original_indexes)
+    {
+        original_neuron_indexes_[population_uid] = std::move(original_indexes);
+    }
+
 protected:
     /**
      * @brief Base data.
@@ -102,6 +115,11 @@ protected:
      * @brief Messages received from output population.
      */
     std::vector<core::messaging::SpikeMessage> message_buffer_;  // cppcheck-suppress unusedStructMember
+
+    /**
+     * @brief Original neuron indexes of reordered populations.
+     */
+    std::unordered_map<core::UID, std::vector<size_t>, core::uid_hash> original_neuron_indexes_;
 };
 
 
@@ -0,0 +1,73 @@
+/**
+ * @file data_storage_binary.h
+ * @brief Save and load spike messages in the binary spike train format.
+ * @kaspersky_support Artiom N.
+ * @date 18.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <knp/core/impexp.h>
+#include <knp/core/messaging/messaging.h>
+
+#include <filesystem>
+#include <vector>
+
+
+/**
+ * @brief Data storage namespace.
+ */
+namespace knp::framework::io::storage::native
+{
+
+/**
+ * @brief Save a vector of spike messages to a binary spike train file.
+ * @details The file contains offsets of spikes for every step from `0` to the last message step followed by spiked
+ * neuron indexes, so spikes of a step are found without parsing. Spikes of messages with the same step are merged.
+ * Use `io::input::SpikeTrainReader` to read the file as network input.
+ * @note Passing messages by value is not an error. Messages are sorted inside the function.
+ * @param messages vector of spike messages to save.
+ * @param path_to_save path to file.
+ * @throw std::runtime_error if the file can't be written.
+ */
+KNP_DECLSPEC void save_messages_to_binary(
+    std::vector<core::messaging::SpikeMessage> messages, const std::filesystem::path &path_to_save);
+
+
+/**
+ * @brief Read spike messages from a binary spike train file.
+ * @details Steps without spikes don't have messages.
+ * @param path_to_binary path to binary spike train file.
+ * @param uid sender UID.
+ * @return vector of messages sorted by steps.
+ * @throw std::runtime_error if the file has a wrong format.
+ */
+KNP_DECLSPEC std::vector<core::messaging::SpikeMessage> load_messages_from_binary(
+    const std::filesystem::path &path_to_binary, const knp::core::UID &uid);
+
+
+/**
+ * @brief Convert a spike file in the HDF5 or JSON format to the binary spike train format.
+ * @details Input format is defined by the file extension: `.h5` or `.json`.
+ * @param input_path path to HDF5 or JSON spike file.
+ * @param output_path path to binary spike train file.
+ * @param time_per_step time per step used to convert HDF5 timestamps to steps.
+ * @throw std::runtime_error if the input format isn't supported or files can't be read or written.
+ */
+KNP_DECLSPEC void convert_messages_to_binary(
+    const std::filesystem::path &input_path, const std::filesystem::path &output_path, float time_per_step = 1.0f);
+
+}  // namespace knp::framework::io::storage::native
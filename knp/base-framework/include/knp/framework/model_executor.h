@@ -53,9 +53,24 @@ public:
      * @param model model to run.
      * @param backend pointer to backend on which you want to run the model.
      * @param i_map input channel map.
+     * @param b_map bulk input map.
      */
     ModelExecutor(
-        knp::framework::Model &model, std::shared_ptr<core::Backend> backend, ModelLoader::InputChannelMap i_map);
+        knp::framework::Model &model, std::shared_ptr<core::Backend> backend, ModelLoader::InputChannelMap i_map,
+        ModelLoader::BulkInputMap b_map = {});
+
+    /**
+     * @brief ModelExecutor constructor that moves the model network to the backend.
+     * @details Use this constructor to avoid keeping two copies of a large network in memory. The model network is
+     * empty after the call.
+     * @param model model to run.
+     * @param backend pointer to backend on which you want to run the model.
+     * @param i_map input channel map.
+     * @param b_map bulk input map.
+     */
+    ModelExecutor(
+        knp::framework::Model &&model, std::shared_ptr<core::Backend> backend, ModelLoader::InputChannelMap i_map,
+        ModelLoader::BulkInputMap b_map = {});
 
     /**
      * @brief ModelExecutor destructor.
@@ -74,6 +89,19 @@ public:
      */
     void start(core::Backend::RunPredicate run_predicate);
 
+    /**
+     * @brief Execute a number of steps without host interaction between them.
+     * @details Input channels send spikes, and output channels, message handlers and observers process messages only
+     * around synchronization steps. Other steps run back-to-back inside the backend. Messages sent to output channels
+     * and observers between synchronization steps are processed at the next synchronization step. Output channels,
+     * message handlers and observers also process messages after the last step. Use bulk inputs for inputs that
+     * change every step. Calling `stop()` from a message handler or an observer ends execution at the current
+     * synchronization step.
+     * @param steps_count number of steps to execute.
+     * @param sync_steps steps before which input channels send spikes and after which outputs are processed.
+     */
+    void fast_forward(size_t steps_count, std::vector<core::Step> sync_steps = {});
+
     /**
      * @brief Stop model execution.
      */
@@ -85,14 +113,21 @@ public:
      * @tparam Message type of messages to observe.
      * @param message_processor functor to process received messages.
      * @param senders list of observed entities.
+     * @param update_period number of steps after which the functor receives messages accumulated during these steps.
+     * The remaining messages are processed when execution stops.
      */
     template <class Message>
-    void add_observer(monitoring::MessageProcessor<Message> &&message_processor, const std::vector<core::UID> &senders)
+    void add_observer(
+        monitoring::MessageProcessor<Message> &&message_processor, const std::vector<core::UID> &senders,
+        size_t update_period = 1)
     {
         observers_.emplace_back(monitoring::MessageObserver<Message>(
-            get_backend()->get_message_bus().create_endpoint(), std::move(message_processor), core::UID{true}));
+            get_backend()->get_message_bus().create_endpoint(), std::move(message_processor), core::UID{true},
+            update_period));
 
         std::visit([&senders](auto &entity) { entity.subscribe(senders); }, observers_.back());
+        // Observed messages must not be delivered inside the backend only.
+        get_backend()->require_bus_messages(senders);
     }
 
     /**
@@ -137,6 +172,9 @@ public:
 private:
     class SpikeMessageHandler;
 
+    void send_inputs(core::Step step);
+    void process_outputs();
+
     knp::core::BaseData base_;
     ModelLoader loader_;
 
@@ -21,6 +21,7 @@
 
 #pragma once
 
+#include <knp/core/bulk_input.h>
 #include <knp/core/impexp.h>
 #include <knp/framework/io/input_converter.h>
 #include <knp/framework/model.h>
@@ -50,14 +51,22 @@ public:
      */
     using InputChannelMap = std::unordered_map<core::UID, io::input::DataGenerator, core::uid_hash>;
 
+    /**
+     * @brief Type of the bulk input map.
+     * @details Bulk inputs are read by the backend directly, they don't have input channels. Their spikes aren't
+     * sent through the message bus, so observers don't receive them.
+     */
+    using BulkInputMap = std::unordered_map<core::UID, core::BulkSpikeInput, core::uid_hash>;
+
 public:
     /**
      * @brief Model loader constructor.
      * @param backend pointer to backend to which you want to load the model.
      * @param i_map input channel map.
+     * @param b_map bulk input map. Model input channels with UIDs from this map are loaded as backend bulk inputs.
      */
-    ModelLoader(std::shared_ptr<core::Backend> backend, InputChannelMap i_map)
-        : backend_(backend), i_map_(std::move(i_map))
+    ModelLoader(std::shared_ptr<core::Backend> backend, InputChannelMap i_map, BulkInputMap b_map = {})
+        : backend_(backend), i_map_(std::move(i_map)), b_map_(std::move(b_map))
     {
     }
 
@@ -77,6 +86,14 @@ public:
      */
     void load(knp::framework::Model &model);
 
+    /**
+     * @brief Move model to backend.
+     * @details Populations and projections are moved to the backend instead of being copied, so loading doesn't need
+     * memory for a second copy of the network. The model network is empty after the call.
+     * @param model model to load.
+     */
+    void load(knp::framework::Model &&model);
+
 public:
     /**
      * @brief Get reference to output channel.
@@ -134,6 +151,7 @@ private:
         knp::framework::Model &model, const std::unordered_multimap<core::UID, core::UID, core::uid_hash> &channels,
         GenType channel_gen);
 
+    void init_all_channels(knp::framework::Model &model);
     void gen_input_channel(knp::framework::Model &model, const core::UID &, const std::vector<core::UID> &);
     void gen_output_channel(knp::framework::Model &model, const core::UID &, const std::vector<core::UID> &);
 
@@ -142,6 +160,7 @@ private:
     std::shared_ptr<core::Backend> backend_;
 
     InputChannelMap i_map_;
+    BulkInputMap b_map_;
     // cppcheck-suppress unusedStructMember
     std::vector<knp::framework::io::input::InputChannel> in_channels_;
     // cppcheck-suppress unusedStructMember
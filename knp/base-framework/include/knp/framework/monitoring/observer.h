@@ -23,9 +23,11 @@
 #include <knp/core/message_endpoint.h>
 #include <knp/core/messaging/messaging.h>
 
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
 #include <functional>
+#include <iterator>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -61,10 +63,17 @@ public:
      * @param endpoint endpoint from which to get messages.
      * @param processor functor to process messages.
      * @param uid observer UID.
+     * @param update_period number of updates after which the processor receives all messages accumulated during these
+     * updates. Use values greater than `1` to reduce the number of processor calls, for example if the processor is
+     * implemented in Python.
      */
     MessageObserver(
-        core::MessageEndpoint &&endpoint, MessageProcessor<Message> &&processor, core::UID uid = core::UID{true})
-        : endpoint_(std::move(endpoint)), process_messages_(processor), base_data_{uid}
+        core::MessageEndpoint &&endpoint, MessageProcessor<Message> &&processor, core::UID uid = core::UID{true},
+        size_t update_period = 1)
+        : endpoint_(std::move(endpoint)),
+          process_messages_(processor),
+          base_data_{uid},
+          update_period_(std::max<size_t>(update_period, 1))
     {
     }
 
@@ -87,7 +96,35 @@ public:
     {
         endpoint_.receive_all_messages();
         auto messages_raw = endpoint_.unload_messages<Message>(base_data_.uid_);
-        process_messages_(messages_raw);
+        // Messages of several steps are received at once after fast-forward execution.
+        auto step_less = [](const Message &message1, const Message &message2)
+        { return message1.header_.send_time_ < message2.header_.send_time_; };
+        if (!std::is_sorted(messages_raw.begin(), messages_raw.end(), step_less))
+        {
+            std::stable_sort(messages_raw.begin(), messages_raw.end(), step_less);
+        }
+        if (1 == update_period_)
+        {
+            process_messages_(messages_raw);
+            return;
+        }
+
+        pending_messages_.insert(
+            pending_messages_.end(), std::make_move_iterator(messages_raw.begin()),
+            std::make_move_iterator(messages_raw.end()));
+        if (++pending_updates_ >= update_period_) flush();
+    }
+
+    /**
+     * @brief Process messages accumulated since the last processor call.
+     * @details The processor isn't called if there were no updates since the last call.
+     */
+    void flush()
+    {
+        if (!pending_updates_) return;
+        process_messages_(pending_messages_);
+        pending_messages_.clear();
+        pending_updates_ = 0;
     }
 
     /**
@@ -100,6 +137,9 @@ private:
     core::MessageEndpoint endpoint_;
     MessageProcessor<Message> process_messages_;
     core::BaseData base_data_;
+    size_t update_period_;
+    std::vector<Message> pending_messages_;
+    size_t pending_updates_ = 0;
 };
 
 /**
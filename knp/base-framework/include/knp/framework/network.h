@@ -35,6 +35,7 @@
 #include <string>
 #include <tuple>
 #include <type_traits>
+#include <unordered_map>
 #include <utility>
 #include <variant>
 #include <vector>
@@ -120,6 +121,43 @@ public:
      */
     using ProjectionConstIterator = ProjectionContainer::const_iterator;
 
+    /**
+     * @brief The Handle class is a definition of a reference to a population or a projection in the network.
+     * @details A handle stores the element UID and the element position in the network container. The position is
+     * checked on every access, so the access takes constant time. If the element was moved by adding or removing other
+     * elements, the handle finds it by UID and remembers the new position. A handle becomes invalid only if the
+     * element itself is removed from the network.
+     * @tparam ContainerType type of container with referenced elements.
+     */
+    template <typename ContainerType>
+    class Handle
+    {
+    public:
+        /**
+         * @brief Get UID of the referenced element.
+         * @return element UID.
+         */
+        [[nodiscard]] const core::UID &get_uid() const { return uid_; }
+
+    private:
+        friend class Network;
+        Handle(const core::UID &uid, size_t index) : uid_(uid), index_(index) {}
+
+    private:
+        // cppcheck-suppress unusedStructMember
+        core::UID uid_;
+        mutable size_t index_;
+    };
+
+    /**
+     * @brief Type of population handle.
+     */
+    using PopulationHandle = Handle<PopulationContainer>;
+    /**
+     * @brief Type of projection handle.
+     */
+    using ProjectionHandle = Handle<ProjectionContainer>;
+
 public:
     /**
      * @brief Default network constructor.
@@ -189,12 +227,61 @@ public:
      */
     [[nodiscard]] core::AllPopulationsVariant &get_population(const knp::core::UID &population_uid);
 
+    /**
+     * @brief Get a handle of the population with the given UID.
+     * @param population_uid population UID.
+     * @throw std::logic_error if population is not found in the network.
+     * @return population handle.
+     */
+    [[nodiscard]] PopulationHandle get_population_handle(const knp::core::UID &population_uid) const;
+
+    /**
+     * @brief Get a population by its handle.
+     * @param handle population handle.
+     * @throw std::logic_error if population was removed from the network.
+     * @return population.
+     */
+    [[nodiscard]] core::AllPopulationsVariant &get_population(const PopulationHandle &handle);
+
+    /**
+     * @brief Get a population by its handle.
+     * @note Constant method.
+     * @param handle population handle.
+     * @throw std::logic_error if population was removed from the network.
+     * @return population.
+     */
+    [[nodiscard]] const core::AllPopulationsVariant &get_population(const PopulationHandle &handle) const;
+
+    /**
+     * @brief Get a population by its handle.
+     * @tparam NeuronType type of population neuron.
+     * @param handle population handle.
+     * @throw std::logic_error if population was removed from the network.
+     * @return population.
+     */
+    template <typename NeuronType>
+    [[nodiscard]] knp::core::Population<NeuronType> &get_population(const PopulationHandle &handle)
+    {
+        return std::get<knp::core::Population<NeuronType>>(get_population(handle));
+    }
+
     /**
      * @brief Remove a population with the given UID from the network.
+     * @details The last population takes the place of the removed one, so the population order changes.
      * @param population_uid UID of the population to remove.
      */
     void remove_population(const knp::core::UID &population_uid);
 
+    /**
+     * @brief Remove neurons from a population together with all synapses attached to them.
+     * @details Neuron indexes of synapses in the projections connected to the population are decreased accordingly.
+     * @param population_uid UID of the population.
+     * @param neuron_indexes indexes of neurons to remove in any order. Indexes out of range are ignored.
+     * @throw std::logic_error if population doesn't exist in the network.
+     * @return number of deleted synapses.
+     */
+    size_t remove_neurons(const knp::core::UID &population_uid, std::vector<size_t> neuron_indexes);
+
 public:
     /**
      * @brief Add a projection to the network.
@@ -262,8 +349,43 @@ public:
      * @return projection.
      */
     [[nodiscard]] core::AllProjectionsVariant &get_projection(const knp::core::UID &projection_uid);
+    /**
+     * @brief Get a handle of the projection with the given UID.
+     * @param projection_uid projection UID.
+     * @throw std::logic_error if projection is not found in the network.
+     * @return projection handle.
+     */
+    [[nodiscard]] ProjectionHandle get_projection_handle(const knp::core::UID &projection_uid) const;
+    /**
+     * @brief Get a projection by its handle.
+     * @param handle projection handle.
+     * @throw std::logic_error if projection was removed from the network.
+     * @return projection.
+     */
+    [[nodiscard]] core::AllProjectionsVariant &get_projection(const ProjectionHandle &handle);
+    /**
+     * @brief Get a projection by its handle.
+     * @note Constant method.
+     * @param handle projection handle.
+     * @throw std::logic_error if projection was removed from the network.
+     * @return projection.
+     */
+    [[nodiscard]] const core::AllProjectionsVariant &get_projection(const ProjectionHandle &handle) const;
+    /**
+     * @brief Get a projection by its handle.
+     * @tparam SynapseType type of projection synapse.
+     * @param handle projection handle.
+     * @throw std::logic_error if projection was removed from the network.
+     * @return projection.
+     */
+    template <typename SynapseType>
+    [[nodiscard]] knp::core::Projection<SynapseType> &get_projection(const ProjectionHandle &handle)
+    {
+        return std::get<knp::core::Projection<SynapseType>>(get_projection(handle));
+    }
     /**
      * @brief Remove a projection with the given UID from the network.
+     * @details The last projection takes the place of the removed one, so the projection order changes.
      * @param projection_uid UID of the projection to remove.
      */
     void remove_projection(const knp::core::UID &projection_uid);
@@ -326,6 +448,7 @@ public:
 public:
     /**
      * @brief Get an iterator pointing to the first element of the population.
+     * @note Populations must not be replaced through the iterator, as the network indexes them by UID.
      * @return population iterator.
      */
     [[nodiscard]] PopulationIterator begin_populations();
@@ -346,6 +469,7 @@ public:
     [[nodiscard]] PopulationConstIterator end_populations() const;
     /**
      * @brief Get an iterator pointing to the first element of the projection.
+     * @note Projections must not be replaced through the iterator, as the network indexes them by UID.
      * @return projection iterator.
      */
     [[nodiscard]] ProjectionIterator begin_projections();
@@ -377,6 +501,21 @@ public:
      */
     [[nodiscard]] const ProjectionContainer &get_projections() const { return projections_; }
 
+    /**
+     * @brief Move all populations out of the network.
+     * @details Use this method to pass populations to a backend without copying them. The network has no populations
+     * after the call.
+     * @return container of populations.
+     */
+    [[nodiscard]] PopulationContainer release_populations();
+    /**
+     * @brief Move all projections out of the network.
+     * @details Use this method to pass projections to a backend without copying them. The network has no projections
+     * after the call.
+     * @return container of projections.
+     */
+    [[nodiscard]] ProjectionContainer release_projections();
+
 public:
     /**
      * @brief Count populations in the network.
@@ -428,10 +567,16 @@ private:
     template <typename ProjectionType>
     void check_projection_constraints(const ProjectionType &projection) const;
 
+private:
+    using UIDIndex = std::unordered_map<core::UID, size_t, core::uid_hash>;
+
 private:
     knp::core::BaseData base_;
     PopulationContainer populations_;
     ProjectionContainer projections_;
+    // Positions of populations and projections in the containers.
+    UIDIndex population_index_;
+    UIDIndex projection_index_;
 };
 
 
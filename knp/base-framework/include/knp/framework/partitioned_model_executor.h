@@ -0,0 +1,159 @@
+/**
+ * @file partitioned_model_executor.h
+ * @brief Partitioned model executor interface.
+ * @kaspersky_support Artiom N.
+ * @date 18.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <knp/core/impexp.h>
+#include <knp/framework/model.h>
+#include <knp/framework/model_loader.h>
+#include <knp/framework/partitioning.h>
+
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <vector>
+
+
+/**
+ * @brief Framework namespace.
+ */
+namespace knp::framework
+{
+/**
+ * @brief The PartitionedModelExecutor class is a definition of an executor that splits the model network into
+ * partitions and runs every partition on its own backend.
+ * @details Backends run in separate threads and make steps in lockstep. Synaptic impacts sent to the populations
+ * of other partitions are exchanged between steps, so the populations receive them at the same step as
+ * in the unpartitioned run. Impacts from other partitions are delivered after the local impacts of the same step.
+ * Because the impacts are summed in a different order, neuron potentials can differ from the unpartitioned run
+ * in the last bits.
+ * @note Populations connected to the same input or output channel are placed into the same partition.
+ */
+class KNP_DECLSPEC PartitionedModelExecutor
+{
+public:
+    /**
+     * @brief PartitionedModelExecutor constructor.
+     * @param model model to run.
+     * @param backends backends to run the model partitions on. The number of partitions equals the number of backends.
+     * @param i_map input channel map.
+     * @throw std::logic_error if no backends are specified.
+     */
+    PartitionedModelExecutor(
+        knp::framework::Model &model, std::vector<std::shared_ptr<core::Backend>> backends,
+        const ModelLoader::InputChannelMap &i_map);
+
+    /**
+     * @brief PartitionedModelExecutor destructor.
+     */
+    ~PartitionedModelExecutor();
+
+public:
+    /**
+     * @brief Start model execution.
+     */
+    void start();
+
+    /**
+     * @brief Start model execution.
+     * @details The predicate is called once per step for all partitions.
+     * @param run_predicate predicate that stops running if the `false` value is returned.
+     */
+    void start(core::Backend::RunPredicate run_predicate);
+
+    /**
+     * @brief Stop model execution.
+     * @details All backends stop before the same step.
+     */
+    void stop();
+
+public:
+    /**
+     * @brief Unlock synapse weights on all backends.
+     */
+    void start_learning();
+
+    /**
+     * @brief Lock synapse weights on all backends.
+     */
+    void stop_learning();
+
+public:
+    /**
+     * @brief Get number of partitions.
+     * @return number of partitions.
+     */
+    [[nodiscard]] size_t get_partition_count() const { return loaders_.size(); }
+
+    /**
+     * @brief Get partition map.
+     * @return partition map used to split the model network.
+     */
+    [[nodiscard]] const partitioning::PartitionMap &get_partitions() const { return partitions_; }
+
+    /**
+     * @brief Get pointer to backend object.
+     * @param partition_index partition index.
+     * @return shared pointer to `Backend` object that runs the partition.
+     */
+    std::shared_ptr<core::Backend> get_backend(size_t partition_index)
+    {
+        return loaders_.at(partition_index)->get_backend();
+    }
+
+    /**
+     * @brief Get model loader object.
+     * @param partition_index partition index.
+     * @return reference to `ModelLoader` object that loaded the partition.
+     */
+    ModelLoader &get_loader(size_t partition_index) { return *loaders_.at(partition_index); }
+
+    /**
+     * @brief Get reference to output channel.
+     * @param channel_uid channel UID.
+     * @return reference to output channel.
+     * @throw std::runtime_error if there is no channel with a given UID.
+     */
+    io::output::OutputChannel &get_output_channel(const core::UID &channel_uid);
+
+private:
+    class StepBarrier;
+
+    void run_partition(size_t partition_index);
+    void send_cut_impacts(size_t partition_index, core::Step step);
+    void receive_cut_impacts(size_t partition_index, core::Step step);
+
+private:
+    knp::core::BaseData base_;
+    partitioning::PartitionMap partitions_;
+    // cppcheck-suppress unusedStructMember
+    std::vector<std::unique_ptr<ModelLoader>> loaders_;
+    // Endpoints used to send impacts from other partitions.
+    std::vector<core::MessageEndpoint> bridges_;
+    // Postsynaptic populations of the cut projections and their partitions, per source partition.
+    std::vector<std::vector<std::pair<core::UID, size_t>>> cut_targets_;
+    // Impacts between partitions. Index is `(step parity * partitions + target) * partitions + source`.
+    std::vector<std::vector<core::messaging::SynapticImpactMessage>> mailboxes_;
+    std::unique_ptr<StepBarrier> barrier_;
+    core::Backend::RunPredicate run_predicate_;
+    std::atomic<bool> stop_requested_ = false;
+};
+}  // namespace knp::framework
@@ -0,0 +1,92 @@
+/**
+ * @file partitioning.h
+ * @brief Network partitioning routines.
+ * @kaspersky_support Artiom N.
+ * @date 18.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <knp/core/core.h>
+#include <knp/core/impexp.h>
+#include <knp/framework/network.h>
+
+#include <unordered_map>
+#include <vector>
+
+
+/**
+ * @brief Network partitioning namespace.
+ */
+namespace knp::framework::partitioning
+{
+
+/**
+ * @brief The PartitionMap structure describes how network objects are distributed between partitions.
+ * @details A projection is always placed into the partition of its presynaptic population. If a projection has
+ * no presynaptic population in the network (for example, an input projection), it is placed into the partition of
+ * its postsynaptic population. Thus only synaptic impacts are sent between partitions.
+ */
+struct KNP_DECLSPEC PartitionMap
+{
+    /**
+     * @brief Number of partitions.
+     */
+    size_t partition_count_ = 0;
+
+    /**
+     * @brief Partition indexes of populations.
+     */
+    std::unordered_map<core::UID, size_t, core::uid_hash> population_partitions_;
+
+    /**
+     * @brief Partition indexes of projections.
+     */
+    std::unordered_map<core::UID, size_t, core::uid_hash> projection_partitions_;
+
+    /**
+     * @brief Number of synapses in the projections that connect populations from different partitions.
+     */
+    size_t cut_synapse_count_ = 0;
+};
+
+
+/**
+ * @brief Split network populations into the given number of partitions.
+ * @details The function minimizes the number of synapses between partitions and keeps the number of neurons in
+ * partitions balanced. Presynaptic, postsynaptic and STDP populations of an STDP projection are always placed into
+ * the same partition.
+ * @param network network to partition.
+ * @param partition_count number of partitions.
+ * @param colocated_populations groups of population UIDs. Populations of a group are placed into the same partition.
+ * @throw std::logic_error if the number of partitions is zero.
+ * @return partition map.
+ */
+KNP_DECLSPEC PartitionMap partition_network(
+    const Network &network, size_t partition_count,
+    const std::vector<std::vector<core::UID>> &colocated_populations = {});
+
+
+/**
+ * @brief Copy network populations and projections into a separate network for every partition.
+ * @param network network to split.
+ * @param partitions partition map created for the network.
+ * @return vector of networks, a network per partition.
+ */
+KNP_DECLSPEC std::vector<Network> split_network(const Network &network, const PartitionMap &partitions);
+
+}  // namespace knp::framework::partitioning
@@ -26,7 +26,10 @@
 #include <functional>
 #include <optional>
 #include <random>
+#include <stdexcept>
 #include <tuple>
+#include <utility>
+#include <vector>
 
 #include "synapse_generators.h"
 #include "synapse_parameters_generators.h"
@@ -72,6 +75,59 @@ template <typename SynapseType>
 }
 
 
+/**
+ * @brief Make a compact projection that connects each presynaptic population neuron to each postsynaptic population
+ * neuron.
+ * @details The connector makes the same connections as `all_to_all()`, but the projection stores only a weight matrix
+ * and delays instead of synapses. Delays are not stored if they are equal. Parameters other than weights and delays
+ * are taken from the first synapse.
+ * @param presynaptic_uid presynaptic population UID.
+ * @param postsynaptic_uid postsynaptic population UID.
+ * @param presynaptic_pop_size presynaptic population neuron count.
+ * @param postsynaptic_pop_size postsynaptic population neuron count.
+ * @param syn_gen generator of synapse parameters.
+ * @tparam SynapseType projection synapse type.
+ * @return compact projection.
+ * @throw std::invalid_argument if synapses have different output types.
+ * @see knp::core::Projection::make_dense().
+ */
+template <typename SynapseType>
+[[nodiscard]] knp::core::Projection<SynapseType> dense_all_to_all(
+    const knp::core::UID &presynaptic_uid, const knp::core::UID &postsynaptic_uid, size_t presynaptic_pop_size,
+    size_t postsynaptic_pop_size,
+    parameters_generators::SynGen2ParamsType<SynapseType> syn_gen =
+        parameters_generators::default_synapse_gen<SynapseType>)
+{
+    typename knp::core::Projection<SynapseType>::SynapseParameters parameters;
+    std::vector<float> weights;
+    std::vector<uint32_t> delays;
+    weights.reserve(presynaptic_pop_size * postsynaptic_pop_size);
+    delays.reserve(presynaptic_pop_size * postsynaptic_pop_size);
+    bool same_delays = true;
+
+    for (size_t presynaptic_index = 0; presynaptic_index < presynaptic_pop_size; ++presynaptic_index)
+    {
+        for (size_t postsynaptic_index = 0; postsynaptic_index < postsynaptic_pop_size; ++postsynaptic_index)
+        {
+            auto synapse_parameters = syn_gen(presynaptic_index, postsynaptic_index);
+            if (weights.empty()) parameters = synapse_parameters;
+            if (synapse_parameters.output_type_ != parameters.output_type_)
+            {
+                throw std::invalid_argument("Synapses of a dense projection must have the same output type.");
+            }
+            same_delays = same_delays && synapse_parameters.delay_ == parameters.delay_;
+            weights.push_back(synapse_parameters.weight_);
+            delays.push_back(synapse_parameters.delay_);
+        }
+    }
+    if (same_delays) delays.clear();
+
+    return knp::core::Projection<SynapseType>::make_dense(
+        presynaptic_uid, postsynaptic_uid, presynaptic_pop_size, postsynaptic_pop_size, std::move(weights),
+        std::move(delays), parameters);
+}
+
+
 /**
  * @brief Make one-to-one connections between neurons of presynaptic and postsynaptic populations.
  * @details Simple connector that generates connections from source neuron index to the same destination index.
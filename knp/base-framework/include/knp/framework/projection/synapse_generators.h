@@ -357,7 +357,7 @@ template <typename DestinationSynapseType, typename SourceSynapseType>
     return [&source_proj,
             syn_gen](size_t index) -> std::optional<typename knp::core::Projection<DestinationSynapseType>::Synapse>
     {
-        auto const &synapse = source_proj[index];
+        const auto synapse = source_proj.get_synapse(index);
         return std::make_tuple(
             syn_gen(index), std::get<knp::core::source_neuron_id>(synapse),
             std::get<knp::core::target_neuron_id>(synapse));
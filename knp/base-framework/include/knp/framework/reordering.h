@@ -0,0 +1,109 @@
+/**
+ * @file reordering.h
+ * @brief Routines that reorder neurons and synapses of a network to improve memory access locality.
+ * @kaspersky_support Artiom N.
+ * @date 18.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <knp/core/core.h>
+#include <knp/core/impexp.h>
+#include <knp/framework/io/output_channel.h>
+#include <knp/framework/network.h>
+
+#include <unordered_map>
+#include <vector>
+
+
+/**
+ * @brief Network reordering namespace.
+ * @details Reordering is an optional pass that is applied to a network before it is loaded to a backend. Synapses
+ * of a projection are processed in the order of their storage and neuron indexes are arbitrary, so processing of
+ * spikes and impacts accesses neurons and synapses randomly. Reordering places connected neurons and synapses
+ * that are processed together close to each other in memory.
+ */
+namespace knp::framework::reordering
+{
+
+/**
+ * @brief The NeuronIndexMap structure describes how neurons of network populations were reordered.
+ * @details Populations which neurons weren't reordered are not present in the map.
+ */
+struct KNP_DECLSPEC NeuronIndexMap
+{
+    /**
+     * @brief New neuron indexes by original neuron indexes.
+     */
+    std::unordered_map<core::UID, std::vector<size_t>, core::uid_hash> new_indexes_;
+
+    /**
+     * @brief Original neuron indexes by new neuron indexes.
+     */
+    std::unordered_map<core::UID, std::vector<size_t>, core::uid_hash> original_indexes_;
+};
+
+
+/**
+ * @brief Calculate a neuron order that reduces distance between indexes of connected neurons.
+ * @details The function uses the reverse Cuthill-McKee algorithm on the graph of all network neurons, in which
+ * neurons are connected if there is a synapse between them. Neurons of a population are numbered in the order
+ * of the graph nodes, so neurons connected to the same neurons get close indexes in all populations. Neurons
+ * of populations that aren't connected to other populations keep their order. Populations connected by compact
+ * projections are not reordered and are not present in the map.
+ * @param network network to analyze.
+ * @return neuron index map of all network populations.
+ */
+KNP_DECLSPEC NeuronIndexMap make_neuron_order(const Network &network);
+
+
+/**
+ * @brief Reorder neurons of network populations and change neuron indexes of synapses accordingly.
+ * @param network network to reorder.
+ * @param index_map new neuron indexes of populations.
+ * @throw std::logic_error if the map sizes don't match population sizes.
+ */
+KNP_DECLSPEC void reorder_neurons(Network &network, const NeuronIndexMap &index_map);
+
+
+/**
+ * @brief Sort synapses of all network projections by delay, presynaptic and postsynaptic neuron indexes.
+ * @details Synapses of the same presynaptic neuron and delay are stored together, so impacts delivered at the same
+ * step are calculated and accumulated in the order of neuron indexes. Synapses without delay are sorted by neuron
+ * indexes. Compact projections are not changed.
+ * @param network network which projections are sorted.
+ */
+KNP_DECLSPEC void sort_synapses(Network &network);
+
+
+/**
+ * @brief Reorder network neurons and sort synapses to improve memory access locality.
+ * @details The function calls `make_neuron_order()`, `reorder_neurons()` and `sort_synapses()`.
+ * @param network network to optimize.
+ * @return neuron index map used to restore original neuron indexes.
+ */
+KNP_DECLSPEC NeuronIndexMap optimize_locality(Network &network);
+
+
+/**
+ * @brief Make an output channel report original neuron indexes of reordered populations.
+ * @param channel output channel.
+ * @param index_map neuron index map returned by the reordering.
+ */
+KNP_DECLSPEC void restore_original_indexes(io::output::OutputChannel &channel, const NeuronIndexMap &index_map);
+
+}  // namespace knp::framework::reordering
@@ -24,12 +24,61 @@
 #include <knp/framework/network.h>
 
 #include <filesystem>
+#include <vector>
 
 /**
  * @brief SONATA namespace.
  */
 namespace knp::framework::sonata
 {
+/**
+ * @brief The SaveOptions structure describes how HDF5 datasets of a saved network are stored.
+ * @details Filters require chunked datasets. If a filter is enabled and the chunk size is zero, datasets
+ * are split into chunks of `default_chunk_size` elements.
+ */
+struct KNP_DECLSPEC SaveOptions
+{
+    /**
+     * @brief Chunk size used if a filter is enabled and no chunk size is set.
+     */
+    static constexpr size_t default_chunk_size = 1 << 16;
+
+    /**
+     * @brief Number of elements in a dataset chunk, `0` means contiguous datasets.
+     */
+    size_t chunk_size_ = 0;
+
+    /**
+     * @brief Deflate compression level from `1` to `9`, `0` disables deflate compression.
+     */
+    unsigned deflate_level_ = 0;
+
+    /**
+     * @brief Reorder bytes of dataset elements before compression to improve compression ratio.
+     */
+    bool shuffle_ = false;
+
+    /**
+     * @brief ID of an HDF5 filter plugin, `0` disables the filter.
+     * @details For example, `32004` is the LZ4 filter ID and `32015` is the Zstandard filter ID. The plugin must be
+     * available to HDF5 when the network is saved and loaded.
+     */
+    unsigned filter_id_ = 0;
+
+    /**
+     * @brief Parameters of the filter plugin.
+     */
+    std::vector<unsigned> filter_parameters_;
+
+    /**
+     * @brief Store parameters that have the same value for all neurons or synapses as scalar attributes.
+     * @details Files saved with this option are smaller, but other SONATA readers may expect parameter datasets.
+     * If the option is disabled, every parameter is stored as a dataset.
+     */
+    bool collapse_uniform_parameters_ = false;
+};
+
+
 /**
  * @brief Save network to disk.
  * @note The network is saved in the SONATA format.
@@ -39,6 +88,17 @@ namespace knp::framework::sonata
 KNP_DECLSPEC void save_network(const Network &network, const std::filesystem::path &dir);
 
 
+/**
+ * @brief Save network to disk with the given dataset storage options.
+ * @details Populations and projections are serialized in parallel, HDF5 files are written by a single thread.
+ * With default options, the file layout is the same as the layout of files saved without options.
+ * @param network network to save.
+ * @param dir directory to save the network.
+ * @param options dataset storage options.
+ */
+KNP_DECLSPEC void save_network(const Network &network, const std::filesystem::path &dir, const SaveOptions &options);
+
+
 /**
  * @brief Load network from disk.
  * @param config_path path to network configuration file.
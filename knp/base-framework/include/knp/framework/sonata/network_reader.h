@@ -0,0 +1,221 @@
+/**
+ * @file network_reader.h
+ * @brief Selective reading of networks saved in the SONATA format.
+ * @kaspersky_support Artiom N.
+ * @date 18.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <knp/core/impexp.h>
+#include <knp/core/population.h>
+#include <knp/core/projection.h>
+#include <knp/core/uid.h>
+#include <knp/framework/network.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+
+/**
+ * @brief SONATA namespace.
+ */
+namespace knp::framework::sonata
+{
+/**
+ * @brief Internal implementation namespace.
+ */
+namespace impl
+{
+/**
+ * @brief The NetworkFiles class is an internal class that keeps SONATA files of a network open.
+ */
+class NetworkFiles;
+}  // namespace impl
+
+
+/**
+ * @brief The EntityInfo structure describes a population or a projection stored in SONATA files.
+ */
+struct KNP_DECLSPEC EntityInfo
+{
+    /**
+     * @brief Entity UID.
+     */
+    core::UID uid_{false};
+
+    /**
+     * @brief Name of the neuron or synapse type, for example `knp:DeltaSynapse`.
+     */
+    std::string type_name_;
+
+    /**
+     * @brief Number of neurons in a population or number of synapses in a projection.
+     */
+    size_t size_ = 0;
+
+    /**
+     * @brief Presynaptic population UID of a projection.
+     */
+    core::UID presynaptic_uid_{false};
+
+    /**
+     * @brief Postsynaptic population UID of a projection.
+     */
+    core::UID postsynaptic_uid_{false};
+};
+
+
+/**
+ * @brief The ProjectionArrays class provides synapse arrays of a stored projection without loading the projection.
+ * @details Every array is read from the file on the first access and is kept in memory afterwards. Arrays
+ * are indexed by synapse indexes of the stored projection. The class is not thread-safe.
+ */
+class KNP_DECLSPEC ProjectionArrays
+{
+public:
+    /**
+     * @brief Get projection description.
+     * @return projection description.
+     */
+    [[nodiscard]] const EntityInfo &get_info() const { return info_; }
+
+    /**
+     * @brief Get presynaptic neuron indexes of synapses.
+     * @return presynaptic neuron indexes.
+     */
+    const std::vector<size_t> &get_source_ids();
+
+    /**
+     * @brief Get postsynaptic neuron indexes of synapses.
+     * @return postsynaptic neuron indexes.
+     */
+    const std::vector<size_t> &get_target_ids();
+
+    /**
+     * @brief Get synapse weights.
+     * @return synapse weights.
+     */
+    const std::vector<float> &get_weights();
+
+    /**
+     * @brief Get synapse delays.
+     * @return synapse delays.
+     */
+    const std::vector<uint32_t> &get_delays();
+
+private:
+    friend class NetworkReader;
+
+    ProjectionArrays(std::shared_ptr<const impl::NetworkFiles> files, EntityInfo info);
+
+    std::shared_ptr<const impl::NetworkFiles> files_;
+    EntityInfo info_;
+    std::optional<std::vector<size_t>> source_ids_;
+    std::optional<std::vector<size_t>> target_ids_;
+    std::optional<std::vector<float>> weights_;
+    std::optional<std::vector<uint32_t>> delays_;
+};
+
+
+/**
+ * @brief The NetworkReader class is a definition of a reader that loads selected parts of a network saved
+ * in the SONATA format.
+ * @details The reader keeps network files open. Descriptions of populations and projections are read from file
+ * metadata when the reader is created, data of entities are read only when they are loaded. Populations and
+ * projections of types that are not supported are not listed.
+ */
+class KNP_DECLSPEC NetworkReader
+{
+public:
+    /**
+     * @brief Open network files and read descriptions of stored populations and projections.
+     * @param config_path path to network configuration file.
+     * @throw std::runtime_error if network files can't be opened.
+     */
+    explicit NetworkReader(const std::filesystem::path &config_path);
+
+    /**
+     * @brief Get UID of the stored network.
+     * @return network UID.
+     */
+    [[nodiscard]] const core::UID &get_network_uid() const { return network_uid_; }
+
+    /**
+     * @brief Get descriptions of stored populations.
+     * @return population descriptions in the order of storage.
+     */
+    [[nodiscard]] const std::vector<EntityInfo> &get_populations() const { return populations_; }
+
+    /**
+     * @brief Get descriptions of stored projections.
+     * @return projection descriptions in the order of storage.
+     */
+    [[nodiscard]] const std::vector<EntityInfo> &get_projections() const { return projections_; }
+
+    /**
+     * @brief Load a population.
+     * @param uid population UID.
+     * @return loaded population.
+     * @throw std::logic_error if there is no such population.
+     */
+    [[nodiscard]] core::AllPopulationsVariant load_population(const core::UID &uid) const;
+
+    /**
+     * @brief Load a projection.
+     * @param uid projection UID.
+     * @return loaded projection.
+     * @throw std::logic_error if there is no such projection.
+     */
+    [[nodiscard]] core::AllProjectionsVariant load_projection(const core::UID &uid) const;
+
+    /**
+     * @brief Get synapse arrays of a projection that are read from the file on the first access.
+     * @param uid projection UID.
+     * @return synapse arrays of the projection.
+     * @throw std::logic_error if there is no such projection.
+     */
+    [[nodiscard]] ProjectionArrays get_projection_arrays(const core::UID &uid) const;
+
+    /**
+     * @brief Load the whole network.
+     * @details Projections are loaded in parallel.
+     * @return loaded network.
+     */
+    [[nodiscard]] Network load_network() const;
+
+    /**
+     * @brief Load a network that contains selected populations and projections.
+     * @details Projections connected to populations that are not selected are loaded unchanged.
+     * @param uids UIDs of populations and projections to load.
+     * @return network with the network UID of the stored network.
+     * @throw std::logic_error if there is no population or projection with one of the UIDs.
+     */
+    [[nodiscard]] Network load_network(const std::vector<core::UID> &uids) const;
+
+private:
+    std::shared_ptr<const impl::NetworkFiles> files_;
+    core::UID network_uid_{false};
+    std::vector<EntityInfo> populations_;
+    std::vector<EntityInfo> projections_;
+};
+
+}  // namespace knp::framework::sonata
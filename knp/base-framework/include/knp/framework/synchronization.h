@@ -25,6 +25,16 @@
 #include <knp/core/impexp.h>
 #include <knp/framework/network.h>
 
+#include <atomic>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
 
 /**
  * @brief Synchronization namespace.
@@ -38,4 +48,324 @@ namespace knp::framework::synchronization
  */
 KNP_DECLSPEC Network get_network_copy(const knp::core::Backend &backend);
 
+
+/**
+ * @brief The ParameterView class provides read-only access to a parameter of neurons or synapses without copying.
+ * @details Parameters are stored in structures of neurons or synapses, so values of one parameter are placed in
+ * memory with a constant stride. A view refers to backend storage and becomes invalid when the backend storage
+ * changes, for example when populations or projections are loaded, neurons or synapses are added or removed or a
+ * compact projection is converted to explicit storage. Values change during backend steps, use
+ * `read_between_steps()` to read them from another thread.
+ * @warning A view is valid only while the network structure is frozen. `read_between_steps()` detects value
+ * changes, but it doesn't make a view of released storage valid again. Don't change the network structure while
+ * other threads use views, and get new views after the structure is changed.
+ * @tparam Value parameter type.
+ */
+template <typename Value>
+class ParameterView
+{
+public:
+    /**
+     * @brief The ConstIterator class is a definition of an iterator over parameter values.
+     */
+    class ConstIterator
+    {
+    public:
+        /**
+         * @brief Iterator tag.
+         */
+        using iterator_category = std::forward_iterator_tag;
+        /**
+         * @brief Value type.
+         */
+        using value_type = Value;
+        /**
+         * @brief Difference type.
+         */
+        using difference_type = std::ptrdiff_t;
+        /**
+         * @brief Pointer type.
+         */
+        using pointer = const Value *;
+        /**
+         * @brief Reference type.
+         */
+        using reference = const Value &;
+
+        /**
+         * @brief Iterator constructor.
+         * @param view parameter view.
+         * @param index value index.
+         */
+        ConstIterator(const ParameterView &view, size_t index) : view_(&view), index_(index) {}
+
+        /**
+         * @brief Get parameter value.
+         * @return reference to the value in backend storage.
+         */
+        reference operator*() const { return (*view_)[index_]; }
+
+        /**
+         * @brief Increment an iterator.
+         * @return reference to iterator.
+         */
+        ConstIterator &operator++()
+        {
+            ++index_;
+            return *this;
+        }
+
+        /**
+         * @brief Iterator equality.
+         * @param other another iterator.
+         * @return `true` if both iterators point at the same value.
+         */
+        bool operator==(const ConstIterator &other) const { return view_ == other.view_ && index_ == other.index_; }
+
+        /**
+         * @brief Iterator inequality.
+         * @param other another iterator.
+         * @return `true` if iterators point at different values.
+         */
+        bool operator!=(const ConstIterator &other) const { return !(*this == other); }
+
+    private:
+        const ParameterView *view_;
+        size_t index_;
+    };
+
+public:
+    /**
+     * @brief Create an empty view.
+     */
+    ParameterView() = default;
+
+    /**
+     * @brief Create a view.
+     * @param data pointer to the first value.
+     * @param size number of values.
+     * @param stride distance between values in bytes.
+     */
+    ParameterView(const Value *data, size_t size, size_t stride)
+        : data_(reinterpret_cast<const char *>(data)), size_(size), stride_(stride)
+    {
+    }
+
+    /**
+     * @brief Get parameter value by neuron or synapse index.
+     * @param index neuron or synapse index.
+     * @return reference to the value in backend storage.
+     */
+    [[nodiscard]] const Value &operator[](size_t index) const
+    {
+        return *reinterpret_cast<const Value *>(data_ + index * stride_);
+    }
+
+    /**
+     * @brief Get number of values.
+     * @return number of neurons or synapses.
+     */
+    [[nodiscard]] size_t size() const { return size_; }
+
+    /**
+     * @brief Check if the view is empty.
+     * @return `true` if the view has no values.
+     */
+    [[nodiscard]] bool empty() const { return 0 == size_; }
+
+    /**
+     * @brief Get an iterator pointing to the first value.
+     * @return iterator.
+     */
+    [[nodiscard]] ConstIterator begin() const { return ConstIterator(*this, 0); }
+
+    /**
+     * @brief Get an iterator pointing to the end of values.
+     * @return iterator.
+     */
+    [[nodiscard]] ConstIterator end() const { return ConstIterator(*this, size_); }
+
+private:
+    const char *data_ = nullptr;
+    size_t size_ = 0;
+    size_t stride_ = 0;
+};
+
+
+/**
+ * @brief Get a view of a neuron parameter of a population loaded to the backend.
+ * @details To get potentials of BLIFAT neurons, call
+ * `get_neuron_parameter_view<BLIFATNeuron>(backend, uid, &neuron_parameters<BLIFATNeuron>::potential_)`.
+ * @tparam NeuronType neuron type of the population.
+ * @tparam Value parameter type.
+ * @tparam Parameters neuron parameter structure or its base that contains the parameter.
+ * @param backend backend with the population.
+ * @param population_uid population UID.
+ * @param parameter pointer to the parameter member.
+ * @return parameter values of population neurons.
+ * @throw std::logic_error if the backend doesn't provide the population or the population has another neuron type.
+ */
+template <typename NeuronType, typename Value, typename Parameters>
+ParameterView<Value> get_neuron_parameter_view(
+    const knp::core::Backend &backend, const knp::core::UID &population_uid, Value Parameters::*parameter)
+{
+    static_assert(
+        std::is_base_of_v<Parameters, knp::neuron_traits::neuron_parameters<NeuronType>>,
+        "Parameter doesn't belong to the neuron type.");
+
+    const auto pointer = backend.get_population_pointer(population_uid);
+    if (!pointer)
+    {
+        throw std::logic_error(
+            "Population with UID \"" + std::string(population_uid) + "\" isn't available in backend memory.");
+    }
+    const auto *population = std::get_if<const knp::core::Population<NeuronType> *>(&*pointer);
+    if (!population)
+    {
+        throw std::logic_error(
+            "Population with UID \"" + std::string(population_uid) + "\" has another neuron type.");
+    }
+
+    const auto &neurons = (*population)->get_neurons_parameters();
+    if (neurons.empty()) return {};
+    return ParameterView<Value>(&(neurons.front().*parameter), neurons.size(), sizeof(neurons.front()));
+}
+
+
+/**
+ * @brief Get a view of a synapse parameter of a projection loaded to the backend.
+ * @tparam SynapseType synapse type of the projection.
+ * @tparam Value parameter type.
+ * @tparam Parameters synapse parameter structure or its base that contains the parameter.
+ * @param backend backend with the projection.
+ * @param projection_uid projection UID.
+ * @param parameter pointer to the parameter member.
+ * @return parameter values of projection synapses in the order of synapse indexes.
+ * @throw std::logic_error if the backend doesn't provide the projection, the projection has another synapse type
+ * or it is compact.
+ */
+template <typename SynapseType, typename Value, typename Parameters>
+ParameterView<Value> get_synapse_parameter_view(
+    const knp::core::Backend &backend, const knp::core::UID &projection_uid, Value Parameters::*parameter)
+{
+    using ProjectionType = knp::core::Projection<SynapseType>;
+    static_assert(
+        std::is_base_of_v<Parameters, typename ProjectionType::SynapseParameters>,
+        "Parameter doesn't belong to the synapse type.");
+
+    const auto pointer = backend.get_projection_pointer(projection_uid);
+    if (!pointer)
+    {
+        throw std::logic_error(
+            "Projection with UID \"" + std::string(projection_uid) + "\" isn't available in backend memory.");
+    }
+    const auto *projection = std::get_if<const ProjectionType *>(&*pointer);
+    if (!projection)
+    {
+        throw std::logic_error(
+            "Projection with UID \"" + std::string(projection_uid) + "\" has another synapse type.");
+    }
+    if ((*projection)->is_compact())
+    {
+        throw std::logic_error(
+            "Projection with UID \"" + std::string(projection_uid) + "\" is compact and has only weights.");
+    }
+
+    if (0 == (*projection)->size()) return {};
+    const auto &first_synapse = std::get<knp::core::synapse_data>(*(*projection)->begin());
+    return ParameterView<Value>(
+        &(first_synapse.*parameter), (*projection)->size(), sizeof(typename ProjectionType::Synapse));
+}
+
+
+/**
+ * @brief Get a view of synapse weights of a projection loaded to the backend.
+ * @details Weights of a compact projection are in the order defined by its synapse block.
+ * @param backend backend with the projection.
+ * @param projection_uid projection UID.
+ * @return synapse weights.
+ * @throw std::logic_error if the backend doesn't provide the projection.
+ */
+inline ParameterView<float> get_weights_view(const knp::core::Backend &backend, const knp::core::UID &projection_uid)
+{
+    const auto pointer = backend.get_projection_pointer(projection_uid);
+    if (!pointer)
+    {
+        throw std::logic_error(
+            "Projection with UID \"" + std::string(projection_uid) + "\" isn't available in backend memory.");
+    }
+
+    return std::visit(
+        [](const auto *projection) -> ParameterView<float>
+        {
+            if (projection->is_compact())
+            {
+                const auto &weights = projection->get_block_weights();
+                return {weights.data(), weights.size(), sizeof(float)};
+            }
+            if (0 == projection->size()) return {};
+            using Synapse = typename std::decay_t<decltype(*projection)>::Synapse;
+            return {
+                &std::get<knp::core::synapse_data>(*projection->begin()).weight_, projection->size(),
+                sizeof(Synapse)};
+        },
+        *pointer);
+}
+
+
+/**
+ * @brief Read network data of a backend so that all data belongs to the same step.
+ * @details The function calls `read` again if the backend executed a step during the call, so `read` must copy
+ * the data it needs and must not have side effects. If `read` is called by the thread that executes the backend,
+ * for example from a step predicate, it is called once. After several failed attempts the function pauses the
+ * backend with `knp::core::Backend::PauseGuard` and reads the data while no step runs, so reading finishes even
+ * if steps run back-to-back.
+ * @note Repeating `read` doesn't protect against structural changes such as removal of neurons. Views and pointers
+ * used by `read` must stay valid for the whole call, so the network structure must not change while it runs.
+ * @note Network data is not atomic. An attempt that overlaps a step reads data that the backend writes at the same
+ * time, which is a data race in terms of the C++ memory model: the result of such an attempt is discarded, but
+ * `read` must only copy trivially copyable values and must not follow pointers read from network data. Reading
+ * while the backend is paused has no concurrent writers.
+ * @warning Don't call the function inside a step, for example from a message handler.
+ * @tparam Function type of the reading function.
+ * @param backend backend that executes the network.
+ * @param read function that reads data using views or pointers and returns a result.
+ * @return result of `read`.
+ */
+template <typename Function>
+auto read_between_steps(const knp::core::Backend &backend, Function &&read)
+{
+    // Number of optimistic attempts, including waits for the end of a step, before the backend is paused.
+    constexpr size_t optimistic_attempts = 64;
+
+    for (size_t attempt = 0; attempt < optimistic_attempts; ++attempt)
+    {
+        const uint64_t sequence = backend.get_update_sequence();
+        // The backend is changing the network.
+        if (sequence % 2 != 0)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        auto result = read();
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (backend.get_update_sequence() == sequence) return result;
+    }
+
+    const knp::core::Backend::PauseGuard pause_guard{backend};
+    while (true)
+    {
+        // An update that started before the pause request could slip in, it is the only one to wait for.
+        const uint64_t sequence = backend.get_update_sequence();
+        if (sequence % 2 != 0)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        auto result = read();
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (backend.get_update_sequence() == sequence) return result;
+    }
+}
+
 }  // namespace knp::framework::synchronization
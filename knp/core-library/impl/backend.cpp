@@ -24,6 +24,8 @@
 
 #include <spdlog/spdlog.h>
 
+#include <stdexcept>
+
 
 namespace knp::core
 {
@@ -134,6 +136,91 @@ void Backend::start(const RunPredicate& pre_step, const RunPredicate& post_step)
 }
 
 
+void Backend::run_steps(size_t steps_count)
+{
+    pre_start();
+
+    try
+    {
+        for (; steps_count && running(); --steps_count)
+        {
+            _step();
+        }
+    }
+    catch (...)
+    {
+        started_ = false;
+        throw;
+    }
+}
+
+
+void Backend::load_all_projections(std::vector<AllProjectionsVariant>&& projections)
+{
+    load_all_projections(static_cast<const std::vector<AllProjectionsVariant>&>(projections));
+    projections.clear();
+    projections.shrink_to_fit();
+}
+
+
+void Backend::load_all_populations(std::vector<AllPopulationsVariant>&& populations)
+{
+    load_all_populations(static_cast<const std::vector<AllPopulationsVariant>&>(populations));
+    populations.clear();
+    populations.shrink_to_fit();
+}
+
+
+void Backend::deliver_bulk_inputs()
+{
+    for (auto &bulk_input : bulk_inputs_)
+    {
+        const auto &spikes = bulk_input.input_.get_spikes(step_);
+        if (spikes.empty()) continue;
+        auto &message = std::get<messaging::SpikeMessage>(bulk_input.message_);
+        message.header_.send_time_ = step_;
+        message.neuron_indexes_.assign(spikes.begin(), spikes.end());
+        message_endpoint_.deliver_message(bulk_input.message_);
+    }
+}
+
+
+DynamicState Backend::get_dynamic_state() const
+{
+    DynamicState result;
+    result.step_ = step_;
+    auto data_ranges = get_network_data();
+    for (auto& iter = *data_ranges.population_range.first; iter != *data_ranges.population_range.second; ++iter)
+    {
+        result.populations_.push_back(std::visit([](const auto& pop) { return core::get_dynamic_state(pop); }, *iter));
+    }
+    for (auto& iter = *data_ranges.projection_range.first; iter != *data_ranges.projection_range.second; ++iter)
+    {
+        result.projections_.push_back(
+            std::visit([](const auto& proj) { return core::get_dynamic_state(proj); }, *iter));
+    }
+    return result;
+}
+
+
+void Backend::set_dynamic_state(const DynamicState& state)
+{
+    throw std::logic_error("Backend " + std::string(base_.uid_) + " doesn't support restoring dynamic state.");
+}
+
+
+std::optional<Backend::PopulationConstPointer> Backend::get_population_pointer(const UID& uid) const
+{
+    return std::nullopt;
+}
+
+
+std::optional<Backend::ProjectionConstPointer> Backend::get_projection_pointer(const UID& uid) const
+{
+    return std::nullopt;
+}
+
+
 void Backend::stop()
 {
     if (!running())
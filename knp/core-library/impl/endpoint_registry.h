@@ -0,0 +1,108 @@
+/**
+ * @file endpoint_registry.h
+ * @brief Registry of endpoints created by a message bus.
+ * @kaspersky_support Artiom N.
+ * @date 18.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <knp/core/message_endpoint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+
+namespace knp::core::messaging::impl
+{
+/**
+ * @brief Registry of endpoints created by a message bus.
+ * @details The registry is shared by the bus and its endpoints. Endpoints add themselves on creation and remove
+ * themselves on destruction, so the registry can outlive the bus. The registry version changes every time
+ * subscriptions of the endpoints change, so results of `has_subscription()` can be cached until the next change.
+ */
+class EndpointRegistry
+{
+public:
+    /**
+     * @brief Add an endpoint to the registry.
+     * @param endpoint endpoint to add.
+     */
+    void add(const MessageEndpoint *endpoint)
+    {
+        const std::lock_guard lock(mutex_);
+        endpoints_.push_back(endpoint);
+    }
+
+    /**
+     * @brief Replace an endpoint after it was moved.
+     * @param old_endpoint moved endpoint.
+     * @param endpoint endpoint that received subscriptions of the moved endpoint.
+     */
+    void replace(const MessageEndpoint *old_endpoint, const MessageEndpoint *endpoint)
+    {
+        const std::lock_guard lock(mutex_);
+        std::replace(endpoints_.begin(), endpoints_.end(), old_endpoint, endpoint);
+        update_version();
+    }
+
+    /**
+     * @brief Remove an endpoint from the registry.
+     * @param endpoint endpoint to remove.
+     */
+    void remove(const MessageEndpoint *endpoint)
+    {
+        const std::lock_guard lock(mutex_);
+        endpoints_.erase(std::remove(endpoints_.begin(), endpoints_.end(), endpoint), endpoints_.end());
+        update_version();
+    }
+
+    /**
+     * @brief Get version of endpoint subscriptions.
+     * @return version that changes every time subscriptions of the endpoints change.
+     */
+    [[nodiscard]] uint64_t get_version() const { return version_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Notify the registry that subscriptions of an endpoint changed.
+     */
+    void update_version() { version_.fetch_add(1, std::memory_order_acq_rel); }
+
+    /**
+     * @brief Check if any registered endpoint has a subscription to messages of a sender.
+     * @param type_index index of the message type in the message variant.
+     * @param sender sender UID.
+     * @param ignored_receiver receiver which subscriptions are not taken into account.
+     * @return `true` if a receiver other than `ignored_receiver` is subscribed to messages of the sender.
+     */
+    [[nodiscard]] bool has_subscription(size_t type_index, const UID &sender, const UID &ignored_receiver) const
+    {
+        const std::lock_guard lock(mutex_);
+        return std::any_of(
+            endpoints_.begin(), endpoints_.end(), [type_index, &sender, &ignored_receiver](const auto *endpoint)
+            { return endpoint->has_subscription(type_index, sender, ignored_receiver); });
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::vector<const MessageEndpoint *> endpoints_;
+    std::atomic<uint64_t> version_ = 0;
+};
+
+}  // namespace knp::core::messaging::impl
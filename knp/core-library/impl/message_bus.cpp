@@ -26,7 +26,9 @@
 
 #include <zmq.hpp>
 
+#include "endpoint_registry.h"
 #include "message_bus_cpu_impl/message_bus_cpu_impl.h"
+#include "message_bus_shm_impl/message_bus_shm_impl.h"
 #include "message_bus_zmq_impl/message_bus_zmq_impl.h"
 
 
@@ -48,7 +50,16 @@ MessageBus MessageBus::construct_zmq_bus()
 }
 
 
-MessageBus::MessageBus(std::unique_ptr<messaging::impl::MessageBusImpl> &&impl) : impl_(std::move(impl))
+MessageBus MessageBus::construct_shm_bus(
+    const std::string &name, size_t process_count, size_t max_endpoints, size_t buffer_size)
+{
+    return MessageBus(
+        std::make_unique<messaging::impl::MessageBusSHMImpl>(name, process_count, max_endpoints, buffer_size));
+}
+
+
+MessageBus::MessageBus(std::unique_ptr<messaging::impl::MessageBusImpl> &&impl)
+    : impl_(std::move(impl)), endpoints_(std::make_shared<messaging::impl::EndpointRegistry>())
 {
     if (!impl_)
     {
@@ -59,7 +70,22 @@ MessageBus::MessageBus(std::unique_ptr<messaging::impl::MessageBusImpl> &&impl)
 
 MessageEndpoint MessageBus::create_endpoint()
 {
-    return impl_->create_endpoint();
+    auto endpoint = impl_->create_endpoint();
+    endpoint.bus_endpoints_ = endpoints_;
+    endpoints_->add(&endpoint);
+    return endpoint;
+}
+
+
+bool MessageBus::has_subscription(size_t type_index, const UID &sender, const UID &ignored_receiver) const
+{
+    return endpoints_->has_subscription(type_index, sender, ignored_receiver);
+}
+
+
+uint64_t MessageBus::get_subscription_version() const
+{
+    return endpoints_->get_version();
 }
 
 
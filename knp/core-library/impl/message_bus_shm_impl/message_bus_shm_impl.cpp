@@ -0,0 +1,502 @@
+/**
+ * @file message_bus_shm_impl.cpp
+ * @brief Shared memory message bus implementation.
+ * @kaspersky_support Artiom N.
+ * @date 18.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <message_bus_shm_impl/message_bus_shm_impl.h>
+#include <message_bus_shm_impl/message_endpoint_shm_impl.h>
+#include <messaging/message_envelope_impl.h>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+
+#if defined(_WIN32)
+#    define NOMINMAX
+#    include <windows.h>
+#else
+#    include <signal.h>
+#    include <unistd.h>
+
+#    include <cerrno>
+#endif
+
+
+/**
+ * @brief Namespace for implementations of message bus.
+ */
+namespace knp::core::messaging::impl
+{
+
+namespace bip = boost::interprocess;
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "Shared memory bus requires lock-free 64-bit atomics.");
+
+namespace
+{
+// "KNP_SHM1".
+constexpr uint64_t segment_magic = 0x4b4e505f53484d31;
+// "KNP_SHM0": the segment is being removed, because it was left by stopped processes.
+constexpr uint64_t stale_segment_magic = 0x4b4e505f53484d30;
+// Time during which the segment creator must initialize the segment.
+constexpr auto segment_init_timeout = std::chrono::seconds(10);
+// Keep segment parts on separate cache lines.
+constexpr size_t segment_alignment = 64;
+// Number of barrier checks before the waiting process starts yielding the CPU.
+constexpr size_t barrier_spin_count = 1 << 14;
+
+
+constexpr size_t align_size(size_t size)
+{
+    return (size + segment_alignment - 1) / segment_alignment * segment_alignment;
+}
+
+
+constexpr size_t get_process_ids_offset()
+{
+    return align_size(sizeof(MessageBusSHMImpl::SegmentHeader));
+}
+
+
+constexpr size_t get_slots_offset(size_t process_count)
+{
+    return get_process_ids_offset() + align_size(process_count * sizeof(std::atomic<uint64_t>));
+}
+
+
+constexpr size_t get_data_offset(size_t process_count, size_t max_endpoints)
+{
+    return get_slots_offset(process_count) + align_size(max_endpoints * sizeof(MessageBusSHMImpl::EndpointSlot));
+}
+
+
+uint64_t get_process_id()
+{
+#if defined(_WIN32)
+    return ::GetCurrentProcessId();
+#else
+    return static_cast<uint64_t>(::getpid());
+#endif
+}
+
+
+bool is_process_alive(uint64_t process_id)
+{
+#if defined(_WIN32)
+    const HANDLE process = ::OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, static_cast<DWORD>(process_id));
+    // The process exists, but belongs to another user.
+    if (!process) return ::GetLastError() == ERROR_ACCESS_DENIED;
+    DWORD exit_code = 0;
+    const bool is_alive = ::GetExitCodeProcess(process, &exit_code) && STILL_ACTIVE == exit_code;
+    ::CloseHandle(process);
+    return is_alive;
+#else
+    return !::kill(static_cast<pid_t>(process_id), 0) || EPERM == errno;
+#endif
+}
+
+
+// FlatBuffers allocator that gives the builder a slot buffer, so batches are built directly in the shared memory.
+class SlotAllocator : public ::flatbuffers::Allocator
+{
+public:
+    SlotAllocator(uint8_t *buffer, size_t size) : buffer_(buffer), size_(size) {}
+
+    uint8_t *allocate(size_t size) override
+    {
+        if (size > size_) throw_overflow(size);
+        return buffer_;
+    }
+
+    void deallocate(uint8_t *, size_t) override {}
+
+    uint8_t *reallocate_downward(uint8_t *, size_t, size_t new_size, size_t, size_t) override
+    {
+        throw_overflow(new_size);
+        return nullptr;
+    }
+
+private:
+    [[noreturn]] void throw_overflow(size_t size) const
+    {
+        throw std::runtime_error(
+            "Message batch needs " + std::to_string(size) + " bytes, but the shared memory buffer has only " +
+            std::to_string(size_) + " bytes.");
+    }
+
+    uint8_t *buffer_;
+    size_t size_;
+};
+}  // namespace
+
+
+class MessageEndpointSHM : public MessageEndpoint
+{
+public:
+    explicit MessageEndpointSHM(std::shared_ptr<MessageEndpointSHMImpl> &&ptr) { impl_ = std::move(ptr); }
+};
+
+
+MessageBusSHMImpl::MessageBusSHMImpl(
+    const std::string &name, size_t process_count, size_t max_endpoints, size_t buffer_size)
+    : name_(name)
+{
+    if (!process_count || !max_endpoints || !buffer_size)
+    {
+        throw std::invalid_argument("Shared memory bus parameters must be non-zero.");
+    }
+
+    buffer_size = align_size(buffer_size);
+    // A stale segment is removed, after that the bus creates or attaches to a new one.
+    while (!open_segment(process_count, max_endpoints, buffer_size))
+    {
+        region_ = bip::mapped_region();
+        shm_ = bip::shared_memory_object();
+        std::this_thread::yield();
+    }
+    join_segment();
+}
+
+
+MessageBusSHMImpl::~MessageBusSHMImpl()
+{
+    if (!header_) return;
+
+    process_ids_[process_index_].store(0, std::memory_order_release);
+    if (header_->attached_count_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        SPDLOG_DEBUG("Removing shared memory segment \"{}\"...", name_);
+        bip::shared_memory_object::remove(name_.c_str());
+    }
+}
+
+
+bool MessageBusSHMImpl::open_segment(size_t process_count, size_t max_endpoints, size_t buffer_size)
+{
+    const size_t segment_size = get_data_offset(process_count, max_endpoints) + 2 * max_endpoints * buffer_size;
+    const auto init_deadline = std::chrono::steady_clock::now() + segment_init_timeout;
+    bool is_creator = true;
+
+    try
+    {
+        SPDLOG_DEBUG("Creating shared memory segment \"{}\" of {} bytes...", name_, segment_size);
+        shm_ = bip::shared_memory_object(bip::create_only, name_.c_str(), bip::read_write);
+        shm_.truncate(static_cast<bip::offset_t>(segment_size));
+    }
+    catch (const bip::interprocess_exception &e)
+    {
+        if (e.get_error_code() != bip::already_exists_error)
+        {
+            SPDLOG_CRITICAL(e.what());
+            throw;
+        }
+
+        SPDLOG_DEBUG("Attaching to the existing shared memory segment \"{}\"...", name_);
+        is_creator = false;
+        try
+        {
+            shm_ = bip::shared_memory_object(bip::open_only, name_.c_str(), bip::read_write);
+        }
+        catch (const bip::interprocess_exception &)
+        {
+            // The segment was removed after the creation attempt.
+            return false;
+        }
+
+        // Wait until the creator sets the segment size.
+        bip::offset_t size = 0;
+        while (!shm_.get_size(size) || static_cast<size_t>(size) < get_process_ids_offset())
+        {
+            if (std::chrono::steady_clock::now() > init_deadline)
+            {
+                SPDLOG_WARN("Shared memory segment \"{}\" has no size, it is created again.", name_);
+                bip::shared_memory_object::remove(name_.c_str());
+                return false;
+            }
+            std::this_thread::yield();
+        }
+    }
+
+    region_ = bip::mapped_region(shm_, bip::read_write);
+
+    auto *base = static_cast<uint8_t *>(region_.get_address());
+    header_ = reinterpret_cast<SegmentHeader *>(base);
+    if (is_creator)
+    {
+        header_ = new (base) SegmentHeader{};
+        header_->process_count_ = process_count;
+        header_->max_endpoints_ = max_endpoints;
+        header_->buffer_size_ = buffer_size;
+        process_ids_ = reinterpret_cast<std::atomic<uint64_t> *>(base + get_process_ids_offset());
+        for (size_t process_index = 0; process_index < process_count; ++process_index)
+        {
+            new (process_ids_ + process_index) std::atomic<uint64_t>(0);
+        }
+        slots_ = reinterpret_cast<EndpointSlot *>(base + get_slots_offset(process_count));
+        for (size_t slot_index = 0; slot_index < max_endpoints; ++slot_index)
+        {
+            new (slots_ + slot_index) EndpointSlot{};
+        }
+        data_ = base + get_data_offset(process_count, max_endpoints);
+        header_->magic_.store(segment_magic, std::memory_order_release);
+        return true;
+    }
+
+    uint64_t magic = header_->magic_.load(std::memory_order_acquire);
+    for (; magic != segment_magic; magic = header_->magic_.load(std::memory_order_acquire))
+    {
+        // Another bus instance is removing the segment.
+        if (stale_segment_magic == magic) return false;
+        // The creator stopped before the segment was initialized.
+        if (std::chrono::steady_clock::now() > init_deadline) return reclaim_segment(magic);
+        std::this_thread::yield();
+    }
+
+    if (region_.get_size() < get_data_offset(header_->process_count_, header_->max_endpoints_))
+    {
+        throw std::runtime_error("Shared memory segment \"" + name_ + "\" is damaged.");
+    }
+    process_ids_ = reinterpret_cast<std::atomic<uint64_t> *>(base + get_process_ids_offset());
+    if (is_segment_stale()) return reclaim_segment(magic);
+
+    if (header_->process_count_ != process_count || header_->max_endpoints_ != max_endpoints ||
+        header_->buffer_size_ != buffer_size)
+    {
+        throw std::runtime_error("Shared memory bus \"" + name_ + "\" was created with different parameters.");
+    }
+    slots_ = reinterpret_cast<EndpointSlot *>(base + get_slots_offset(process_count));
+    data_ = base + get_data_offset(process_count, max_endpoints);
+    return true;
+}
+
+
+bool MessageBusSHMImpl::is_segment_stale() const
+{
+    const size_t joined_count =
+        std::min<size_t>(header_->joined_count_.load(std::memory_order_acquire), header_->process_count_);
+    for (size_t process_index = 0; process_index < joined_count; ++process_index)
+    {
+        const uint64_t process_id = process_ids_[process_index].load(std::memory_order_acquire);
+        if (process_id && !is_process_alive(process_id)) return true;
+    }
+    return false;
+}
+
+
+bool MessageBusSHMImpl::reclaim_segment(uint64_t magic)
+{
+    // Only one bus instance removes the segment, others retry after it is removed.
+    if (header_->magic_.compare_exchange_strong(magic, stale_segment_magic, std::memory_order_acq_rel))
+    {
+        SPDLOG_WARN("Shared memory segment \"{}\" was left by stopped processes, it is created again.", name_);
+        bip::shared_memory_object::remove(name_.c_str());
+    }
+    header_ = nullptr;
+    return false;
+}
+
+
+void MessageBusSHMImpl::join_segment()
+{
+    process_index_ = header_->joined_count_.fetch_add(1, std::memory_order_acq_rel);
+    if (process_index_ >= header_->process_count_)
+    {
+        header_->joined_count_.fetch_sub(1, std::memory_order_acq_rel);
+        throw std::runtime_error(
+            "Shared memory bus \"" + name_ + "\" is already used by " + std::to_string(header_->process_count_) +
+            " bus instances.");
+    }
+    process_ids_[process_index_].store(get_process_id(), std::memory_order_release);
+    header_->attached_count_.fetch_add(1, std::memory_order_acq_rel);
+}
+
+
+void MessageBusSHMImpl::check_segment_errors() const
+{
+    if (header_->error_count_.load(std::memory_order_acquire))
+    {
+        throw std::runtime_error(
+            "Shared memory bus \"" + name_ + "\" failed, because a bus instance couldn't write its messages.");
+    }
+}
+
+
+uint8_t *MessageBusSHMImpl::get_buffer(size_t slot_index, size_t parity) const
+{
+    return data_ + (2 * slot_index + parity) * header_->buffer_size_;
+}
+
+
+void MessageBusSHMImpl::write_batch(size_t slot_index, const std::vector<messaging::MessageVariant> &messages)
+{
+    const size_t parity = phase_ % 2;
+    auto &used_size = slots_[slot_index].used_size_[parity];
+
+    if (messages.empty())
+    {
+        used_size.store(0, std::memory_order_relaxed);
+        return;
+    }
+
+    // The builder reserves the whole buffer at once and fills it from the end.
+    SlotAllocator allocator(get_buffer(slot_index, parity), header_->buffer_size_);
+    ::flatbuffers::FlatBufferBuilder builder(header_->buffer_size_, &allocator);
+    knp::core::messaging::pack_to_batch(builder, messages);
+    used_size.store(builder.GetSize(), std::memory_order_release);
+}
+
+
+void MessageBusSHMImpl::wait_barrier()
+{
+    const auto generation = header_->barrier_generation_.load(std::memory_order_acquire);
+
+    if (header_->barrier_count_.fetch_add(1, std::memory_order_acq_rel) + 1 == header_->process_count_)
+    {
+        // The last process opens the barrier.
+        header_->barrier_count_.store(0, std::memory_order_relaxed);
+        header_->barrier_generation_.fetch_add(1, std::memory_order_release);
+        return;
+    }
+
+    // In the steady state other processes arrive soon, so spinning avoids system calls.
+    for (size_t spin = 0; header_->barrier_generation_.load(std::memory_order_acquire) == generation; ++spin)
+    {
+        if (spin > barrier_spin_count)
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+
+void MessageBusSHMImpl::update()
+{
+    const std::lock_guard lock(mutex_);
+    // All bus instances found the failure after the same barrier, so nobody waits for the others.
+    check_segment_errors();
+
+    std::exception_ptr write_error;
+    auto iter = endpoints_.begin();
+    while (iter != endpoints_.end())
+    {
+        auto endpoint_ptr = iter->first.lock();
+        // Slots of expired endpoints will be cleared.
+        if (!endpoint_ptr)
+        {
+            released_slots_.push_back(iter->second);
+            endpoints_.erase(iter++);
+            continue;
+        }
+
+        try
+        {
+            write_batch(iter->second, endpoint_ptr->unload_sent_messages());
+        }
+        catch (...)
+        {
+            // Other processes wait at the barrier, so the error is reported after it.
+            slots_[iter->second].used_size_[phase_ % 2].store(0, std::memory_order_relaxed);
+            if (!write_error) write_error = std::current_exception();
+        }
+        ++iter;
+    }
+
+    for (const auto slot_index : released_slots_)
+    {
+        slots_[slot_index].used_size_[phase_ % 2].store(0, std::memory_order_relaxed);
+    }
+    if (write_error) header_->error_count_.fetch_add(1, std::memory_order_acq_rel);
+
+    SPDLOG_TRACE("Waiting for other processes, phase = {}...", phase_);
+    wait_barrier();
+
+    ++phase_;
+    if (write_error) std::rethrow_exception(write_error);
+    check_segment_errors();
+    delivered_ = false;
+}
+
+
+size_t MessageBusSHMImpl::step()
+{
+    const std::lock_guard lock(mutex_);
+
+    // All messages of the phase are delivered at once.
+    if (delivered_) return 0;
+    delivered_ = true;
+
+    const size_t parity = (phase_ - 1) % 2;
+    const size_t slot_count = std::min<size_t>(
+        header_->endpoint_count_.load(std::memory_order_acquire), header_->max_endpoints_);
+    size_t message_counter = 0;
+
+    for (size_t slot_index = 0; slot_index < slot_count; ++slot_index)
+    {
+        const size_t used_size = slots_[slot_index].used_size_[parity].load(std::memory_order_acquire);
+        if (!used_size) continue;
+
+        // The batch occupies the end of the buffer.
+        const auto *buffer = get_buffer(slot_index, parity) + header_->buffer_size_ - used_size;
+        for (const auto &endpoint : endpoints_)
+        {
+            auto recv_ptr = endpoint.first.lock();
+            // Skip all endpoints deleted after previous update(). They will be deleted at the next update().
+            if (!recv_ptr) continue;
+            message_counter += recv_ptr->add_received_batch(buffer);
+        }
+    }
+
+    return message_counter;
+}
+
+
+core::MessageEndpoint MessageBusSHMImpl::create_endpoint()
+{
+    const std::lock_guard lock(mutex_);
+
+    size_t slot_index = 0;
+    if (!released_slots_.empty())
+    {
+        slot_index = released_slots_.back();
+        released_slots_.pop_back();
+    }
+    else
+    {
+        slot_index = header_->endpoint_count_.fetch_add(1, std::memory_order_acq_rel);
+        if (slot_index >= header_->max_endpoints_)
+        {
+            throw std::runtime_error("Shared memory bus \"" + name_ + "\" has no free endpoint slots.");
+        }
+    }
+
+    SPDLOG_DEBUG("Creating shared memory endpoint in the slot {}...", slot_index);
+
+    auto endpoint_impl = std::make_shared<MessageEndpointSHMImpl>(slot_index);
+    endpoints_.emplace_back(endpoint_impl, slot_index);
+
+    return MessageEndpointSHM(std::move(endpoint_impl));
+}
+
+}  // namespace knp::core::messaging::impl
@@ -0,0 +1,163 @@
+/**
+ * @file message_bus_shm_impl.h
+ * @brief Shared memory message bus implementation header.
+ * @kaspersky_support Artiom N.
+ * @date 18.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <knp/core/message_bus.h>
+
+#include <message_bus_impl.h>
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+
+
+/**
+ * @brief Namespace for implementations of message bus.
+ */
+namespace knp::core::messaging::impl
+{
+class MessageEndpointSHMImpl;
+
+/**
+ * @brief Message bus that exchanges messages between processes via a POSIX shared memory segment.
+ * @details Every endpoint owns a slot with two buffers in the shared memory. During the routing phase `N` an
+ * endpoint builds its messages as one batch directly in the buffer `N % 2` of its slot, the batch ends at the buffer
+ * end. Then all bus instances wait on
+ * a barrier in the shared memory, after which every endpoint reads the batches of all slots for the phase `N`.
+ * The next barrier guarantees that nobody reads the buffer `N % 2` when it is rewritten during the phase `N + 2`.
+ * All bus instances attached to the segment must call `MessageBus::route_messages()` the same number of times.
+ * If a bus instance fails to write its messages, it still passes the barrier and marks the segment as failed, so
+ * all bus instances throw an exception in the same phase. The segment stores process IDs of the bus instances. A
+ * segment with a stopped process is left by a crash, so it is removed and created again.
+ */
+class MessageBusSHMImpl : public MessageBusImpl
+{
+public:
+    /**
+     * @brief Create or attach to the shared memory segment.
+     * @details A segment that was left by stopped processes is created again.
+     * @param name segment name.
+     * @param process_count number of bus instances that share the segment and take part in the barrier.
+     * @param max_endpoints maximum number of endpoints in all processes.
+     * @param buffer_size size of a single endpoint buffer in bytes.
+     */
+    MessageBusSHMImpl(const std::string &name, size_t process_count, size_t max_endpoints, size_t buffer_size);
+
+    /**
+     * @brief Detach from the shared memory segment and remove it if the bus is the last user.
+     */
+    ~MessageBusSHMImpl() override;
+
+    /**
+     * @brief Write messages sent by local endpoints to the segment and wait until all bus instances do the same.
+     */
+    void update() override;
+
+    /**
+     * @brief Deliver all messages written during the current phase to local endpoints.
+     * @return number of delivered messages, zero if the messages of the current phase were already delivered.
+     */
+    size_t step() override;
+
+    /**
+     * @brief Create an endpoint that can be used for message exchange.
+     * @return new endpoint.
+     */
+    [[nodiscard]] core::MessageEndpoint create_endpoint() override;
+
+public:
+    /**
+     * @brief Segment header placed at the beginning of the shared memory.
+     */
+    struct SegmentHeader
+    {
+        // cppcheck-suppress unusedStructMember
+        std::atomic<uint64_t> magic_;
+        // cppcheck-suppress unusedStructMember
+        uint64_t process_count_;
+        // cppcheck-suppress unusedStructMember
+        uint64_t max_endpoints_;
+        // cppcheck-suppress unusedStructMember
+        uint64_t buffer_size_;
+        // cppcheck-suppress unusedStructMember
+        std::atomic<uint64_t> endpoint_count_;
+        // cppcheck-suppress unusedStructMember
+        std::atomic<uint64_t> attached_count_;
+        // cppcheck-suppress unusedStructMember
+        std::atomic<uint64_t> barrier_count_;
+        // cppcheck-suppress unusedStructMember
+        std::atomic<uint64_t> barrier_generation_;
+        // cppcheck-suppress unusedStructMember
+        std::atomic<uint64_t> joined_count_;
+        // cppcheck-suppress unusedStructMember
+        std::atomic<uint64_t> error_count_;
+    };
+
+    /**
+     * @brief Endpoint slot: sizes of the data written to the two slot buffers.
+     */
+    struct EndpointSlot
+    {
+        // cppcheck-suppress unusedStructMember
+        std::atomic<uint64_t> used_size_[2];
+    };
+
+private:
+    [[nodiscard]] bool open_segment(size_t process_count, size_t max_endpoints, size_t buffer_size);
+    [[nodiscard]] bool is_segment_stale() const;
+    [[nodiscard]] bool reclaim_segment(uint64_t magic);
+    void join_segment();
+    void check_segment_errors() const;
+    void wait_barrier();
+    void write_batch(size_t slot_index, const std::vector<messaging::MessageVariant> &messages);
+    [[nodiscard]] uint8_t *get_buffer(size_t slot_index, size_t parity) const;
+
+private:
+    // cppcheck-suppress unusedStructMember
+    std::string name_;
+    boost::interprocess::shared_memory_object shm_;
+    boost::interprocess::mapped_region region_;
+    SegmentHeader *header_ = nullptr;
+    // IDs of processes of the bus instances, zero if the bus instance is joining or detached.
+    std::atomic<uint64_t> *process_ids_ = nullptr;
+    // cppcheck-suppress unusedStructMember
+    size_t process_index_ = 0;
+    EndpointSlot *slots_ = nullptr;
+    uint8_t *data_ = nullptr;
+    // cppcheck-suppress unusedStructMember
+    uint64_t phase_ = 0;
+    // cppcheck-suppress unusedStructMember
+    bool delivered_ = true;
+    // Local endpoints and their slot indexes.
+    std::list<std::pair<std::weak_ptr<MessageEndpointSHMImpl>, size_t>> endpoints_;
+    // Slots of the deleted endpoints, they are cleared every phase.
+    // cppcheck-suppress unusedStructMember
+    std::vector<size_t> released_slots_;
+    std::mutex mutex_;
+};
+}  // namespace knp::core::messaging::impl
@@ -0,0 +1,114 @@
+/**
+ * @file message_endpoint_shm_impl.h
+ * @brief Shared memory endpoint implementation header.
+ * @kaspersky_support Artiom N.
+ * @date 18.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <message_endpoint_impl.h>
+#include <messaging/message_envelope_impl.h>
+#include <spdlog/spdlog.h>
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Namespace for implementations of message bus.
+ */
+namespace knp::core::messaging::impl
+{
+
+/**
+ * @brief Endpoint implementation class for shared memory message bus.
+ * @note It should never be used explicitly.
+ */
+class MessageEndpointSHMImpl : public MessageEndpointImpl
+{
+public:
+    /**
+     * @brief Endpoint constructor.
+     * @param slot_index index of the endpoint slot in the shared memory segment.
+     */
+    explicit MessageEndpointSHMImpl(size_t slot_index) : slot_index_(slot_index) {}
+
+    ~MessageEndpointSHMImpl() override = default;
+
+    void send_message(const knp::core::messaging::MessageVariant &message) override
+    {
+        const std::lock_guard lock(mutex_);
+
+        messages_to_send_.push_back(message);
+        SPDLOG_TRACE("Message was queued, type index = {}.", message.index());
+    }
+
+    std::optional<knp::core::messaging::MessageVariant> receive_message() override
+    {
+        const std::lock_guard lock(mutex_);
+
+        if (received_messages_.empty())
+        {
+            return {};
+        }
+
+        auto result = std::move(received_messages_.front());
+        received_messages_.pop_front();
+        return result;
+    }
+
+    /**
+     * @brief Read all the messages queued to be sent, then clear message container.
+     * @return vector of messages to be sent to other endpoints.
+     */
+    [[nodiscard]] std::vector<knp::core::messaging::MessageVariant> unload_sent_messages()
+    {
+        const std::lock_guard lock(mutex_);
+        auto result = std::move(messages_to_send_);
+
+        messages_to_send_.clear();
+        return result;
+    }
+
+    /**
+     * @brief Add all messages from a batch to the received messages.
+     * @param buffer batch buffer. The buffer is read in place and is not copied.
+     * @return number of received messages.
+     */
+    size_t add_received_batch(const void *buffer)
+    {
+        const std::lock_guard lock(mutex_);
+
+        return knp::core::messaging::extract_from_batch(buffer, received_messages_);
+    }
+
+    /**
+     * @brief Get index of the endpoint slot in the shared memory segment.
+     * @return slot index.
+     */
+    [[nodiscard]] size_t get_slot_index() const { return slot_index_; }
+
+private:
+    size_t slot_index_;
+    std::vector<knp::core::messaging::MessageVariant> messages_to_send_;
+    std::deque<knp::core::messaging::MessageVariant> received_messages_;
+    std::mutex mutex_;
+};
+
+}  // namespace knp::core::messaging::impl
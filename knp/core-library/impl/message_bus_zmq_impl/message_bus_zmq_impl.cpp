@@ -46,10 +46,7 @@ using std::chrono_literals::operator""ms;
 class MessageEndpointZMQ : public MessageEndpoint
 {
 public:
-    explicit MessageEndpointZMQ(zmq::socket_t &&sub_socket, zmq::socket_t &&pub_socket)
-    {
-        impl_ = std::make_shared<MessageEndpointZMQImpl>(std::move(sub_socket), std::move(pub_socket));
-    }
+    explicit MessageEndpointZMQ(std::shared_ptr<MessageEndpointZMQImpl> &&ptr) { impl_ = std::move(ptr); }
 };
 
 
@@ -68,6 +65,26 @@ MessageBusZMQImpl::MessageBusZMQImpl()
 }
 
 
+void MessageBusZMQImpl::update()
+{
+    // This function is called before routing messages: every endpoint sends messages queued during the step.
+    auto iter = endpoints_.begin();
+    while (iter != endpoints_.end())
+    {
+        auto endpoint_ptr = iter->lock();
+        // Clear up all pointers to expired endpoints.
+        if (!endpoint_ptr)
+        {
+            endpoints_.erase(iter++);
+            continue;
+        }
+
+        endpoint_ptr->flush();
+        ++iter;
+    }
+}
+
+
 zmq::recv_result_t MessageBusZMQImpl::poll(zmq::message_t &message)
 {
     // recv_result is an optional and if it doesn't contain a value, EAGAIN is returned by the call.
@@ -170,7 +187,10 @@ MessageEndpoint MessageBusZMQImpl::create_endpoint()
     SPDLOG_DEBUG("Sub socket connecting to {}...", publish_sock_address_);
     sub_socket.connect(publish_sock_address_);
 
-    return std::move(MessageEndpointZMQ(std::move(sub_socket), std::move(pub_socket)));
+    auto endpoint_impl = std::make_shared<MessageEndpointZMQImpl>(std::move(sub_socket), std::move(pub_socket));
+    endpoints_.push_back(endpoint_impl);
+
+    return std::move(MessageEndpointZMQ(std::move(endpoint_impl)));
 }
 
 }  // namespace knp::core::messaging::impl
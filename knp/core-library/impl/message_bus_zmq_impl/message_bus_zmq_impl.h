@@ -24,6 +24,8 @@
 #include <message_bus_impl.h>
 #include <spdlog/spdlog.h>
 
+#include <list>
+#include <memory>
 #include <string>
 
 #include <zmq.hpp>
@@ -31,6 +33,7 @@
 
 namespace knp::core::messaging::impl
 {
+class MessageEndpointZMQImpl;
 
 /**
  * @brief Internal message bus class, not intended for user code.
@@ -40,6 +43,11 @@ class MessageBusZMQImpl : public MessageBusImpl
 public:
     MessageBusZMQImpl();
 
+    /**
+     * @brief Send messages queued by endpoints. Each endpoint sends all its messages as one batch.
+     */
+    void update() override;
+
     /**
      * @brief Send a message from one socket to another.
      */
@@ -82,6 +90,11 @@ private:
      * @brief Publish socket.
      */
     zmq::socket_t publish_socket_;
+
+    /**
+     * @brief Endpoints created by the bus.
+     */
+    std::list<std::weak_ptr<MessageEndpointZMQImpl>> endpoints_;
 };
 
 
@@ -23,6 +23,7 @@
 
 #include <knp/meta/macro.h>
 
+#include <messaging/message_envelope_impl.h>
 #include <spdlog/spdlog.h>
 
 #include <memory>
@@ -50,6 +51,70 @@ MessageEndpointZMQImpl::MessageEndpointZMQImpl(zmq::socket_t &&sub_socket, zmq::
 }
 
 
+std::optional<messaging::MessageVariant> MessageEndpointZMQImpl::receive_message()
+{
+    const std::lock_guard lock(mutex_);
+
+    if (received_messages_.empty())
+    {
+        auto message_var = receive_zmq_message();
+        if (!message_var.has_value())
+        {
+            return {};
+        }
+
+        // Messages are unpacked directly from the ZeroMQ message buffer.
+        knp::core::messaging::extract_from_batch(message_var->data(), received_messages_);
+        if (received_messages_.empty())
+        {
+            return {};
+        }
+    }
+
+    auto message = std::move(received_messages_.front());
+    received_messages_.pop_front();
+    return message;
+}
+
+
+void MessageEndpointZMQImpl::send_message(const knp::core::messaging::MessageVariant &message)
+{
+    const std::lock_guard lock(mutex_);
+
+    messages_to_send_.push_back(message);
+    SPDLOG_TRACE("Message was queued, type index = {}.", message.index());
+}
+
+
+bool MessageEndpointZMQImpl::flush()
+{
+    const std::lock_guard lock(mutex_);
+
+    if (messages_to_send_.empty())
+    {
+        return false;
+    }
+
+    auto &builder = knp::core::messaging::get_thread_builder();
+    knp::core::messaging::pack_to_batch(builder, messages_to_send_);
+    messages_to_send_.clear();
+
+    // ZeroMQ takes ownership of the detached builder buffer, so the batch isn't copied.
+    auto batch = std::make_unique<::flatbuffers::DetachedBuffer>(builder.Release());
+    SPDLOG_TRACE("Packed batch size: {}.", batch->size());
+
+    zmq::message_t message(
+        batch->data(), batch->size(),
+        [](void *, void *hint) { delete static_cast<::flatbuffers::DetachedBuffer *>(hint); }, batch.get());
+    // The message owns the buffer now.
+    batch.release();
+
+    send_zmq_message(std::move(message));
+
+    return true;
+}
+
+
 void MessageEndpointZMQImpl::send_zmq_message(const std::vector<uint8_t> &data)
 {
     send_zmq_message(data.data(), data.size());
@@ -57,6 +122,12 @@ void MessageEndpointZMQImpl::send_zmq_message(const std::vector<uint8_t> &data)
 
 
 void MessageEndpointZMQImpl::send_zmq_message(const void *data, size_t size)
+{
+    send_zmq_message(zmq::message_t(data, size));
+}
+
+
+void MessageEndpointZMQImpl::send_zmq_message(zmq::message_t &&message)
 {
     // `send_result` is `std::optional` and if it doesn't contain a value, EAGAIN is returned by the call.
     zmq::send_result_t result;
@@ -66,9 +137,9 @@ void MessageEndpointZMQImpl::send_zmq_message(const void *data, size_t size)
         KNP_UNROLL_LOOP()
         do
         {
-            SPDLOG_TRACE("Sending {} bytes...", size);
-            result = pub_socket_.send(zmq::message_t(data, size), zmq::send_flags::dontwait);
-            SPDLOG_TRACE("{} bytes were sent.", size);
+            SPDLOG_TRACE("Sending {} bytes...", message.size());
+            result = pub_socket_.send(message, zmq::send_flags::dontwait);
+            SPDLOG_TRACE("{} bytes were sent.", message.size());
         } while (!result.has_value());
     }
     catch (const zmq::error_t &e)
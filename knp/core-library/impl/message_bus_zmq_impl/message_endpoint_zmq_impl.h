@@ -23,7 +23,9 @@
 #include <message_endpoint_impl.h>
 #include <spdlog/spdlog.h>
 
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -42,33 +44,39 @@ public:
     explicit MessageEndpointZMQImpl(zmq::socket_t &&sub_socket, zmq::socket_t &&pub_socket);
 
 public:
-    std::optional<messaging::MessageVariant> receive_message() override
-    {
-        auto message_var = receive_zmq_message();
-        if (!message_var.has_value())
-        {
-            return {};
-        }
+    /**
+     * @brief Receive a message from the latest received batch, read a new batch if needed.
+     * @return message if a message was received, nothing otherwise.
+     */
+    std::optional<messaging::MessageVariant> receive_message() override;
 
-        auto message = knp::core::messaging::extract_from_envelope(message_var->data());
-        return message;
-    }
-    void send_message(const knp::core::messaging::MessageVariant &message) override
-    {
-        auto packed_msg = knp::core::messaging::pack_to_envelope(message);
-        SPDLOG_TRACE("Packed message size: {}.", packed_msg.size());
-        send_zmq_message(packed_msg.data(), packed_msg.size());
-    }
+    /**
+     * @brief Queue a message. All queued messages are sent as one batch by `flush()`.
+     * @param message message to send.
+     */
+    void send_message(const knp::core::messaging::MessageVariant &message) override;
+
+    /**
+     * @brief Send all queued messages to the bus as a single batch.
+     * @return `true` if a batch was sent, `false` if there were no queued messages.
+     */
+    bool flush();
 
 public:
     void send_zmq_message(const std::vector<uint8_t> &data);
     void send_zmq_message(const void *data, size_t size);
+    void send_zmq_message(zmq::message_t &&message);
     std::optional<zmq::message_t> receive_zmq_message();
 
 private:
     // zmq::context_t &context_;
     zmq::socket_t sub_socket_;
     zmq::socket_t pub_socket_;
+    // Messages waiting for the next flush.
+    std::vector<knp::core::messaging::MessageVariant> messages_to_send_;
+    // Messages extracted from a received batch, but not yet read.
+    std::deque<knp::core::messaging::MessageVariant> received_messages_;
+    std::mutex mutex_;
 };
 
 }  // namespace knp::core::messaging::impl
@@ -21,10 +21,13 @@
 
 #include <knp/core/message_endpoint.h>
 
+#include <endpoint_registry.h>
 #include <message_endpoint_impl.h>
 #include <spdlog/spdlog.h>
 
 #include <memory>
+#include <utility>
+#include <variant>
 
 // sleep_for.
 #include <thread>
@@ -53,19 +56,34 @@ bool operator<(const MessageEndpoint::SubscriptionVariant &sv1, const MessageEnd
 }
 
 
-std::pair<size_t, UID> MessageEndpoint::get_subscription_key(const MessageEndpoint::SubscriptionVariant &subscription)
+std::pair<size_t, UIDHandle> MessageEndpoint::get_subscription_key(
+    const MessageEndpoint::SubscriptionVariant &subscription)
 {
-    return std::make_pair(subscription.index(), get_receiver_uid(subscription));
+    return std::make_pair(
+        subscription.index(),
+        std::visit([](const auto &subscr) { return subscr.get_receiver_handle(); }, subscription));
 }
 
 
 MessageEndpoint::MessageEndpoint(MessageEndpoint &&endpoint) noexcept
-    : impl_(std::move(endpoint.impl_)), subscriptions_(std::move(endpoint.subscriptions_))
+    : impl_(std::move(endpoint.impl_)),
+      uid_registry_(std::move(endpoint.uid_registry_)),
+      sender_handles_(std::move(endpoint.sender_handles_)),
+      sender_handles_version_(endpoint.sender_handles_version_),
+      bus_endpoints_(std::move(endpoint.bus_endpoints_))
 {
+    {
+        const std::lock_guard lock(endpoint.subscriptions_mutex_);
+        subscriptions_ = std::move(endpoint.subscriptions_);
+    }
+    if (bus_endpoints_) bus_endpoints_->replace(&endpoint, this);
 }
 
 
-MessageEndpoint::~MessageEndpoint() = default;
+MessageEndpoint::~MessageEndpoint()
+{
+    if (bus_endpoints_) bus_endpoints_->remove(this);
+}
 
 
 template <typename MessageType>
@@ -75,7 +93,9 @@ Subscription<MessageType> &MessageEndpoint::subscribe(const UID &receiver, const
 
     constexpr size_t index = get_type_index<knp::core::messaging::MessageVariant, MessageType>;
 
-    auto iter = subscriptions_.find(std::make_pair(index, receiver));
+    const std::lock_guard lock(subscriptions_mutex_);
+    update_bus_subscriptions();
+    auto iter = subscriptions_.find(std::make_pair(index, uid_registry_->find(receiver)));
 
     if (iter != subscriptions_.end())
     {
@@ -84,8 +104,9 @@ Subscription<MessageType> &MessageEndpoint::subscribe(const UID &receiver, const
         return sub;
     }
 
-    auto sub_variant = SubscriptionVariant{Subscription<MessageType>{receiver, senders}};
-    auto insert_res = subscriptions_.emplace(std::make_pair(index, receiver), sub_variant);
+    auto sub_variant = SubscriptionVariant{Subscription<MessageType>{uid_registry_, receiver, senders}};
+    const auto key = get_subscription_key(sub_variant);
+    auto insert_res = subscriptions_.emplace(key, std::move(sub_variant));
     auto &sub = std::get<index>(insert_res.first->second);
     return sub;
 }
@@ -96,10 +117,12 @@ bool MessageEndpoint::unsubscribe(const UID &receiver)
 {
     SPDLOG_DEBUG("Unsubscribing {}...", std::string(receiver));
     constexpr auto index = get_type_index<knp::core::messaging::MessageVariant, MessageType>;
-    auto iter = subscriptions_.find(std::make_pair(index, receiver));
+    const std::lock_guard lock(subscriptions_mutex_);
+    auto iter = subscriptions_.find(std::make_pair(index, uid_registry_->find(receiver)));
     if (iter != subscriptions_.end())
     {
         subscriptions_.erase(iter);
+        update_bus_subscriptions();
         return true;
     }
     return false;
@@ -110,13 +133,15 @@ void MessageEndpoint::remove_receiver(const UID &receiver)
 {
     SPDLOG_DEBUG("Removing receiver {}...", std::string(receiver));
 
-    for (auto sub_iter = subscriptions_.begin(); sub_iter != subscriptions_.end(); ++sub_iter)
+    const auto handle = uid_registry_->find(receiver);
+    if (UIDRegistry::invalid_handle == handle) return;
+
+    const std::lock_guard lock(subscriptions_mutex_);
+    for (size_t index = 0; index < std::variant_size_v<SubscriptionVariant>; ++index)
     {
-        if (get_receiver_uid(sub_iter->second) == receiver)
-        {
-            subscriptions_.erase(sub_iter);
-        }
+        subscriptions_.erase(std::make_pair(index, handle));
     }
+    update_bus_subscriptions();
 }
 
 
@@ -138,28 +163,36 @@ bool MessageEndpoint::receive_message()
         SPDLOG_TRACE("No message received.");
         return false;
     }
-    auto &message = message_opt.value();
+    deliver_message(message_opt.value());
+    return true;
+}
+
+
+void MessageEndpoint::deliver_message(const knp::core::messaging::MessageVariant &message)
+{
     const UID &sender_uid = get_header(message).sender_uid_;
     const size_t type_index = message.index();
 
     SPDLOG_TRACE("Subscription count = {}.", subscriptions_.size());
 
-    // Find a subscription.
-    for (auto &&[k, sub_variant] : subscriptions_)
+    // Senders of all subscriptions are registered, so nobody subscribed to an unknown sender.
+    const auto sender_handle = find_sender_handle(sender_uid);
+    if (UIDRegistry::invalid_handle == sender_handle)
     {
-        if (sub_variant.index() != type_index)
-        {
-            SPDLOG_TRACE(
-                "Subscription message type index does not match the message type index [{} != {}].",
-                sub_variant.index(), type_index);
-            continue;
-        }
+        SPDLOG_TRACE("No subscriptions to sender {}.", std::string(sender_uid));
+        return;
+    }
 
+    // Find a subscription. Subscriptions to messages of the same type are adjacent.
+    const auto subscriptions_end = subscriptions_.lower_bound(std::make_pair(type_index + 1, UIDHandle{0}));
+    for (auto sub_iter = subscriptions_.lower_bound(std::make_pair(type_index, UIDHandle{0}));
+         sub_iter != subscriptions_end; ++sub_iter)
+    {
         std::visit(
-            [&sender_uid, &message](auto &&subscription)
+            [&sender_uid, sender_handle, &message](auto &&subscription)
             {
                 SPDLOG_TRACE("Sender UID: {}.", std::string(sender_uid));
-                if (subscription.has_sender(sender_uid))
+                if (subscription.has_sender(sender_handle))
                 {
                     SPDLOG_TRACE("Subscription has sender with UID {}.", std::string(sender_uid));
                     subscription.add_message(
@@ -167,12 +200,51 @@ bool MessageEndpoint::receive_message()
                     SPDLOG_TRACE("Message was added to the subscription {}.", std::string(sender_uid));
                 }
             },
-            sub_variant);
+            sub_iter->second);
+    }
+}
+
 
-        // sub_variant.swap(v);
+bool MessageEndpoint::has_subscription(size_t type_index, const UID &sender, const UID &ignored_receiver) const
+{
+    const std::lock_guard lock(subscriptions_mutex_);
+    // Subscriptions to messages of the same type are adjacent.
+    const auto subscriptions_end = subscriptions_.lower_bound(std::make_pair(type_index + 1, UIDHandle{0}));
+    for (auto iter = subscriptions_.lower_bound(std::make_pair(type_index, UIDHandle{0})); iter != subscriptions_end;
+         ++iter)
+    {
+        const bool is_subscribed = std::visit(
+            [&sender, &ignored_receiver](const auto &subscription)
+            { return subscription.get_receiver_uid() != ignored_receiver && subscription.has_sender(sender); },
+            iter->second);
+        if (is_subscribed) return true;
     }
+    return false;
+}
 
-    return true;
+
+void MessageEndpoint::update_bus_subscriptions() const
+{
+    if (bus_endpoints_) bus_endpoints_->update_version();
+}
+
+
+UIDHandle MessageEndpoint::find_sender_handle(const UID &sender_uid)
+{
+    // Registry lookups take a lock, so handles are cached until the registry changes.
+    const auto version = uid_registry_->get_version();
+    if (version != sender_handles_version_)
+    {
+        sender_handles_.clear();
+        sender_handles_version_ = version;
+    }
+
+    auto iter = sender_handles_.find(sender_uid);
+    if (iter == sender_handles_.end())
+    {
+        iter = sender_handles_.emplace(sender_uid, uid_registry_->find(sender_uid)).first;
+    }
+    return iter->second;
 }
 
 
@@ -197,7 +269,7 @@ template <class MessageType>
 std::vector<MessageType> MessageEndpoint::unload_messages(const knp::core::UID &receiver_uid)
 {
     constexpr size_t index = get_type_index<knp::core::messaging::MessageVariant, MessageType>;
-    auto iter = subscriptions_.find(std::make_pair(index, receiver_uid));
+    auto iter = subscriptions_.find(std::make_pair(index, uid_registry_->find(receiver_uid)));
 
     if (iter == subscriptions_.end())
     {
@@ -212,13 +284,25 @@ std::vector<MessageType> MessageEndpoint::unload_messages(const knp::core::UID &
 }
 
 
+template <class MessageType>
+std::vector<MessageType> *MessageEndpoint::get_received_messages(const knp::core::UID &receiver_uid)
+{
+    constexpr size_t index = get_type_index<knp::core::messaging::MessageVariant, MessageType>;
+    auto iter = subscriptions_.find(std::make_pair(index, uid_registry_->find(receiver_uid)));
+    if (iter == subscriptions_.end()) return nullptr;
+    return &std::get<index>(iter->second).get_messages();
+}
+
+
 namespace cm = knp::core::messaging;
 
-#define INSTANCE_MESSAGES_FUNCTIONS(n, template_for_instance, message_type)                \
-    template Subscription<cm::message_type> &MessageEndpoint::subscribe<cm::message_type>( \
-        const UID &receiver, const std::vector<UID> &senders);                             \
-    template bool MessageEndpoint::unsubscribe<cm::message_type>(const UID &receiver);     \
-    template std::vector<cm::message_type> MessageEndpoint::unload_messages<cm::message_type>(const UID &receiver_uid);
+#define INSTANCE_MESSAGES_FUNCTIONS(n, template_for_instance, message_type)                                        \
+    template Subscription<cm::message_type> &MessageEndpoint::subscribe<cm::message_type>(                         \
+        const UID &receiver, const std::vector<UID> &senders);                                                     \
+    template bool MessageEndpoint::unsubscribe<cm::message_type>(const UID &receiver);                             \
+    template std::vector<cm::message_type> MessageEndpoint::unload_messages<cm::message_type>(                     \
+        const UID &receiver_uid);                                                                                  \
+    template std::vector<cm::message_type> *MessageEndpoint::get_received_messages<cm::message_type>(const UID &);
 
 BOOST_PP_SEQ_FOR_EACH(INSTANCE_MESSAGES_FUNCTIONS, "", BOOST_PP_VARIADIC_TO_SEQ(ALL_MESSAGES))
 
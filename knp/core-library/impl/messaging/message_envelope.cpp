@@ -19,17 +19,9 @@
  * limitations under the License.
  */
 
-#include <knp/core/messaging/message_envelope.h>
-#ifdef __clang__
-#    pragma clang diagnostic push
-#    pragma clang diagnostic ignored "-Wdocumentation"
-#endif
-#include <knp_gen_headers/message_envelope_generated.h>
-#ifdef __clang__
-#    pragma clang diagnostic pop
-#endif
 #include <spdlog/spdlog.h>
 
+#include "message_envelope_impl.h"
 #include "spike_message_impl.h"
 #include "synaptic_impact_message_impl.h"
 
@@ -37,33 +29,28 @@
 namespace knp::core::messaging
 {
 
-std::vector<uint8_t> pack_to_envelope(const MessageVariant &message)
+namespace
+{
+::flatbuffers::Offset<marshal::MessageEnvelope> pack_envelope_internal(
+    ::flatbuffers::FlatBufferBuilder &builder, const MessageVariant &message)
 {
-    ::flatbuffers::FlatBufferBuilder builder;
-    ::flatbuffers::Offset<marshal::MessageEnvelope> s_msg;
-
     SPDLOG_TRACE("Message index = {}.", message.index());
 
-    std::visit(
-        [&builder, &s_msg, &message](const auto &msg)
+    return std::visit(
+        [&builder, &message](const auto &msg)
         {
             // Zero index is NONE.
             const auto message_type_index = message.index() + 1;
             SPDLOG_TRACE("Creating envelope for the message type {}...", message_type_index);
-            s_msg = marshal::CreateMessageEnvelope(
+            return marshal::CreateMessageEnvelope(
                 builder, static_cast<marshal::Message>(message_type_index), pack_internal(builder, msg));
-            marshal::FinishMessageEnvelopeBuffer(builder, s_msg);
         },
         message);
-
-    return std::vector<uint8_t>(builder.GetBufferPointer(), builder.GetBufferPointer() + builder.GetSize());
 }
 
 
-MessageVariant extract_from_envelope(const void *buffer)
+MessageVariant unpack_envelope(const marshal::MessageEnvelope *msg_ev)
 {
-    auto msg_ev = marshal::GetMessageEnvelope(buffer);
-
     switch (msg_ev->message_type())
     {
         case marshal::Message_SpikeMessage:
@@ -77,6 +64,64 @@ MessageVariant extract_from_envelope(const void *buffer)
             throw std::logic_error("Unknown message type.");
     }
 }
+}  // namespace
+
+
+::flatbuffers::FlatBufferBuilder &get_thread_builder()
+{
+    thread_local ::flatbuffers::FlatBufferBuilder builder;
+    builder.Clear();
+    return builder;
+}
+
+
+std::vector<uint8_t> pack_to_envelope(const MessageVariant &message)
+{
+    auto &builder = get_thread_builder();
+
+    marshal::FinishMessageEnvelopeBuffer(builder, pack_envelope_internal(builder, message));
+
+    return std::vector<uint8_t>(builder.GetBufferPointer(), builder.GetBufferPointer() + builder.GetSize());
+}
+
+
+void pack_to_batch(::flatbuffers::FlatBufferBuilder &builder, const std::vector<MessageVariant> &messages)
+{
+    SPDLOG_TRACE("Packing {} messages to the batch...", messages.size());
+
+    std::vector<::flatbuffers::Offset<marshal::MessageEnvelope>> envelopes;
+    envelopes.reserve(messages.size());
+
+    for (const auto &message : messages)
+    {
+        envelopes.push_back(pack_envelope_internal(builder, message));
+    }
+
+    builder.Finish(marshal::CreateMessageBatchDirect(builder, &envelopes));
+}
+
+
+size_t extract_from_batch(const void *buffer, std::deque<MessageVariant> &messages)
+{
+    const auto *envelopes = ::flatbuffers::GetRoot<marshal::MessageBatch>(buffer)->messages();
+
+    if (!envelopes) return 0;
+
+    SPDLOG_TRACE("Unpacking {} messages from the batch...", envelopes->size());
+
+    for (const auto *msg_ev : *envelopes)
+    {
+        messages.push_back(unpack_envelope(msg_ev));
+    }
+
+    return envelopes->size();
+}
+
+
+MessageVariant extract_from_envelope(const void *buffer)
+{
+    return unpack_envelope(marshal::GetMessageEnvelope(buffer));
+}
 
 boost::mp11::mp_rename<AllMessages, std::variant> extract_from_envelope(const std::vector<uint8_t> &buffer)
 {
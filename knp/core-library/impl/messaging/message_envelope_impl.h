@@ -0,0 +1,71 @@
+/**
+ * @file message_envelope_impl.h
+ * @brief Message envelope and message batch implementation routines.
+ * @kaspersky_support Artiom N.
+ * @date 18.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <knp/core/messaging/message_envelope.h>
+
+#include <deque>
+#include <vector>
+
+#ifdef __clang__
+#    pragma clang diagnostic push
+#    pragma clang diagnostic ignored "-Wdocumentation"
+#endif
+#include <knp_gen_headers/message_envelope_generated.h>
+#ifdef __clang__
+#    pragma clang diagnostic pop
+#endif
+
+
+/**
+ * @brief Messaging namespace.
+ */
+namespace knp::core::messaging
+{
+/**
+ * @brief Get a cleared FlatBuffers builder owned by the calling thread.
+ * @details The builder keeps its internal buffer between calls, so packing doesn't allocate memory
+ * once the buffer has grown to the size of a typical message.
+ * @return reference to the thread-local builder.
+ */
+::flatbuffers::FlatBufferBuilder &get_thread_builder();
+
+
+/**
+ * @brief Pack several messages to a single batch.
+ * @details The batch is finished in the builder buffer, use `GetBufferPointer()` and `GetSize()` of the builder to
+ * access it. The buffer stays owned by the builder, so a retained builder doesn't allocate memory for every batch.
+ * @param builder cleared builder.
+ * @param messages messages to pack.
+ */
+void pack_to_batch(::flatbuffers::FlatBufferBuilder &builder, const std::vector<MessageVariant> &messages);
+
+
+/**
+ * @brief Extract all messages from a batch.
+ * @param buffer batch buffer. The buffer is read in place and is not copied.
+ * @param messages container to which the extracted messages are appended.
+ * @return number of extracted messages.
+ */
+size_t extract_from_batch(const void *buffer, std::deque<MessageVariant> &messages);
+
+}  // namespace knp::core::messaging
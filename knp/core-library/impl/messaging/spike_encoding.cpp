@@ -0,0 +1,166 @@
+/**
+ * @file spike_encoding.cpp
+ * @brief Compact encodings of spike indexes implementation.
+ * @kaspersky_support Artiom N.
+ * @date 18.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <knp/core/messaging/spike_encoding.h>
+
+#include <algorithm>
+#include <functional>
+
+
+namespace knp::core::messaging
+{
+
+namespace
+{
+bool is_strictly_ascending(const SpikeData &spikes)
+{
+    return std::adjacent_find(spikes.begin(), spikes.end(), std::greater_equal<SpikeIndex>()) == spikes.end();
+}
+
+
+size_t get_varint_size(uint32_t value)
+{
+    size_t result = 1;
+    for (; value >= 0x80; value >>= 7) ++result;
+    return result;
+}
+
+
+void put_varint(uint32_t value, std::vector<uint8_t> &data)
+{
+    for (; value >= 0x80; value >>= 7) data.push_back(static_cast<uint8_t>(value | 0x80));
+    data.push_back(static_cast<uint8_t>(value));
+}
+}  // namespace
+
+
+size_t get_encoded_size(const SpikeData &spikes, SpikeEncoding encoding)
+{
+    switch (encoding)
+    {
+        case SpikeEncoding::bitset:
+            return spikes.empty() ? 0 : spikes.back() / 8 + 1;
+        case SpikeEncoding::delta_varint:
+        {
+            size_t result = 0;
+            for (size_t index = 0; index < spikes.size(); ++index)
+            {
+                result += get_varint_size(index ? spikes[index] - spikes[index - 1] - 1 : spikes[index]);
+            }
+            return result;
+        }
+        default:
+            return spikes.size() * sizeof(SpikeIndex);
+    }
+}
+
+
+size_t get_max_spike_count(SpikeEncoding encoding, size_t size)
+{
+    switch (encoding)
+    {
+        case SpikeEncoding::bitset:
+            return size * 8;
+        case SpikeEncoding::delta_varint:
+            // Every index takes at least one byte.
+            return size;
+        default:
+            return size / sizeof(SpikeIndex);
+    }
+}
+
+
+SpikeEncoding choose_spike_encoding(const SpikeData &spikes)
+{
+    if (spikes.empty() || !is_strictly_ascending(spikes)) return SpikeEncoding::raw;
+
+    // On equal sizes the encoding that is faster to decode wins.
+    SpikeEncoding result = SpikeEncoding::raw;
+    size_t result_size = get_encoded_size(spikes, SpikeEncoding::raw);
+    for (const auto encoding : {SpikeEncoding::bitset, SpikeEncoding::delta_varint})
+    {
+        const size_t size = get_encoded_size(spikes, encoding);
+        if (size < result_size)
+        {
+            result = encoding;
+            result_size = size;
+        }
+    }
+
+    return result;
+}
+
+
+void encode_spikes(const SpikeData &spikes, SpikeEncoding encoding, EncodedSpikeData &encoded)
+{
+    if (encoding != SpikeEncoding::raw && !is_strictly_ascending(spikes))
+    {
+        throw std::invalid_argument("Only sorted unique spike indexes can be encoded as bitset or delta-varint.");
+    }
+
+    encoded.encoding_ = encoding;
+    encoded.spike_count_ = static_cast<uint32_t>(spikes.size());
+    encoded.data_.clear();
+
+    switch (encoding)
+    {
+        case SpikeEncoding::raw:
+            encoded.data_.resize(spikes.size() * sizeof(SpikeIndex));
+            if (!spikes.empty()) std::memcpy(encoded.data_.data(), spikes.data(), encoded.data_.size());
+            break;
+        case SpikeEncoding::bitset:
+            encoded.data_.resize(get_encoded_size(spikes, encoding), 0);
+            for (const auto index : spikes) encoded.data_[index / 8] |= static_cast<uint8_t>(1U << (index % 8));
+            break;
+        case SpikeEncoding::delta_varint:
+            encoded.data_.reserve(get_encoded_size(spikes, encoding));
+            for (size_t index = 0; index < spikes.size(); ++index)
+            {
+                put_varint(index ? spikes[index] - spikes[index - 1] - 1 : spikes[index], encoded.data_);
+            }
+            break;
+    }
+}
+
+
+void encode_spikes(const SpikeData &spikes, EncodedSpikeData &encoded)
+{
+    encode_spikes(spikes, choose_spike_encoding(spikes), encoded);
+}
+
+
+EncodedSpikeData encode_spikes(const SpikeData &spikes)
+{
+    EncodedSpikeData result;
+    encode_spikes(spikes, result);
+    return result;
+}
+
+
+SpikeData decode_spikes(const EncodedSpikeData &spikes)
+{
+    SpikeData result;
+    result.reserve(std::min<size_t>(spikes.spike_count_, get_max_spike_count(spikes.encoding_, spikes.data_.size())));
+    for_each_spike(spikes, [&result](SpikeIndex index) { result.push_back(index); });
+    return result;
+}
+
+}  // namespace knp::core::messaging
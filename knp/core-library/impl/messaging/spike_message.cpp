@@ -19,8 +19,13 @@
  * limitations under the License.
  */
 
+#include <knp/core/messaging/spike_encoding.h>
+
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
+
+#include "message_envelope_impl.h"
 #include "spike_message_impl.h"
 #include "uid_marshal.h"
 
@@ -75,14 +80,29 @@ std::istream &operator>>(std::istream &stream, SpikeMessage &msg)
 
     marshal::MessageHeader header(get_marshaled_uid(msg.header_.sender_uid_), msg.header_.send_time_);
 
-    return marshal::CreateSpikeMessageDirect(builder, &header, &msg.neuron_indexes_).o;
+    const auto encoding = choose_spike_encoding(msg.neuron_indexes_);
+    if (SpikeEncoding::raw == encoding)
+    {
+        return marshal::CreateSpikeMessageDirect(builder, &header, &msg.neuron_indexes_).o;
+    }
+
+    // Buffer is reused to avoid allocation for every message.
+    thread_local EncodedSpikeData encoded;
+    encode_spikes(msg.neuron_indexes_, encoding, encoded);
+    SPDLOG_TRACE(
+        "Spike message is encoded with type {}: {} bytes instead of {}.", static_cast<int>(encoding),
+        encoded.data_.size(), msg.neuron_indexes_.size() * sizeof(SpikeIndex));
+
+    return marshal::CreateSpikeMessageDirect(
+               builder, &header, nullptr, static_cast<marshal::SpikeEncoding>(encoding), &encoded.data_,
+               encoded.spike_count_)
+        .o;
 }
 
 
 std::vector<uint8_t> pack(const SpikeMessage &msg)
 {
-    // TODO: Don't create an instance every time.
-    ::flatbuffers::FlatBufferBuilder builder;
+    auto &builder = get_thread_builder();
     auto s_msg = pack_internal(builder, msg);
     marshal::FinishSpikeMessageBuffer(builder, ::flatbuffers::Offset<marshal::SpikeMessage>(s_msg));
     return {builder.GetBufferPointer(), builder.GetBufferPointer() + builder.GetSize()};
@@ -103,8 +123,28 @@ SpikeMessage unpack(const marshal::SpikeMessage *s_msg)
         s_msg_header->sender_uid().data()->end(),    // clang_sa_ignore [core.CallAndMessage]
         uid1.tag.begin());
 
-    return SpikeMessage{
-        {uid1, s_msg_header->send_time()}, {s_msg->neuron_indexes()->begin(), s_msg->neuron_indexes()->end()}};
+    SpikeMessage result{{uid1, s_msg_header->send_time()}, {}};
+    const auto encoding = static_cast<SpikeEncoding>(s_msg->encoding());
+
+    if (SpikeEncoding::raw == encoding)
+    {
+        if (const auto *indexes = s_msg->neuron_indexes(); indexes)
+        {
+            result.neuron_indexes_.assign(indexes->begin(), indexes->end());
+        }
+    }
+    else if (const auto *encoded = s_msg->encoded_indexes(); encoded)
+    {
+        // Indexes are read directly from the message buffer. The spike count is bounded by the buffer size, so a
+        // broken message can't make the receiver reserve arbitrary memory.
+        result.neuron_indexes_.reserve(
+            std::min<size_t>(s_msg->spike_count(), get_max_spike_count(encoding, encoded->size())));
+        for_each_spike(
+            encoding, encoded->data(), encoded->size(),
+            [&result](SpikeIndex index) { result.neuron_indexes_.push_back(index); });
+    }
+
+    return result;
 }
 
 
@@ -23,6 +23,7 @@
 
 #include <algorithm>
 
+#include "message_envelope_impl.h"
 #include "synaptic_impact_message_impl.h"
 #include "uid_marshal.h"
 
@@ -123,8 +124,7 @@ std::istream &operator>>(std::istream &stream, SynapticImpactMessage &msg)
 
 std::vector<uint8_t> pack(const SynapticImpactMessage &msg)
 {
-    // TODO: Don't create instance every time.
-    ::flatbuffers::FlatBufferBuilder builder;
+    auto &builder = get_thread_builder();
     auto s_msg = std::move(pack_internal(builder, msg));
     marshal::FinishSynapticImpactMessageBuffer(
         builder, static_cast<::flatbuffers::Offset<marshal::SynapticImpactMessage>>(s_msg));
@@ -48,6 +48,24 @@ Population<NeuronType>::Population(
 }
 
 
+template <typename NeuronType>
+Population<NeuronType>::Population(std::vector<NeuronParameters> neurons)  //!OCLINT
+    : neurons_(std::move(neurons))
+{
+    SPDLOG_DEBUG(
+        "Creating population with UID = {} and number of neurons = {}...", std::string(get_uid()), neurons_.size());
+}
+
+
+template <typename NeuronType>
+Population<NeuronType>::Population(const UID &uid, std::vector<NeuronParameters> neurons)  //!OCLINT
+    : base_{uid}, neurons_(std::move(neurons))
+{
+    SPDLOG_DEBUG(
+        "Creating population with UID = {} and number of neurons = {}...", std::string(get_uid()), neurons_.size());
+}
+
+
 #define INSTANCE_POPULATIONS(n, template_for_instance, neuron_type) \
     template class knp::core::Population<knp::neuron_traits::neuron_type>;
 
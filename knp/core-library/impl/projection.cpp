@@ -23,85 +23,77 @@
 
 #include <spdlog/spdlog.h>
 
-
-// Index functions.
-template <class Index, class Connection>
-void insert_to_index(Index &val, const Connection &connection)
-{
-    val.insert(connection);
-}
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <utility>
 
 
-template <class Index, class Type>
-auto find_by_type(const Index &val, size_t neuron_index)
+/**
+ * @brief Remove elements by their indexes in a single pass.
+ * @details Order of the remaining elements is kept.
+ * @tparam T value type.
+ * @param data vector that will be modified by deletion.
+ * @param to_remove indexes of the elements to remove
+ * @warning Indexes must be sorted, unique and less than the `data` size.
+ */
+template <class T, class IndexContainer>
+void remove_by_index(std::vector<T> &data, const IndexContainer &to_remove)
 {
-    return val.template get<Type>().equal_range(neuron_index);
-}
-
+    if (to_remove.empty()) return;
 
-template <class Index, class Type>
-std::vector<size_t> find_indexes_by_type(const Index &val, size_t neuron_index)
-{
-    auto range = find_by_type<Index, Type>(val, neuron_index);
-    std::vector<size_t> res;
-    std::transform(range.first, range.second, std::back_inserter(res), [](const auto &val) { return val.index_; });
-    return res;
+    auto next_to_remove = to_remove.begin();
+    size_t write_index = *next_to_remove;
+    for (size_t read_index = write_index; read_index < data.size(); ++read_index)
+    {
+        if (next_to_remove != to_remove.end() && *next_to_remove == read_index)
+        {
+            ++next_to_remove;
+            continue;
+        }
+        data[write_index++] = std::move(data[read_index]);
+    }
+    data.erase(data.begin() + write_index, data.end());
 }
 
 
+namespace
+{
 /**
- * @brief Remove a synapse with a given index.
- * @param index index of a synapse.
- * @return true if an element was found and erased.
+ * @brief Sort indexes and remove duplicates.
+ * @param indexes indexes to sort.
+ * @return sorted unique indexes.
  */
-template <class Index, class Projection>
-bool erase_synapse(Index &val, size_t index)
+std::vector<size_t> make_sorted_indexes(std::vector<size_t> indexes)
 {
-    auto num_erased = val.template get<typename Projection::mi_synapse_index>().erase(index);
-    return num_erased > 0;
+    std::sort(indexes.begin(), indexes.end());
+    indexes.erase(std::unique(indexes.begin(), indexes.end()), indexes.end());
+    return indexes;
 }
 
 
 /**
- * @brief Remove elements by their indexes in a single pass.
- * @tparam T value type.
- * @param data vector that will be modified by deletion.
- * @param to_remove indexes of the elements to remove
- * @warning Indexes must be sorted.
+ * @brief Check weights and delays of a synapse block.
+ * @param block synapse block.
+ * @param weights block weights.
+ * @param delays block delays.
+ * @throw std::invalid_argument if array sizes don't match the block.
  */
-template <class T, class IndexContainer>
-void remove_by_index(std::vector<T> &data, const IndexContainer &to_remove)
+template <typename Block>
+void check_block_arrays(const Block &block, const std::vector<float> &weights, const std::vector<uint32_t> &delays)
 {
-    if (to_remove.empty()) return;
-
-    size_t cor_counter = 0;
-    for (const auto rem_index : to_remove)
+    if (weights.size() != block.get_weight_count() || (!delays.empty() && delays.size() != weights.size()))
     {
-        data.erase(std::next(data.begin(), rem_index - cor_counter++));
+        throw std::invalid_argument(
+            "Synapse block requires " + std::to_string(block.get_weight_count()) + " weights and delays.");
     }
-
-    // Cool but incorrect (MSVC\14.40.33807\include\vector(56) : Assertion failed: can't dereference out of range vector
-    // iterator):
-    // size_t removed = 0;
-    // auto next_to_remove = to_remove.begin();
-    // size_t index = *next_to_remove;
-    // while (index + removed < data.size())
-    //{
-    //    while (index + removed == *next_to_remove)
-    //    {
-    //        ++next_to_remove;
-    //        ++removed;
-    //    }
-    //    data[index] = std::move(data[index + removed]);
-    //    ++index;
-    //}
-    // data.resize(data.size() - removed);
 }
+}  // namespace
 
 
 namespace knp::core
 {
-using Connection = typename std::tuple<size_t, size_t, size_t>;
 
 
 template <typename SynapseType>
@@ -140,7 +132,7 @@ Projection<SynapseType>::Projection(
             parameters_.emplace_back(std::move(params.value()));
         }
     }
-    reindex();
+    rebuild_index();
 }
 
 
@@ -161,30 +153,147 @@ Projection<SynapseType>::Projection(
             parameters_.emplace_back(Synapse{std::move(p), id_from, id_to});
         }
     }
-    reindex();
+    rebuild_index();
 }
 
 
 template <typename SynapseType>
-std::vector<size_t> knp::core::Projection<SynapseType>::find_synapses(
-    size_t neuron_id, Search search_criterion) const  //!OCLINT(Parameters used)
+Projection<SynapseType>::Projection(
+    UID presynaptic_uid, UID postsynaptic_uid, std::vector<Synapse> synapses)  //!OCLINT(Parameters used)
+    : presynaptic_uid_(presynaptic_uid), postsynaptic_uid_(postsynaptic_uid), parameters_(std::move(synapses))
+{
+    SPDLOG_DEBUG(
+        "Creating projection with UID = {}, presynaptic UID = {}, postsynaptic UID = {}, synapses = {}...",
+        std::string(get_uid()), std::string(presynaptic_uid_), std::string(postsynaptic_uid_), parameters_.size());
+    rebuild_index();
+}
+
+
+template <typename SynapseType>
+Projection<SynapseType>::Projection(
+    UID uid, UID presynaptic_uid, UID postsynaptic_uid, std::vector<Synapse> synapses)  //!OCLINT(Parameters used)
+    : base_{uid},
+      presynaptic_uid_(presynaptic_uid),
+      postsynaptic_uid_(postsynaptic_uid),
+      parameters_(std::move(synapses))
+{
+    SPDLOG_DEBUG(
+        "Creating projection with UID = {}, presynaptic UID = {}, postsynaptic UID = {}, synapses = {}...",
+        std::string(get_uid()), std::string(presynaptic_uid_), std::string(postsynaptic_uid_), parameters_.size());
+    rebuild_index();
+}
+
+
+template <typename SynapseType>
+std::vector<typename Projection<SynapseType>::Synapse> Projection<SynapseType>::make_synapses(
+    const std::vector<size_t> &sources, const std::vector<size_t> &targets, const std::vector<float> &weights,
+    const std::vector<uint32_t> &delays, const SynapseParameters &parameters)
 {
-    reindex();
-    std::vector<size_t> res;
-    switch (search_criterion)
+    const size_t synapses_count = sources.size();
+    if (targets.size() != synapses_count || (!weights.empty() && weights.size() != synapses_count) ||
+        (!delays.empty() && delays.size() != synapses_count))
     {
-        case Search::by_postsynaptic:
-            res = find_indexes_by_type<decltype(index_), core::Projection<SynapseType>::ByPostsynaptic>(
-                index_, neuron_id);
-            break;
-        case Search::by_presynaptic:
-            res =
-                find_indexes_by_type<decltype(index_), core::Projection<SynapseType>::ByPresynaptic>(index_, neuron_id);
-            break;
-        default:
-            return {};
+        throw std::invalid_argument("Synapse parameter arrays must have the same size.");
     }
-    return res;
+
+    std::vector<Synapse> result;
+    result.reserve(synapses_count);
+    for (size_t index = 0; index < synapses_count; ++index)
+    {
+        auto &synapse = result.emplace_back(parameters, sources[index], targets[index]);
+        if (!weights.empty()) std::get<synapse_data>(synapse).weight_ = weights[index];
+        if (!delays.empty()) std::get<synapse_data>(synapse).delay_ = delays[index];
+    }
+
+    return result;
+}
+
+
+template <typename SynapseType>
+Projection<SynapseType> Projection<SynapseType>::make_compact(
+    UID presynaptic_uid, UID postsynaptic_uid, const SynapseBlock &block, std::vector<float> weights,
+    std::vector<uint32_t> delays, const SynapseParameters &parameters)
+{
+    // make_dense() and make_kernel() reject synapse types with individual state at compile time.
+    std::visit([&weights, &delays](const auto &blk) { check_block_arrays(blk, weights, delays); }, block);
+
+    Projection result(presynaptic_uid, postsynaptic_uid);
+    result.block_ = block;
+    result.block_weights_ = std::move(weights);
+    result.block_delays_ = std::move(delays);
+    result.block_parameters_.delay_ = parameters.delay_;
+    result.block_parameters_.output_type_ = parameters.output_type_;
+    SPDLOG_DEBUG(
+        "Created compact projection with UID = {}, synapses = {}.", std::string(result.get_uid()), result.size());
+    return result;
+}
+
+
+template <typename SynapseType>
+typename Projection<SynapseType>::Synapse Projection<SynapseType>::get_synapse(size_t index) const
+{
+    if (!block_) return parameters_.at(index);
+    if (index >= size()) throw std::out_of_range("Synapse index " + std::to_string(index) + " is out of range.");
+
+    const auto block_synapse = std::visit([index](const auto &block) { return block.get_synapse(index); }, *block_);
+    Synapse result{SynapseParameters(), block_synapse.source_, block_synapse.target_};
+    auto &params = std::get<synapse_data>(result);
+    params.weight_ = block_weights_[block_synapse.weight_index_];
+    params.delay_ = block_delays_.empty() ? block_parameters_.delay_ : block_delays_[block_synapse.weight_index_];
+    params.output_type_ = block_parameters_.output_type_;
+    return result;
+}
+
+
+template <typename SynapseType>
+void Projection<SynapseType>::materialize()
+{
+    if (!block_) return;
+
+    SPDLOG_DEBUG("Converting compact projection {} to explicit synapses...", std::string(get_uid()));
+    std::vector<Synapse> synapses;
+    synapses.reserve(size());
+    for (size_t index = 0; index < size(); ++index) synapses.push_back(get_synapse(index));
+
+    block_.reset();
+    std::vector<float>().swap(block_weights_);
+    std::vector<uint32_t>().swap(block_delays_);
+    parameters_ = std::move(synapses);
+    rebuild_index();
+}
+
+
+template <typename SynapseType>
+std::vector<size_t> knp::core::Projection<SynapseType>::find_synapses(
+    size_t neuron_id, Search search_criterion) const  //!OCLINT(Parameters used)
+{
+    if (!block_) return get_synapse_indexes(neuron_id, search_criterion);
+
+    std::vector<size_t> result;
+    const auto add_synapse = [&result](size_t synapse_index, size_t, size_t) { result.push_back(synapse_index); };
+    std::visit(
+        [neuron_id, search_criterion, &add_synapse](const auto &block)
+        {
+            if (Search::by_presynaptic == search_criterion)
+                block.for_each_postsynaptic(neuron_id, add_synapse);
+            else
+                block.for_each_presynaptic(neuron_id, add_synapse);
+        },
+        *block_);
+    return result;
+}
+
+
+template <typename SynapseType>
+const std::vector<size_t> &knp::core::Projection<SynapseType>::get_synapse_indexes(
+    size_t neuron_index, Search search_method) const  //!OCLINT(Parameters used)
+{
+    static const std::vector<size_t> no_synapses;
+
+    check_explicit();
+    const auto &index = Search::by_presynaptic == search_method ? presynaptic_index_ : postsynaptic_index_;
+    if (neuron_index >= index.size()) return no_synapses;
+    return index[neuron_index];
 }
 
 
@@ -192,90 +301,301 @@ template <typename SynapseType>
 size_t knp::core::Projection<SynapseType>::add_synapses(
     SynapseGenerator generator, size_t num_iterations)  //!OCLINT(Parameters used)
 {
+    materialize();
     const size_t starting_size = parameters_.size();
-    is_index_updated_ = false;
     for (size_t i = 0; i < num_iterations; ++i)
     {
         if (auto data = generator(i))
         {
             parameters_.emplace_back(std::move(data.value()));
+            index_synapse(parameters_.size() - 1);
         }
     }
     return parameters_.size() - starting_size;
 }
 
 
+template <typename SynapseType>
+size_t knp::core::Projection<SynapseType>::add_synapses(std::vector<Synapse> synapses)
+{
+    materialize();
+    const size_t starting_size = parameters_.size();
+    if (parameters_.empty())
+    {
+        parameters_ = std::move(synapses);
+    }
+    else
+    {
+        parameters_.insert(
+            parameters_.end(), std::make_move_iterator(synapses.begin()), std::make_move_iterator(synapses.end()));
+    }
+
+    for (size_t i = starting_size; i < parameters_.size(); ++i) index_synapse(i);
+    return parameters_.size() - starting_size;
+}
+
+
 template <typename SynapseType>
 void Projection<SynapseType>::clear()
 {
     parameters_.clear();
-    index_.clear();
+    presynaptic_index_.clear();
+    postsynaptic_index_.clear();
+    block_.reset();
+    block_weights_.clear();
+    block_delays_.clear();
 }
 
 
 template <typename SynapseType>
 void knp::core::Projection<SynapseType>::remove_synapse(size_t index)  //!OCLINT
 {
-    is_index_updated_ = false;
+    materialize();
+    const auto &synapse = parameters_.at(index);
+    for (auto *neuron_synapses :
+         {&presynaptic_index_[std::get<source_neuron_id>(synapse)],
+          &postsynaptic_index_[std::get<target_neuron_id>(synapse)]})
+    {
+        neuron_synapses->erase(std::lower_bound(neuron_synapses->begin(), neuron_synapses->end(), index));
+    }
     parameters_.erase(parameters_.begin() + index);
+
+    // Indexes of the following synapses are shifted, neuron lists stay sorted. This is linear in the number of
+    // synapses, as is erasing the synapse from the vector.
+    for (auto *index_container : {&presynaptic_index_, &postsynaptic_index_})
+    {
+        for (auto &neuron_synapses : *index_container)
+        {
+            auto first_shifted = std::upper_bound(neuron_synapses.begin(), neuron_synapses.end(), index);
+            std::for_each(first_shifted, neuron_synapses.end(), [](size_t &synapse_index) { --synapse_index; });
+        }
+    }
+}
+
+
+template <typename SynapseType>
+size_t knp::core::Projection<SynapseType>::remove_synapses(std::vector<size_t> synapse_indexes)
+{
+    materialize();
+    synapse_indexes = make_sorted_indexes(std::move(synapse_indexes));
+    if (!synapse_indexes.empty() && synapse_indexes.back() >= parameters_.size())
+    {
+        throw std::out_of_range("Synapse index " + std::to_string(synapse_indexes.back()) + " is out of range.");
+    }
+
+    remove_indexed_synapses(synapse_indexes);
+    return synapse_indexes.size();
 }
 
 
 template <typename SynapseType>
 size_t knp::core::Projection<SynapseType>::remove_synapse_if(std::function<bool(const Synapse &)> predicate)  //!OCLINT
 {
-    const size_t starting_size = parameters_.size();
-    is_index_updated_ = false;
-    parameters_.resize(std::remove_if(parameters_.begin(), parameters_.end(), predicate) - parameters_.begin());
-    return starting_size - parameters_.size();
+    materialize();
+    std::vector<size_t> synapses_to_remove;
+    for (size_t i = 0; i < parameters_.size(); ++i)
+    {
+        if (predicate(parameters_[i])) synapses_to_remove.push_back(i);
+    }
+    remove_indexed_synapses(synapses_to_remove);
+    return synapses_to_remove.size();
 }
 
 
 template <typename SynapseType>
 size_t knp::core::Projection<SynapseType>::remove_postsynaptic_neuron_synapses(size_t neuron_index)  //!OCLINT
 {
+    materialize();
+    // Index lists are sorted.
+    const auto synapses_to_remove = get_synapse_indexes(neuron_index, Search::by_postsynaptic);
+    remove_indexed_synapses(synapses_to_remove);
+    return synapses_to_remove.size();
+}
+
+
+template <typename SynapseType>
+size_t knp::core::Projection<SynapseType>::remove_presynaptic_neuron_synapses(size_t neuron_index)  //!OCLINT
+{
+    materialize();
+    // Index lists are sorted.
+    const auto synapses_to_remove = get_synapse_indexes(neuron_index, Search::by_presynaptic);
+    remove_indexed_synapses(synapses_to_remove);
+    return synapses_to_remove.size();
+}
+
+
+template <typename SynapseType>
+size_t knp::core::Projection<SynapseType>::remove_presynaptic_neurons(std::vector<size_t> neuron_indexes)
+{
+    return remove_neurons(make_sorted_indexes(std::move(neuron_indexes)), Search::by_presynaptic);
+}
+
+
+template <typename SynapseType>
+size_t knp::core::Projection<SynapseType>::remove_postsynaptic_neurons(std::vector<size_t> neuron_indexes)
+{
+    return remove_neurons(make_sorted_indexes(std::move(neuron_indexes)), Search::by_postsynaptic);
+}
+
+
+template <typename SynapseType>
+size_t knp::core::Projection<SynapseType>::remove_neurons(
+    const std::vector<size_t> &neuron_indexes, Search search_method)
+{
+    if (neuron_indexes.empty()) return 0;
+
+    materialize();
+    const auto &index = Search::by_presynaptic == search_method ? presynaptic_index_ : postsynaptic_index_;
+    // New indexes of neurons, removed neurons are marked with the number of neurons.
+    std::vector<size_t> neuron_remap(std::max(index.size(), neuron_indexes.back() + 1));
+    auto next_removed = neuron_indexes.begin();
+    size_t removed_count = 0;
+    for (size_t neuron = 0; neuron < neuron_remap.size(); ++neuron)
+    {
+        if (next_removed != neuron_indexes.end() && *next_removed == neuron)
+        {
+            ++next_removed;
+            ++removed_count;
+            neuron_remap[neuron] = neuron_remap.size();
+            continue;
+        }
+        neuron_remap[neuron] = neuron - removed_count;
+    }
+
     const size_t starting_size = parameters_.size();
-    bool was_index_updated = is_index_updated_;
-    // Basic exception safety.
-    is_index_updated_ = false;
-    auto synapses_to_remove = find_synapses(neuron_index, Search::by_postsynaptic);
-    std::sort(synapses_to_remove.begin(), synapses_to_remove.end());
-    remove_by_index(parameters_, synapses_to_remove);
-    if (was_index_updated)
-        for (auto &synapse : synapses_to_remove) index_.erase(synapse);
-
-    is_index_updated_ = was_index_updated;
+    size_t write_index = 0;
+    for (size_t read_index = 0; read_index < starting_size; ++read_index)
+    {
+        auto &synapse = parameters_[read_index];
+        auto &neuron = Search::by_presynaptic == search_method ? std::get<source_neuron_id>(synapse)
+                                                               : std::get<target_neuron_id>(synapse);
+        if (neuron_remap[neuron] == neuron_remap.size()) continue;
+        neuron = neuron_remap[neuron];
+        if (write_index != read_index) parameters_[write_index] = std::move(synapse);
+        ++write_index;
+    }
+    parameters_.erase(parameters_.begin() + write_index, parameters_.end());
+    rebuild_index();
+
     return starting_size - parameters_.size();
 }
 
 
 template <typename SynapseType>
-size_t knp::core::Projection<SynapseType>::remove_presynaptic_neuron_synapses(size_t neuron_index)  //!OCLINT
+void knp::core::Projection<SynapseType>::sort_synapses(
+    const std::function<bool(const Synapse &, const Synapse &)> &compare)
 {
-    // TODO: We now have a way to find them quickly, make use of it instead of disconnect_if.
-    return remove_synapse_if([neuron_index](const Synapse &synapse)
-                             { return std::get<knp::core::source_neuron_id>(synapse) == neuron_index; });
+    materialize();
+    std::stable_sort(parameters_.begin(), parameters_.end(), compare);
+    rebuild_index();
 }
 
 
 template <typename SynapseType>
-void knp::core::Projection<SynapseType>::reindex() const
+void knp::core::Projection<SynapseType>::renumber_neurons(
+    const std::vector<size_t> &presynaptic_indexes, const std::vector<size_t> &postsynaptic_indexes)
 {
-    if (is_index_updated_)
+    materialize();
+    // Check all indexes first to keep the projection unchanged on error.
+    for (const auto &synapse : parameters_)
+    {
+        if ((!presynaptic_indexes.empty() && std::get<source_neuron_id>(synapse) >= presynaptic_indexes.size()) ||
+            (!postsynaptic_indexes.empty() && std::get<target_neuron_id>(synapse) >= postsynaptic_indexes.size()))
+        {
+            throw std::out_of_range("Neuron index of a synapse is out of range of the new neuron indexes.");
+        }
+    }
+
+    for (auto &synapse : parameters_)
     {
-        return;
+        auto &source = std::get<source_neuron_id>(synapse);
+        auto &target = std::get<target_neuron_id>(synapse);
+        if (!presynaptic_indexes.empty()) source = presynaptic_indexes[source];
+        if (!postsynaptic_indexes.empty()) target = postsynaptic_indexes[target];
     }
+    rebuild_index();
+}
 
-    index_.clear();
-    for (size_t i = 0; i < parameters_.size(); ++i)
+
+template <typename SynapseType>
+void knp::core::Projection<SynapseType>::remove_indexed_synapses(const std::vector<size_t> &synapse_indexes)
+{
+    if (synapse_indexes.empty()) return;
+
+    // New indexes of synapses, removed synapses are marked with the number of synapses.
+    const size_t starting_size = parameters_.size();
+    std::vector<size_t> synapse_remap(starting_size);
+    auto next_removed = synapse_indexes.begin();
+    size_t removed_count = 0;
+    for (size_t synapse = 0; synapse < starting_size; ++synapse)
+    {
+        if (next_removed != synapse_indexes.end() && *next_removed == synapse)
+        {
+            ++next_removed;
+            ++removed_count;
+            synapse_remap[synapse] = starting_size;
+            continue;
+        }
+        synapse_remap[synapse] = synapse - removed_count;
+    }
+
+    remove_by_index(parameters_, synapse_indexes);
+
+    // Remapping keeps index lists sorted.
+    for (auto *index_container : {&presynaptic_index_, &postsynaptic_index_})
+    {
+        for (auto &neuron_synapses : *index_container)
+        {
+            size_t write_index = 0;
+            for (const auto synapse_index : neuron_synapses)
+            {
+                if (synapse_remap[synapse_index] != starting_size)
+                    neuron_synapses[write_index++] = synapse_remap[synapse_index];
+            }
+            neuron_synapses.resize(write_index);
+        }
+    }
+}
+
+
+template <typename SynapseType>
+void knp::core::Projection<SynapseType>::index_synapse(size_t synapse_index)
+{
+    const auto &synapse = parameters_[synapse_index];
+    const size_t source = std::get<source_neuron_id>(synapse);
+    const size_t target = std::get<target_neuron_id>(synapse);
+
+    if (source >= presynaptic_index_.size()) presynaptic_index_.resize(source + 1);
+    if (target >= postsynaptic_index_.size()) postsynaptic_index_.resize(target + 1);
+    presynaptic_index_[source].push_back(synapse_index);
+    postsynaptic_index_[target].push_back(synapse_index);
+}
+
+
+template <typename SynapseType>
+void knp::core::Projection<SynapseType>::rebuild_index()
+{
+    presynaptic_index_.clear();
+    postsynaptic_index_.clear();
+
+    // Synapses are counted first, so index vectors are allocated once with the exact size.
+    std::vector<size_t> presynaptic_counts, postsynaptic_counts;
+    for (const auto &synapse : parameters_)
     {
-        auto &synapse = parameters_[i];
-        insert_to_index(
-            index_,
-            Connection{
-                std::get<knp::core::source_neuron_id>(synapse), std::get<knp::core::target_neuron_id>(synapse), i});
+        const size_t source = std::get<source_neuron_id>(synapse);
+        const size_t target = std::get<target_neuron_id>(synapse);
+        if (source >= presynaptic_counts.size()) presynaptic_counts.resize(source + 1, 0);
+        if (target >= postsynaptic_counts.size()) postsynaptic_counts.resize(target + 1, 0);
+        ++presynaptic_counts[source];
+        ++postsynaptic_counts[target];
     }
-    is_index_updated_ = true;
+
+    presynaptic_index_.resize(presynaptic_counts.size());
+    for (size_t i = 0; i < presynaptic_counts.size(); ++i) presynaptic_index_[i].reserve(presynaptic_counts[i]);
+    postsynaptic_index_.resize(postsynaptic_counts.size());
+    for (size_t i = 0; i < postsynaptic_counts.size(); ++i) postsynaptic_index_[i].reserve(postsynaptic_counts[i]);
+
+    for (size_t i = 0; i < parameters_.size(); ++i) index_synapse(i);
 }
 
 
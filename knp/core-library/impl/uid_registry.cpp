@@ -0,0 +1,110 @@
+/**
+ * @file uid_registry.cpp
+ * @brief UID registry implementation.
+ * @kaspersky_support Artiom N.
+ * @date 18.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <knp/core/uid_registry.h>
+
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+
+namespace knp::core
+{
+
+UIDHandle UIDRegistry::intern(const UID &uid)
+{
+    const std::unique_lock lock(mutex_);
+    if (const auto iter = handles_.find(uid); iter != handles_.end())
+    {
+        ++ref_counts_[iter->second];
+        return iter->second;
+    }
+
+    UIDHandle handle = invalid_handle;
+    if (!free_handles_.empty())
+    {
+        handle = free_handles_.back();
+        free_handles_.pop_back();
+        uids_[handle] = uid;
+        ref_counts_[handle] = 1;
+    }
+    else
+    {
+        if (uids_.size() >= invalid_handle) throw std::length_error("UID registry is full.");
+        handle = static_cast<UIDHandle>(uids_.size());
+        uids_.push_back(uid);
+        ref_counts_.push_back(1);
+    }
+    handles_.emplace(uid, handle);
+    version_.fetch_add(1, std::memory_order_release);
+    return handle;
+}
+
+
+void UIDRegistry::release(UIDHandle handle)
+{
+    const std::unique_lock lock(mutex_);
+    if (handle >= uids_.size() || !ref_counts_[handle])
+    {
+        throw std::out_of_range("Handle " + std::to_string(handle) + " is not registered.");
+    }
+    if (--ref_counts_[handle]) return;
+
+    handles_.erase(uids_[handle]);
+    free_handles_.push_back(handle);
+    version_.fetch_add(1, std::memory_order_release);
+}
+
+
+std::shared_ptr<UIDRegistry> UIDRegistry::get_shared()
+{
+    static const auto registry = std::make_shared<UIDRegistry>();
+    return registry;
+}
+
+
+UIDHandle UIDRegistry::find(const UID &uid) const
+{
+    const std::shared_lock lock(mutex_);
+    const auto iter = handles_.find(uid);
+    return iter != handles_.end() ? iter->second : invalid_handle;
+}
+
+
+UID UIDRegistry::get_uid(UIDHandle handle) const
+{
+    const std::shared_lock lock(mutex_);
+    if (handle >= uids_.size() || !ref_counts_[handle])
+    {
+        throw std::out_of_range("Handle " + std::to_string(handle) + " is not registered.");
+    }
+    return uids_[handle];
+}
+
+
+size_t UIDRegistry::size() const
+{
+    const std::shared_lock lock(mutex_);
+    return handles_.size();
+}
+
+}  // namespace knp::core
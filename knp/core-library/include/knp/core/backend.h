@@ -21,21 +21,30 @@
 
 #pragma once
 
+#include <knp/core/bulk_input.h>
 #include <knp/core/core.h>
 #include <knp/core/device.h>
+#include <knp/core/dynamic_state.h>
 #include <knp/core/message_bus.h>
 #include <knp/core/population.h>
 #include <knp/core/projection.h>
 
 #include <atomic>
+#include <condition_variable>
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <set>
 #include <string>
+#include <type_traits>
+#include <unordered_set>
 #include <utility>
+#include <variant>
 #include <vector>
 
 #include <boost/config.hpp>
+#include <boost/mp11.hpp>
 
 
 /**
@@ -61,6 +70,20 @@ public:
      */
     using RunPredicate = std::function<bool(knp::core::Step)>;
 
+    /**
+     * @brief Variant of constant pointers to populations of any type specified in `AllPopulations`.
+     */
+    using PopulationConstPointer = boost::mp11::mp_rename<
+        boost::mp11::mp_transform<std::add_pointer_t, boost::mp11::mp_transform<std::add_const_t, AllPopulations>>,
+        std::variant>;
+
+    /**
+     * @brief Variant of constant pointers to projections of any type specified in `AllProjections`.
+     */
+    using ProjectionConstPointer = boost::mp11::mp_rename<
+        boost::mp11::mp_transform<std::add_pointer_t, boost::mp11::mp_transform<std::add_const_t, AllProjections>>,
+        std::variant>;
+
 public:
     /**
      * @brief Backend destructor.
@@ -122,6 +145,15 @@ public:
      */
     virtual void load_all_projections(const std::vector<AllProjectionsVariant> &projections) = 0;
 
+    /**
+     * @brief Move projections to backend.
+     * @details Projections are moved instead of being copied, so loading doesn't need memory for a second copy of
+     * the network. The default implementation copies projections.
+     * @throw exception if the `projections` parameters contains unsupported projection types.
+     * @param projections projections to add. The container is empty after the call.
+     */
+    virtual void load_all_projections(std::vector<AllProjectionsVariant> &&projections);
+
     /**
      * @brief Add populations to backend.
      * @throw exception if the `populations` parameter contains unsupported population types.
@@ -129,6 +161,15 @@ public:
      */
     virtual void load_all_populations(const std::vector<AllPopulationsVariant> &populations) = 0;
 
+    /**
+     * @brief Move populations to backend.
+     * @details Populations are moved instead of being copied, so loading doesn't need memory for a second copy of
+     * the network. The default implementation copies populations.
+     * @throw exception if the `populations` parameter contains unsupported population types.
+     * @param populations populations to add. The container is empty after the call.
+     */
+    virtual void load_all_populations(std::vector<AllPopulationsVariant> &&populations);
+
     /**
      * @brief Remove projections with given UIDs from the backend.
      * @param uids UIDs of projections to remove.
@@ -215,6 +256,72 @@ public:
      */
     [[nodiscard]] virtual core::MessageEndpoint &get_message_endpoint() { return message_endpoint_; }
 
+    /**
+     * @brief Require sending messages of the specified entities to the message bus.
+     * @details A backend can deliver messages between its own populations and projections without the message bus.
+     * Messages of the specified senders are always sent to the message bus, so observers and other backends can
+     * receive them. Subscriptions of endpoints created by the backend message bus are detected automatically. Call this
+     * method if messages are received by endpoints in other processes, for example via the ZMQ message bus.
+     * @param senders UIDs of the sender entities.
+     */
+    void require_bus_messages(const std::vector<UID> &senders)
+    {
+        bus_message_senders_.insert(senders.begin(), senders.end());
+    }
+
+    /**
+     * @brief Check if messages of the entity must be sent to the message bus.
+     * @param sender UID of the sender entity.
+     * @return `true` if messages of the entity must be sent to the message bus.
+     */
+    [[nodiscard]] bool is_bus_message_required(const UID &sender) const
+    {
+        return bus_message_senders_.find(sender) != bus_message_senders_.end();
+    }
+
+    /**
+     * @brief Check if messages of the entity must be sent to the message bus instead of an internal receiver.
+     * @details Messages are required if they were requested by `require_bus_messages()` or if an endpoint of the
+     * backend message bus is subscribed to them for a receiver other than the internal one.
+     * @tparam MessageType message type.
+     * @param sender UID of the sender entity.
+     * @param local_receiver UID of the receiver to which the backend delivers messages internally.
+     * @return `true` if messages of the entity must be sent to the message bus.
+     */
+    template <typename MessageType>
+    [[nodiscard]] bool is_bus_message_required(const UID &sender, const UID &local_receiver) const
+    {
+        return is_bus_message_required(sender) || message_bus_.has_subscription<MessageType>(sender, local_receiver);
+    }
+
+    /**
+     * @brief Get version of the data used by `is_bus_message_required()`.
+     * @details The version changes when `require_bus_messages()` adds a sender or when subscriptions of the backend
+     * message bus change. Backends cache results of `is_bus_message_required()` until the version changes.
+     * @return bus message version.
+     */
+    [[nodiscard]] uint64_t get_bus_message_version() const
+    {
+        // Both terms never decrease, so the sum changes every time one of them changes.
+        return message_bus_.get_subscription_version() + bus_message_senders_.size();
+    }
+
+    /**
+     * @brief Add an input that the backend reads at every step without the message bus.
+     * @details At the beginning of every step the backend gets spikes of the step from the input and adds them to
+     * the subscriptions of its entities subscribed to the input UID, as if an input channel sent them. Spikes are
+     * generated for a window of steps at once. Subscribe receivers with `subscribe()` as for input channels.
+     * @note Bulk inputs are local to the backend. Their spikes aren't sent through the message bus, so observers and
+     * other endpoints subscribed to the input UID don't receive them. Use an input channel if spikes must be
+     * observed.
+     * @param input_uid UID of the input used as a sender UID.
+     * @param input bulk spike input.
+     */
+    void add_bulk_input(const UID &input_uid, BulkSpikeInput input)
+    {
+        bulk_inputs_.push_back({std::move(input), messaging::SpikeMessage{{input_uid, 0}, {}}});
+    }
+
 public:
     /**
      * @brief Start network execution on the backend.
@@ -234,6 +341,13 @@ public:
      */
     void start(const RunPredicate &run_predicate);
 
+    /**
+     * @brief Execute a number of steps back-to-back.
+     * @details No functions are called between steps. Execution stops earlier if `stop()` is called.
+     * @param steps_count number of steps to execute.
+     */
+    void run_steps(size_t steps_count);
+
     /**
      * @brief Stop network execution on the backend.
      */
@@ -245,6 +359,15 @@ public:
      */
     [[nodiscard]] core::Step get_step() const { return step_; }
 
+    /**
+     * @brief Get sequence number of network state updates.
+     * @details The number is increased at the beginning and at the end of every step, so it is odd while the
+     * backend changes network data. Data read from another thread belongs to a single step if the sequence number
+     * is even and doesn't change during reading.
+     * @return update sequence number.
+     */
+    [[nodiscard]] uint64_t get_update_sequence() const { return update_sequence_.load(std::memory_order_acquire); }
+
     /**
      * @brief Stop learning.
      */
@@ -360,6 +483,133 @@ public:
      */
     [[nodiscard]] virtual DataRanges get_network_data() const = 0;
 
+    /**
+     * @brief Get mutable state of populations and projections loaded to the backend.
+     * @details The state contains dynamic neuron parameters, weights and rule state of plastic synapses and
+     * pending synaptic impacts. The default implementation copies the whole network with `get_network_data()`
+     * and doesn't get pending impacts.
+     * @return dynamic state at the current step.
+     */
+    [[nodiscard]] virtual DynamicState get_dynamic_state() const;
+
+    /**
+     * @brief Restore mutable state of populations and projections loaded to the backend.
+     * @details The current step of the backend is set to the step of the state. Entities and parameters that are
+     * not present in the state are not changed. The default implementation throws an exception.
+     * @param state dynamic state of the backend network.
+     * @throw std::logic_error if the backend doesn't support restoring or the state doesn't match the network.
+     */
+    virtual void set_dynamic_state(const DynamicState &state);
+
+    /**
+     * @brief Get a pointer to a population stored by the backend.
+     * @details The pointer gives read-only access to population data without copying. It stays valid until
+     * populations are loaded or removed or neurons are added or removed. Use `get_update_sequence()` to find out
+     * if the data was changed by a step during reading. The default implementation returns `std::nullopt`.
+     * @param uid population UID.
+     * @return pointer to the population or `std::nullopt` if the backend doesn't store the population in host
+     * memory.
+     */
+    [[nodiscard]] virtual std::optional<PopulationConstPointer> get_population_pointer(const UID &uid) const;
+
+    /**
+     * @brief Get a pointer to a projection stored by the backend.
+     * @details The pointer gives read-only access to projection data without copying. It stays valid until
+     * projections are loaded or removed, but references to synapses are invalidated when synapses are added or
+     * removed or a compact projection is converted to explicit storage. Use `get_update_sequence()` to find out
+     * if the data was changed by a step during reading. The default implementation returns `std::nullopt`.
+     * @param uid projection UID.
+     * @return pointer to the projection or `std::nullopt` if the backend doesn't store the projection in host
+     * memory.
+     */
+    [[nodiscard]] virtual std::optional<ProjectionConstPointer> get_projection_pointer(const UID &uid) const;
+
+    /**
+     * @brief The PauseGuard class stops changes of backend network data while the guard exists.
+     * @details The guard waits until the current step or other change of network data finishes. Steps and other
+     * changes that start while the guard exists wait until the guard is destroyed. Use the guard to read network
+     * data from another thread when steps run back-to-back and optimistic reading never finishes between them.
+     * @warning Don't create the guard in the thread that executes the backend while it changes network data, for
+     * example inside a step.
+     */
+    class PauseGuard
+    {
+    public:
+        /**
+         * @brief Request a pause and wait until the backend stops changing network data.
+         * @param backend backend to pause.
+         */
+        explicit PauseGuard(const Backend &backend) : backend_(backend)
+        {
+            std::unique_lock lock(backend_.pause_mutex_);
+            backend_.pause_requests_.fetch_add(1);
+            backend_.pause_condition_.wait(lock, [this]() { return backend_.update_sequence_.load() % 2 == 0; });
+        }
+
+        /**
+         * @brief Let the backend continue changing network data.
+         */
+        ~PauseGuard()
+        {
+            const std::lock_guard lock(backend_.pause_mutex_);
+            backend_.pause_requests_.fetch_sub(1);
+            backend_.pause_condition_.notify_all();
+        }
+
+        PauseGuard(const PauseGuard &) = delete;
+        PauseGuard &operator=(const PauseGuard &) = delete;
+
+    private:
+        const Backend &backend_;
+    };
+
+protected:
+    /**
+     * @brief The UpdateGuard class marks network data of a backend as being changed while the guard exists.
+     * @details Create a guard for the duration of a step or any other change of network state. The guard waits
+     * while a `PauseGuard` exists, unless it is created inside another update.
+     */
+    class UpdateGuard
+    {
+    public:
+        /**
+         * @brief Mark beginning of a network data update.
+         * @param backend backend that changes its network data.
+         */
+        explicit UpdateGuard(Backend &backend) : backend_(backend)
+        {
+            // Nested updates don't wait, a reader that paused the backend waits for the outer update to finish.
+            if (backend_.pause_requests_.load() && backend_.update_sequence_.load(std::memory_order_relaxed) % 2 == 0)
+            {
+                std::unique_lock lock(backend_.pause_mutex_);
+                backend_.pause_condition_.wait(lock, [this]() { return !backend_.pause_requests_.load(); });
+            }
+            backend_.update_sequence_.fetch_add(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+        }
+
+        /**
+         * @brief Mark end of a network data update.
+         */
+        ~UpdateGuard()
+        {
+            // Sequentially consistent operations make sure that a waiting reader is either notified or sees the
+            // even sequence number itself.
+            backend_.update_sequence_.fetch_add(1);
+            if (backend_.pause_requests_.load())
+            {
+                const std::lock_guard lock(backend_.pause_mutex_);
+                backend_.pause_condition_.notify_all();
+            }
+        }
+
+        UpdateGuard(const UpdateGuard &) = delete;
+        UpdateGuard &operator=(const UpdateGuard &) = delete;
+
+    private:
+        Backend &backend_;
+    };
+
 protected:
     /**
      * @brief Backend default constructor.
@@ -378,9 +628,37 @@ protected:
      */
     core::Step gad_step() { return step_++; }
 
+    /**
+     * @brief Set the current step.
+     * @param step step number.
+     */
+    void set_step(core::Step step) { step_ = step; }
+
+    /**
+     * @brief Deliver spikes of bulk inputs for the current step to subscriptions of the backend endpoint.
+     * @details Call the method at the beginning of a step. Spikes bypass the message bus.
+     */
+    void deliver_bulk_inputs();
+
 private:
     void pre_start();
 
+    /**
+     * @brief Bulk input with the message used to deliver its spikes.
+     */
+    struct BulkInputMessages
+    {
+        /**
+         * @brief Bulk spike input.
+         */
+        BulkSpikeInput input_;
+
+        /**
+         * @brief Spike message reused at every step, so its spike buffer is allocated once.
+         */
+        messaging::MessageVariant message_;
+    };
+
 private:
     BaseData base_;
     std::atomic<bool> initialized_ = false;
@@ -388,7 +666,14 @@ private:
     std::vector<std::unique_ptr<Device>> devices_;
     MessageBus message_bus_;
     MessageEndpoint message_endpoint_;
+    std::unordered_set<UID, uid_hash> bus_message_senders_;
+    std::vector<BulkInputMessages> bulk_inputs_;
     core::Step step_ = 0;
+    std::atomic<uint64_t> update_sequence_ = 0;
+    // Readers that wait for a pause or read during a pause.
+    mutable std::atomic<size_t> pause_requests_ = 0;
+    mutable std::mutex pause_mutex_;
+    mutable std::condition_variable pause_condition_;
 };
 
 }  // namespace knp::core
@@ -0,0 +1,57 @@
+/**
+ * @file batch.h
+ * @brief Inputs and outputs of batched inference of independent samples.
+ * @kaspersky_support Artiom N.
+ * @date 18.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <knp/core/core.h>
+#include <knp/core/messaging/spike_message.h>
+#include <knp/core/uid.h>
+
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+
+/**
+ * @brief Core library namespace.
+ */
+namespace knp::core
+{
+/**
+ * @brief Functor that generates input spikes of a sample.
+ * @details The first parameter is the sample index, the second parameter is the step. Multi-threaded backends call
+ * the generator from several threads at once for different samples.
+ */
+using BatchInputGenerator = std::function<messaging::SpikeData(size_t, Step)>;
+
+
+/**
+ * @brief Input spike generators by UIDs of entities that send spikes to projections, such as input channels.
+ */
+using BatchInputMap = std::unordered_map<UID, BatchInputGenerator, uid_hash>;
+
+
+/**
+ * @brief Spike messages of output populations by sample index.
+ */
+using BatchOutput = std::vector<std::vector<messaging::SpikeMessage>>;
+
+}  // namespace knp::core
@@ -0,0 +1,105 @@
+/**
+ * @file bulk_input.h
+ * @brief Input of spikes generated for several steps at once.
+ * @kaspersky_support Artiom N.
+ * @date 18.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <knp/core/core.h>
+#include <knp/core/messaging/spike_message.h>
+
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+
+/**
+ * @brief Core library namespace.
+ */
+namespace knp::core
+{
+/**
+ * @brief Functor that generates spikes for several consecutive steps.
+ * @details The first parameter is the first step of the window. The second parameter contains one cleared vector
+ * of spiked neuron indexes for every step of the window, the functor fills them. Vectors keep their capacity
+ * between calls.
+ */
+using BulkSpikeGenerator = std::function<void(Step, std::vector<messaging::SpikeData> &)>;
+
+
+/**
+ * @brief The BulkSpikeInput class is a definition of an input that generates spikes for a window of future steps.
+ * @details The generator is called only when a step outside the current window is requested, so the cost of
+ * the call is shared by all steps of the window.
+ */
+class BulkSpikeInput
+{
+public:
+    /**
+     * @brief Create a bulk input.
+     * @param generator functor that generates spikes for a window of steps.
+     * @param window_size number of steps in a window.
+     * @throw std::invalid_argument if the window size is zero.
+     */
+    BulkSpikeInput(BulkSpikeGenerator generator, size_t window_size)
+        : generator_(std::move(generator)), window_(window_size)
+    {
+        if (window_.empty()) throw std::invalid_argument("Bulk input window size must be non-zero.");
+    }
+
+    /**
+     * @brief Get spiked neuron indexes of a step.
+     * @details If the step is outside the current window, the generator fills the window starting from the step.
+     * @param step step number.
+     * @return reference to spiked neuron indexes, valid until the next call.
+     * @throw std::logic_error if the generator changed the number of steps in the window.
+     */
+    const messaging::SpikeData &get_spikes(Step step)
+    {
+        if (!is_filled_ || step < first_step_ || step - first_step_ >= window_.size())
+        {
+            for (auto &spikes : window_) spikes.clear();
+            const size_t window_size = window_.size();
+            generator_(step, window_);
+            if (window_.size() != window_size)
+            {
+                is_filled_ = false;
+                throw std::logic_error("Bulk spike generator changed the window size.");
+            }
+            first_step_ = step;
+            is_filled_ = true;
+        }
+        return window_[step - first_step_];
+    }
+
+    /**
+     * @brief Get number of steps in a window.
+     * @return window size.
+     */
+    [[nodiscard]] size_t get_window_size() const { return window_.size(); }
+
+private:
+    BulkSpikeGenerator generator_;
+    std::vector<messaging::SpikeData> window_;
+    Step first_step_ = 0;
+    bool is_filled_ = false;
+};
+
+}  // namespace knp::core
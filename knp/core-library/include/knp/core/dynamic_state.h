@@ -0,0 +1,334 @@
+/**
+ * @file dynamic_state.h
+ * @brief Mutable state of populations and projections.
+ * @kaspersky_support Artiom N.
+ * @date 18.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <knp/core/core.h>
+#include <knp/core/messaging/messaging.h>
+#include <knp/core/population.h>
+#include <knp/core/projection.h>
+
+#include <cstdint>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+
+/**
+ * @brief Core library namespace.
+ */
+namespace knp::core
+{
+
+/**
+ * @brief Values of a dynamic parameter of all neurons of a population or all synapses of a projection.
+ * @details Floating-point parameters keep their type, integer, boolean and enumeration parameters are stored as
+ * 64-bit integers. Parameters that contain a vector for every neuron or synapse are stored as concatenated
+ * vectors, their sizes are stored as another parameter with the `sizes` suffix.
+ */
+using StateValues = std::variant<std::vector<double>, std::vector<float>, std::vector<int64_t>, std::vector<uint64_t>>;
+
+
+/**
+ * @brief The EntityState structure contains mutable state of a population or a projection.
+ */
+struct EntityState
+{
+    /**
+     * @brief Entity UID.
+     */
+    UID uid_{false};
+
+    /**
+     * @brief Dynamic parameter values by parameter names.
+     */
+    std::map<std::string, StateValues> values_;
+
+    /**
+     * @brief Pending synaptic impact messages of a projection with steps at which they are delivered.
+     */
+    std::vector<std::pair<uint64_t, messaging::SynapticImpactMessage>> pending_impacts_;
+};
+
+
+/**
+ * @brief The DynamicState structure contains mutable state of a network loaded to a backend.
+ * @details Dynamic state doesn't contain parameters that don't change during network execution, so it is
+ * much smaller than the network.
+ */
+struct DynamicState
+{
+    /**
+     * @brief Backend step at which the state was taken.
+     */
+    Step step_ = 0;
+
+    /**
+     * @brief States of populations.
+     */
+    std::vector<EntityState> populations_;
+
+    /**
+     * @brief States of projections.
+     */
+    std::vector<EntityState> projections_;
+};
+
+
+namespace detail
+{
+template <typename Value>
+using state_value_type = std::conditional_t<
+    std::is_floating_point_v<Value>, Value,
+    std::conditional_t<
+        std::is_signed_v<Value> || std::is_enum_v<Value>, int64_t,
+        std::conditional_t<std::is_integral_v<Value>, uint64_t, void>>>;
+
+
+// Call `function(name, accessor)` for every dynamic parameter of neurons or synapses. Accessor returns
+// a parameter reference by a neuron or a synapse.
+template <typename Parameters, typename Function>
+void for_each_dynamic_parameter(Function &&function)
+{
+    if constexpr (std::is_base_of_v<neuron_traits::neuron_parameters<neuron_traits::BLIFATNeuron>, Parameters>)
+    {
+        function("n_time_steps_since_last_firing_", [](auto &n) -> auto &
+                 { return n.n_time_steps_since_last_firing_; });
+        function("dynamic_threshold_", [](auto &n) -> auto & { return n.dynamic_threshold_; });
+        function("postsynaptic_trace_", [](auto &n) -> auto & { return n.postsynaptic_trace_; });
+        function("inhibitory_conductance_", [](auto &n) -> auto & { return n.inhibitory_conductance_; });
+        function("potential_", [](auto &n) -> auto & { return n.potential_; });
+        function("pre_impact_potential_", [](auto &n) -> auto & { return n.pre_impact_potential_; });
+        function("bursting_phase_", [](auto &n) -> auto & { return n.bursting_phase_; });
+        function("total_blocking_period_", [](auto &n) -> auto & { return n.total_blocking_period_; });
+        function("dopamine_value_", [](auto &n) -> auto & { return n.dopamine_value_; });
+    }
+    if constexpr (std::is_base_of_v<
+                      neuron_traits::neuron_parameters<neuron_traits::SynapticResourceSTDPBLIFATNeuron>, Parameters>)
+    {
+        function("free_synaptic_resource_", [](auto &n) -> auto & { return n.free_synaptic_resource_; });
+        function("stability_", [](auto &n) -> auto & { return n.stability_; });
+        function("isi_status_", [](auto &n) -> auto & { return n.isi_status_; });
+        function("last_step_", [](auto &n) -> auto & { return n.last_step_; });
+        function("first_isi_spike_", [](auto &n) -> auto & { return n.first_isi_spike_; });
+        function("is_being_forced_", [](auto &n) -> auto & { return n.is_being_forced_; });
+    }
+    if constexpr (std::is_same_v<neuron_traits::neuron_parameters<neuron_traits::AltAILIF>, Parameters>)
+    {
+        function("potential_", [](auto &n) -> auto & { return n.potential_; });
+    }
+
+    // Weights of synapses without plasticity rules are not dynamic.
+    using AdditiveSynapse = synapse_traits::synapse_parameters<synapse_traits::AdditiveSTDPDeltaSynapse>;
+    using ResourceSynapse = synapse_traits::synapse_parameters<synapse_traits::SynapticResourceSTDPDeltaSynapse>;
+    if constexpr (std::is_same_v<AdditiveSynapse, Parameters> || std::is_same_v<ResourceSynapse, Parameters>)
+    {
+        function("weight_", [](auto &s) -> auto & { return s.weight_; });
+    }
+    if constexpr (std::is_same_v<AdditiveSynapse, Parameters>)
+    {
+        function("presynaptic_spike_times_", [](auto &s) -> auto & { return s.rule_.presynaptic_spike_times_; });
+        function("postsynaptic_spike_times_", [](auto &s) -> auto & { return s.rule_.postsynaptic_spike_times_; });
+    }
+    if constexpr (std::is_same_v<ResourceSynapse, Parameters>)
+    {
+        function("synaptic_resource_", [](auto &s) -> auto & { return s.rule_.synaptic_resource_; });
+        function("last_spike_step_", [](auto &s) -> auto & { return s.rule_.last_spike_step_; });
+        function("had_hebbian_update_", [](auto &s) -> auto & { return s.rule_.had_hebbian_update_; });
+    }
+}
+
+
+template <typename Value>
+struct is_vector : std::false_type
+{
+};
+
+
+template <typename Value>
+struct is_vector<std::vector<Value>> : std::true_type
+{
+};
+
+
+// Add values of a parameter for a sequence of neurons or synapses to the state.
+template <typename Iterator, typename Accessor>
+void add_state_values(EntityState &state, const std::string &name, Iterator first, Iterator last, Accessor accessor)
+{
+    using Value = std::decay_t<decltype(accessor(*first))>;
+    if constexpr (is_vector<Value>::value)
+    {
+        std::vector<state_value_type<typename Value::value_type>> values;
+        std::vector<uint64_t> sizes;
+        sizes.reserve(std::distance(first, last));
+        for (auto iter = first; iter != last; ++iter)
+        {
+            const auto &vector = accessor(*iter);
+            values.insert(values.end(), vector.begin(), vector.end());
+            sizes.push_back(vector.size());
+        }
+        state.values_.emplace(name, std::move(values));
+        state.values_.emplace(name + "sizes", std::move(sizes));
+    }
+    else
+    {
+        std::vector<state_value_type<Value>> values;
+        values.reserve(std::distance(first, last));
+        for (auto iter = first; iter != last; ++iter)
+        {
+            values.push_back(static_cast<state_value_type<Value>>(accessor(*iter)));
+        }
+        state.values_.emplace(name, std::move(values));
+    }
+}
+
+
+// Set parameter values of a sequence of neurons or synapses from the state.
+template <typename Iterator, typename Accessor>
+void set_state_values(
+    const EntityState &state, const std::string &name, Iterator first, Iterator last, Accessor accessor)
+{
+    const auto values_iter = state.values_.find(name);
+    // Parameters that are not present in the state are not changed.
+    if (values_iter == state.values_.end()) return;
+
+    using Value = std::decay_t<decltype(accessor(*first))>;
+    const size_t count = std::distance(first, last);
+    std::visit(
+        [&](const auto &values)
+        {
+            if constexpr (is_vector<Value>::value)
+            {
+                const auto sizes_iter = state.values_.find(name + "sizes");
+                if (sizes_iter == state.values_.end()) throw std::logic_error("No sizes of \"" + name + "\" in state.");
+                const auto &sizes = std::get<std::vector<uint64_t>>(sizes_iter->second);
+                if (sizes.size() != count) throw std::logic_error("Wrong number of \"" + name + "\" values in state.");
+                size_t offset = 0;
+                for (auto iter = first; iter != last; ++iter)
+                {
+                    const size_t size = sizes[std::distance(first, iter)];
+                    if (offset + size > values.size())
+                        throw std::logic_error("Wrong number of \"" + name + "\" values in state.");
+                    auto &vector = accessor(*iter);
+                    vector.resize(size);
+                    for (size_t i = 0; i < size; ++i)
+                        vector[i] = static_cast<typename Value::value_type>(values[offset + i]);
+                    offset += size;
+                }
+            }
+            else
+            {
+                if (values.size() != count) throw std::logic_error("Wrong number of \"" + name + "\" values in state.");
+                size_t index = 0;
+                for (auto iter = first; iter != last; ++iter) accessor(*iter) = static_cast<Value>(values[index++]);
+            }
+        },
+        values_iter->second);
+}
+}  // namespace detail
+
+
+/**
+ * @brief Get mutable state of a population.
+ * @tparam NeuronType type of population neurons.
+ * @param population population.
+ * @return population state without pending impacts.
+ */
+template <typename NeuronType>
+EntityState get_dynamic_state(const Population<NeuronType> &population)
+{
+    EntityState result;
+    result.uid_ = population.get_uid();
+    detail::for_each_dynamic_parameter<typename Population<NeuronType>::NeuronParameters>(
+        [&result, &population](const std::string &name, auto accessor)
+        { detail::add_state_values(result, name, population.begin(), population.end(), accessor); });
+    return result;
+}
+
+
+/**
+ * @brief Get mutable state of a projection.
+ * @details Weights of synapses that don't have a plasticity rule are not dynamic. Compact projections don't have
+ * dynamic state.
+ * @tparam SynapseType type of projection synapses.
+ * @param projection projection.
+ * @return projection state without pending impacts.
+ */
+template <typename SynapseType>
+EntityState get_dynamic_state(const Projection<SynapseType> &projection)
+{
+    EntityState result;
+    result.uid_ = projection.get_uid();
+    if (projection.is_compact()) return result;
+    detail::for_each_dynamic_parameter<typename Projection<SynapseType>::SynapseParameters>(
+        [&result, &projection](const std::string &name, auto accessor)
+        {
+            detail::add_state_values(
+                result, name, projection.begin(), projection.end(),
+                [&accessor](const auto &synapse) -> const auto & { return accessor(std::get<synapse_data>(synapse)); });
+        });
+    return result;
+}
+
+
+/**
+ * @brief Restore mutable state of a population.
+ * @details Parameters that are not present in the state are not changed.
+ * @tparam NeuronType type of population neurons.
+ * @param population population.
+ * @param state population state.
+ * @throw std::logic_error if the state doesn't match the population.
+ */
+template <typename NeuronType>
+void set_dynamic_state(Population<NeuronType> &population, const EntityState &state)
+{
+    detail::for_each_dynamic_parameter<typename Population<NeuronType>::NeuronParameters>(
+        [&state, &population](const std::string &name, auto accessor)
+        { detail::set_state_values(state, name, population.begin(), population.end(), accessor); });
+}
+
+
+/**
+ * @brief Restore mutable state of a projection.
+ * @details Parameters that are not present in the state are not changed.
+ * @tparam SynapseType type of projection synapses.
+ * @param projection projection.
+ * @param state projection state.
+ * @throw std::logic_error if the state doesn't match the projection.
+ */
+template <typename SynapseType>
+void set_dynamic_state(Projection<SynapseType> &projection, const EntityState &state)
+{
+    if (projection.is_compact()) return;
+    detail::for_each_dynamic_parameter<typename Projection<SynapseType>::SynapseParameters>(
+        [&state, &projection](const std::string &name, auto accessor)
+        {
+            detail::set_state_values(
+                state, name, projection.begin(), projection.end(),
+                [&accessor](auto &synapse) -> auto & { return accessor(std::get<synapse_data>(synapse)); });
+        });
+}
+
+}  // namespace knp::core
@@ -25,6 +25,7 @@
 
 #include <functional>
 #include <memory>
+#include <string>
 
 /**
  * @brief Namespace for message bus implementations.
@@ -35,6 +36,11 @@ namespace knp::core::messaging::impl
  * @brief The MessageBusImpl class is an internal implementation class for message bus.
  */
 class MessageBusImpl;
+
+/**
+ * @brief The EndpointRegistry class is an internal class that tracks endpoints created by a message bus.
+ */
+class EndpointRegistry;
 }  // namespace knp::core::messaging::impl
 
 
@@ -61,6 +67,21 @@ public:
      */
     static MessageBus construct_zmq_bus();
 
+    /**
+     * @brief Create a message bus that exchanges messages between processes via POSIX shared memory.
+     * @details Each process creates its own bus with the same segment name. The first bus creates the segment,
+     * other buses attach to it. Every call of `route_messages()` waits until all processes call it too, then
+     * delivers messages sent by all endpoints of all processes. If messages of a process don't fit its buffer,
+     * `route_messages()` throws an exception in all processes. A segment left by stopped processes is created again.
+     * @param name shared memory segment name.
+     * @param process_count number of processes that use the bus.
+     * @param max_endpoints maximum number of endpoints in all processes.
+     * @param buffer_size maximum size in bytes of the messages that one endpoint can send between two routings.
+     * @return message bus.
+     */
+    static MessageBus construct_shm_bus(
+        const std::string &name, size_t process_count = 1, size_t max_endpoints = 32, size_t buffer_size = 1 << 20);
+
     /**
      * @brief Create a message bus with default implementation.
      * @return message bus.
@@ -103,19 +124,58 @@ public:
      */
     size_t route_messages();
 
+    /**
+     * @brief Check if an endpoint of the message bus is subscribed to messages of a sender.
+     * @details Only endpoints created by this message bus object are checked. Endpoints of other processes that use
+     * the same ZMQ or shared memory bus are not known. The method locks subscriptions of every endpoint, so cache
+     * its result until `get_subscription_version()` changes instead of calling it at every step.
+     * @tparam MessageType message type.
+     * @param sender sender UID.
+     * @param ignored_receiver receiver which subscriptions are not taken into account.
+     * @return `true` if a receiver other than `ignored_receiver` is subscribed to messages of the sender.
+     */
+    template <typename MessageType>
+    [[nodiscard]] bool has_subscription(const UID &sender, const UID &ignored_receiver = UID{false}) const
+    {
+        return has_subscription(
+            MessageEndpoint::get_type_index<messaging::MessageVariant, MessageType>, sender, ignored_receiver);
+    }
+
+    /**
+     * @brief Get version of subscriptions of the message bus endpoints.
+     * @details The version changes every time an endpoint of the message bus subscribes, unsubscribes or is
+     * destroyed.
+     * @return subscription version.
+     */
+    [[nodiscard]] uint64_t get_subscription_version() const;
+
 private:
     /**
      * @brief Message bus constructor with a specialized implementation.
      * @param impl message bus implementation.
-     * @note Currently two implementations are available: ZMQ and CPU.
+     * @note Currently three implementations are available: ZMQ, CPU and shared memory.
      */
     explicit MessageBus(std::unique_ptr<messaging::impl::MessageBusImpl> &&impl);
 
+    /**
+     * @brief Check if an endpoint of the message bus is subscribed to messages of a sender.
+     * @param type_index index of the message type in the message variant.
+     * @param sender sender UID.
+     * @param ignored_receiver receiver which subscriptions are not taken into account.
+     * @return `true` if a receiver other than `ignored_receiver` is subscribed to messages of the sender.
+     */
+    [[nodiscard]] bool has_subscription(size_t type_index, const UID &sender, const UID &ignored_receiver) const;
+
 
     /**
      * @brief Message bus implementation.
      */
     std::unique_ptr<messaging::impl::MessageBusImpl> impl_;
+
+    /**
+     * @brief Endpoints created by the message bus.
+     */
+    std::shared_ptr<messaging::impl::EndpointRegistry> endpoints_;
 };
 
 }  // namespace knp::core
@@ -25,14 +25,17 @@
 #include <knp/core/messaging/messaging.h>
 #include <knp/core/subscription.h>
 #include <knp/core/uid.h>
+#include <knp/core/uid_registry.h>
 
 #include <any>
 #include <chrono>
 #include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <numeric>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <variant>
 #include <vector>
@@ -50,6 +53,11 @@ namespace knp::core::messaging::impl
  * @brief The MessageEndpointImpl class is an internal implementation class for message endpoint.
  */
 class MessageEndpointImpl;
+
+/**
+ * @brief The EndpointRegistry class is an internal class that tracks endpoints created by a message bus.
+ */
+class EndpointRegistry;
 }  // namespace knp::core::messaging::impl
 
 
@@ -94,9 +102,9 @@ public:
     /**
      * @brief Get subscription key from a subscription variant.
      * @param subscription subscription variant.
-     * @return pair of subscription index and subscription key.
+     * @return pair of subscription index and receiver handle.
      */
-    static std::pair<size_t, UID> get_subscription_key(const SubscriptionVariant &subscription);
+    static std::pair<size_t, UIDHandle> get_subscription_key(const SubscriptionVariant &subscription);
 
     /**
      * @brief Find index of an entity type in its variant.
@@ -129,7 +137,8 @@ public:
     /**
      * @brief Add a subscription to messages of the specified type from senders with given UIDs.
      * @note If the subscription for the specified receiver and message type already exists, the method updates the list
-     * of senders in the subscription.
+     * of senders in the subscription. Change senders of the subscription with this method rather than with the
+     * returned reference, otherwise backends that cache subscriptions of the message bus aren't notified.
      * @tparam MessageType type of messages to which the receiver subscribes via the subscription.
      * @param receiver receiver UID.
      * @param senders vector of sender UIDs.
@@ -166,6 +175,13 @@ public:
      */
     bool receive_message();
 
+    /**
+     * @brief Add a message to subscriptions of the endpoint without sending it to the message bus.
+     * @details Use this method to deliver messages to entities served by the same endpoint.
+     * @param message message to deliver.
+     */
+    void deliver_message(const knp::core::messaging::MessageVariant &message);
+
     /**
      * @brief Receive all messages that were sent to the endpoint.
      * @param sleep_duration time interval in milliseconds between the moments of receiving messages.
@@ -183,11 +199,24 @@ public:
     template <class MessageType>
     std::vector<MessageType> unload_messages(const knp::core::UID &receiver_uid);
 
+    /**
+     * @brief Get messages of the specified type received via subscription without unloading them.
+     * @details Use the method to update received messages that are not processed yet, for example after neurons of
+     * a receiver are removed.
+     * @tparam MessageType type of messages.
+     * @param receiver_uid receiver UID.
+     * @return pointer to received messages or `nullptr` if the receiver has no subscription to messages of the type.
+     */
+    template <class MessageType>
+    std::vector<MessageType> *get_received_messages(const knp::core::UID &receiver_uid);
+
 public:
     /**
      * @brief Type of subscription container.
+     * @details Subscriptions are ordered by message type index and receiver handle, so subscriptions to messages of
+     * the same type are adjacent.
      */
-    using SubscriptionContainer = std::map<std::pair<size_t, UID>, SubscriptionVariant>;
+    using SubscriptionContainer = std::map<std::pair<size_t, UIDHandle>, SubscriptionVariant>;
 
     /**
      * @brief Get access to subscription container of the endpoint.
@@ -195,6 +224,12 @@ public:
      */
     const SubscriptionContainer &get_endpoint_subscriptions() const { return subscriptions_; }
 
+    /**
+     * @brief Get registry that assigns handles to receivers and senders of the endpoint subscriptions.
+     * @return UID registry.
+     */
+    [[nodiscard]] const UIDRegistry &get_uid_registry() const { return *uid_registry_; }
+
 protected:
     /**
      * @brief Message endpoint implementation.
@@ -208,10 +243,64 @@ protected:
     MessageEndpoint() = default;
 
 private:
+    /**
+     * @brief Find handle of a message sender.
+     * @details Messages carry sender UIDs, so a sender UID is hashed once per message. Subscriptions are then checked
+     * by integer handles.
+     * @param sender_uid sender UID.
+     * @return sender handle or `UIDRegistry::invalid_handle` if no subscription has the sender.
+     */
+    UIDHandle find_sender_handle(const UID &sender_uid);
+
+    /**
+     * @brief Check if the endpoint has a subscription to messages of a sender.
+     * @details The method can be called from any thread.
+     * @param type_index index of the message type in the message variant.
+     * @param sender sender UID.
+     * @param ignored_receiver receiver which subscriptions are not taken into account.
+     * @return `true` if a receiver other than `ignored_receiver` is subscribed to messages of the sender.
+     */
+    [[nodiscard]] bool has_subscription(size_t type_index, const UID &sender, const UID &ignored_receiver) const;
+
+    /**
+     * @brief Notify the message bus that subscriptions of the endpoint changed.
+     */
+    void update_bus_subscriptions() const;
+
+private:
+    /**
+     * @brief Registry of UID handles shared with subscriptions.
+     */
+    std::shared_ptr<UIDRegistry> uid_registry_ = std::make_shared<UIDRegistry>();
+
     /**
      * @brief Container that stores all the subscriptions for the current endpoint.
      */
     SubscriptionContainer subscriptions_;
+
+    /**
+     * @brief Mutex that guards changes of the subscription container against reads from other threads.
+     * @details The owning thread reads subscriptions without locking.
+     */
+    mutable std::mutex subscriptions_mutex_;
+
+    /**
+     * @brief Cached handles of message senders, including senders without subscriptions.
+     */
+    std::unordered_map<UID, UIDHandle, uid_hash> sender_handles_;
+
+    /**
+     * @brief Registry version for which sender handles are cached.
+     */
+    uint64_t sender_handles_version_ = 0;
+
+    /**
+     * @brief Registry of endpoints of the message bus that created the endpoint.
+     */
+    std::shared_ptr<messaging::impl::EndpointRegistry> bus_endpoints_;
+
+    friend class MessageBus;
+    friend class messaging::impl::EndpointRegistry;
 };
 
 }  // namespace knp::core
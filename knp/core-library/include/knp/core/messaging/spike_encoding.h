@@ -0,0 +1,232 @@
+/**
+ * @file spike_encoding.h
+ * @brief Compact encodings of spike indexes in serialized spike messages.
+ * @kaspersky_support Artiom N.
+ * @date 18.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "spike_message.h"
+
+
+/**
+ * @brief Messaging namespace.
+ */
+namespace knp::core::messaging
+{
+
+/**
+ * @brief Spike index encoding type.
+ */
+enum class SpikeEncoding : uint8_t
+{
+    /**
+     * @brief Indexes are stored as 32-bit unsigned integers.
+     */
+    raw = 0,
+    /**
+     * @brief Bit `i` is set if neuron `i` spiked. Suitable for dense spikes.
+     */
+    bitset = 1,
+    /**
+     * @brief Differences between sorted indexes are stored as variable-length integers. Suitable for sparse spikes.
+     */
+    delta_varint = 2
+};
+
+
+/**
+ * @brief Structure of encoded spike indexes.
+ */
+struct EncodedSpikeData
+{
+    /**
+     * @brief Encoding type.
+     */
+    SpikeEncoding encoding_ = SpikeEncoding::raw;
+
+    /**
+     * @brief Number of encoded spikes.
+     */
+    uint32_t spike_count_ = 0;
+
+    /**
+     * @brief Encoded bytes.
+     */
+    std::vector<uint8_t> data_;
+};
+
+
+/**
+ * @brief Choose the encoding that gives the smallest size for the spike indexes.
+ * @details Bitset and delta-varint encodings are used only if indexes are sorted in ascending order without
+ * duplicates. Otherwise the order of the decoded indexes would differ from the original one.
+ * @param spikes spike indexes.
+ * @return encoding type.
+ */
+SpikeEncoding choose_spike_encoding(const SpikeData &spikes);
+
+
+/**
+ * @brief Get size of the encoded spike indexes.
+ * @note Bitset and delta-varint sizes are valid only for sorted indexes.
+ * @param spikes spike indexes.
+ * @param encoding encoding type.
+ * @return size in bytes.
+ */
+size_t get_encoded_size(const SpikeData &spikes, SpikeEncoding encoding);
+
+
+/**
+ * @brief Encode spike indexes with the smallest encoding.
+ * @param spikes spike indexes.
+ * @param encoded structure that receives encoded data. Its buffer is reused.
+ */
+void encode_spikes(const SpikeData &spikes, EncodedSpikeData &encoded);
+
+
+/**
+ * @brief Encode spike indexes with the given encoding.
+ * @param spikes spike indexes.
+ * @param encoding encoding type.
+ * @param encoded structure that receives encoded data. Its buffer is reused.
+ * @throw std::invalid_argument if indexes are not sorted for bitset or delta-varint encoding.
+ */
+void encode_spikes(const SpikeData &spikes, SpikeEncoding encoding, EncodedSpikeData &encoded);
+
+
+/**
+ * @brief Encode spike indexes with the smallest encoding.
+ * @param spikes spike indexes.
+ * @return encoded spike indexes.
+ */
+EncodedSpikeData encode_spikes(const SpikeData &spikes);
+
+
+/**
+ * @brief Get maximum number of spike indexes that an encoded buffer can contain.
+ * @details Use the value to bound memory reserved for decoded indexes, as the spike count of a received message
+ * can't be trusted.
+ * @param encoding encoding type.
+ * @param size number of encoded bytes.
+ * @return maximum number of spike indexes.
+ */
+size_t get_max_spike_count(SpikeEncoding encoding, size_t size);
+
+
+/**
+ * @brief Call a function for every spike index stored in an encoded buffer.
+ * @details Indexes are read directly from the buffer without decoding it to a vector. Encodings are used only in
+ * serialized messages, `SpikeData` always contains raw indexes.
+ * @tparam Function type of function that receives `SpikeIndex`.
+ * @param encoding encoding type.
+ * @param data pointer to encoded bytes.
+ * @param size number of encoded bytes.
+ * @param function function to call.
+ * @throw std::runtime_error if a delta-varint buffer is truncated.
+ */
+template <typename Function>
+void for_each_spike(SpikeEncoding encoding, const uint8_t *data, size_t size, Function &&function)
+{
+    switch (encoding)
+    {
+        case SpikeEncoding::raw:
+            for (size_t offset = 0; offset + sizeof(SpikeIndex) <= size; offset += sizeof(SpikeIndex))
+            {
+                SpikeIndex index;
+                std::memcpy(&index, data + offset, sizeof(SpikeIndex));
+                function(index);
+            }
+            break;
+        case SpikeEncoding::bitset:
+            for (size_t byte_index = 0; byte_index < size; ++byte_index)
+            {
+                const uint8_t bits = data[byte_index];
+                if (!bits) continue;
+                for (unsigned bit = 0; bit < 8; ++bit)
+                {
+                    if (bits & (1U << bit)) function(static_cast<SpikeIndex>(byte_index * 8 + bit));
+                }
+            }
+            break;
+        case SpikeEncoding::delta_varint:
+        {
+            SpikeIndex index = 0;
+            bool first = true;
+            for (size_t offset = 0; offset < size;)
+            {
+                uint32_t value = 0;
+                for (unsigned shift = 0;; shift += 7)
+                {
+                    if (offset >= size || shift > 28) throw std::runtime_error("Broken delta-varint spike data.");
+                    const uint8_t byte = data[offset++];
+                    value |= static_cast<uint32_t>(byte & 0x7f) << shift;
+                    if (!(byte & 0x80)) break;
+                }
+                // Indexes are strictly ascending, so all differences except the first one are decreased by one.
+                index = first ? value : index + value + 1;
+                first = false;
+                function(index);
+            }
+            break;
+        }
+    }
+}
+
+
+/**
+ * @brief Call a function for every encoded spike index.
+ * @tparam Function type of function that receives `SpikeIndex`.
+ * @param spikes encoded spike indexes.
+ * @param function function to call.
+ */
+template <typename Function>
+void for_each_spike(const EncodedSpikeData &spikes, Function &&function)
+{
+    for_each_spike(spikes.encoding_, spikes.data_.data(), spikes.data_.size(), std::forward<Function>(function));
+}
+
+
+/**
+ * @brief Call a function for every spike index.
+ * @details This overload allows code to process raw and encoded spike indexes in the same way.
+ * @tparam Function type of function that receives `SpikeIndex`.
+ * @param spikes spike indexes.
+ * @param function function to call.
+ */
+template <typename Function>
+void for_each_spike(const SpikeData &spikes, Function &&function)
+{
+    for (const auto index : spikes) function(index);
+}
+
+
+/**
+ * @brief Decode spike indexes.
+ * @param spikes encoded spike indexes.
+ * @return vector of spike indexes.
+ */
+SpikeData decode_spikes(const EncodedSpikeData &spikes);
+
+}  // namespace knp::core::messaging
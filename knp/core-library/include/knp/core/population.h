@@ -26,7 +26,9 @@
 #include <knp/core/uid.h>
 #include <knp/neuron-traits/all_traits.h>
 
+#include <algorithm>
 #include <functional>
+#include <iterator>
 #include <utility>
 #include <vector>
 
@@ -80,6 +82,19 @@ public:  // NOLINT
      */
     Population(const knp::core::UID &uid, NeuronGenerator generator, size_t neurons_count);
 
+    /**
+     * @brief Construct a population from prepared neuron parameters.
+     * @param neurons parameters of population neurons.
+     */
+    explicit Population(std::vector<NeuronParameters> neurons);
+
+    /**
+     * @brief Construct a population from prepared neuron parameters.
+     * @param uid population UID.
+     * @param neurons parameters of population neurons.
+     */
+    Population(const knp::core::UID &uid, std::vector<NeuronParameters> neurons);
+
 public:  // NOLINT
     /**
      * @brief Get population UID.
@@ -165,17 +180,44 @@ public:  // NOLINT
         }
     }
 
+    /**
+     * @brief Add prepared neurons to the population.
+     * @param neurons parameters of neurons to add.
+     */
+    void add_neurons(std::vector<NeuronParameters> neurons)
+    {
+        if (neurons_.empty())
+        {
+            neurons_ = std::move(neurons);
+            return;
+        }
+        neurons_.insert(
+            neurons_.end(), std::make_move_iterator(neurons.begin()), std::make_move_iterator(neurons.end()));
+    }
+
     /**
      * @brief Remove neurons with given indexes from the population.
-     * @param neuron_indexes indexes of neurons to remove.
+     * @details Neurons are removed in a single pass, order of the remaining neurons is kept.
+     * @param neuron_indexes indexes of neurons to remove in any order.
      */
-    void remove_neurons(const std::vector<size_t> &neuron_indexes)
+    void remove_neurons(std::vector<size_t> neuron_indexes)
     {
-        size_t index_shift = 0;
-        for (const auto &index : neuron_indexes)
+        std::sort(neuron_indexes.begin(), neuron_indexes.end());
+        neuron_indexes.erase(std::unique(neuron_indexes.begin(), neuron_indexes.end()), neuron_indexes.end());
+        if (neuron_indexes.empty()) return;
+
+        auto next_to_remove = neuron_indexes.begin();
+        size_t write_index = *next_to_remove;
+        for (size_t read_index = write_index; read_index < neurons_.size(); ++read_index)
         {
-            remove_neuron(index - index_shift++);
+            if (next_to_remove != neuron_indexes.end() && *next_to_remove == read_index)
+            {
+                ++next_to_remove;
+                continue;
+            }
+            neurons_[write_index++] = std::move(neurons_[read_index]);
         }
+        neurons_.erase(neurons_.begin() + write_index, neurons_.end());
     }
 
     /**
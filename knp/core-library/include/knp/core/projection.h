@@ -22,21 +22,23 @@
 #pragma once
 
 #include <knp/core/core.h>
+#include <knp/core/synapse_block.h>
 #include <knp/core/uid.h>
 #include <knp/synapse-traits/all_traits.h>
 
 #include <algorithm>
+#include <cstddef>
 #include <functional>
+#include <iterator>
 #include <optional>
+#include <stdexcept>
 #include <tuple>
+#include <type_traits>
 #include <unordered_map>
 #include <utility>
+#include <variant>
 #include <vector>
 
-#include <boost/multi_index/hashed_index.hpp>
-#include <boost/multi_index/member.hpp>
-#include <boost/multi_index_container.hpp>
-
 
 /**
  * @brief Core library namespace.
@@ -65,6 +67,10 @@ enum SynapseElementAccess
 
 /**
  * @brief The Projection class is a definition of similar connections between the neurons of two populations.
+ * @details A projection stores synapses explicitly as a list or compactly as a synapse block. A compact projection
+ * stores only weights and optional delays of a block, neuron indexes of synapses are computed. Synapses of a compact
+ * projection are generated by `get_synapse()` and `find_synapses()`, methods that change synapses or give
+ * non-constant access to the synapse list convert the projection to the explicit storage.
  * @todo This class should later be divided to interface and implementation classes.
  * @tparam SynapseType type of synapses the projection contains.
  * @see ALL_SYNAPSES.
@@ -96,6 +102,12 @@ public:
      */
     using SynapseGenerator = std::function<std::optional<Synapse>(size_t)>;
 
+    /**
+     * @brief Parameters shared by all synapses of a compact projection.
+     * @details Compact projections contain synapses that have only weight, delay and output type.
+     */
+    using BlockParameters = typename synapse_traits::synapse_parameters<synapse_traits::DeltaSynapse>;
+
 public:
     /**
      * @brief Shared synapse parameters for the non-STDP variant of the projection.
@@ -187,6 +199,122 @@ public:
      */
     Projection(UID uid, UID presynaptic_uid, UID postsynaptic_uid, SynapseGenerator generator, size_t num_iterations);
 
+    /**
+     * @brief Construct a projection from prepared synapses.
+     * @details The synapse index is built once after all synapses are stored.
+     * @param presynaptic_uid presynaptic population UID.
+     * @param postsynaptic_uid postsynaptic population UID.
+     * @param synapses synapses of the projection.
+     */
+    Projection(UID presynaptic_uid, UID postsynaptic_uid, std::vector<Synapse> synapses);
+
+    /**
+     * @brief Construct a projection from prepared synapses.
+     * @details The synapse index is built once after all synapses are stored.
+     * @param uid projection UID.
+     * @param presynaptic_uid presynaptic population UID.
+     * @param postsynaptic_uid postsynaptic population UID.
+     * @param synapses synapses of the projection.
+     */
+    Projection(UID uid, UID presynaptic_uid, UID postsynaptic_uid, std::vector<Synapse> synapses);
+
+public:
+    /**
+     * @brief Create synapses from arrays of their parameters.
+     * @param sources presynaptic neuron indexes.
+     * @param targets postsynaptic neuron indexes. Size must be equal to the `sources` size.
+     * @param weights synapse weights. If empty, the weight of `parameters` is used.
+     * @param delays synapse delays. If empty, the delay of `parameters` is used.
+     * @param parameters parameters of all synapses except weights and delays.
+     * @return vector of synapses.
+     * @throw std::invalid_argument if array sizes are different.
+     */
+    static std::vector<Synapse> make_synapses(
+        const std::vector<size_t> &sources, const std::vector<size_t> &targets, const std::vector<float> &weights,
+        const std::vector<uint32_t> &delays, const SynapseParameters &parameters = SynapseParameters());
+
+    /**
+     * @brief Construct a projection from arrays of synapse parameters.
+     * @details Use this method instead of a synapse generator to load connectivity exported from other tools.
+     * @param presynaptic_uid presynaptic population UID.
+     * @param postsynaptic_uid postsynaptic population UID.
+     * @param sources presynaptic neuron indexes.
+     * @param targets postsynaptic neuron indexes. Size must be equal to the `sources` size.
+     * @param weights synapse weights. If empty, the weight of `parameters` is used.
+     * @param delays synapse delays. If empty, the delay of `parameters` is used.
+     * @param parameters parameters of all synapses except weights and delays.
+     * @return projection.
+     * @throw std::invalid_argument if array sizes are different.
+     */
+    static Projection from_arrays(
+        UID presynaptic_uid, UID postsynaptic_uid, const std::vector<size_t> &sources,
+        const std::vector<size_t> &targets, const std::vector<float> &weights, const std::vector<uint32_t> &delays,
+        const SynapseParameters &parameters = SynapseParameters())
+    {
+        return Projection(
+            presynaptic_uid, postsynaptic_uid, make_synapses(sources, targets, weights, delays, parameters));
+    }
+
+    /**
+     * @brief Construct a compact projection that connects every presynaptic neuron to every postsynaptic neuron.
+     * @details Only weights and delays are stored, memory used by the projection doesn't depend on the synapse size.
+     * @param presynaptic_uid presynaptic population UID.
+     * @param postsynaptic_uid postsynaptic population UID.
+     * @param presynaptic_size number of presynaptic neurons.
+     * @param postsynaptic_size number of postsynaptic neurons.
+     * @param weights row-major weight matrix with a row per presynaptic neuron.
+     * @param delays synapse delays in the same order as weights. If empty, the delay of `parameters` is used.
+     * @param parameters parameters of all synapses except weights and delays.
+     * @tparam ProjectionSynapse projection synapse type. Only delta synapses are supported, because other synapses have
+     * individual state.
+     * @return projection.
+     * @throw std::invalid_argument if array sizes don't match the block.
+     */
+    template <typename ProjectionSynapse = SynapseType>
+    static Projection make_dense(
+        UID presynaptic_uid, UID postsynaptic_uid, size_t presynaptic_size, size_t postsynaptic_size,
+        std::vector<float> weights, std::vector<uint32_t> delays = {},
+        const SynapseParameters &parameters = SynapseParameters())
+    {
+        static_assert(
+            std::is_same_v<ProjectionSynapse, SynapseType> &&
+                std::is_same_v<ProjectionSynapse, synapse_traits::DeltaSynapse>,
+            "Compact projections support only synapses without individual state.");
+        return make_compact(
+            presynaptic_uid, postsynaptic_uid, DenseBlock{presynaptic_size, postsynaptic_size}, std::move(weights),
+            std::move(delays), parameters);
+    }
+
+    /**
+     * @brief Construct a compact projection with convolution-like connections.
+     * @param presynaptic_uid presynaptic population UID.
+     * @param postsynaptic_uid postsynaptic population UID.
+     * @param block sizes of the neuron grid and the kernel.
+     * @param kernel row-major kernel weights shared by all postsynaptic neurons.
+     * @param delays delays of kernel synapses. If empty, the delay of `parameters` is used.
+     * @param parameters parameters of all synapses except weights and delays.
+     * @tparam ProjectionSynapse projection synapse type. Only delta synapses are supported, because other synapses have
+     * individual state.
+     * @return projection.
+     * @throw std::invalid_argument if the block is invalid or array sizes don't match the kernel size.
+     */
+    template <typename ProjectionSynapse = SynapseType>
+    static Projection make_kernel(
+        UID presynaptic_uid, UID postsynaptic_uid, const KernelBlock &block, std::vector<float> kernel,
+        std::vector<uint32_t> delays = {}, const SynapseParameters &parameters = SynapseParameters())
+    {
+        static_assert(
+            std::is_same_v<ProjectionSynapse, SynapseType> &&
+                std::is_same_v<ProjectionSynapse, synapse_traits::DeltaSynapse>,
+            "Compact projections support only synapses without individual state.");
+        if (!block.kernel_height_ || !block.kernel_width_ || !block.stride_)
+        {
+            throw std::invalid_argument("Kernel sizes and stride must be positive.");
+        }
+        return make_compact(
+            presynaptic_uid, postsynaptic_uid, block, std::move(kernel), std::move(delays), parameters);
+    }
+
 public:
     /**
      * @brief Get projection UID.
@@ -211,49 +339,253 @@ public:
 public:
     /**
      * @brief Get parameter values of a synapse with the given index.
+     * @note Neuron indexes of the synapse must not be changed, because the synapse index is not updated.
      * @param index synapse index.
      * @return synapse parameters and indexes.
+     * @throw std::logic_error if the projection is compact. Call `materialize()` to change its synapses.
      */
-    [[nodiscard]] Synapse &operator[](size_t index) { return parameters_[index]; }
+    [[nodiscard]] Synapse &operator[](size_t index)
+    {
+        check_explicit();
+        return parameters_[index];
+    }
 
     /**
      * @brief Get parameter values of a synapse with the given index.
      * @details Constant method.
      * @param index synapse index.
      * @return synapse parameters and indexes.
+     * @throw std::logic_error if the projection is compact. Use `get_synapse()` or `get_synapses()` to read its
+     * synapses.
+     */
+    [[nodiscard]] const Synapse &operator[](size_t index) const
+    {
+        check_explicit();
+        return parameters_[index];
+    }
+
+    /**
+     * @brief Get a synapse with the given index from the explicit or compact storage.
+     * @param index synapse index.
+     * @return copy of synapse parameters and indexes.
+     * @throw std::out_of_range if the index is out of range.
      */
-    [[nodiscard]] const Synapse &operator[](size_t index) const { return parameters_[index]; }
+    [[nodiscard]] Synapse get_synapse(size_t index) const;
 
     /**
      * @brief Get an iterator pointing to the first element of the projection.
      * @return constant projection iterator.
+     * @throw std::logic_error if the projection is compact.
      */
-    [[nodiscard]] auto begin() const { return parameters_.cbegin(); }
+    [[nodiscard]] auto begin() const
+    {
+        check_explicit();
+        return parameters_.cbegin();
+    }
 
     /**
      * @brief Get an iterator pointing to the first element of the projection.
      * @return projection iterator.
+     * @throw std::logic_error if the projection is compact. Call `materialize()` to change its synapses.
      */
-    [[nodiscard]] auto begin() { return parameters_.begin(); }
+    [[nodiscard]] auto begin()
+    {
+        check_explicit();
+        return parameters_.begin();
+    }
 
     /**
      * @brief Get an iterator pointing to the last element of the projection.
      * @return constant iterator.
+     * @throw std::logic_error if the projection is compact.
      */
-    [[nodiscard]] auto end() const { return parameters_.cend(); }
+    [[nodiscard]] auto end() const
+    {
+        check_explicit();
+        return parameters_.cend();
+    }
 
     /**
      * @brief Get an iterator pointing to the last element of the projection.
      * @return iterator.
+     * @throw std::logic_error if the projection is compact. Call `materialize()` to change its synapses.
+     */
+    [[nodiscard]] auto end()
+    {
+        check_explicit();
+        return parameters_.end();
+    }
+
+    /**
+     * @brief The SynapseView class is a read-only view of projection synapses in the explicit or compact storage.
+     * @details Synapses of a compact projection are computed on access, so iterators return copies of synapses.
+     */
+    class SynapseView
+    {
+    public:
+        /**
+         * @brief The Iterator class is a definition of an iterator over synapses of a view.
+         */
+        class Iterator
+        {
+        public:
+            /**
+             * @brief Iterator category.
+             */
+            using iterator_category = std::input_iterator_tag;
+            /**
+             * @brief Value type.
+             */
+            using value_type = Synapse;
+            /**
+             * @brief Difference type.
+             */
+            using difference_type = std::ptrdiff_t;
+            /**
+             * @brief Pointer type.
+             */
+            using pointer = void;
+            /**
+             * @brief Reference type, synapses are returned by value.
+             */
+            using reference = Synapse;
+
+            /**
+             * @brief Constructor.
+             * @param projection projection with synapses.
+             * @param index synapse index.
+             */
+            Iterator(const Projection &projection, size_t index) : projection_(&projection), index_(index) {}
+
+            /**
+             * @brief Get a copy of the current synapse.
+             * @return synapse parameters and indexes.
+             */
+            [[nodiscard]] Synapse operator*() const { return projection_->get_synapse(index_); }
+
+            /**
+             * @brief Move to the next synapse.
+             * @return reference to the iterator.
+             */
+            Iterator &operator++()
+            {
+                ++index_;
+                return *this;
+            }
+
+            /**
+             * @brief Compare iterators.
+             * @param other other iterator.
+             * @return `true` if iterators point to the same synapse.
+             */
+            [[nodiscard]] bool operator==(const Iterator &other) const
+            {
+                return projection_ == other.projection_ && index_ == other.index_;
+            }
+
+            /**
+             * @brief Compare iterators.
+             * @param other other iterator.
+             * @return `true` if iterators point to different synapses.
+             */
+            [[nodiscard]] bool operator!=(const Iterator &other) const { return !(*this == other); }
+
+        private:
+            const Projection *projection_;
+            size_t index_;
+        };
+
+        /**
+         * @brief Constructor.
+         * @param projection projection with synapses.
+         */
+        explicit SynapseView(const Projection &projection) : projection_(projection) {}
+
+        /**
+         * @brief Get an iterator pointing to the first synapse.
+         * @return synapse iterator.
+         */
+        [[nodiscard]] Iterator begin() const { return {projection_, 0}; }
+
+        /**
+         * @brief Get an iterator pointing past the last synapse.
+         * @return synapse iterator.
+         */
+        [[nodiscard]] Iterator end() const { return {projection_, projection_.size()}; }
+
+        /**
+         * @brief Count number of synapses.
+         * @return number of synapses.
+         */
+        [[nodiscard]] size_t size() const { return projection_.size(); }
+
+    private:
+        const Projection &projection_;
+    };
+
+    /**
+     * @brief Get a read-only view of synapses that works with the explicit and compact storage.
+     * @details Use the view to read synapses of a compact projection without converting it to the explicit storage.
+     * @return synapse view.
      */
-    [[nodiscard]] auto end() { return parameters_.end(); }
+    [[nodiscard]] SynapseView get_synapses() const { return SynapseView{*this}; }
 
 public:
     /**
      * @brief Count number of synapses in the projection.
      * @return number of synapses.
      */
-    [[nodiscard]] size_t size() const { return parameters_.size(); }
+    [[nodiscard]] size_t size() const
+    {
+        if (!block_) return parameters_.size();
+        return std::visit([](const auto &block) { return block.get_synapse_count(); }, *block_);
+    }
+
+    /**
+     * @brief Determine if the projection stores synapses as a synapse block.
+     * @return `true` if the projection is compact.
+     */
+    [[nodiscard]] bool is_compact() const { return block_.has_value(); }
+
+    /**
+     * @brief Get the synapse block of a compact projection.
+     * @return synapse block or `std::nullopt` if synapses are stored explicitly.
+     */
+    [[nodiscard]] const std::optional<SynapseBlock> &get_synapse_block() const { return block_; }
+
+    /**
+     * @brief Get weights of a compact projection.
+     * @details Weights can be changed in place, their order is defined by the synapse block.
+     * @return block weights.
+     */
+    [[nodiscard]] std::vector<float> &get_block_weights() { return block_weights_; }
+
+    /**
+     * @brief Get weights of a compact projection.
+     * @note Constant method.
+     * @return block weights.
+     */
+    [[nodiscard]] const std::vector<float> &get_block_weights() const { return block_weights_; }
+
+    /**
+     * @brief Get delays of a compact projection.
+     * @return block delays in the order of weights or an empty vector if all synapses use the delay of block
+     * parameters.
+     */
+    [[nodiscard]] const std::vector<uint32_t> &get_block_delays() const { return block_delays_; }
+
+    /**
+     * @brief Get parameters shared by all synapses of a compact projection.
+     * @return synapse parameters, weight is not used.
+     */
+    [[nodiscard]] const BlockParameters &get_block_parameters() const { return block_parameters_; }
+
+    /**
+     * @brief Convert a compact projection to the explicit storage.
+     * @details Synapse indexes are kept. The method does nothing if the projection isn't compact. Call the method
+     * before changing synapses of a compact projection through iterators or the subscript operator.
+     */
+    void materialize();
 
     /**
      * @brief Get UID of the associated population from which this projection receives spikes.
@@ -284,12 +616,25 @@ public:
 
     /**
      * @brief Find synapses that originate from a neuron with the given index.
+     * @details Synapses of a compact projection are computed.
      * @param neuron_index index of a neuron.
      * @param search_method search by presynaptic or postsynaptic neuron.
      * @return indexes of all synapses associated with the specified presynaptic neuron.
      */
     [[nodiscard]] std::vector<size_t> find_synapses(size_t neuron_index, Search search_method) const;
 
+    /**
+     * @brief Get synapses associated with a neuron with the given index without copying them.
+     * @details The synapse index is updated when synapses are added or removed, so the method doesn't change the
+     * projection and can be called from several threads at once while the projection isn't modified.
+     * @param neuron_index index of a neuron.
+     * @param search_method search by presynaptic or postsynaptic neuron.
+     * @return ascending indexes of all synapses associated with the specified neuron.
+     * @throw std::logic_error if the projection is compact.
+     * @warning The returned reference becomes invalid after synapses are added or removed.
+     */
+    [[nodiscard]] const std::vector<size_t> &get_synapse_indexes(size_t neuron_index, Search search_method) const;
+
     /**
      * @brief Append connections to the existing projection.
      * @param generator synapse generation function.
@@ -298,6 +643,13 @@ public:
      */
     size_t add_synapses(SynapseGenerator generator, size_t num_iterations);
 
+    /**
+     * @brief Append prepared synapses to the existing projection.
+     * @param synapses synapses to append.
+     * @return number of synapses added to the projection.
+     */
+    size_t add_synapses(std::vector<Synapse> synapses);
+
     /**
      * @brief Remove all synapses from the projection.
      */
@@ -305,10 +657,22 @@ public:
 
     /**
      * @brief Remove a synapse with the given index from the projection.
+     * @details Indexes of the following synapses are decreased by one. The method takes time linear in the number of
+     * projection synapses, because the following synapses and their indexes in neuron lists are shifted. Use
+     * `remove_synapses()` to remove several synapses in one pass.
      * @param index index of the synapse to remove.
      */
     void remove_synapse(size_t index);
 
+    /**
+     * @brief Remove synapses with the given indexes from the projection.
+     * @details Synapses are removed in a single pass, order of the remaining synapses is kept.
+     * @param synapse_indexes indexes of synapses to remove in any order.
+     * @throw std::out_of_range if a synapse index is out of range.
+     * @return number of deleted synapses.
+     */
+    size_t remove_synapses(std::vector<size_t> synapse_indexes);
+
     /**
      * @brief Remove synapses according to a given criterion.
      * @param predicate functor that receives a synapse and returns `true` if the synapse must be deleted.
@@ -330,6 +694,42 @@ public:
      */
     size_t remove_presynaptic_neuron_synapses(size_t neuron_index);
 
+    /**
+     * @brief Update the projection after neurons were removed from the presynaptic population.
+     * @details The method removes all synapses that receive signals from removed neurons and decreases presynaptic
+     * neuron indexes of the remaining synapses accordingly.
+     * @param neuron_indexes indexes of removed presynaptic neurons in any order.
+     * @return number of deleted synapses.
+     */
+    size_t remove_presynaptic_neurons(std::vector<size_t> neuron_indexes);
+
+    /**
+     * @brief Update the projection after neurons were removed from the postsynaptic population.
+     * @details The method removes all synapses that lead to removed neurons and decreases postsynaptic neuron indexes
+     * of the remaining synapses accordingly.
+     * @param neuron_indexes indexes of removed postsynaptic neurons in any order.
+     * @return number of deleted synapses.
+     */
+    size_t remove_postsynaptic_neurons(std::vector<size_t> neuron_indexes);
+
+    /**
+     * @brief Sort synapses of the projection.
+     * @details The sort is stable. Indexes of synapses change, so synapse indexes obtained before sorting are invalid.
+     * @param compare functor that returns `true` if the first synapse must precede the second one.
+     */
+    void sort_synapses(const std::function<bool(const Synapse &, const Synapse &)> &compare);
+
+    /**
+     * @brief Change neuron indexes of all synapses after neurons of the associated populations were reordered.
+     * @param presynaptic_indexes new indexes of presynaptic neurons by their current indexes or an empty vector to
+     * keep presynaptic neuron indexes.
+     * @param postsynaptic_indexes new indexes of postsynaptic neurons by their current indexes or an empty vector to
+     * keep postsynaptic neuron indexes.
+     * @throw std::out_of_range if a neuron index of a synapse is out of range of the corresponding vector.
+     */
+    void renumber_neurons(
+        const std::vector<size_t> &presynaptic_indexes, const std::vector<size_t> &postsynaptic_indexes);
+
 public:
     /**
      * @brief Lock the possibility to change synapses weights.
@@ -361,7 +761,19 @@ public:
     const SharedSynapseParameters &get_shared_parameters() const { return shared_parameters_; }
 
 private:
-    void reindex() const;
+    static Projection make_compact(
+        UID presynaptic_uid, UID postsynaptic_uid, const SynapseBlock &block, std::vector<float> weights,
+        std::vector<uint32_t> delays, const SynapseParameters &parameters);
+
+    void check_explicit() const
+    {
+        if (block_) throw std::logic_error("Synapses of a compact projection are not stored explicitly.");
+    }
+
+    void index_synapse(size_t synapse_index);
+    void rebuild_index();
+    void remove_indexed_synapses(const std::vector<size_t> &synapse_indexes);
+    size_t remove_neurons(const std::vector<size_t> &neuron_indexes, Search search_method);
 
     BaseData base_;
 
@@ -384,34 +796,37 @@ private:
      * @brief Container of synapse parameters.
      */
     std::vector<Synapse> parameters_;
-    // So far the index is mutable so we can reindex a const object that has a non-updated index.
-    struct Connection
-    {
-        size_t from_;
-        size_t to_;
-        size_t index_;
-        bool operator==(const Connection &connection) const
-        {
-            return from_ == connection.from_ && to_ == connection.to_ && index_ == connection.index_;
-        }
-    };
 
-    typedef boost::multi_index::multi_index_container<
-        Connection,
-        boost::multi_index::indexed_by<
-            boost::multi_index::hashed_non_unique<
-                boost::multi_index::tag<struct mi_presynaptic>, BOOST_MULTI_INDEX_MEMBER(Connection, size_t, from_)>,
-            boost::multi_index::hashed_non_unique<
-                boost::multi_index::tag<struct mi_postsynaptic>, BOOST_MULTI_INDEX_MEMBER(Connection, size_t, to_)>,
-            boost::multi_index::hashed_unique<
-                boost::multi_index::tag<struct mi_synapse_index>,
-                BOOST_MULTI_INDEX_MEMBER(Connection, size_t, index_)>>>
-        Index;
-    using ByPresynaptic = mi_presynaptic;
-    using ByPostsynaptic = mi_postsynaptic;
-
-    mutable Index index_;
-    mutable bool is_index_updated_ = false;
+    /**
+     * @brief Indexes of synapses grouped by presynaptic neuron index.
+     * @details The index is updated together with the synapse container.
+     */
+    std::vector<std::vector<size_t>> presynaptic_index_;
+
+    /**
+     * @brief Indexes of synapses grouped by postsynaptic neuron index.
+     */
+    std::vector<std::vector<size_t>> postsynaptic_index_;
+
+    /**
+     * @brief Synapse block of a compact projection.
+     */
+    std::optional<SynapseBlock> block_;
+
+    /**
+     * @brief Weights of a compact projection.
+     */
+    std::vector<float> block_weights_;
+
+    /**
+     * @brief Delays of a compact projection.
+     */
+    std::vector<uint32_t> block_delays_;
+
+    /**
+     * @brief Parameters of all synapses of a compact projection.
+     */
+    BlockParameters block_parameters_;
 
     SharedSynapseParameters shared_parameters_;
 };
@@ -21,10 +21,13 @@
 
 #pragma once
 #include <knp/core/uid.h>
+#include <knp/core/uid_registry.h>
 
 #include <algorithm>
+#include <memory>
 #include <string>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include <boost/functional/hash.hpp>
@@ -59,10 +62,72 @@ public:
 public:
     /**
      * @brief Subscription constructor.
+     * @details Handles of the receiver and senders are assigned by the registry that is shared by all subscriptions
+     * created outside message endpoints.
      * @param receiver receiver UID.
      * @param senders list of sender UIDs.
      */
-    Subscription(const UID &receiver, const std::vector<UID> &senders) : receiver_(receiver) { add_senders(senders); }
+    Subscription(const UID &receiver, const std::vector<UID> &senders)
+        : Subscription(UIDRegistry::get_shared(), receiver, senders)
+    {
+    }
+
+    /**
+     * @brief Subscription constructor.
+     * @details Handles of the receiver and senders are assigned by the given registry. Message endpoints share their
+     * registry with their subscriptions, so a sender handle is found once per message. The subscription releases its
+     * handles when it is destroyed.
+     * @param registry UID registry.
+     * @param receiver receiver UID.
+     * @param senders list of sender UIDs.
+     */
+    Subscription(std::shared_ptr<UIDRegistry> registry, const UID &receiver, const std::vector<UID> &senders)
+        : registry_(std::move(registry)), receiver_(receiver), receiver_handle_(registry_->intern(receiver))
+    {
+        add_senders(senders);
+    }
+
+    /**
+     * @brief Copy constructor.
+     * @details The copy registers its receiver and senders in the same registry.
+     * @param subscription subscription to copy.
+     */
+    Subscription(const Subscription &subscription)
+        : registry_(subscription.registry_),
+          receiver_(subscription.receiver_),
+          receiver_handle_(registry_->intern(receiver_)),
+          senders_(subscription.senders_),
+          sender_handles_(subscription.sender_handles_),
+          messages_(subscription.messages_)
+    {
+        for (const auto &uid : senders_) registry_->intern(UID(uid));
+    }
+
+    /**
+     * @brief Move constructor.
+     * @param subscription subscription to move.
+     */
+    Subscription(Subscription &&subscription) noexcept
+        : registry_(std::move(subscription.registry_)),
+          receiver_(subscription.receiver_),
+          receiver_handle_(subscription.receiver_handle_),
+          senders_(std::move(subscription.senders_)),
+          sender_handles_(std::move(subscription.sender_handles_)),
+          messages_(std::move(subscription.messages_))
+    {
+    }
+
+    /**
+     * @brief Subscription destructor.
+     * @details The destructor releases the receiver and senders, so the registry doesn't keep UIDs of removed
+     * subscriptions.
+     */
+    ~Subscription()
+    {
+        if (!registry_) return;
+        for (const auto handle : sender_handles_) registry_->release(handle);
+        registry_->release(receiver_handle_);
+    }
 
     /**
      * @brief Get list of sender UIDs.
@@ -76,13 +141,28 @@ public:
      */
     [[nodiscard]] UID get_receiver_uid() const { return receiver_; }
 
+    /**
+     * @brief Get handle of the entity that receives messages via the subscription.
+     * @return receiver handle in the subscription UID registry.
+     */
+    [[nodiscard]] UIDHandle get_receiver_handle() const { return receiver_handle_; }
+
     /**
      * @brief Unsubscribe from a sender.
      * @details If a sender is not associated with the subscription, the method doesn't do anything.
      * @param uid sender UID.
      * @return number of senders deleted from subscription.
      */
-    size_t remove_sender(const UID &uid) { return senders_.erase(static_cast<boost::uuids::uuid>(uid)); }
+    size_t remove_sender(const UID &uid)
+    {
+        if (!senders_.erase(static_cast<boost::uuids::uuid>(uid))) return 0;
+
+        const auto handle = registry_->find(uid);
+        const auto iter = std::lower_bound(sender_handles_.begin(), sender_handles_.end(), handle);
+        if (iter != sender_handles_.end() && *iter == handle) sender_handles_.erase(iter);
+        registry_->release(handle);
+        return 1;
+    }
 
     /**
      * @brief Add a sender with the given UID to the subscription.
@@ -90,7 +170,15 @@ public:
      * @param uid UID of the new sender.
      * @return number of senders added.
      */
-    size_t add_sender(const UID &uid) { return senders_.insert(static_cast<boost::uuids::uuid>(uid)).second; }
+    size_t add_sender(const UID &uid)
+    {
+        if (!senders_.insert(static_cast<boost::uuids::uuid>(uid)).second) return 0;
+
+        // Handles are kept sorted, so the sender check is a binary search over integers.
+        const auto handle = registry_->intern(uid);
+        sender_handles_.insert(std::upper_bound(sender_handles_.begin(), sender_handles_.end(), handle), handle);
+        return 1;
+    }
 
     /**
      * @brief Add several senders to the subscription.
@@ -99,9 +187,9 @@ public:
      */
     size_t add_senders(const std::vector<UID> &senders)
     {
-        size_t size_before = senders_.size();
-        std::copy(senders.begin(), senders.end(), std::inserter(senders_, senders_.end()));
-        return senders_.size() - size_before;
+        size_t added = 0;
+        for (const auto &uid : senders) added += add_sender(uid);
+        return added;
     }
 
     /**
@@ -114,6 +202,16 @@ public:
         return senders_.find(static_cast<boost::uuids::uuid>(uid)) != senders_.end();
     }
 
+    /**
+     * @brief Check if a sender with the given handle exists.
+     * @param handle sender handle in the subscription UID registry.
+     * @return `true` if the sender with the given handle exists, `false` otherwise.
+     */
+    [[nodiscard]] bool has_sender(UIDHandle handle) const
+    {
+        return std::binary_search(sender_handles_.begin(), sender_handles_.end(), handle);
+    }
+
 public:
     /**
      * @brief Add a message to the subscription.
@@ -143,15 +241,29 @@ public:
     void clear_messages() { messages_.clear(); }
 
 private:
+    /**
+     * @brief Registry that assigns handles of the receiver and senders.
+     */
+    std::shared_ptr<UIDRegistry> registry_;
+
     /**
      * @brief Receiver UID.
      */
     const UID receiver_;
 
+    /**
+     * @brief Receiver handle.
+     */
+    UIDHandle receiver_handle_;
+
     /**
      * @brief Set of sender UIDs.
      */
     std::unordered_set<::boost::uuids::uuid, boost::hash<boost::uuids::uuid>> senders_;
+    /**
+     * @brief Sorted handles of senders.
+     */
+    std::vector<UIDHandle> sender_handles_;
     /**
      * @brief Message storage.
      */
@@ -0,0 +1,320 @@
+/**
+ * @file synapse_block.h
+ * @brief Implicit connectivity of compact projections.
+ * @kaspersky_support Artiom N.
+ * @date 18.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <variant>
+
+
+/**
+ * @brief Core library namespace.
+ */
+namespace knp::core
+{
+
+/**
+ * @brief The BlockSynapse structure describes a synapse of a synapse block.
+ */
+struct BlockSynapse
+{
+    /**
+     * @brief Index of the synapse weight in the weight array of the block.
+     */
+    size_t weight_index_;
+
+    /**
+     * @brief Presynaptic neuron index.
+     */
+    size_t source_;
+
+    /**
+     * @brief Postsynaptic neuron index.
+     */
+    size_t target_;
+};
+
+
+/**
+ * @brief The DenseBlock structure describes connections from every presynaptic neuron to every postsynaptic neuron.
+ * @details Weights are stored as a row-major matrix with a row per presynaptic neuron. Synapse index equals
+ * the weight index: `source * postsynaptic_size_ + target`.
+ */
+struct DenseBlock
+{
+    /**
+     * @brief Number of presynaptic neurons.
+     */
+    size_t presynaptic_size_ = 0;
+
+    /**
+     * @brief Number of postsynaptic neurons.
+     */
+    size_t postsynaptic_size_ = 0;
+
+    /**
+     * @brief Get number of synapses in the block.
+     * @return number of synapses.
+     */
+    [[nodiscard]] size_t get_synapse_count() const { return presynaptic_size_ * postsynaptic_size_; }
+
+    /**
+     * @brief Get number of weights the block requires.
+     * @return number of weights.
+     */
+    [[nodiscard]] size_t get_weight_count() const { return get_synapse_count(); }
+
+    /**
+     * @brief Get a synapse by its index.
+     * @param synapse_index synapse index less than the number of synapses.
+     * @return synapse description.
+     */
+    [[nodiscard]] BlockSynapse get_synapse(size_t synapse_index) const
+    {
+        return {synapse_index, synapse_index / postsynaptic_size_, synapse_index % postsynaptic_size_};
+    }
+
+    /**
+     * @brief Call a function for every synapse that receives spikes from a presynaptic neuron.
+     * @details Synapses are passed in ascending order of indexes.
+     * @tparam Function type of function that receives synapse index, weight index and postsynaptic neuron index.
+     * @param source presynaptic neuron index.
+     * @param function function to call.
+     */
+    template <typename Function>
+    void for_each_postsynaptic(size_t source, Function function) const
+    {
+        for_each_postsynaptic(source, 0, get_synapse_count(), function);
+    }
+
+    /**
+     * @brief Call a function for every synapse in the index range that receives spikes from a presynaptic neuron.
+     * @details Synapses are passed in ascending order of indexes. Only synapses of the range are visited.
+     * @tparam Function type of function that receives synapse index, weight index and postsynaptic neuron index.
+     * @param source presynaptic neuron index.
+     * @param first_synapse index of the first synapse of the range.
+     * @param last_synapse index of the synapse after the range.
+     * @param function function to call.
+     */
+    template <typename Function>
+    void for_each_postsynaptic(size_t source, size_t first_synapse, size_t last_synapse, Function function) const
+    {
+        if (source >= presynaptic_size_) return;
+        const size_t row_start = source * postsynaptic_size_;
+        const size_t first = std::max(row_start, first_synapse);
+        const size_t last = std::min(row_start + postsynaptic_size_, last_synapse);
+        for (size_t synapse_index = first; synapse_index < last; ++synapse_index)
+        {
+            function(synapse_index, synapse_index, synapse_index - row_start);
+        }
+    }
+
+    /**
+     * @brief Call a function for every synapse that sends impacts to a postsynaptic neuron.
+     * @details Synapses are passed in ascending order of indexes.
+     * @tparam Function type of function that receives synapse index, weight index and presynaptic neuron index.
+     * @param target postsynaptic neuron index.
+     * @param function function to call.
+     */
+    template <typename Function>
+    void for_each_presynaptic(size_t target, Function function) const
+    {
+        if (target >= postsynaptic_size_) return;
+        for (size_t source = 0; source < presynaptic_size_; ++source)
+        {
+            function(source * postsynaptic_size_ + target, source * postsynaptic_size_ + target, source);
+        }
+    }
+};
+
+
+/**
+ * @brief The KernelBlock structure describes convolution-like connections with weights shared by all
+ * postsynaptic neurons.
+ * @details Presynaptic neurons form a row-major 2D grid. Every postsynaptic neuron is connected to a window of
+ * the grid with the size of the kernel, windows are shifted by the stride and don't exceed the grid. Postsynaptic
+ * neurons form a row-major grid of windows. A synapse uses the kernel weight at its position in the window,
+ * synapse index is `target * kernel_height_ * kernel_width_ + weight_index`.
+ */
+struct KernelBlock
+{
+    /**
+     * @brief Height of the presynaptic neuron grid.
+     */
+    size_t input_height_ = 0;
+
+    /**
+     * @brief Width of the presynaptic neuron grid.
+     */
+    size_t input_width_ = 0;
+
+    /**
+     * @brief Kernel height.
+     */
+    size_t kernel_height_ = 1;
+
+    /**
+     * @brief Kernel width.
+     */
+    size_t kernel_width_ = 1;
+
+    /**
+     * @brief Distance between neighbor windows in both directions.
+     */
+    size_t stride_ = 1;
+
+    /**
+     * @brief Get height of the postsynaptic neuron grid.
+     * @return number of window rows.
+     */
+    [[nodiscard]] size_t get_output_height() const
+    {
+        return input_height_ < kernel_height_ ? 0 : (input_height_ - kernel_height_) / stride_ + 1;
+    }
+
+    /**
+     * @brief Get width of the postsynaptic neuron grid.
+     * @return number of window columns.
+     */
+    [[nodiscard]] size_t get_output_width() const
+    {
+        return input_width_ < kernel_width_ ? 0 : (input_width_ - kernel_width_) / stride_ + 1;
+    }
+
+    /**
+     * @brief Get number of presynaptic neurons.
+     * @return number of neurons in the input grid.
+     */
+    [[nodiscard]] size_t get_presynaptic_size() const { return input_height_ * input_width_; }
+
+    /**
+     * @brief Get number of postsynaptic neurons.
+     * @return number of neurons in the output grid.
+     */
+    [[nodiscard]] size_t get_postsynaptic_size() const { return get_output_height() * get_output_width(); }
+
+    /**
+     * @brief Get number of synapses in the block.
+     * @return number of synapses.
+     */
+    [[nodiscard]] size_t get_synapse_count() const { return get_postsynaptic_size() * get_weight_count(); }
+
+    /**
+     * @brief Get number of weights the block requires.
+     * @return kernel size.
+     */
+    [[nodiscard]] size_t get_weight_count() const { return kernel_height_ * kernel_width_; }
+
+    /**
+     * @brief Get a synapse by its index.
+     * @param synapse_index synapse index less than the number of synapses.
+     * @return synapse description.
+     */
+    [[nodiscard]] BlockSynapse get_synapse(size_t synapse_index) const
+    {
+        const size_t target = synapse_index / get_weight_count();
+        const size_t weight_index = synapse_index % get_weight_count();
+        const size_t row = target / get_output_width() * stride_ + weight_index / kernel_width_;
+        const size_t column = target % get_output_width() * stride_ + weight_index % kernel_width_;
+        return {weight_index, row * input_width_ + column, target};
+    }
+
+    /**
+     * @brief Call a function for every synapse that receives spikes from a presynaptic neuron.
+     * @details Synapses are passed in ascending order of indexes.
+     * @tparam Function type of function that receives synapse index, weight index and postsynaptic neuron index.
+     * @param source presynaptic neuron index.
+     * @param function function to call.
+     */
+    template <typename Function>
+    void for_each_postsynaptic(size_t source, Function function) const
+    {
+        for_each_postsynaptic(source, 0, get_synapse_count(), function);
+    }
+
+    /**
+     * @brief Call a function for every synapse in the index range that receives spikes from a presynaptic neuron.
+     * @details Synapses are passed in ascending order of indexes. Window rows outside the range are skipped.
+     * @tparam Function type of function that receives synapse index, weight index and postsynaptic neuron index.
+     * @param source presynaptic neuron index.
+     * @param first_synapse index of the first synapse of the range.
+     * @param last_synapse index of the synapse after the range.
+     * @param function function to call.
+     */
+    template <typename Function>
+    void for_each_postsynaptic(size_t source, size_t first_synapse, size_t last_synapse, Function function) const
+    {
+        last_synapse = std::min(last_synapse, get_synapse_count());
+        if (source >= get_presynaptic_size() || first_synapse >= last_synapse) return;
+        const size_t row = source / input_width_;
+        const size_t column = source % input_width_;
+        const size_t output_width = get_output_width();
+        // Window rows that contain synapses of the range.
+        const size_t first_output_row = first_synapse / get_weight_count() / output_width;
+        const size_t last_output_row = (last_synapse - 1) / get_weight_count() / output_width;
+
+        // Windows with larger kernel offsets have smaller indexes.
+        for (size_t kernel_row = std::min(row + 1, kernel_height_); kernel_row-- > 0;)
+        {
+            if ((row - kernel_row) % stride_) continue;
+            const size_t output_row = (row - kernel_row) / stride_;
+            if (output_row < first_output_row || output_row > last_output_row) continue;
+            for (size_t kernel_column = std::min(column + 1, kernel_width_); kernel_column-- > 0;)
+            {
+                if ((column - kernel_column) % stride_) continue;
+                const size_t output_column = (column - kernel_column) / stride_;
+                if (output_column >= output_width) continue;
+                const size_t target = output_row * output_width + output_column;
+                const size_t weight_index = kernel_row * kernel_width_ + kernel_column;
+                const size_t synapse_index = target * get_weight_count() + weight_index;
+                if (synapse_index < first_synapse || synapse_index >= last_synapse) continue;
+                function(synapse_index, weight_index, target);
+            }
+        }
+    }
+
+    /**
+     * @brief Call a function for every synapse that sends impacts to a postsynaptic neuron.
+     * @details Synapses are passed in ascending order of indexes.
+     * @tparam Function type of function that receives synapse index, weight index and presynaptic neuron index.
+     * @param target postsynaptic neuron index.
+     * @param function function to call.
+     */
+    template <typename Function>
+    void for_each_presynaptic(size_t target, Function function) const
+    {
+        if (target >= get_postsynaptic_size()) return;
+        for (size_t weight_index = 0; weight_index < get_weight_count(); ++weight_index)
+        {
+            const size_t synapse_index = target * get_weight_count() + weight_index;
+            function(synapse_index, weight_index, get_synapse(synapse_index).source_);
+        }
+    }
+};
+
+
+/**
+ * @brief Synapse block variant that contains any supported block type.
+ */
+using SynapseBlock = std::variant<DenseBlock, KernelBlock>;
+
+}  // namespace knp::core
@@ -0,0 +1,125 @@
+/**
+ * @file uid_registry.h
+ * @brief Registry of dense integer handles of UIDs.
+ * @kaspersky_support Artiom N.
+ * @date 18.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <knp/core/uid.h>
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+
+namespace knp::core
+{
+
+/**
+ * @brief Dense integer handle of a UID.
+ * @details Handles are assigned by a `UIDRegistry` starting from zero. Handles of released UIDs are reused, so handles
+ * stay dense. Handles are meaningful only for the registry that assigned them and must not be stored or serialized.
+ */
+using UIDHandle = uint32_t;
+
+
+/**
+ * @brief The UIDRegistry class is a definition of a registry that assigns dense integer handles to UIDs.
+ * @details Handles can be compared and stored in flat arrays, which is much cheaper than hashing and comparing UIDs.
+ * Every registration of a UID must be paired with its release. A handle remains valid until the UID is released as
+ * many times as it was registered. The class is thread-safe.
+ */
+class UIDRegistry
+{
+public:
+    /**
+     * @brief Value returned for UIDs that are not registered.
+     */
+    static constexpr UIDHandle invalid_handle = std::numeric_limits<UIDHandle>::max();
+
+public:
+    /**
+     * @brief Get handle of a UID. Register the UID if it is not registered.
+     * @param uid UID.
+     * @throw std::length_error if there are no free handles.
+     * @return UID handle.
+     */
+    UIDHandle intern(const UID &uid);
+
+    /**
+     * @brief Release a UID registered by `intern()`.
+     * @details The UID is removed from the registry when it is released as many times as it was registered. Its
+     * handle can then be assigned to another UID.
+     * @param handle UID handle.
+     * @throw std::out_of_range if the handle is not assigned.
+     */
+    void release(UIDHandle handle);
+
+    /**
+     * @brief Get handle of a registered UID.
+     * @param uid UID.
+     * @return UID handle or `invalid_handle` if the UID is not registered.
+     */
+    [[nodiscard]] UIDHandle find(const UID &uid) const;
+
+    /**
+     * @brief Get UID by its handle.
+     * @param handle UID handle.
+     * @throw std::out_of_range if the handle was not assigned by the registry.
+     * @return UID.
+     */
+    [[nodiscard]] UID get_uid(UIDHandle handle) const;
+
+    /**
+     * @brief Get number of registered UIDs.
+     * @return number of UIDs.
+     */
+    [[nodiscard]] size_t size() const;
+
+    /**
+     * @brief Get registry version.
+     * @details The version changes every time a UID is added to or removed from the registry. Use it to invalidate
+     * handles cached outside the registry. The method doesn't lock the registry.
+     * @return registry version.
+     */
+    [[nodiscard]] uint64_t get_version() const { return version_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Get registry shared by subscriptions that are created outside message endpoints.
+     * @details The registry is created once per module that links the core library.
+     * @return shared registry.
+     */
+    static std::shared_ptr<UIDRegistry> get_shared();
+
+private:
+    mutable std::shared_mutex mutex_;
+    // cppcheck-suppress unusedStructMember
+    std::unordered_map<UID, UIDHandle, uid_hash> handles_;
+    std::vector<UID> uids_;
+    // Number of registrations of every handle, zero for free handles.
+    std::vector<size_t> ref_counts_;
+    std::vector<UIDHandle> free_handles_;
+    std::atomic<uint64_t> version_ = 0;
+};
+
+}  // namespace knp::core
@@ -22,6 +22,7 @@
 #pragma once
 
 #include <string>
+#include <utility>
 #include <variant>
 #include <vector>
 
@@ -65,6 +66,42 @@ void load_from_container(const std::vector<AllVariants> &from_container, ToConta
 }
 
 
+/**
+ * @brief Move elements from one container of all variants to another container that contains a subset of all
+ * variants.
+ * @details Elements are moved one by one, so memory used by an element is released as soon as the element is loaded.
+ * Unsupported elements are dropped. The source container is empty after the call.
+ * @tparam SupportedTypes subset of variants.
+ * @tparam AllVariants all supported variants.
+ * @tparam ToContainer target container.
+ * @param from_container source container.
+ * @param to_container target container.
+ */
+template <typename SupportedTypes, typename AllVariants, typename ToContainer>
+void load_from_container(std::vector<AllVariants> &&from_container, ToContainer &to_container)
+{
+    to_container.clear();
+    to_container.reserve(from_container.size());
+
+    for (auto &p : from_container)
+    {
+        std::visit(
+            [&to_container](auto &arg)
+            {
+                using T = std::decay_t<decltype(arg)>;
+                if constexpr (boost::mp11::mp_find<SupportedTypes, T>{} != boost::mp11::mp_size<SupportedTypes>{})
+                {
+                    to_container.push_back(typename ToContainer::value_type{std::move(arg)});
+                }
+            },
+            p);
+    }
+
+    from_container.clear();
+    from_container.shrink_to_fit();
+}
+
+
 /**
  * @brief Convert from one set of arguments to another.
  * @note This is is a helper structure. Use `variant_cast` instead.
@@ -30,10 +30,22 @@ py::class_<knp::framework::ModelExecutor, boost::noncopyable>(
     py::no_init)
     .def("__init__", &create_model_executor, "Construct model executor.")
     .def("start", &start_model_executor, "Start model execution.")
-    .def("start", &start_model_executor_predicate, "Start model execution with a predicate.")
+    .def(
+        "start", &start_model_executor_predicate,
+        (py::arg("self"), py::arg("run_predicate"), py::arg("call_period") = 1),
+        "Start model execution with a predicate called once per `call_period` steps. The GIL is released between "
+        "predicate calls.")
     .def("stop", &knp::framework::ModelExecutor::stop, "Stop model execution.")
-    .def("add_spike_observer", &add_executor_spike_observer, "Add spike observer to model executor.")
-    .def("add_impact_observer", &add_executor_impact_observer, "Add impact message observer to model executor.")
+    .def(
+        "add_spike_observer", &add_executor_observer<knp::core::messaging::SpikeMessage>,
+        (py::arg("self"), py::arg("message_processor"), py::arg("senders"), py::arg("update_period") = 1),
+        "Add spike observer to model executor. The observer receives a list of messages once per `update_period` "
+        "steps.")
+    .def(
+        "add_impact_observer", &add_executor_observer<knp::core::messaging::SynapticImpactMessage>,
+        (py::arg("self"), py::arg("message_processor"), py::arg("senders"), py::arg("update_period") = 1),
+        "Add impact message observer to model executor. The observer receives a list of messages once per "
+        "`update_period` steps.")
     .def("start_learning", &knp::framework::ModelExecutor::start_learning, "Unlock synapse weights.")
     .def("stop_learning", &knp::framework::ModelExecutor::stop_learning, "Lock synapse weights.")
     .def("get_backend", &knp::framework::ModelExecutor::get_backend, "Get reference of backend object.");
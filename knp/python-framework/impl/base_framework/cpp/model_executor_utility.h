@@ -27,6 +27,9 @@
 #include <utility>
 #include <vector>
 
+#include "../../core/cpp/gil.h"
+#include "common.h"
+
 
 auto create_model_executor(
     knp::framework::Model &model, std::shared_ptr<knp::core::Backend> &backend,
@@ -37,30 +40,35 @@ auto create_model_executor(
 
 void start_model_executor(knp::framework::ModelExecutor &self)
 {
+    GILRelease no_gil;
     self.start();
 }
 
 
+// The GIL is released while the model runs and acquired only to call Python functions.
 void start_model_executor_predicate(
-    knp::framework::ModelExecutor &self, const knp::core::Backend::RunPredicate &predicate)
+    knp::framework::ModelExecutor &self, const py::object &predicate, size_t call_period)
 {
-    self.start(predicate);
+    auto run_predicate = make_python_predicate(predicate, call_period);
+    GILRelease no_gil;
+    self.start(std::move(run_predicate));
 }
 
 
-void add_executor_spike_observer(
-    knp::framework::ModelExecutor &self,
-    knp::framework::monitoring::MessageProcessor<knp::core::messaging::SpikeMessage> &message_processor,
-    const std::vector<knp::core::UID> &senders)
+template <class Message>
+void add_executor_observer(
+    knp::framework::ModelExecutor &self, const py::object &message_processor, const py::object &senders,
+    size_t update_period)
 {
-    self.add_observer(std::move(message_processor), senders);
-}
+    using UIDIterator = py::stl_input_iterator<knp::core::UID>;
 
-
-void add_executor_impact_observer(
-    knp::framework::ModelExecutor &self,
-    knp::framework::monitoring::MessageProcessor<knp::core::messaging::SynapticImpactMessage> &message_processor,
-    const std::vector<knp::core::UID> &senders)
-{
-    self.add_observer(std::move(message_processor), senders);
+    self.add_observer<Message>(
+        [processor = share_python_object(message_processor)](const std::vector<Message> &messages)
+        {
+            GILAcquire gil;
+            py::list py_messages;
+            for (const auto &message : messages) py_messages.append(message);
+            py::call<void>(processor->ptr(), py_messages);
+        },
+        std::vector<knp::core::UID>(UIDIterator(senders), UIDIterator()), update_period);
 }
@@ -29,7 +29,10 @@ py::def("make_model_loader", &make_model_loader, "Create model loader.");
 py::class_<knp::framework::ModelLoader, boost::noncopyable>(
     "ModelLoader", "The ModelLoader class is a definition of a loader that uploads the model to the specified backend.",
     py::no_init)
-    .def("load", &knp::framework::ModelLoader::load, "Write model to backend.")
+    .def(
+        "load",
+        static_cast<void (knp::framework::ModelLoader::*)(knp::framework::Model &)>(&knp::framework::ModelLoader::load),
+        "Write model to backend.")
     .def(
         "get_inputs", &knp::framework::ModelLoader::get_inputs, py::return_internal_reference<>(),
         "Get input channels.")
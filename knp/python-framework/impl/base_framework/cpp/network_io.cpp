@@ -22,7 +22,11 @@
 
 #ifdef KNP_IN_BASE_FW
 
-py::def("save_network", &knp::framework::sonata::save_network, "Save network to disk.");
+py::def(
+    "save_network",
+    static_cast<void (*)(const knp::framework::Network &, const std::filesystem::path &)>(
+        &knp::framework::sonata::save_network),
+    "Save network to disk.");
 
 py::def("load_network", &knp::framework::sonata::load_network, "Load network from disk.");
 
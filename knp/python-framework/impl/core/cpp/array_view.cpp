@@ -0,0 +1,42 @@
+/**
+ * @file array_view.cpp
+ * @brief Python bindings for zero-copy array views.
+ * @kaspersky_support Artiom N.
+ * @date 18.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "array_view.h"
+
+#include "common.h"
+
+
+#if defined(KNP_IN_CORE)
+
+py::class_<ArrayView>(
+    "ArrayView",
+    "The ArrayView class is a definition of a one-dimensional view of values stored in a C++ container. Use "
+    "`numpy.asarray()` to get an array that shares memory with the container. The view becomes invalid if neurons or "
+    "synapses are added or removed.",
+    py::no_init)
+    .add_property("__array_interface__", &ArrayView::get_array_interface, "NumPy array interface.")
+    .add_property("readonly", &ArrayView::is_readonly, "`True` if values can't be modified.")
+    .def("__len__", &ArrayView::size, "Get number of values.")
+    .def("__getitem__", &ArrayView::get_item, "Get value with the given index.")
+    .def("__setitem__", &ArrayView::set_item, "Set value with the given index.")
+    .def("assign", &ArrayView::assign, "Copy values from a one-dimensional array of the same size.");
+
+#endif
@@ -0,0 +1,332 @@
+/**
+ * @file array_view.h
+ * @brief Python bindings header for zero-copy array views.
+ * @kaspersky_support Artiom N.
+ * @date 18.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include <boost/endian/conversion.hpp>
+
+#include "common.h"
+
+
+/**
+ * @brief Get NumPy type string of a value type.
+ * @tparam ValueType arithmetic value type.
+ * @return type string in the format of the NumPy array interface.
+ */
+template <typename ValueType>
+std::string get_array_typestr()
+{
+    static_assert(std::is_arithmetic_v<ValueType>, "Only arithmetic values can be viewed as arrays.");
+
+    std::string result;
+    if constexpr (sizeof(ValueType) == 1)
+    {
+        result += '|';
+    }
+    else
+    {
+        result += boost::endian::order::native == boost::endian::order::little ? '<' : '>';
+    }
+
+    if constexpr (std::is_same_v<ValueType, bool>)
+    {
+        result += 'b';
+    }
+    else if constexpr (std::is_floating_point_v<ValueType>)
+    {
+        result += 'f';
+    }
+    else if constexpr (std::is_signed_v<ValueType>)
+    {
+        result += 'i';
+    }
+    else
+    {
+        result += 'u';
+    }
+
+    return result + std::to_string(sizeof(ValueType));
+}
+
+
+/**
+ * @brief The ArrayView class is a definition of a one-dimensional strided view of values stored in a C++ container.
+ * @details The view implements the NumPy array interface, so `numpy.asarray(view)` creates an array that uses
+ * container memory without copying. The view holds a reference to the Python object that owns the container.
+ * @warning The view and arrays created from it become invalid if the container is reallocated, for example after
+ * neurons or synapses are added or removed.
+ */
+class ArrayView
+{
+public:
+    /**
+     * @brief Create a view.
+     * @tparam ValueType type of viewed values.
+     * @param owner Python object that owns viewed values.
+     * @param first pointer to the first value. May be `nullptr` if `size` is zero.
+     * @param size number of values.
+     * @param stride distance between values in bytes.
+     * @param readonly `true` if values can't be modified.
+     */
+    template <typename ValueType>
+    ArrayView(py::object owner, ValueType *first, size_t size, size_t stride, bool readonly)
+        : owner_(std::move(owner)),
+          data_(reinterpret_cast<char *>(first)),
+          size_(size),
+          stride_(stride),
+          typestr_(get_array_typestr<ValueType>()),
+          readonly_(readonly),
+          getter_(&get_value<ValueType>),
+          setter_(&set_value<ValueType>),
+          assigner_(&assign_buffer<ValueType>)
+    {
+    }
+
+    /**
+     * @brief Get number of values.
+     * @return number of values.
+     */
+    [[nodiscard]] size_t size() const { return size_; }
+
+    /**
+     * @brief Check if values can't be modified.
+     * @return `true` if the view is read-only.
+     */
+    [[nodiscard]] bool is_readonly() const { return readonly_; }
+
+    /**
+     * @brief Get description of the view in the NumPy array interface format.
+     * @return array interface dictionary.
+     */
+    [[nodiscard]] py::dict get_array_interface() const
+    {
+        py::dict result;
+        result["version"] = 3;
+        result["shape"] = py::make_tuple(size_);
+        result["strides"] = py::make_tuple(stride_);
+        result["typestr"] = typestr_;
+        result["data"] = py::make_tuple(reinterpret_cast<uintptr_t>(data_), readonly_);
+        return result;
+    }
+
+    /**
+     * @brief Get value with the given index.
+     * @param index value index. Negative indexes are counted from the end.
+     * @return value.
+     */
+    [[nodiscard]] py::object get_item(int64_t index) const { return getter_(data_ + get_offset(index)); }
+
+    /**
+     * @brief Copy values from a one-dimensional array.
+     * @details Objects that support the buffer protocol, such as NumPy arrays, are copied without calling Python
+     * for every value. Values are converted to the view value type. Other iterables are copied value by value.
+     * @param values array of values. Its size must be equal to the view size.
+     */
+    void assign(const py::object &values)
+    {
+        if (readonly_)
+        {
+            PyErr_SetString(PyExc_ValueError, "Array view is read-only.");
+            py::throw_error_already_set();
+        }
+
+        if (!PyObject_CheckBuffer(values.ptr()))
+        {
+            if (py::len(values) != static_cast<Py_ssize_t>(size_))
+            {
+                PyErr_SetString(PyExc_ValueError, "Array size doesn't match the view size.");
+                py::throw_error_already_set();
+            }
+            int64_t index = 0;
+            for (py::stl_input_iterator<py::object> value(values), end; value != end; ++value)
+            {
+                set_item(index++, *value);
+            }
+            return;
+        }
+
+        BufferGuard buffer(values);
+        if (buffer.view_.ndim != 1 || static_cast<size_t>(buffer.view_.shape[0]) != size_)
+        {
+            PyErr_SetString(PyExc_ValueError, "Array must be one-dimensional and its size must match the view size.");
+            py::throw_error_already_set();
+        }
+        assigner_(data_, stride_, size_, buffer.view_);
+    }
+
+    /**
+     * @brief Set value with the given index.
+     * @param index value index. Negative indexes are counted from the end.
+     * @param value new value.
+     */
+    void set_item(int64_t index, const py::object &value)
+    {
+        if (readonly_)
+        {
+            PyErr_SetString(PyExc_ValueError, "Array view is read-only.");
+            py::throw_error_already_set();
+        }
+        setter_(data_ + get_offset(index), value);
+    }
+
+private:
+    struct BufferGuard
+    {
+        explicit BufferGuard(const py::object &values)
+        {
+            if (PyObject_GetBuffer(values.ptr(), &view_, PyBUF_RECORDS_RO) != 0) py::throw_error_already_set();
+        }
+        ~BufferGuard() { PyBuffer_Release(&view_); }
+        BufferGuard(const BufferGuard &) = delete;
+        BufferGuard &operator=(const BufferGuard &) = delete;
+
+        Py_buffer view_{};
+    };
+
+    template <typename ValueType, typename SourceType>
+    static void assign_values(char *data, size_t stride, size_t size, const Py_buffer &buffer)
+    {
+        const auto *source = static_cast<const char *>(buffer.buf);
+        for (size_t index = 0; index < size; ++index, data += stride, source += buffer.strides[0])
+        {
+            SourceType source_value;
+            std::memcpy(&source_value, source, sizeof(SourceType));
+            const auto value = static_cast<ValueType>(source_value);
+            std::memcpy(data, &value, sizeof(ValueType));
+        }
+    }
+
+    template <typename ValueType>
+    static void assign_buffer(char *data, size_t stride, size_t size, const Py_buffer &buffer)
+    {
+        std::string format = buffer.format ? buffer.format : "B";
+        const char native_order = boost::endian::order::native == boost::endian::order::little ? '<' : '>';
+        if (!format.empty() && (format[0] == '@' || format[0] == '=' || format[0] == native_order)) format.erase(0, 1);
+
+        if (format.size() == 1)
+        {
+            switch (format[0])
+            {
+                case '?':
+                    return assign_values<ValueType, bool>(data, stride, size, buffer);
+                case 'b':
+                    return assign_values<ValueType, signed char>(data, stride, size, buffer);
+                case 'B':
+                    return assign_values<ValueType, unsigned char>(data, stride, size, buffer);
+                case 'h':
+                    return assign_values<ValueType, int16_t>(data, stride, size, buffer);
+                case 'H':
+                    return assign_values<ValueType, uint16_t>(data, stride, size, buffer);
+                case 'i':
+                    return assign_values<ValueType, int32_t>(data, stride, size, buffer);
+                case 'I':
+                    return assign_values<ValueType, uint32_t>(data, stride, size, buffer);
+                case 'l':
+                    return assign_values<ValueType, long>(data, stride, size, buffer);  // NOLINT
+                case 'L':
+                    return assign_values<ValueType, unsigned long>(data, stride, size, buffer);  // NOLINT
+                case 'q':
+                    return assign_values<ValueType, int64_t>(data, stride, size, buffer);
+                case 'Q':
+                    return assign_values<ValueType, uint64_t>(data, stride, size, buffer);
+                case 'n':
+                    return assign_values<ValueType, Py_ssize_t>(data, stride, size, buffer);
+                case 'N':
+                    return assign_values<ValueType, size_t>(data, stride, size, buffer);
+                case 'f':
+                    return assign_values<ValueType, float>(data, stride, size, buffer);
+                case 'd':
+                    return assign_values<ValueType, double>(data, stride, size, buffer);
+                default:
+                    break;
+            }
+        }
+
+        PyErr_SetString(PyExc_TypeError, ("Unsupported array value format \"" + format + "\".").c_str());
+        py::throw_error_already_set();
+    }
+
+    template <typename ValueType>
+    static py::object get_value(const char *data)
+    {
+        // Values of neuron and synapse structures are not always aligned.
+        ValueType value;
+        std::memcpy(&value, data, sizeof(ValueType));
+        return py::object(value);
+    }
+
+    template <typename ValueType>
+    static void set_value(char *data, const py::object &value)
+    {
+        const ValueType new_value = py::extract<ValueType>(value);
+        std::memcpy(data, &new_value, sizeof(ValueType));
+    }
+
+    [[nodiscard]] size_t get_offset(int64_t index) const
+    {
+        if (index < 0) index += static_cast<int64_t>(size_);
+        if (index < 0 || static_cast<size_t>(index) >= size_)
+        {
+            PyErr_SetString(PyExc_IndexError, "Array view index out of range.");
+            py::throw_error_already_set();
+        }
+        return static_cast<size_t>(index) * stride_;
+    }
+
+private:
+    // cppcheck-suppress unusedStructMember
+    py::object owner_;
+    char *data_;
+    size_t size_;
+    size_t stride_;
+    std::string typestr_;
+    bool readonly_;
+    py::object (*getter_)(const char *);
+    void (*setter_)(char *, const py::object &);
+    void (*assigner_)(char *, size_t, size_t, const Py_buffer &);
+};
+
+
+/**
+ * @brief Create a view of a member of every structure stored in a contiguous container.
+ * @tparam StructType type of stored structures.
+ * @tparam ValueType type of the viewed member.
+ * @tparam MemberOwnerType structure that declares the member. It may be a base of `StructType`.
+ * @param owner Python object that owns the container.
+ * @param first pointer to the first structure. May be `nullptr` if `size` is zero.
+ * @param size number of structures.
+ * @param member pointer to the viewed member.
+ * @param readonly `true` if values can't be modified.
+ * @return array view.
+ */
+template <typename StructType, typename ValueType, typename MemberOwnerType>
+ArrayView make_member_view(
+    const py::object &owner, StructType *first, size_t size, ValueType MemberOwnerType::*member, bool readonly)
+{
+    static_assert(std::is_base_of_v<MemberOwnerType, StructType>, "Member doesn't belong to the structure.");
+    ValueType *first_value = size ? &(first->*member) : nullptr;
+    return ArrayView(owner, first_value, size, sizeof(StructType), readonly);
+}
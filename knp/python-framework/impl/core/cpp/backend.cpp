@@ -20,6 +20,7 @@
  */
 
 #include "common.h"
+#include "gil.h"
 
 
 #if defined(KNP_IN_CORE)
@@ -133,7 +134,11 @@ py::class_<BackendWrapper, boost::noncopyable>(
                     std::vector<PT>(py::stl_input_iterator<PT>(projections), py::stl_input_iterator<PT>()));
             }),
         "Add projections to backend.")
-    .def("load_all_projections", py::pure_virtual(&core::Backend::load_all_projections), "Add projections to backend.")
+    .def(
+        "load_all_projections",
+        py::pure_virtual(static_cast<void (core::Backend::*)(const std::vector<core::AllProjectionsVariant> &)>(
+            &core::Backend::load_all_projections)),
+        "Add projections to backend.")
     .def(
         "remove_projections", py::pure_virtual(&core::Backend::remove_projections),
         "Remove projections with given UIDs from the backend.")
@@ -155,19 +160,22 @@ py::class_<BackendWrapper, boost::noncopyable>(
     // core::MessageEndpoint&(core::Backend::*)() const>(& core::Backend::get_message_endpoint), "Get message
     // endpoint.")
     .def(
-        "start", static_cast<void (core::Backend::*)()>(&core::Backend::start),
+        "start",
+        make_handler(
+            [](core::Backend &self)
+            {
+                GILRelease no_gil;
+                self.start();
+            }),
         "Start network execution on the backend.")
     .def(
         "start",
         make_handler(
             [](core::Backend &self, py::object &run_predicate)
             {
-                self.start(
-                    [&run_predicate](core::Step step)
-                    {
-                        auto res = py::call<py::object>(run_predicate.ptr(), step);
-                        return py::extract<bool>(res);
-                    });
+                const auto predicate = make_python_predicate(run_predicate);
+                GILRelease no_gil;
+                self.start(predicate);
             }),
         "Start network execution on the backend.")
     .def(
@@ -175,19 +183,24 @@ py::class_<BackendWrapper, boost::noncopyable>(
         make_handler(
             [](core::Backend &self, py::object &pre_step, py::object &post_step)
             {
-                self.start(
-                    [&pre_step](core::Step step)
-                    {
-                        auto res = py::call<py::object>(pre_step.ptr(), step);
-                        return py::extract<bool>(res);
-                    },
-                    [&post_step](core::Step step)
-                    {
-                        auto res = py::call<py::object>(post_step.ptr(), step);
-                        return py::extract<bool>(res);
-                    });
+                const auto pre_step_predicate = make_python_predicate(pre_step);
+                const auto post_step_predicate = make_python_predicate(post_step);
+                GILRelease no_gil;
+                self.start(pre_step_predicate, post_step_predicate);
             }),
         "Start network execution on the backend.")
+    // Overloads are tried in reverse order, so a non-integer second argument selects the overload above.
+    .def(
+        "start",
+        make_handler(
+            [](core::Backend &self, py::object &run_predicate, size_t call_period)
+            {
+                const auto predicate = make_python_predicate(run_predicate, call_period);
+                GILRelease no_gil;
+                self.start(predicate);
+            }),
+        "Start network execution on the backend, calling the run predicate once per `call_period` steps. The GIL is "
+        "released between predicate calls.")
     .def("stop", &core::Backend::stop, "Stop network execution on the backend.")
     .def("get_step", &core::Backend::get_step, "Get current step.")
     .def("stop_learning", &core::Backend::stop_learning, "Stop learning.")
@@ -213,7 +226,15 @@ py::class_<BackendWrapper, boost::noncopyable>(
             }),
         "Subscribe internal endpoint to messages.")
     .def("_init", &core::Backend::_init, "Initialize backend before starting network execution.")
-    .def("_step", &core::Backend::_step, "Make one network execution step.")
+    .def(
+        "_step",
+        make_handler(
+            [](core::Backend &self)
+            {
+                GILRelease no_gil;
+                self._step();
+            }),
+        "Make one network execution step.")
     .def("_uninit", &core::Backend::_uninit, "Set backend to the uninitialized state.")
     .add_property(
         "message_bus",
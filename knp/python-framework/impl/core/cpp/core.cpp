@@ -24,7 +24,9 @@
 #include <filesystem>
 
 #include "any_converter.h"
+#include "array_view.h"
 #include "common.h"
+#include "gil.h"
 #include "message_endpoint.h"
 #include "optional_converter.h"
 #include "population.h"
@@ -80,6 +82,7 @@ BOOST_PYTHON_MODULE(KNP_FULL_LIBRARY_NAME)
     //    boost::python::import("libknp_python_framework_neuron_traits");
 
 #define KNP_IN_CORE
+#include "array_view.cpp"               // NOLINT
 #include "backend.cpp"                  // NOLINT
 #include "device.cpp"                   // NOLINT
 #include "message_bus.cpp"              // NOLINT
@@ -0,0 +1,108 @@
+/**
+ * @file gil.h
+ * @brief Python bindings header for Python GIL management.
+ * @kaspersky_support Artiom N.
+ * @date 18.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <knp/core/backend.h>
+
+#include <cstddef>
+#include <memory>
+
+#include <boost/python.hpp>
+
+
+/**
+ * @brief The GILRelease class is a definition of a guard that releases the Python GIL while it exists.
+ * @details Use the guard around long C++ computations, so other Python threads can run.
+ */
+class GILRelease
+{
+public:
+    GILRelease() : state_(PyEval_SaveThread()) {}
+    ~GILRelease() { PyEval_RestoreThread(state_); }
+    GILRelease(const GILRelease &) = delete;
+    GILRelease &operator=(const GILRelease &) = delete;
+
+private:
+    // cppcheck-suppress unusedStructMember
+    PyThreadState *state_;
+};
+
+
+/**
+ * @brief The GILAcquire class is a definition of a guard that acquires the Python GIL while it exists.
+ * @details Use the guard in C++ callbacks that call Python while the GIL is released.
+ */
+class GILAcquire
+{
+public:
+    GILAcquire() : state_(PyGILState_Ensure()) {}
+    ~GILAcquire() { PyGILState_Release(state_); }
+    GILAcquire(const GILAcquire &) = delete;
+    GILAcquire &operator=(const GILAcquire &) = delete;
+
+private:
+    // cppcheck-suppress unusedStructMember
+    PyGILState_STATE state_;
+};
+
+
+/**
+ * @brief Make a run predicate that calls a Python function.
+ * @details The Python function is called at the first step and then once per `call_period` steps, the predicate
+ * returns `true` at other steps. The GIL is acquired only for the call.
+ * @param predicate Python function that receives step number and returns `False` to stop execution.
+ * @param call_period number of steps between Python function calls.
+ * @return run predicate.
+ * @note The predicate doesn't own the Python function, so it can be copied without the GIL. The function object must
+ * exist while the predicate is used.
+ */
+inline knp::core::Backend::RunPredicate make_python_predicate(
+    const boost::python::object &predicate, size_t call_period = 1)
+{
+    namespace py = boost::python;
+
+    if (!call_period) call_period = 1;
+    size_t calls_count = 0;
+    return [function = predicate.ptr(), call_period, calls_count](knp::core::Step step) mutable
+    {
+        if (calls_count++ % call_period) return true;
+        GILAcquire gil;
+        return static_cast<bool>(py::extract<bool>(py::call<py::object>(function, step)));
+    };
+}
+
+
+/**
+ * @brief Make a shared pointer to a Python object that can be copied and destroyed without the GIL.
+ * @details Use the pointer to keep Python functions in C++ callbacks that are stored after a Python call returns.
+ * @param object Python object.
+ * @return shared pointer to the Python object. The GIL is acquired to release the object.
+ */
+inline std::shared_ptr<boost::python::object> share_python_object(const boost::python::object &object)
+{
+    return std::shared_ptr<boost::python::object>(
+        new boost::python::object(object),
+        [](boost::python::object *shared_object)
+        {
+            GILAcquire gil;
+            delete shared_object;
+        });
+}
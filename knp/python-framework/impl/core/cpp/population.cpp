@@ -69,6 +69,13 @@ namespace nt = knp::neuron_traits;
                         static_cast<std::shared_ptr<core::Population<nt::neuron_type>> (*)(                            \
                             const py::object &, size_t)>(&population_constructor_wrapper<nt::neuron_type>)),           \
                     "Construct a population by running a neuron generator.")                                           \
+                .def(                                                                                                  \
+                    "from_arrays", &population_from_arrays<nt::neuron_type>,                                           \
+                    (py::arg("neurons_count"), py::arg("columns") = py::dict(), py::arg("parameters") = py::object(),  \
+                     py::arg("uid") = py::object()),                                                                   \
+                    py::return_value_policy<py::manage_new_object>(),                                                  \
+                    "Construct a population from arrays of neuron parameters without calling a generator.")            \
+                .staticmethod("from_arrays")                                                                           \
                 .def(                                                                                                  \
                     "add_neurons", &population_neurons_add_wrapper<nt::neuron_type>, "Add neurons to the population.") \
                 .def(                                                                                                  \
@@ -93,6 +100,12 @@ namespace nt = knp::neuron_traits;
                         core::Population<nt::neuron_type>::*)(size_t)>(                                                \
                         &core::Population<nt::neuron_type>::operator[]),                                               \
                     py::return_internal_reference<>(), "Get parameter values of a neuron with the given index.")       \
+                .def(                                                                                                  \
+                    "get_parameter_view", &population_parameter_view<nt::neuron_type>,                                 \
+                    "Get a writable view of a parameter of all neurons in the population.")                            \
+                .add_property(                                                                                         \
+                    "parameter_names", &population_parameter_names<nt::neuron_type>,                                   \
+                    "Get names of neuron parameters that can be viewed.")                                              \
                 .add_property(                                                                                         \
                     "uid",                                                                                             \
                     make_handler([](core::Population<nt::neuron_type> &population) { return population.get_uid(); }),  \
@@ -26,7 +26,11 @@
 #include <iostream>
 #include <memory>
 #include <optional>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
 
+#include "array_view.h"
 #include "common.h"
 
 template <typename ElemParametersType>
@@ -78,3 +82,197 @@ void population_neurons_add_wrapper(core::Population<ElemType> &population, cons
     population.add_neurons(
         PopulationGeneratorProxy<typename core::Population<ElemType>::NeuronParameters>(gen_func), index);
 };
+
+
+/**
+ * @brief Type of a function that creates a view of a neuron parameter.
+ */
+template <typename NeuronParameters>
+using ParameterViewFactory = ArrayView (*)(const py::object &, NeuronParameters *, size_t);
+
+
+template <auto member, typename NeuronParameters>
+ArrayView make_parameter_view(const py::object &population_object, NeuronParameters *neurons, size_t size)
+{
+    return make_member_view(population_object, neurons, size, member, false);
+}
+
+
+template <typename NeuronParameters>
+void add_blifat_parameter_views(std::unordered_map<std::string, ParameterViewFactory<NeuronParameters>> &factories)
+{
+    using BP = knp::neuron_traits::neuron_parameters<knp::neuron_traits::BLIFATNeuron>;
+
+    factories.insert({
+        {"n_time_steps_since_last_firing",
+         &make_parameter_view<&BP::n_time_steps_since_last_firing_, NeuronParameters>},
+        {"activation_threshold", &make_parameter_view<&BP::activation_threshold_, NeuronParameters>},
+        {"dynamic_threshold", &make_parameter_view<&BP::dynamic_threshold_, NeuronParameters>},
+        {"threshold_decay", &make_parameter_view<&BP::threshold_decay_, NeuronParameters>},
+        {"threshold_increment", &make_parameter_view<&BP::threshold_increment_, NeuronParameters>},
+        {"postsynaptic_trace", &make_parameter_view<&BP::postsynaptic_trace_, NeuronParameters>},
+        {"postsynaptic_trace_decay", &make_parameter_view<&BP::postsynaptic_trace_decay_, NeuronParameters>},
+        {"postsynaptic_trace_increment", &make_parameter_view<&BP::postsynaptic_trace_increment_, NeuronParameters>},
+        {"inhibitory_conductance", &make_parameter_view<&BP::inhibitory_conductance_, NeuronParameters>},
+        {"inhibitory_conductance_decay", &make_parameter_view<&BP::inhibitory_conductance_decay_, NeuronParameters>},
+        {"potential", &make_parameter_view<&BP::potential_, NeuronParameters>},
+        {"pre_impact_potential", &make_parameter_view<&BP::pre_impact_potential_, NeuronParameters>},
+        {"potential_decay", &make_parameter_view<&BP::potential_decay_, NeuronParameters>},
+        {"bursting_phase", &make_parameter_view<&BP::bursting_phase_, NeuronParameters>},
+        {"bursting_period", &make_parameter_view<&BP::bursting_period_, NeuronParameters>},
+        {"reflexive_weight", &make_parameter_view<&BP::reflexive_weight_, NeuronParameters>},
+        {"reversal_inhibitory_potential",
+         &make_parameter_view<&BP::reversal_inhibitory_potential_, NeuronParameters>},
+        {"absolute_refractory_period", &make_parameter_view<&BP::absolute_refractory_period_, NeuronParameters>},
+        {"potential_reset_value", &make_parameter_view<&BP::potential_reset_value_, NeuronParameters>},
+        {"min_potential", &make_parameter_view<&BP::min_potential_, NeuronParameters>},
+        {"total_blocking_period", &make_parameter_view<&BP::total_blocking_period_, NeuronParameters>},
+        {"dopamine_value", &make_parameter_view<&BP::dopamine_value_, NeuronParameters>},
+    });
+}
+
+
+template <typename NeuronParameters>
+void add_resource_stdp_parameter_views(
+    std::unordered_map<std::string, ParameterViewFactory<NeuronParameters>> &factories)
+{
+    using RP = NeuronParameters;
+
+    factories.insert({
+        {"dopamine_plasticity_time", &make_parameter_view<&RP::dopamine_plasticity_time_, NeuronParameters>},
+        {"free_synaptic_resource", &make_parameter_view<&RP::free_synaptic_resource_, NeuronParameters>},
+        {"synaptic_resource_threshold", &make_parameter_view<&RP::synaptic_resource_threshold_, NeuronParameters>},
+        {"resource_drain_coefficient", &make_parameter_view<&RP::resource_drain_coefficient_, NeuronParameters>},
+        {"stability", &make_parameter_view<&RP::stability_, NeuronParameters>},
+        {"stability_change_parameter", &make_parameter_view<&RP::stability_change_parameter_, NeuronParameters>},
+        {"stability_change_at_isi", &make_parameter_view<&RP::stability_change_at_isi_, NeuronParameters>},
+        {"isi_max", &make_parameter_view<&RP::isi_max_, NeuronParameters>},
+        {"d_h", &make_parameter_view<&RP::d_h_, NeuronParameters>},
+        {"last_step", &make_parameter_view<&RP::last_step_, NeuronParameters>},
+        {"first_isi_spike", &make_parameter_view<&RP::first_isi_spike_, NeuronParameters>},
+        {"is_being_forced", &make_parameter_view<&RP::is_being_forced_, NeuronParameters>},
+    });
+}
+
+
+template <typename NeuronParameters>
+void add_altai_lif_parameter_views(std::unordered_map<std::string, ParameterViewFactory<NeuronParameters>> &factories)
+{
+    using AP = NeuronParameters;
+
+    factories.insert({
+        {"is_diff", &make_parameter_view<&AP::is_diff_, NeuronParameters>},
+        {"is_reset", &make_parameter_view<&AP::is_reset_, NeuronParameters>},
+        {"leak_rev", &make_parameter_view<&AP::leak_rev_, NeuronParameters>},
+        {"saturate", &make_parameter_view<&AP::saturate_, NeuronParameters>},
+        {"do_not_save", &make_parameter_view<&AP::do_not_save_, NeuronParameters>},
+        {"potential", &make_parameter_view<&AP::potential_, NeuronParameters>},
+        {"activation_threshold", &make_parameter_view<&AP::activation_threshold_, NeuronParameters>},
+        {"negative_activation_threshold",
+         &make_parameter_view<&AP::negative_activation_threshold_, NeuronParameters>},
+        {"potential_leak", &make_parameter_view<&AP::potential_leak_, NeuronParameters>},
+        {"potential_reset_value", &make_parameter_view<&AP::potential_reset_value_, NeuronParameters>},
+    });
+}
+
+
+template <typename ElemType>
+const std::unordered_map<std::string, ParameterViewFactory<knp::neuron_traits::neuron_parameters<ElemType>>>
+    &get_parameter_view_factories()
+{
+    using NeuronParameters = knp::neuron_traits::neuron_parameters<ElemType>;
+
+    static const auto factories = []()
+    {
+        std::unordered_map<std::string, ParameterViewFactory<NeuronParameters>> result;
+        if constexpr (std::is_base_of_v<
+                          knp::neuron_traits::neuron_parameters<knp::neuron_traits::BLIFATNeuron>, NeuronParameters>)
+        {
+            add_blifat_parameter_views(result);
+        }
+        if constexpr (std::is_same_v<ElemType, knp::neuron_traits::SynapticResourceSTDPBLIFATNeuron>)
+        {
+            add_resource_stdp_parameter_views(result);
+        }
+        if constexpr (std::is_same_v<ElemType, knp::neuron_traits::AltAILIF>)
+        {
+            add_altai_lif_parameter_views(result);
+        }
+        return result;
+    }();
+
+    return factories;
+}
+
+
+template <typename ElemType>
+ArrayView make_parameter_view_by_name(
+    const py::object &owner, knp::neuron_traits::neuron_parameters<ElemType> *neurons, size_t size,
+    const std::string &name)
+{
+    const auto &factories = get_parameter_view_factories<ElemType>();
+    const auto factory = factories.find(name);
+    if (factory == factories.end())
+    {
+        PyErr_SetString(PyExc_KeyError, ("Unknown neuron parameter \"" + name + "\".").c_str());
+        py::throw_error_already_set();
+    }
+    return factory->second(owner, neurons, size);
+}
+
+
+/**
+ * @brief Get a view of a parameter of all neurons in the population.
+ * @details Views of the parameters are writable, so neuron state can be changed without copying.
+ * @param population_object Python population object.
+ * @param name parameter name without the trailing underscore.
+ * @return array view.
+ */
+template <typename ElemType>
+ArrayView population_parameter_view(const py::object &population_object, const std::string &name)
+{
+    auto &population = py::extract<core::Population<ElemType> &>(population_object)();
+    return make_parameter_view_by_name<ElemType>(
+        population_object, population.size() ? &*population.begin() : nullptr, population.size(), name);
+}
+
+
+/**
+ * @brief Construct a population from arrays of neuron parameters.
+ * @details Arrays that support the buffer protocol are copied without calling Python for every neuron.
+ * @param neurons_count number of neurons.
+ * @param columns dictionary of parameter names and arrays of parameter values.
+ * @param parameters parameters of neurons that are not in `columns`. Default parameters are used if `None`.
+ * @param uid population UID or `None`.
+ * @return new population.
+ */
+template <typename ElemType>
+core::Population<ElemType> *population_from_arrays(
+    size_t neurons_count, const py::dict &columns, const py::object &parameters, const py::object &uid)
+{
+    using NeuronParameters = typename core::Population<ElemType>::NeuronParameters;
+
+    std::vector<NeuronParameters> neurons(
+        neurons_count, parameters.is_none() ? NeuronParameters() : py::extract<NeuronParameters>(parameters)());
+
+    const py::list items = columns.items();
+    for (py::ssize_t index = 0; index < py::len(items); ++index)
+    {
+        const std::string name = py::extract<std::string>(items[index][0]);
+        // Views over a local vector don't need an owner.
+        make_parameter_view_by_name<ElemType>(py::object(), neurons.data(), neurons.size(), name).assign(items[index][1]);
+    }
+
+    if (uid.is_none()) return new core::Population<ElemType>(std::move(neurons));
+    return new core::Population<ElemType>(py::extract<core::UID>(uid)(), std::move(neurons));
+}
+
+
+template <typename ElemType>
+py::list population_parameter_names(const core::Population<ElemType> &)
+{
+    py::list result;
+    for (const auto &factory : get_parameter_view_factories<ElemType>()) result.append(factory.first);
+    result.sort();
+    return result;
+}
@@ -96,12 +96,32 @@ py::class_<core::Synapse>(
                                              core::UID, core::UID, const py::object &, size_t)>(                       \
                         &projection_constructor_wrapper<st::synapse_type>)),                                           \
                     "Construct a projection by running a synapse generator a given number of times.")                  \
+                .def(                                                                                                  \
+                    "from_arrays", &projection_from_arrays<st::synapse_type>,                                          \
+                    (py::arg("presynaptic_uid"), py::arg("postsynaptic_uid"), py::arg("sources"), py::arg("targets"),  \
+                     py::arg("weights") = py::object(), py::arg("delays") = py::object(),                              \
+                     py::arg("parameters") = py::object(), py::arg("uid") = py::object(),                              \
+                     py::arg("presynaptic_size") = py::object(), py::arg("postsynaptic_size") = py::object()),         \
+                    py::return_value_policy<py::manage_new_object>(),                                                  \
+                    "Construct a projection from arrays of synapse parameters without calling a generator.")           \
+                .staticmethod("from_arrays")                                                                           \
                 .def(                                                                                                  \
                     "add_synapses", &projection_synapses_add_wrapper<st::synapse_type>,                                \
                     "Append connections to the existing projection.")                                                  \
                 .add_property(                                                                                         \
                     "uid", make_handler([](core::Projection<st::synapse_type> &proj) { return proj.get_uid(); }),      \
                     "Get projection UID.")                                                                             \
+                .add_property(                                                                                         \
+                    "weights", &projection_weights_view<st::synapse_type>,                                             \
+                    "Get a writable view of synapse weights.")                                                         \
+                .add_property(                                                                                         \
+                    "delays", &projection_delays_view<st::synapse_type>, "Get a writable view of synapse delays.")     \
+                .add_property(                                                                                         \
+                    "sources", &projection_sources_view<st::synapse_type>,                                             \
+                    "Get a read-only view of presynaptic neuron indexes.")                                             \
+                .add_property(                                                                                         \
+                    "targets", &projection_targets_view<st::synapse_type>,                                             \
+                    "Get a read-only view of postsynaptic neuron indexes.")                                            \
                 .def(                                                                                                  \
                     "__iter__",                                                                                        \
                     py::range(                                                                                         \
@@ -114,12 +134,17 @@ py::class_<core::Synapse>(
                     "__len__", &core::Projection<st::synapse_type>::size,                                              \
                     "Count number of synapses in the projection.")                                                     \
                 .def(                                                                                                  \
-                    "__getitem__",                                                                                     \
-                    static_cast<core::Projection<st::synapse_type>::Synapse &(                                         \
-                        core::Projection<st::synapse_type>::*)(size_t index)>(                                         \
-                        &core::Projection<st::synapse_type>::operator[]),                                              \
-                    py::return_internal_reference<>(),                                                                 \
-                    "Get parameter values of a synapse with the given index.");  // NOLINT
+                    "__getitem__", &projection_get_item<st::synapse_type>, py::return_internal_reference<>(),          \
+                    "Get parameter values of a synapse with the given index.")                                         \
+                .def(                                                                                                  \
+                    "get_synapse", &core::Projection<st::synapse_type>::get_synapse,                                   \
+                    "Get a copy of a synapse from the explicit or compact storage.")                                   \
+                .def(                                                                                                  \
+                    "is_compact", &core::Projection<st::synapse_type>::is_compact,                                     \
+                    "Determine if the projection stores synapses as a synapse block.")                                 \
+                .def(                                                                                                  \
+                    "materialize", &core::Projection<st::synapse_type>::materialize,                                   \
+                    "Convert a compact projection to the explicit storage.");  // NOLINT
 
 BOOST_PP_SEQ_FOR_EACH(INSTANCE_PY_PROJECTIONS, "", BOOST_PP_VARIADIC_TO_SEQ(ALL_SYNAPSES))  //!OCLINT(Parameters used)
 
@@ -23,13 +23,21 @@
 #include <knp/core/projection.h>
 #include <knp/synapse-traits/all_traits.h>
 
+#include <cstdint>
 #include <iostream>
+#include <limits>
 #include <memory>
 #include <optional>
+#include <stdexcept>
+#include <string>
 #include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #include <boost/python/tuple.hpp>
 
+#include "array_view.h"
 #include "common.h"
 
 
@@ -85,3 +93,143 @@ void projection_synapses_add_wrapper(
 {
     projection.add_synapses(ProjectionGeneratorProxy<ElemType>(gen_func), num_iterations);
 };
+
+
+// Synapses are accessed by reference, so `materialize()` must be called for a compact projection first, otherwise
+// the subscript operator throws.
+template <typename ElemType>
+typename core::Projection<ElemType>::Synapse &projection_get_item(core::Projection<ElemType> &projection, size_t index)
+{
+    if (index >= projection.size()) throw std::out_of_range("Synapse index is out of range.");
+    return projection[index];
+}
+
+
+template <typename Synapse, typename Getter>
+ArrayView make_synapse_view(const py::object &owner, Synapse *synapses, size_t size, Getter getter, bool readonly)
+{
+    using ValueType = std::remove_reference_t<decltype(getter(std::declval<Synapse &>()))>;
+    ValueType *first = size ? &getter(*synapses) : nullptr;
+    return ArrayView(owner, first, size, sizeof(Synapse), readonly);
+}
+
+
+template <typename ElemType, typename Getter>
+ArrayView make_synapse_view(const py::object &projection_object, Getter getter, bool readonly)
+{
+    auto &projection = py::extract<core::Projection<ElemType> &>(projection_object)();
+    return make_synapse_view(
+        projection_object, projection.size() ? &*projection.begin() : nullptr, projection.size(), getter, readonly);
+}
+
+
+template <typename ElemType>
+ArrayView projection_weights_view(const py::object &projection_object)
+{
+    return make_synapse_view<ElemType>(
+        projection_object, [](auto &synapse) -> auto & { return std::get<core::synapse_data>(synapse).weight_; },
+        false);
+}
+
+
+template <typename ElemType>
+ArrayView projection_delays_view(const py::object &projection_object)
+{
+    return make_synapse_view<ElemType>(
+        projection_object, [](auto &synapse) -> auto & { return std::get<core::synapse_data>(synapse).delay_; },
+        false);
+}
+
+
+// Neuron indexes are read-only, because the projection keeps a search index over them.
+template <typename ElemType>
+ArrayView projection_sources_view(const py::object &projection_object)
+{
+    return make_synapse_view<ElemType>(
+        projection_object, [](auto &synapse) -> auto & { return std::get<core::source_neuron_id>(synapse); }, true);
+}
+
+
+template <typename ElemType>
+ArrayView projection_targets_view(const py::object &projection_object)
+{
+    return make_synapse_view<ElemType>(
+        projection_object, [](auto &synapse) -> auto & { return std::get<core::target_neuron_id>(synapse); }, true);
+}
+
+
+// Copy neuron indexes of synapses from an array, a `ValueError` is raised for negative indexes and for indexes that
+// are not less than the population size. The size isn't checked if it is `None`.
+inline std::vector<int64_t> read_neuron_indexes(
+    const py::object &values, size_t synapses_count, const py::object &population_size, const char *name)
+{
+    std::vector<int64_t> result(synapses_count);
+    ArrayView(py::object(), result.data(), result.size(), sizeof(int64_t), false).assign(values);
+
+    const auto max_index = population_size.is_none()
+                               ? std::numeric_limits<int64_t>::max()
+                               : static_cast<int64_t>(py::extract<size_t>(population_size)()) - 1;
+    for (size_t index = 0; index < result.size(); ++index)
+    {
+        if (result[index] >= 0 && result[index] <= max_index) continue;
+        const std::string message = std::string("Synapse ") + std::to_string(index) + " has " + name +
+                                    " neuron index " + std::to_string(result[index]) + ", which is out of range.";
+        PyErr_SetString(PyExc_ValueError, message.c_str());
+        py::throw_error_already_set();
+    }
+    return result;
+}
+
+
+/**
+ * @brief Construct a projection from arrays of synapse parameters.
+ * @details Arrays that support the buffer protocol are copied without calling Python for every synapse. The synapse
+ * index is built once. All arrays must have the same length. Neuron indexes must be non-negative and less than
+ * population sizes, if the sizes are given.
+ */
+template <typename ElemType>
+core::Projection<ElemType> *projection_from_arrays(
+    const core::UID &presynaptic_uid, const core::UID &postsynaptic_uid, const py::object &sources,
+    const py::object &targets, const py::object &weights, const py::object &delays, const py::object &parameters,
+    const py::object &uid, const py::object &presynaptic_size, const py::object &postsynaptic_size)
+{
+    using Synapse = typename core::Projection<ElemType>::Synapse;
+    using SynapseParameters = typename core::Projection<ElemType>::SynapseParameters;
+
+    const SynapseParameters synapse_parameters =
+        parameters.is_none() ? SynapseParameters() : py::extract<SynapseParameters>(parameters)();
+    std::vector<Synapse> synapses(py::len(sources), Synapse{synapse_parameters, 0, 0});
+
+    // Views over a local vector don't need an owner.
+    const py::object owner;
+    auto *first = synapses.data();
+    const size_t size = synapses.size();
+    const auto source_ids = read_neuron_indexes(sources, size, presynaptic_size, "presynaptic");
+    const auto target_ids = read_neuron_indexes(targets, size, postsynaptic_size, "postsynaptic");
+    for (size_t index = 0; index < size; ++index)
+    {
+        std::get<core::source_neuron_id>(synapses[index]) = static_cast<size_t>(source_ids[index]);
+        std::get<core::target_neuron_id>(synapses[index]) = static_cast<size_t>(target_ids[index]);
+    }
+    if (!weights.is_none())
+    {
+        make_synapse_view(
+            owner, first, size, [](auto &synapse) -> auto & { return std::get<core::synapse_data>(synapse).weight_; },
+            false)
+            .assign(weights);
+    }
+    if (!delays.is_none())
+    {
+        make_synapse_view(
+            owner, first, size, [](auto &synapse) -> auto & { return std::get<core::synapse_data>(synapse).delay_; },
+            false)
+            .assign(delays);
+    }
+
+    if (uid.is_none())
+    {
+        return new core::Projection<ElemType>(presynaptic_uid, postsynaptic_uid, std::move(synapses));
+    }
+    return new core::Projection<ElemType>(
+        py::extract<core::UID>(uid)(), presynaptic_uid, postsynaptic_uid, std::move(synapses));
+}
@@ -27,7 +27,10 @@
 
 
 py::class_<core::messaging::SpikeData>("SpikeData", "List of spike indexes.")
-    .def(py::vector_indexing_suite<core::messaging::SpikeData>());
+    .def(py::vector_indexing_suite<core::messaging::SpikeData>())
+    .add_property(
+        "__array_interface__", &spike_data_array_interface,
+        "NumPy array interface. `numpy.asarray()` creates a writable array that shares memory with the list.");
 
 
 py::class_<core::messaging::SpikeMessage>("SpikeMessage", "Structure of the spike message.")
@@ -24,6 +24,7 @@
 #include <memory>
 #include <utility>
 
+#include "array_view.h"
 #include "common.h"
 
 
@@ -36,3 +37,16 @@ std::shared_ptr<knp::core::messaging::SpikeMessage> spike_message_constructor(
 
     return std::make_shared<knp::core::messaging::SpikeMessage>(std::move(sm));
 }
+
+
+/**
+ * @brief Get array interface of spike data, so NumPy can read spike indexes without copying them.
+ * @param spikes_object Python spike data object.
+ * @return array interface dictionary.
+ */
+inline py::dict spike_data_array_interface(const py::object &spikes_object)
+{
+    auto &spikes = py::extract<core::messaging::SpikeData &>(spikes_object)();
+    return ArrayView(spikes_object, spikes.data(), spikes.size(), sizeof(core::messaging::SpikeIndex), false)
+        .get_array_interface();
+}
@@ -43,7 +43,9 @@ namespace cm = knp::core::messaging;
                     "add_senders", &core::Subscription<cm::message_type>::add_senders,                          \
                     "Add several senders to the subscription.")                                                 \
                 .def(                                                                                           \
-                    "has_sender", &core::Subscription<cm::message_type>::has_sender,                            \
+                    "has_sender",                                                                               \
+                    static_cast<bool (core::Subscription<cm::message_type>::*)(const core::UID&) const>(        \
+                        &core::Subscription<cm::message_type>::has_sender),                                     \
                     "Check if a sender with the given UID exists.")                                             \
                 .def(                                                                                           \
                     "add_message",                                                                              \
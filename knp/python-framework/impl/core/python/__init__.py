@@ -25,6 +25,7 @@ from knp.core._knp_python_framework_core import (
     UID,
     AdditiveSTDPDeltaSynapseParameters,
     AdditiveSTDPDeltaSynapseProjection,
+    ArrayView,
     Backend,
     BaseData,
     BLIFATNeuronPopulation,
@@ -50,6 +51,7 @@ __all__ = [
     'DeltaSynapseProjection',
     'AdditiveSTDPDeltaSynapseParameters',
     'AdditiveSTDPDeltaSynapseProjection',
+    'ArrayView',
     'Backend',
     'BaseData',
     'DeltaSynapseParameters',
@@ -85,3 +85,21 @@ def test_smallest_network(pytestconfig):  # type: ignore[no-untyped-def]
     expected_results = [1, 6, 7, 11, 12, 13, 16, 17, 18, 19]
 
     assert results == expected_results
+
+
+def test_start_with_call_period(pytestconfig):  # type: ignore[no-untyped-def]
+    population = BLIFATNeuronPopulation(neuron_generator, 1)
+
+    backend = BackendLoader().load(f'{pytestconfig.rootdir}/../bin/libknp-cpu-single-threaded-backend')
+    backend.load_all_populations([population])
+
+    checked_steps = []
+
+    def run_predicate(step):  # type: ignore[no-untyped-def]
+        checked_steps.append(step)
+        return step < 20
+
+    # The predicate is called on every fifth step only, the backend keeps running between calls.
+    backend.start(run_predicate, 5)
+
+    assert checked_steps == [0, 5, 10, 15, 20]
@@ -0,0 +1,126 @@
+"""
+@file test_array_view.py
+@brief Zero-copy array views tests.
+
+@kaspersky_support Artiom N.
+@license Apache 2.0 License.
+@copyright © 2024 AO Kaspersky Lab
+@date 18.10.2026.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+"""
+
+import pytest
+
+from knp.core import UID, BLIFATNeuronPopulation, DeltaSynapseProjection
+from knp.core.messaging import SpikeMessage
+from knp.neuron_traits import BLIFATNeuronParameters
+from knp.synapse_traits import DeltaSynapseParameters, OutputType
+
+
+def neuron_generator(_):  # type: ignore[no-untyped-def]
+    return BLIFATNeuronParameters()
+
+
+def synapse_generator(index):  # type: ignore[no-untyped-def]
+    return DeltaSynapseParameters(float(index), index + 1, OutputType.EXCITATORY), index, 2 * index
+
+
+def test_projection_views():  # type: ignore[no-untyped-def]
+    projection = DeltaSynapseProjection(UID(), UID(), synapse_generator, 4)
+
+    assert len(projection.weights) == 4
+    assert list(projection.delays) == [1, 2, 3, 4]
+    assert list(projection.targets) == [0, 2, 4, 6]
+
+    weights = projection.weights
+    weights[1] = 10.0
+    assert list(projection.weights) == [0.0, 10.0, 2.0, 3.0]
+    assert weights[-1] == 3.0
+
+    assert projection.sources.readonly
+    with pytest.raises(ValueError):
+        projection.sources[0] = 1
+    with pytest.raises(IndexError):
+        _ = projection.weights[4]
+
+
+def test_population_views():  # type: ignore[no-untyped-def]
+    population = BLIFATNeuronPopulation(neuron_generator, 3)
+
+    assert 'potential' in population.parameter_names
+    potential = population.get_parameter_view('potential')
+    potential[2] = 0.5
+    assert population[2].potential == 0.5
+
+    with pytest.raises(KeyError):
+        population.get_parameter_view('unknown')
+
+
+def test_numpy_views():  # type: ignore[no-untyped-def]
+    np = pytest.importorskip('numpy')
+
+    projection = DeltaSynapseProjection(UID(), UID(), synapse_generator, 4)
+    weights = np.asarray(projection.weights)
+    weights *= 2
+    assert list(projection.weights) == [0.0, 2.0, 4.0, 6.0]
+    assert not np.asarray(projection.sources).flags.writeable
+
+    population = BLIFATNeuronPopulation(neuron_generator, 3)
+    np.asarray(population.get_parameter_view('potential'))[:] = 1.0
+    assert [neuron.potential for neuron in population] == [1.0, 1.0, 1.0]
+
+    message = SpikeMessage((UID(), 0), [1, 2, 3])
+    indexes = np.asarray(message.neuron_indexes)
+    assert indexes.dtype == np.uint32
+    indexes[0] = 5
+    assert list(message.neuron_indexes) == [5, 2, 3]
+
+
+def test_projection_from_arrays():  # type: ignore[no-untyped-def]
+    projection = DeltaSynapseProjection.from_arrays(
+        UID(),
+        UID(),
+        sources=[0, 0, 1],
+        targets=[1, 2, 2],
+        weights=[0.5, 1.0, 1.5],
+        parameters=DeltaSynapseParameters(0.0, 3, OutputType.EXCITATORY),
+    )
+
+    assert len(projection) == 3
+    assert list(projection.targets) == [1, 2, 2]
+    assert list(projection.weights) == [0.5, 1.0, 1.5]
+    assert list(projection.delays) == [3, 3, 3]
+
+    with pytest.raises(ValueError):
+        DeltaSynapseProjection.from_arrays(UID(), UID(), [0, 1], [0])
+    with pytest.raises(ValueError):
+        DeltaSynapseProjection.from_arrays(UID(), UID(), [0, 1], [0, 1], weights=[0.5])
+    with pytest.raises(ValueError):
+        DeltaSynapseProjection.from_arrays(UID(), UID(), [0, -1], [0, 1])
+    with pytest.raises(ValueError):
+        DeltaSynapseProjection.from_arrays(UID(), UID(), [0, 1], [0, 3], presynaptic_size=2, postsynaptic_size=3)
+
+    checked = DeltaSynapseProjection.from_arrays(UID(), UID(), [0, 1], [0, 2], presynaptic_size=2, postsynaptic_size=3)
+    assert list(checked.sources) == [0, 1]
+
+
+def test_population_from_arrays():  # type: ignore[no-untyped-def]
+    population = BLIFATNeuronPopulation.from_arrays(3, {'potential': [0.0, 0.5, 1.0], 'bursting_period': [2, 2, 2]})
+
+    assert len(population) == 3
+    assert [neuron.potential for neuron in population] == [0.0, 0.5, 1.0]
+    assert population[1].bursting_period == 2
+
+    with pytest.raises(KeyError):
+        BLIFATNeuronPopulation.from_arrays(3, {'unknown': [0, 0, 0]})
@@ -29,6 +29,7 @@
 #include <spdlog/spdlog.h>
 #include <tests_common.h>
 
+#include <algorithm>
 #include <functional>
 #include <vector>
 
@@ -44,6 +45,11 @@ class MTestingBack : public knp::backends::multi_threaded_cpu::MultiThreadedCPUB
 {
 public:
     MTestingBack() = default;
+    explicit MTestingBack(size_t projection_part_size)
+        : knp::backends::multi_threaded_cpu::MultiThreadedCPUBackend(
+              0, knp::backends::multi_threaded_cpu::default_population_part_size, projection_part_size)
+    {
+    }
     void _init() override { knp::backends::multi_threaded_cpu::MultiThreadedCPUBackend::_init(); }
 };
 
@@ -73,6 +79,51 @@ bool receive_messages_smallest_network(const knp::core::UID &out_channel_uid, En
 }
 
 
+namespace
+{
+// Run a population that receives input spikes through a dense projection, return spikes of every step.
+std::vector<knp::core::messaging::SpikeData> run_dense_input_network(
+    bool is_compact, bool observe_impacts, const std::vector<uint32_t> &delays)
+{
+    // Projection parts contain parts of weight rows.
+    knp::testing::MTestingBack backend(3);
+
+    knp::testing::BLIFATPopulation population{knp::testing::neuron_generator, 4};
+    auto input_projection = knp::testing::DeltaProjection::make_dense(
+        knp::core::UID{false}, population.get_uid(), 2, 4, {1.F, 0.F, 1.F, 0.F, 0.F, 1.F, 1.F, 0.F}, delays,
+        {1.F, 2, knp::synapse_traits::OutputType::EXCITATORY});
+    if (!is_compact) input_projection.materialize();
+    const auto input_uid = input_projection.get_uid();
+
+    backend.load_populations({population});
+    backend.load_projections({input_projection});
+    auto endpoint = backend.get_message_bus().create_endpoint();
+
+    const knp::core::UID in_channel_uid, out_channel_uid;
+    backend.subscribe<knp::core::messaging::SpikeMessage>(input_uid, {in_channel_uid});
+    endpoint.subscribe<knp::core::messaging::SpikeMessage>(out_channel_uid, {population.get_uid()});
+    if (observe_impacts) backend.require_bus_messages({input_uid});
+    backend._init();
+
+    const std::vector<knp::core::messaging::SpikeData> inputs{{0}, {}, {}, {1}, {}, {}, {0, 1}, {}, {}, {}};
+    std::vector<knp::core::messaging::SpikeData> results;
+    for (knp::core::Step step = 0; step < inputs.size(); ++step)
+    {
+        endpoint.send_message(knp::core::messaging::SpikeMessage{{in_channel_uid, step}, inputs[step]});
+        backend._step();
+        endpoint.receive_all_messages();
+        auto &spikes = results.emplace_back();
+        for (const auto &message : endpoint.unload_messages<knp::core::messaging::SpikeMessage>(out_channel_uid))
+        {
+            spikes.insert(spikes.end(), message.neuron_indexes_.begin(), message.neuron_indexes_.end());
+        }
+        std::sort(spikes.begin(), spikes.end());
+    }
+    return results;
+}
+}  // namespace
+
+
 TEST(MultiThreadCpuSuite, SmallestNetwork)
 {
     // Create a single-neuron neural network: input -> input_projection -> population <=> loop_projection.
@@ -117,6 +168,63 @@ TEST(MultiThreadCpuSuite, SmallestNetwork)
 }
 
 
+TEST(MultiThreadCpuSuite, CompactProjection)
+{
+    const auto results = run_dense_input_network(false, false, {});
+    ASSERT_EQ(results[2], (knp::core::messaging::SpikeData{0, 2}));
+    ASSERT_EQ(run_dense_input_network(true, false, {}), results);
+    ASSERT_EQ(run_dense_input_network(true, true, {}), results);
+
+    const std::vector<uint32_t> delays{1, 2, 3, 4, 1, 2, 3, 4};
+    const auto delayed_results = run_dense_input_network(false, false, delays);
+    ASSERT_EQ(run_dense_input_network(true, false, delays), delayed_results);
+    ASSERT_EQ(run_dense_input_network(true, true, delays), delayed_results);
+}
+
+
+TEST(MultiThreadCpuSuite, BatchedInference)
+{
+    using knp::core::messaging::SpikeData;
+    // Even samples get inputs of the dense input network, odd samples get no inputs.
+    const std::vector<SpikeData> inputs{{0}, {}, {}, {1}, {}, {}, {0, 1}, {}, {}, {}};
+    const auto get_input = [&inputs](size_t sample, knp::core::Step step)
+    { return sample % 2 ? SpikeData{} : inputs[step]; };
+    constexpr size_t samples_count = 9;
+
+    for (const auto &delays : {std::vector<uint32_t>{}, std::vector<uint32_t>{1, 2, 3, 4, 1, 2, 3, 4}})
+    {
+        const auto expected_results = run_dense_input_network(true, false, delays);
+        for (const bool is_compact : {true, false})
+        {
+            knp::testing::MTestingBack backend;
+            knp::testing::BLIFATPopulation population{knp::testing::neuron_generator, 4};
+            auto input_projection = knp::testing::DeltaProjection::make_dense(
+                knp::core::UID{false}, population.get_uid(), 2, 4, {1.F, 0.F, 1.F, 0.F, 0.F, 1.F, 1.F, 0.F}, delays,
+                {1.F, 2, knp::synapse_traits::OutputType::EXCITATORY});
+            if (!is_compact) input_projection.materialize();
+            const knp::core::UID in_channel_uid;
+            backend.load_populations({population});
+            backend.load_projections({input_projection});
+            backend.subscribe<knp::core::messaging::SpikeMessage>(input_projection.get_uid(), {in_channel_uid});
+            backend._init();
+
+            const auto output =
+                backend.run_batch({{in_channel_uid, get_input}}, samples_count, inputs.size(), {population.get_uid()});
+            ASSERT_EQ(output.size(), samples_count);
+            for (size_t sample = 0; sample < samples_count; ++sample)
+            {
+                std::vector<SpikeData> results(inputs.size());
+                for (const auto &message : output[sample])
+                {
+                    results[message.header_.send_time_] = message.neuron_indexes_;
+                }
+                ASSERT_EQ(results, sample % 2 ? std::vector<SpikeData>(inputs.size()) : expected_results);
+            }
+        }
+    }
+}
+
+
 TEST(MultiThreadCpuSuite, NeuronsGettingTest)
 {
     const knp::testing::MTestingBack backend;
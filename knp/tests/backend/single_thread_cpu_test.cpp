@@ -30,6 +30,8 @@
 #include <spdlog/spdlog.h>
 #include <tests_common.h>
 
+#include <optional>
+#include <utility>
 #include <vector>
 
 
@@ -50,6 +52,106 @@ public:
 }  // namespace knp::testing
 
 
+namespace
+{
+// Run a population that receives input spikes through a dense projection, return spikes of every step.
+std::vector<knp::core::messaging::SpikeData> run_dense_input_network(
+    bool is_compact, bool observe_impacts, const std::vector<uint32_t> &delays)
+{
+    knp::testing::STestingBack backend;
+
+    knp::testing::BLIFATPopulation population{knp::testing::neuron_generator, 4};
+    auto input_projection = knp::testing::DeltaProjection::make_dense(
+        knp::core::UID{false}, population.get_uid(), 2, 4, {1.F, 0.F, 1.F, 0.F, 0.F, 1.F, 1.F, 0.F}, delays,
+        {1.F, 2, knp::synapse_traits::OutputType::EXCITATORY});
+    if (!is_compact) input_projection.materialize();
+    const auto input_uid = input_projection.get_uid();
+
+    backend.load_populations({population});
+    backend.load_projections({input_projection});
+    backend._init();
+    auto endpoint = backend.get_message_bus().create_endpoint();
+
+    const knp::core::UID in_channel_uid, out_channel_uid;
+    backend.subscribe<knp::core::messaging::SpikeMessage>(input_uid, {in_channel_uid});
+    endpoint.subscribe<knp::core::messaging::SpikeMessage>(out_channel_uid, {population.get_uid()});
+    if (observe_impacts) backend.require_bus_messages({input_uid});
+
+    const std::vector<knp::core::messaging::SpikeData> inputs{{0}, {}, {}, {1}, {}, {}, {0, 1}, {}, {}, {}};
+    std::vector<knp::core::messaging::SpikeData> results;
+    for (knp::core::Step step = 0; step < inputs.size(); ++step)
+    {
+        endpoint.send_message(knp::core::messaging::SpikeMessage{{in_channel_uid, step}, inputs[step]});
+        backend._step();
+        endpoint.receive_all_messages();
+        auto &spikes = results.emplace_back();
+        for (const auto &message : endpoint.unload_messages<knp::core::messaging::SpikeMessage>(out_channel_uid))
+        {
+            spikes.insert(spikes.end(), message.neuron_indexes_.begin(), message.neuron_indexes_.end());
+        }
+    }
+    return results;
+}
+
+
+// Run the network of the SmallestNetwork test on two backends, the second one continues from the state of the
+// first one at the specified step. Steps of the second backend are shifted by the offset. Return steps at which the
+// population spikes without the offset.
+std::vector<knp::core::Step> run_restored_network(
+    bool observe_loop, knp::core::Step restore_step, knp::core::Step step_offset = 0)
+{
+    knp::testing::BLIFATPopulation population{knp::testing::neuron_generator, 1};
+    const knp::testing::DeltaProjection loop_projection{
+        population.get_uid(), population.get_uid(), knp::testing::synapse_generator, 1};
+    const knp::testing::DeltaProjection input_projection{
+        knp::core::UID{false}, population.get_uid(), knp::testing::input_projection_gen, 1};
+
+    std::vector<knp::core::Step> results;
+    std::optional<knp::core::DynamicState> state;
+    for (const auto &[first_step, last_step] : {std::make_pair(0UL, restore_step), std::make_pair(restore_step, 20UL)})
+    {
+        knp::testing::STestingBack backend;
+        backend.load_populations({population});
+        backend.load_projections({input_projection, loop_projection});
+        const knp::core::Step offset = state ? step_offset : 0;
+        if (state) backend.set_dynamic_state(*state);
+        backend._init();
+        EXPECT_EQ(backend.get_step(), first_step + offset);
+
+        auto endpoint = backend.get_message_bus().create_endpoint();
+        const knp::core::UID in_channel_uid, out_channel_uid;
+        backend.subscribe<knp::core::messaging::SpikeMessage>(input_projection.get_uid(), {in_channel_uid});
+        endpoint.subscribe<knp::core::messaging::SpikeMessage>(out_channel_uid, {population.get_uid()});
+        if (observe_loop) backend.require_bus_messages({loop_projection.get_uid()});
+
+        for (knp::core::Step step = first_step + offset; step < last_step + offset; ++step)
+        {
+            if ((step - offset) % 5 == 0)
+            {
+                endpoint.send_message(knp::core::messaging::SpikeMessage{{in_channel_uid, step}, {0}});
+            }
+            backend._step();
+            endpoint.receive_all_messages();
+            if (!endpoint.unload_messages<knp::core::messaging::SpikeMessage>(out_channel_uid).empty())
+            {
+                results.push_back(step - offset);
+            }
+        }
+        state = backend.get_dynamic_state();
+        state->step_ += step_offset;
+        for (auto *entity_states : {&state->populations_, &state->projections_})
+        {
+            for (auto &entity_state : *entity_states)
+            {
+                for (auto &impact : entity_state.pending_impacts_) impact.first += step_offset;
+            }
+        }
+    }
+    return results;
+}
+}  // namespace
+
+
 TEST(SingleThreadCpuSuite, SmallestNetwork)
 {
     // Create a single-neuron neural network: input -> input_projection -> population <=> loop_projection.
@@ -283,6 +385,397 @@ TEST(SingleThreadCpuSuite, ResourceSTDPNetwork)
 }
 
 
+TEST(SingleThreadCpuSuite, ObservedProjectionSendsImpacts)
+{
+    // The same network as in the SmallestNetwork test, but projection impacts are observed.
+    knp::testing::STestingBack backend;
+
+    knp::testing::BLIFATPopulation population{knp::testing::neuron_generator, 1};
+    Projection loop_projection =
+        knp::testing::DeltaProjection{population.get_uid(), population.get_uid(), knp::testing::synapse_generator, 1};
+    Projection input_projection = knp::testing::DeltaProjection{
+        knp::core::UID{false}, population.get_uid(), knp::testing::input_projection_gen, 1};
+    const knp::core::UID input_uid = std::visit([](const auto &proj) { return proj.get_uid(); }, input_projection);
+    const knp::core::UID loop_uid = std::visit([](const auto &proj) { return proj.get_uid(); }, loop_projection);
+
+    backend.load_populations({population});
+    backend.load_projections({input_projection, loop_projection});
+
+    backend._init();
+    auto endpoint = backend.get_message_bus().create_endpoint();
+
+    const knp::core::UID in_channel_uid, out_channel_uid, impact_observer_uid;
+
+    backend.subscribe<knp::core::messaging::SpikeMessage>(input_uid, {in_channel_uid});
+    endpoint.subscribe<knp::core::messaging::SpikeMessage>(out_channel_uid, {population.get_uid()});
+    // Projections send impacts to the bus, because the endpoint is subscribed to them.
+    endpoint.subscribe<knp::core::messaging::SynapticImpactMessage>(impact_observer_uid, {input_uid, loop_uid});
+
+    std::vector<knp::core::Step> results;
+    size_t input_impacts_count = 0;
+    size_t loop_impacts_count = 0;
+
+    for (knp::core::Step step = 0; step < 20; ++step)
+    {
+        if (step % 5 == 0)
+        {
+            knp::core::messaging::SpikeMessage message{{in_channel_uid, step}, {0}};
+            endpoint.send_message(message);
+        }
+        backend._step();
+        endpoint.receive_all_messages();
+        if (!endpoint.unload_messages<knp::core::messaging::SpikeMessage>(out_channel_uid).empty())
+        {
+            results.push_back(step);
+        }
+        for (const auto &message :
+             endpoint.unload_messages<knp::core::messaging::SynapticImpactMessage>(impact_observer_uid))
+        {
+            if (message.header_.sender_uid_ == loop_uid)
+            {
+                ++loop_impacts_count;
+            }
+            else
+            {
+                ++input_impacts_count;
+            }
+        }
+    }
+
+    const std::vector<knp::core::Step> expected_results = {1, 6, 7, 11, 12, 13, 16, 17, 18, 19};
+    ASSERT_EQ(results, expected_results);
+    // Every input spike produces an input impact.
+    ASSERT_EQ(input_impacts_count, 4);
+    // Every spike except the last ones produces a loop impact delivered 6 steps later.
+    ASSERT_EQ(loop_impacts_count, 6);
+
+    // Impacts are accumulated locally again after the observer unsubscribes.
+    endpoint.unsubscribe<knp::core::messaging::SynapticImpactMessage>(impact_observer_uid);
+    for (knp::core::Step step = 20; step < 40; ++step)
+    {
+        if (step % 5 == 0) endpoint.send_message(knp::core::messaging::SpikeMessage{{in_channel_uid, step}, {0}});
+        backend._step();
+        endpoint.receive_all_messages();
+        if (!endpoint.unload_messages<knp::core::messaging::SpikeMessage>(out_channel_uid).empty())
+        {
+            results.push_back(step);
+        }
+    }
+    ASSERT_GT(results.size(), expected_results.size());
+}
+
+
+TEST(SingleThreadCpuSuite, RemoveNeuronsBetweenSteps)
+{
+    knp::testing::STestingBack backend;
+
+    knp::testing::BLIFATPopulation population{knp::testing::neuron_generator, 3};
+    const auto population_uid = population.get_uid();
+    // Impacts are delivered on step 3.
+    Projection input_projection = knp::testing::DeltaProjection{
+        knp::core::UID{false}, population_uid,
+        [](size_t index)
+        {
+            return knp::testing::DeltaProjection::Synapse{
+                {1.0, 3, knp::synapse_traits::OutputType::EXCITATORY}, 0, index};
+        },
+        3};
+    knp::core::UID const input_uid = std::visit([](const auto &proj) { return proj.get_uid(); }, input_projection);
+
+    backend.load_populations({population});
+    backend.load_projections({input_projection});
+
+    backend._init();
+    auto endpoint = backend.get_message_bus().create_endpoint();
+
+    const knp::core::UID in_channel_uid, out_channel_uid;
+    backend.subscribe<knp::core::messaging::SpikeMessage>(input_uid, {in_channel_uid});
+    endpoint.subscribe<knp::core::messaging::SpikeMessage>(out_channel_uid, {population_uid});
+
+    endpoint.send_message(knp::core::messaging::SpikeMessage{{in_channel_uid, 0}, {0}});
+    backend._step();
+
+    // The synapse to the removed neuron is deleted and its pending impact is dropped.
+    ASSERT_EQ(backend.remove_neurons(population_uid, {1}), 1);
+    ASSERT_THROW(backend.remove_neurons(input_uid, {0}), std::logic_error);
+
+    std::vector<knp::core::messaging::SpikeMessage> spikes;
+    for (knp::core::Step step = 1; step < 5; ++step)
+    {
+        backend._step();
+        endpoint.receive_all_messages();
+        auto messages = endpoint.unload_messages<knp::core::messaging::SpikeMessage>(out_channel_uid);
+        spikes.insert(spikes.end(), messages.begin(), messages.end());
+    }
+
+    ASSERT_EQ(spikes.size(), 1);
+    ASSERT_EQ(spikes[0].neuron_indexes_, (knp::core::messaging::SpikeData{0, 1}));
+    ASSERT_EQ(std::visit([](const auto &pop) { return pop.size(); }, *backend.begin_populations()), 2);
+    // Indexes out of range are ignored.
+    ASSERT_EQ(backend.remove_neurons(population_uid, {2, 10}), 0);
+    ASSERT_EQ(std::visit([](const auto &pop) { return pop.size(); }, *backend.begin_populations()), 2);
+}
+
+
+TEST(SingleThreadCpuSuite, RemoveNeuronsWithReceivedImpacts)
+{
+    knp::testing::STestingBack backend;
+
+    knp::testing::BLIFATPopulation population{knp::testing::neuron_generator, 3};
+    const auto population_uid = population.get_uid();
+    // Impacts are delivered to the first two neurons on step 3.
+    Projection input_projection = knp::testing::DeltaProjection{
+        knp::core::UID{false}, population_uid,
+        [](size_t index)
+        {
+            return knp::testing::DeltaProjection::Synapse{
+                {1.0, 3, knp::synapse_traits::OutputType::EXCITATORY}, 0, index};
+        },
+        2};
+    knp::core::UID const input_uid = std::visit([](const auto &proj) { return proj.get_uid(); }, input_projection);
+
+    backend.load_populations({population});
+    backend.load_projections({input_projection});
+
+    backend._init();
+    // Impacts are sent through the bus, the population receives them at the end of step 2.
+    backend.require_bus_messages({input_uid});
+    auto endpoint = backend.get_message_bus().create_endpoint();
+
+    const knp::core::UID in_channel_uid, out_channel_uid;
+    backend.subscribe<knp::core::messaging::SpikeMessage>(input_uid, {in_channel_uid});
+    endpoint.subscribe<knp::core::messaging::SpikeMessage>(out_channel_uid, {population_uid});
+
+    endpoint.send_message(knp::core::messaging::SpikeMessage{{in_channel_uid, 0}, {0}});
+    for (knp::core::Step step = 0; step < 3; ++step) backend._step();
+
+    // The received impact on the removed neuron is dropped, the other impacts are moved to new indexes.
+    ASSERT_EQ(backend.remove_neurons(population_uid, {0}), 1);
+
+    backend._step();
+    endpoint.receive_all_messages();
+    const auto spikes = endpoint.unload_messages<knp::core::messaging::SpikeMessage>(out_channel_uid);
+    ASSERT_EQ(spikes.size(), 1);
+    ASSERT_EQ(spikes[0].neuron_indexes_, (knp::core::messaging::SpikeData{0}));
+}
+
+
+TEST(SingleThreadCpuSuite, ReloadPopulationsAfterInit)
+{
+    knp::testing::STestingBack backend;
+
+    knp::testing::BLIFATPopulation small_population{knp::testing::neuron_generator, 1};
+    const auto population_uid = small_population.get_uid();
+    // Impacts are delivered on step 3.
+    Projection input_projection = knp::testing::DeltaProjection{
+        knp::core::UID{false}, population_uid,
+        [](size_t index)
+        {
+            return knp::testing::DeltaProjection::Synapse{
+                {1.0, 3, knp::synapse_traits::OutputType::EXCITATORY}, 0, index};
+        },
+        3};
+    knp::core::UID const input_uid = std::visit([](const auto &proj) { return proj.get_uid(); }, input_projection);
+
+    backend.load_populations({small_population});
+    backend.load_projections({input_projection});
+    backend._init();
+
+    // Accumulators are rebuilt for the new population size.
+    backend.load_populations({knp::testing::BLIFATPopulation{population_uid, knp::testing::neuron_generator, 3}});
+    backend._init();
+    auto endpoint = backend.get_message_bus().create_endpoint();
+
+    const knp::core::UID in_channel_uid, out_channel_uid;
+    backend.subscribe<knp::core::messaging::SpikeMessage>(input_uid, {in_channel_uid});
+    endpoint.subscribe<knp::core::messaging::SpikeMessage>(out_channel_uid, {population_uid});
+
+    endpoint.send_message(knp::core::messaging::SpikeMessage{{in_channel_uid, 0}, {0}});
+    std::vector<knp::core::messaging::SpikeMessage> spikes;
+    for (knp::core::Step step = 0; step < 5; ++step)
+    {
+        backend._step();
+        endpoint.receive_all_messages();
+        auto messages = endpoint.unload_messages<knp::core::messaging::SpikeMessage>(out_channel_uid);
+        spikes.insert(spikes.end(), messages.begin(), messages.end());
+    }
+
+    ASSERT_EQ(spikes.size(), 1);
+    ASSERT_EQ(spikes[0].neuron_indexes_, (knp::core::messaging::SpikeData{0, 1, 2}));
+}
+
+
+TEST(SingleThreadCpuSuite, CompactProjection)
+{
+    // Compact and explicit projections give the same spikes with impacts delivered locally and through the bus.
+    const auto results = run_dense_input_network(false, false, {});
+    ASSERT_EQ(results[2], (knp::core::messaging::SpikeData{0, 2}));
+    ASSERT_EQ(run_dense_input_network(true, false, {}), results);
+    ASSERT_EQ(run_dense_input_network(true, true, {}), results);
+
+    const std::vector<uint32_t> delays{1, 2, 3, 4, 1, 2, 3, 4};
+    const auto delayed_results = run_dense_input_network(false, false, delays);
+    ASSERT_EQ(run_dense_input_network(true, false, delays), delayed_results);
+    ASSERT_EQ(run_dense_input_network(true, true, delays), delayed_results);
+}
+
+
+TEST(SingleThreadCpuSuite, RestoreDynamicState)
+{
+    // Pending impacts of the loop projection are kept in the accumulator or in the message queue if observed.
+    const std::vector<knp::core::Step> expected_results = {1, 6, 7, 11, 12, 13, 16, 17, 18, 19};
+    for (const knp::core::Step restore_step : {3, 8, 14})
+    {
+        ASSERT_EQ(run_restored_network(false, restore_step), expected_results);
+        ASSERT_EQ(run_restored_network(true, restore_step), expected_results);
+    }
+    // Pending impacts are restored at large steps without growing the accumulator ring up to them.
+    ASSERT_EQ(run_restored_network(false, 8, 1'000'000'000), expected_results);
+
+    // Weights of projections without plasticity are not a part of the state.
+    knp::testing::STestingBack backend;
+    knp::testing::BLIFATPopulation population{knp::testing::neuron_generator, 2};
+    backend.load_populations({population});
+    backend.load_projections({knp::testing::DeltaProjection{
+        population.get_uid(), population.get_uid(), knp::testing::synapse_generator, 1}});
+    const auto state = backend.get_dynamic_state();
+    ASSERT_EQ(state.populations_.size(), 1);
+    ASSERT_EQ(std::get<std::vector<double>>(state.populations_[0].values_.at("potential_")).size(), 2);
+    ASSERT_TRUE(state.projections_.at(0).values_.empty());
+
+    auto wrong_state = state;
+    wrong_state.populations_[0].uid_ = knp::core::UID{};
+    ASSERT_THROW(backend.set_dynamic_state(wrong_state), std::logic_error);
+
+    // Accumulators of populations that are not in the state are reset too, so impacts are not dropped after the
+    // step goes back.
+    knp::testing::STestingBack rewound_backend;
+    const knp::testing::DeltaProjection input_projection{
+        knp::core::UID{false}, population.get_uid(), knp::testing::input_projection_gen, 1};
+    rewound_backend.load_populations({population});
+    rewound_backend.load_projections({input_projection});
+    auto first_state = rewound_backend.get_dynamic_state();
+    first_state.populations_.clear();
+    rewound_backend._init();
+
+    auto endpoint = rewound_backend.get_message_bus().create_endpoint();
+    const knp::core::UID in_channel_uid, out_channel_uid;
+    rewound_backend.subscribe<knp::core::messaging::SpikeMessage>(input_projection.get_uid(), {in_channel_uid});
+    endpoint.subscribe<knp::core::messaging::SpikeMessage>(out_channel_uid, {population.get_uid()});
+    for (knp::core::Step step = 0; step < 10; ++step) rewound_backend._step();
+
+    rewound_backend.set_dynamic_state(first_state);
+    ASSERT_EQ(rewound_backend.get_step(), 0);
+    endpoint.send_message(knp::core::messaging::SpikeMessage{{in_channel_uid, 0}, {0}});
+    rewound_backend._step();
+    rewound_backend._step();
+    endpoint.receive_all_messages();
+    ASSERT_FALSE(endpoint.unload_messages<knp::core::messaging::SpikeMessage>(out_channel_uid).empty());
+}
+
+
+TEST(SingleThreadCpuSuite, BatchedInference)
+{
+    namespace kt = knp::testing;
+    using knp::core::messaging::SpikeData;
+
+    kt::BLIFATPopulation population{kt::neuron_generator, 1};
+    const kt::DeltaProjection loop_projection{population.get_uid(), population.get_uid(), kt::synapse_generator, 1};
+    const kt::DeltaProjection input_projection{
+        knp::core::UID{false}, population.get_uid(), kt::input_projection_gen, 1};
+    const knp::core::UID in_channel_uid;
+
+    // Input spikes of a sample are sent with its own period.
+    const std::vector<knp::core::Step> periods{5, 3, 7, 100};
+    const auto get_input = [&periods](size_t sample, knp::core::Step step)
+    { return step % periods[sample] ? SpikeData{} : SpikeData{0}; };
+
+    constexpr size_t steps_count = 20;
+    std::vector<std::vector<knp::core::Step>> expected_results;
+    for (size_t sample = 0; sample < periods.size(); ++sample)
+    {
+        kt::STestingBack backend;
+        backend.load_populations({population});
+        backend.load_projections({input_projection, loop_projection});
+        backend._init();
+        auto endpoint = backend.get_message_bus().create_endpoint();
+        const knp::core::UID out_channel_uid;
+        backend.subscribe<knp::core::messaging::SpikeMessage>(input_projection.get_uid(), {in_channel_uid});
+        endpoint.subscribe<knp::core::messaging::SpikeMessage>(out_channel_uid, {population.get_uid()});
+
+        auto &results = expected_results.emplace_back();
+        for (knp::core::Step step = 0; step < steps_count; ++step)
+        {
+            endpoint.send_message(knp::core::messaging::SpikeMessage{{in_channel_uid, step}, get_input(sample, step)});
+            backend._step();
+            endpoint.receive_all_messages();
+            if (!endpoint.unload_messages<knp::core::messaging::SpikeMessage>(out_channel_uid).empty())
+            {
+                results.push_back(step);
+            }
+        }
+    }
+    ASSERT_EQ(expected_results[0], std::vector<knp::core::Step>({1, 6, 7, 11, 12, 13, 16, 17, 18, 19}));
+
+    // Every sample of a batch gives the same spikes as a separate run.
+    kt::STestingBack backend;
+    backend.load_populations({population});
+    backend.load_projections({input_projection, loop_projection});
+    backend._init();
+    backend.subscribe<knp::core::messaging::SpikeMessage>(input_projection.get_uid(), {in_channel_uid});
+
+    const knp::core::BatchInputMap inputs{{in_channel_uid, get_input}};
+    const auto output = backend.run_batch(inputs, periods.size(), steps_count, {population.get_uid()});
+    ASSERT_EQ(output.size(), periods.size());
+    for (size_t sample = 0; sample < periods.size(); ++sample)
+    {
+        std::vector<knp::core::Step> results;
+        for (const auto &message : output[sample])
+        {
+            ASSERT_EQ(message.header_.sender_uid_, population.get_uid());
+            ASSERT_EQ(message.neuron_indexes_, SpikeData{0});
+            results.push_back(message.header_.send_time_);
+        }
+        ASSERT_EQ(results, expected_results[sample]);
+    }
+
+    // Backend state isn't changed by the batch.
+    ASSERT_EQ(backend.get_step(), 0);
+    ASSERT_EQ(backend.run_batch(inputs, periods.size(), steps_count, {population.get_uid()}), output);
+    ASSERT_TRUE(backend.run_batch(inputs, periods.size(), steps_count, {})[0].empty());
+
+    // Impacts accumulated before the batch are delivered to samples.
+    auto endpoint = backend.get_message_bus().create_endpoint();
+    endpoint.send_message(knp::core::messaging::SpikeMessage{{in_channel_uid, 0}, get_input(0, 0)});
+    backend._step();
+    const auto continued_output = backend.run_batch(inputs, 1, steps_count - 1, {population.get_uid()});
+    std::vector<knp::core::Step> continued_results;
+    for (const auto &message : continued_output[0])
+    {
+        continued_results.push_back(message.header_.send_time_);
+    }
+    ASSERT_EQ(continued_results, expected_results[0]);
+
+    // Impact messages sent through the message bus before the batch are delivered to samples.
+    kt::STestingBack bus_backend;
+    bus_backend.load_populations({population});
+    bus_backend.load_projections({input_projection, loop_projection});
+    bus_backend.require_bus_messages({input_projection.get_uid(), loop_projection.get_uid()});
+    bus_backend._init();
+    bus_backend.subscribe<knp::core::messaging::SpikeMessage>(input_projection.get_uid(), {in_channel_uid});
+    auto bus_endpoint = bus_backend.get_message_bus().create_endpoint();
+    bus_endpoint.send_message(knp::core::messaging::SpikeMessage{{in_channel_uid, 0}, get_input(0, 0)});
+    bus_backend._step();
+    const auto bus_output = bus_backend.run_batch(inputs, 1, steps_count - 1, {population.get_uid()});
+    std::vector<knp::core::Step> bus_results;
+    for (const auto &message : bus_output[0])
+    {
+        bus_results.push_back(message.header_.send_time_);
+    }
+    ASSERT_EQ(bus_results, expected_results[0]);
+}
+
+
 TEST(SingleThreadCpuSuite, NeuronsGettingTest)
 {
     const knp::testing::STestingBack backend;
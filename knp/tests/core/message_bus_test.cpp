@@ -24,6 +24,16 @@
 
 #include <tests_common.h>
 
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#if !defined(_WIN32)
+#    include <sys/wait.h>
+#    include <unistd.h>
+#endif
+
 
 TEST(MessageBusSuite, AddSubscriptionMessage)
 {
@@ -61,6 +71,39 @@ TEST(MessageBusSuite, SubscribeUnsubscribe)
 }
 
 
+TEST(MessageBusSuite, HasSubscription)
+{
+    using SpikeMessage = knp::core::messaging::SpikeMessage;
+    knp::core::MessageBus bus = knp::core::MessageBus::construct_bus();
+    const knp::core::UID sender{true}, receiver{true};
+
+    EXPECT_FALSE(bus.has_subscription<SpikeMessage>(sender));
+    auto version = bus.get_subscription_version();
+    {
+        // Subscriptions are found after the endpoint is moved.
+        auto endpoint = std::make_unique<knp::core::MessageEndpoint>(bus.create_endpoint());
+        endpoint->subscribe<SpikeMessage>(receiver, {sender});
+        EXPECT_NE(bus.get_subscription_version(), version);
+        version = bus.get_subscription_version();
+        EXPECT_TRUE(bus.has_subscription<SpikeMessage>(sender));
+        EXPECT_FALSE(bus.has_subscription<knp::core::messaging::SynapticImpactMessage>(sender));
+        // Subscriptions of the ignored receiver are not taken into account.
+        EXPECT_FALSE(bus.has_subscription<SpikeMessage>(sender, receiver));
+        // Checks and message delivery don't change the version.
+        endpoint->receive_all_messages();
+        EXPECT_EQ(bus.get_subscription_version(), version);
+        EXPECT_TRUE(endpoint->unsubscribe<SpikeMessage>(receiver));
+        EXPECT_NE(bus.get_subscription_version(), version);
+        EXPECT_FALSE(bus.has_subscription<SpikeMessage>(sender));
+        endpoint->subscribe<SpikeMessage>(receiver, {sender});
+        version = bus.get_subscription_version();
+    }
+    // Subscriptions of destroyed endpoints are not taken into account.
+    EXPECT_NE(bus.get_subscription_version(), version);
+    EXPECT_FALSE(bus.has_subscription<SpikeMessage>(sender));
+}
+
+
 TEST(MessageBusSuite, CreateBusAndEndpointZMQ)
 {
     using SpikeMessage = knp::core::messaging::SpikeMessage;
@@ -86,6 +129,46 @@ TEST(MessageBusSuite, CreateBusAndEndpointZMQ)
 }
 
 
+TEST(MessageBusSuite, SendSeveralMessagesZMQ)
+{
+    using SpikeMessage = knp::core::messaging::SpikeMessage;
+    using SynapticImpactMessage = knp::core::messaging::SynapticImpactMessage;
+    knp::core::MessageBus bus = knp::core::MessageBus::construct_zmq_bus();
+
+    auto ep1{bus.create_endpoint()};
+    auto ep2{bus.create_endpoint()};
+
+    const knp::core::UID sender_uid;
+    SpikeMessage msg1{{sender_uid, 1}, {1, 2, 3}};
+    SpikeMessage msg2{{sender_uid, 2}, {4, 5}};
+    SynapticImpactMessage msg3{
+        {sender_uid, 3},
+        knp::core::UID{},
+        knp::core::UID{},
+        false,
+        {{1, 2, knp::synapse_traits::OutputType::EXCITATORY, 3, 4}}};
+
+    auto &spike_subscription = ep2.subscribe<SpikeMessage>(knp::core::UID(), {sender_uid});
+    auto &impact_subscription = ep2.subscribe<SynapticImpactMessage>(knp::core::UID(), {sender_uid});
+
+    ep1.send_message(msg1);
+    ep1.send_message(msg2);
+    ep1.send_message(msg3);
+    // All messages sent by an endpoint are routed as one batch: message ID and batch data.
+    EXPECT_EQ(bus.route_messages(), 2);
+    EXPECT_EQ(ep2.receive_all_messages(), 3);
+
+    const auto &spike_msgs = spike_subscription.get_messages();
+    ASSERT_EQ(spike_msgs.size(), 2);
+    EXPECT_EQ(spike_msgs[0], msg1);
+    EXPECT_EQ(spike_msgs[1], msg2);
+
+    const auto &impact_msgs = impact_subscription.get_messages();
+    ASSERT_EQ(impact_msgs.size(), 1);
+    EXPECT_EQ(impact_msgs[0], msg3);
+}
+
+
 TEST(MessageBusSuite, CreateBusAndEndpointCPU)
 {
     using SpikeMessage = knp::core::messaging::SpikeMessage;
@@ -111,6 +194,195 @@ TEST(MessageBusSuite, CreateBusAndEndpointCPU)
 }
 
 
+TEST(MessageBusSuite, RouteMessagesToSubscriptions)
+{
+    using SpikeMessage = knp::core::messaging::SpikeMessage;
+    using SynapticImpactMessage = knp::core::messaging::SynapticImpactMessage;
+    knp::core::MessageBus bus = knp::core::MessageBus::construct_cpu_bus();
+
+    auto ep1{bus.create_endpoint()};
+    auto ep2{bus.create_endpoint()};
+
+    const knp::core::UID sender1, sender2, receiver1, receiver2;
+
+    ep2.subscribe<SpikeMessage>(receiver1, {sender1});
+    ep2.subscribe<SpikeMessage>(receiver2, {sender1, sender2});
+    ep2.subscribe<SynapticImpactMessage>(receiver1, {sender2});
+    // Sender added to the subscription directly must be registered too.
+    ep2.subscribe<SpikeMessage>(receiver1, {}).add_sender(sender2);
+
+    ep1.send_message(SpikeMessage{{sender1}, {1}});
+    ep1.send_message(SpikeMessage{{sender2}, {2}});
+    ep1.send_message(SpikeMessage{{knp::core::UID{}}, {3}});
+    bus.route_messages();
+    ep2.receive_all_messages();
+
+    EXPECT_EQ(ep2.unload_messages<SpikeMessage>(receiver1).size(), 2);
+    EXPECT_EQ(ep2.unload_messages<SpikeMessage>(receiver2).size(), 2);
+    EXPECT_TRUE(ep2.unload_messages<SynapticImpactMessage>(receiver1).empty());
+    EXPECT_TRUE(ep2.unload_messages<SpikeMessage>(sender1).empty());
+
+    ep2.remove_receiver(receiver1);
+    EXPECT_EQ(ep2.get_endpoint_subscriptions().size(), 1);
+    EXPECT_FALSE(ep2.unsubscribe<SpikeMessage>(receiver1));
+}
+
+
+TEST(MessageBusSuite, CreateBusAndEndpointSHM)
+{
+    using SpikeMessage = knp::core::messaging::SpikeMessage;
+    knp::core::MessageBus bus = knp::core::MessageBus::construct_shm_bus("knp_test_" + std::string(knp::core::UID()));
+
+    auto ep1{bus.create_endpoint()};
+    auto ep2{bus.create_endpoint()};
+
+    SpikeMessage msg{{knp::core::UID{}}, {1, 2, 3, 4, 5}};
+
+    auto &subscription = ep2.subscribe<SpikeMessage>(knp::core::UID(), {msg.header_.sender_uid_});
+
+    ep1.send_message(msg);
+    // Both endpoints receive the message.
+    EXPECT_EQ(bus.route_messages(), 2);
+    ep2.receive_all_messages();
+
+    const auto &msgs = subscription.get_messages();
+
+    EXPECT_EQ(msgs.size(), 1);
+    EXPECT_EQ(msgs[0], msg);
+}
+
+
+TEST(MessageBusSuite, SendEncodedSpikesSHM)
+{
+    using SpikeMessage = knp::core::messaging::SpikeMessage;
+    knp::core::MessageBus bus = knp::core::MessageBus::construct_shm_bus("knp_test_" + std::string(knp::core::UID()));
+
+    auto ep1{bus.create_endpoint()};
+    auto ep2{bus.create_endpoint()};
+
+    // Dense, sparse and unsorted spikes use different encodings.
+    knp::core::messaging::SpikeData dense(1000);
+    for (uint32_t index = 0; index < dense.size(); ++index) dense[index] = index;
+    const std::vector<SpikeMessage> messages{
+        {{knp::core::UID{}, 1}, dense},
+        {{knp::core::UID{}, 2}, {7, 70000, 3000000000}},
+        {{knp::core::UID{}, 3}, {9, 2, 5}}};
+
+    const knp::core::UID receiver;
+    std::vector<knp::core::UID> senders;
+    for (const auto &msg : messages) senders.push_back(msg.header_.sender_uid_);
+    ep2.subscribe<SpikeMessage>(receiver, senders);
+
+    for (const auto &msg : messages) ep1.send_message(msg);
+    bus.route_messages();
+    ep2.receive_all_messages();
+
+    const auto received = ep2.unload_messages<SpikeMessage>(receiver);
+    ASSERT_EQ(received.size(), messages.size());
+    for (size_t index = 0; index < messages.size(); ++index) EXPECT_EQ(received[index], messages[index]);
+}
+
+TEST(MessageBusSuite, ExchangeMessagesSHM)
+{
+    // Two bus instances attached to the same segment work as two processes.
+    using SpikeMessage = knp::core::messaging::SpikeMessage;
+    const std::string segment_name = "knp_test_" + std::string(knp::core::UID());
+    constexpr size_t process_count = 2;
+    constexpr size_t steps_count = 10;
+
+    knp::core::MessageBus bus1 = knp::core::MessageBus::construct_shm_bus(segment_name, process_count);
+    knp::core::MessageBus bus2 = knp::core::MessageBus::construct_shm_bus(segment_name, process_count);
+
+    const knp::core::UID sender1, sender2;
+
+    auto run_process = [steps_count](knp::core::MessageBus &bus, const knp::core::UID &sender,
+                                     const knp::core::UID &peer, uint32_t spike_index)
+    {
+        auto endpoint{bus.create_endpoint()};
+        const knp::core::UID receiver;
+        endpoint.subscribe<SpikeMessage>(receiver, {peer});
+
+        size_t received_count = 0;
+        for (size_t step = 0; step < steps_count; ++step)
+        {
+            endpoint.send_message(SpikeMessage{{sender, step}, {spike_index}});
+            bus.route_messages();
+            endpoint.receive_all_messages();
+            for (const auto &msg : endpoint.unload_messages<SpikeMessage>(receiver))
+            {
+                const knp::core::messaging::SpikeData expected_spikes{1 - spike_index};
+                if (msg.header_.send_time_ == step && msg.neuron_indexes_ == expected_spikes) ++received_count;
+            }
+        }
+        return received_count;
+    };
+
+    // Each thread works as a separate process.
+    auto future = std::async(std::launch::async, run_process, std::ref(bus2), sender2, sender1, 1);
+    const auto received_count = run_process(bus1, sender1, sender2, 0);
+
+    EXPECT_EQ(received_count, steps_count);
+    EXPECT_EQ(future.get(), steps_count);
+}
+
+
+TEST(MessageBusSuite, BufferOverflowFailsAllProcessesSHM)
+{
+    using SpikeMessage = knp::core::messaging::SpikeMessage;
+    const std::string segment_name = "knp_test_" + std::string(knp::core::UID());
+    constexpr size_t process_count = 2;
+    constexpr size_t max_endpoints = 2;
+    constexpr size_t buffer_size = 256;
+
+    knp::core::MessageBus bus1 =
+        knp::core::MessageBus::construct_shm_bus(segment_name, process_count, max_endpoints, buffer_size);
+    knp::core::MessageBus bus2 =
+        knp::core::MessageBus::construct_shm_bus(segment_name, process_count, max_endpoints, buffer_size);
+    auto endpoint{bus1.create_endpoint()};
+    // Unsorted spikes aren't compressed, so the message doesn't fit the buffer.
+    knp::core::messaging::SpikeData spikes(1000);
+    for (uint32_t index = 0; index < spikes.size(); ++index) spikes[index] = (index * 7919) % 1000;
+    endpoint.send_message(SpikeMessage{{knp::core::UID{}}, spikes});
+
+    // The process that has nothing to send doesn't wait for the failed one forever.
+    auto future = std::async(std::launch::async, [&bus2]() { return bus2.route_messages(); });
+    EXPECT_THROW(bus1.route_messages(), std::runtime_error);
+    EXPECT_THROW(future.get(), std::runtime_error);
+    // The segment stays failed.
+    EXPECT_THROW(bus1.route_messages(), std::runtime_error);
+}
+
+
+#if !defined(_WIN32)
+TEST(MessageBusSuite, RecreateStaleSegmentSHM)
+{
+    const std::string segment_name = "knp_test_" + std::string(knp::core::UID());
+
+    // The child process stops without detaching, as if it crashed.
+    const pid_t child = fork();
+    ASSERT_NE(child, -1);
+    if (!child)
+    {
+        new knp::core::MessageBus(knp::core::MessageBus::construct_shm_bus(segment_name));
+        _exit(0);
+    }
+    int status = 0;
+    ASSERT_EQ(waitpid(child, &status, 0), child);
+    ASSERT_TRUE(WIFEXITED(status));
+
+    // The segment is already used by a single process, but that process is stopped.
+    knp::core::MessageBus bus = knp::core::MessageBus::construct_shm_bus(segment_name);
+    auto endpoint{bus.create_endpoint()};
+    const knp::core::UID sender, receiver;
+    endpoint.subscribe<knp::core::messaging::SpikeMessage>(receiver, {sender});
+    endpoint.send_message(knp::core::messaging::SpikeMessage{{sender}, {1}});
+    bus.route_messages();
+    endpoint.receive_all_messages();
+    EXPECT_EQ(endpoint.unload_messages<knp::core::messaging::SpikeMessage>(receiver).size(), 1);
+}
+#endif
+
+
 TEST(MessageBusSuite, SynapticImpactMessageSendZMQ)
 {
     using SynapticImpactMessage = knp::core::messaging::SynapticImpactMessage;
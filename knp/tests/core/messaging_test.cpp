@@ -24,6 +24,7 @@
 
 #include <tests_common.h>
 
+#include <limits>
 #include <sstream>
 
 
@@ -96,3 +97,42 @@ TEST(MessageSuite, HeaderIOTest)
     ASSERT_EQ(header_in.sender_uid_, header_out.sender_uid_);
     ASSERT_EQ(header_in.send_time_, header_out.send_time_);
 }
+
+
+TEST(MessageSuite, SpikeEncodingTest)
+{
+    namespace kcm = knp::core::messaging;
+
+    // Dense spikes are stored as a bitset.
+    kcm::SpikeData dense(100);
+    for (uint32_t index = 0; index < dense.size(); ++index) dense[index] = index * 2;
+    const auto dense_encoded = kcm::encode_spikes(dense);
+    ASSERT_EQ(dense_encoded.encoding_, kcm::SpikeEncoding::bitset);
+    ASSERT_LT(dense_encoded.data_.size(), dense.size() * sizeof(kcm::SpikeIndex));
+    ASSERT_EQ(kcm::decode_spikes(dense_encoded), dense);
+
+    // Sparse spikes with large indexes are stored as deltas.
+    const kcm::SpikeData sparse{10, 300, 100000, 100001, 4000000000};
+    const auto sparse_encoded = kcm::encode_spikes(sparse);
+    ASSERT_EQ(sparse_encoded.encoding_, kcm::SpikeEncoding::delta_varint);
+    ASSERT_EQ(kcm::decode_spikes(sparse_encoded), sparse);
+
+    // Unsorted spikes keep their order.
+    const kcm::SpikeData unsorted{5, 1, 3};
+    ASSERT_EQ(kcm::choose_spike_encoding(unsorted), kcm::SpikeEncoding::raw);
+    ASSERT_EQ(kcm::decode_spikes(kcm::encode_spikes(unsorted)), unsorted);
+    kcm::EncodedSpikeData encoded;
+    ASSERT_THROW(kcm::encode_spikes(unsorted, kcm::SpikeEncoding::bitset, encoded), std::invalid_argument);
+
+    kcm::SpikeData iterated;
+    kcm::for_each_spike(sparse_encoded, [&iterated](kcm::SpikeIndex index) { iterated.push_back(index); });
+    ASSERT_EQ(iterated, sparse);
+
+    // Spike count of a broken message doesn't make decoding reserve more than the buffer can contain.
+    auto broken = sparse_encoded;
+    broken.spike_count_ = std::numeric_limits<uint32_t>::max();
+    ASSERT_LE(sparse.size(), kcm::get_max_spike_count(broken.encoding_, broken.data_.size()));
+    ASSERT_EQ(kcm::decode_spikes(broken), sparse);
+    ASSERT_EQ(kcm::get_max_spike_count(kcm::SpikeEncoding::raw, 10), 2);
+    ASSERT_EQ(kcm::get_max_spike_count(kcm::SpikeEncoding::bitset, 2), 16);
+}
@@ -66,6 +66,13 @@ TEST(PopulationSuite, RemoveNeurons)
     population.remove_neurons(indexes_to_remove);
 
     ASSERT_EQ(population.size(), prev_size - indexes_to_remove.size());
+
+    // Indexes may be unsorted, the order of the remaining neurons is kept.
+    population[2].potential_ = 2;
+    population[3].potential_ = 3;
+    population.remove_neurons({3, 0, 1});
+    ASSERT_EQ(population.size(), prev_size - indexes_to_remove.size() - 3);
+    ASSERT_EQ(population[0].potential_, 2);
 }
 
 
@@ -81,3 +88,17 @@ TEST(PopulationSuite, SetNeuronParameter)
 
     ASSERT_EQ(150, population[p_index].potential_);
 }
+
+
+TEST(PopulationSuite, CreateFromParameters)
+{
+    std::vector<BLIFATParams> neurons(neurons_count);
+    for (size_t index = 0; index < neurons.size(); ++index) neurons[index] = neuron_generator(index);
+
+    knp::core::Population<knp::neuron_traits::BLIFATNeuron> population(std::move(neurons));
+    population.add_neurons(std::vector<BLIFATParams>(2));
+
+    ASSERT_EQ(population.size(), neurons_count + 2);
+    ASSERT_EQ(population[neurons_count - 1].potential_, neurons_count - 1);
+    ASSERT_EQ(population[neurons_count].potential_, BLIFATParams{}.potential_);
+}
@@ -24,8 +24,15 @@
 
 #include <tests_common.h>
 
+#include <algorithm>
 #include <cstdlib>
+#include <iterator>
 #include <optional>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <variant>
+#include <vector>
 
 
 namespace knc = knp::core;
@@ -218,6 +225,93 @@ TEST(ProjectionSuite, SynapseRemoval)
 }
 
 
+TEST(ProjectionSuite, IncrementalIndex)
+{
+    const SynapseParameters params{0, 1, knp::synapse_traits::OutputType::EXCITATORY};
+    DeltaProjection projection{knc::UID{}, knc::UID{}};
+    ASSERT_TRUE(projection.get_synapse_indexes(0, DeltaProjection::Search::by_presynaptic).empty());
+
+    projection.add_synapses(std::vector<Synapse>{{params, 0, 1}, {params, 1, 1}, {params, 0, 2}});
+    projection.add_synapses(std::vector<Synapse>{{params, 2, 1}, {params, 0, 0}});
+
+    using Indexes = std::vector<size_t>;
+    ASSERT_EQ(projection.find_synapses(0, DeltaProjection::Search::by_presynaptic), (Indexes{0, 2, 4}));
+    ASSERT_EQ(projection.find_synapses(1, DeltaProjection::Search::by_postsynaptic), (Indexes{0, 1, 3}));
+    ASSERT_TRUE(projection.find_synapses(10, DeltaProjection::Search::by_postsynaptic).empty());
+
+    // Indexes of the following synapses are shifted.
+    projection.remove_synapse(1);
+    ASSERT_EQ(projection.find_synapses(0, DeltaProjection::Search::by_presynaptic), (Indexes{0, 1, 3}));
+    ASSERT_EQ(projection.find_synapses(1, DeltaProjection::Search::by_postsynaptic), (Indexes{0, 2}));
+    ASSERT_TRUE(projection.find_synapses(1, DeltaProjection::Search::by_presynaptic).empty());
+
+    ASSERT_EQ(projection.remove_presynaptic_neuron_synapses(0), 3);
+    ASSERT_EQ(projection.find_synapses(2, DeltaProjection::Search::by_presynaptic), (Indexes{0}));
+    ASSERT_EQ(projection.find_synapses(1, DeltaProjection::Search::by_postsynaptic), (Indexes{0}));
+}
+
+
+TEST(ProjectionSuite, BulkRemoval)
+{
+    const SynapseParameters params{0, 1, knp::synapse_traits::OutputType::EXCITATORY};
+    DeltaProjection projection{
+        knc::UID{}, knc::UID{},
+        std::vector<Synapse>{{params, 0, 0}, {params, 0, 1}, {params, 1, 2}, {params, 2, 0}, {params, 2, 2}}};
+
+    // Indexes may be unsorted and repeated.
+    ASSERT_EQ(projection.remove_synapses({3, 0, 3}), 2);
+    ASSERT_EQ(projection.size(), 3);
+    ASSERT_EQ(std::get<knp::core::target_neuron_id>(projection[0]), 1);
+    ASSERT_EQ(std::get<knp::core::target_neuron_id>(projection[1]), 2);
+    ASSERT_EQ(projection.find_synapses(2, DeltaProjection::Search::by_postsynaptic), (std::vector<size_t>{1, 2}));
+    ASSERT_THROW(projection.remove_synapses({3}), std::out_of_range);
+
+    // Neuron #1 is removed from the presynaptic population, neuron #2 takes its index.
+    ASSERT_EQ(projection.remove_presynaptic_neurons({1}), 1);
+    ASSERT_EQ(projection.size(), 2);
+    ASSERT_EQ(std::get<knp::core::source_neuron_id>(projection[1]), 1);
+    ASSERT_EQ(projection.find_synapses(1, DeltaProjection::Search::by_presynaptic), (std::vector<size_t>{1}));
+    ASSERT_TRUE(projection.find_synapses(2, DeltaProjection::Search::by_presynaptic).empty());
+
+    ASSERT_EQ(projection.remove_postsynaptic_neurons({0, 1}), 1);
+    ASSERT_EQ(projection.size(), 1);
+    ASSERT_EQ(std::get<knp::core::target_neuron_id>(projection[0]), 0);
+    ASSERT_EQ(projection.find_synapses(0, DeltaProjection::Search::by_postsynaptic), (std::vector<size_t>{0}));
+}
+
+
+TEST(ProjectionSuite, ConcurrentSearch)
+{
+    const uint32_t neurons_count = 100;
+    const DeltaProjection projection{
+        knc::UID{}, knc::UID{},
+        make_dense_generator({neurons_count, neurons_count}, {0, 1, knp::synapse_traits::OutputType::EXCITATORY}),
+        neurons_count * neurons_count};
+
+    std::vector<size_t> errors(4);
+    std::vector<std::thread> threads;
+    for (size_t thread_index = 0; thread_index < errors.size(); ++thread_index)
+    {
+        threads.emplace_back(
+            [&projection, &errors, thread_index]()
+            {
+                for (size_t neuron = 0; neuron < neurons_count; ++neuron)
+                {
+                    for (auto synapse_index :
+                         projection.get_synapse_indexes(neuron, DeltaProjection::Search::by_postsynaptic))
+                    {
+                        if (std::get<knp::core::target_neuron_id>(projection[synapse_index]) != neuron)
+                            ++errors[thread_index];
+                    }
+                }
+            });
+    }
+    for (auto &thread : threads) thread.join();
+
+    for (auto thread_errors : errors) ASSERT_EQ(thread_errors, 0);
+}
+
+
 TEST(ProjectionSuite, LockTest)
 {
     DeltaProjection projection(knc::UID{}, knc::UID{});
@@ -268,3 +362,158 @@ TEST(ProjectionSuite, GetUIDTest)
     ASSERT_EQ(projection.get_presynaptic(), uid_from);
     ASSERT_EQ(projection.get_postsynaptic(), uid_to);
 }
+
+
+TEST(ProjectionSuite, FromArrays)
+{
+    const std::vector<size_t> sources{0, 0, 1, 2};
+    const std::vector<size_t> targets{1, 2, 2, 0};
+    const std::vector<float> weights{0.5F, 1.F, 1.5F, 2.F};
+
+    const auto projection = DeltaProjection::from_arrays(
+        knc::UID{}, knc::UID{}, sources, targets, weights, {},
+        SynapseParameters{0, 3, knp::synapse_traits::OutputType::INHIBITORY_CURRENT});
+
+    ASSERT_EQ(projection.size(), sources.size());
+    for (size_t index = 0; index < projection.size(); ++index)
+    {
+        const auto &[params, source, target] = projection[index];
+        ASSERT_EQ(source, sources[index]);
+        ASSERT_EQ(target, targets[index]);
+        ASSERT_EQ(params.weight_, weights[index]);
+        ASSERT_EQ(params.delay_, 3);
+        ASSERT_EQ(params.output_type_, knp::synapse_traits::OutputType::INHIBITORY_CURRENT);
+    }
+
+    ASSERT_EQ(projection.find_synapses(0, DeltaProjection::Search::by_presynaptic).size(), 2);
+    ASSERT_EQ(projection.find_synapses(2, DeltaProjection::Search::by_postsynaptic).size(), 2);
+
+    ASSERT_THROW(
+        DeltaProjection::from_arrays(knc::UID{}, knc::UID{}, sources, {1}, weights, {}), std::invalid_argument);
+}
+
+
+TEST(ProjectionSuite, DenseBlock)
+{
+    const std::vector<float> weights{1.F, 2.F, 3.F, 4.F, 5.F, 6.F};
+    auto projection = DeltaProjection::make_dense(
+        knc::UID{}, knc::UID{}, 2, 3, weights, {}, SynapseParameters{0, 2, knp::synapse_traits::OutputType::DOPAMINE});
+
+    ASSERT_TRUE(projection.is_compact());
+    ASSERT_EQ(projection.size(), weights.size());
+    const auto explicit_projection = DeltaProjection::from_arrays(
+        knc::UID{}, knc::UID{}, {0, 0, 0, 1, 1, 1}, {0, 1, 2, 0, 1, 2}, weights, {},
+        SynapseParameters{0, 2, knp::synapse_traits::OutputType::DOPAMINE});
+    for (size_t index = 0; index < projection.size(); ++index)
+    {
+        const auto [params, source, target] = projection.get_synapse(index);
+        const auto &[expected_params, expected_source, expected_target] = explicit_projection[index];
+        ASSERT_EQ(
+            std::make_tuple(source, target, params.weight_, params.delay_, params.output_type_),
+            std::make_tuple(
+                expected_source, expected_target, expected_params.weight_, expected_params.delay_,
+                expected_params.output_type_));
+    }
+    ASSERT_EQ(projection.find_synapses(1, DeltaProjection::Search::by_presynaptic), (std::vector<size_t>{3, 4, 5}));
+    ASSERT_EQ(projection.find_synapses(2, DeltaProjection::Search::by_postsynaptic), (std::vector<size_t>{2, 5}));
+    ASSERT_THROW(projection.get_synapse(6), std::out_of_range);
+    ASSERT_THROW(std::as_const(projection).begin(), std::logic_error);  //!OCLINT(False positive)
+    // Mutable access doesn't convert the projection silently.
+    ASSERT_THROW(projection.begin(), std::logic_error);  //!OCLINT(False positive)
+    ASSERT_THROW(projection[0], std::logic_error);       //!OCLINT(False positive)
+    ASSERT_TRUE(projection.is_compact());
+    size_t view_index = 0;
+    for (const auto &synapse : projection.get_synapses())
+    {
+        const auto &expected_synapse = explicit_projection[view_index++];
+        ASSERT_EQ(std::get<knc::source_neuron_id>(synapse), std::get<knc::source_neuron_id>(expected_synapse));
+        ASSERT_EQ(std::get<knc::target_neuron_id>(synapse), std::get<knc::target_neuron_id>(expected_synapse));
+    }
+    ASSERT_EQ(view_index, projection.size());
+
+    // Weights are changed in place, synapse changes convert the projection to explicit synapses.
+    projection.get_block_weights()[4] = 10.F;
+    ASSERT_EQ(projection.remove_postsynaptic_neuron_synapses(0), 2);
+    ASSERT_FALSE(projection.is_compact());
+    ASSERT_EQ(projection.size(), 4);
+    ASSERT_EQ(std::get<knc::synapse_data>(projection[2]).weight_, 10.F);
+    ASSERT_EQ(projection.find_synapses(1, DeltaProjection::Search::by_presynaptic), (std::vector<size_t>{2, 3}));
+
+    ASSERT_THROW(DeltaProjection::make_dense(knc::UID{}, knc::UID{}, 2, 2, weights), std::invalid_argument);
+}
+
+
+TEST(ProjectionSuite, KernelBlock)
+{
+    // A 3x4 grid, a 2x2 kernel with the stride 2 gives a 1x2 output grid.
+    const knc::KernelBlock block{3, 4, 2, 2, 2};
+    const std::vector<float> kernel{1.F, 2.F, 3.F, 4.F};
+    const std::vector<uint32_t> delays{1, 2, 3, 4};
+    auto projection = DeltaProjection::make_kernel(knc::UID{}, knc::UID{}, block, kernel, delays);
+
+    ASSERT_EQ(block.get_postsynaptic_size(), 2);
+    ASSERT_EQ(projection.size(), 8);
+    const std::vector<size_t> sources{0, 1, 4, 5, 2, 3, 6, 7};
+    for (size_t index = 0; index < projection.size(); ++index)
+    {
+        const auto [params, source, target] = projection.get_synapse(index);
+        ASSERT_EQ(source, sources[index]);
+        ASSERT_EQ(target, index / kernel.size());
+        ASSERT_EQ(params.weight_, kernel[index % kernel.size()]);
+        ASSERT_EQ(params.delay_, delays[index % kernel.size()]);
+    }
+
+    // The search gives the same synapses as the explicit projection.
+    auto explicit_projection = projection;
+    explicit_projection.materialize();
+    ASSERT_FALSE(explicit_projection.is_compact());
+    for (size_t neuron = 0; neuron < block.get_presynaptic_size(); ++neuron)
+    {
+        for (const auto search : {DeltaProjection::Search::by_presynaptic, DeltaProjection::Search::by_postsynaptic})
+        {
+            ASSERT_EQ(projection.find_synapses(neuron, search), explicit_projection.find_synapses(neuron, search));
+        }
+    }
+
+    // Visiting a range of synapses gives the same synapses as filtering all synapses of a neuron.
+    const auto get_range_synapses = [](const auto &synapse_block, size_t neuron, size_t first, size_t last)
+    {
+        std::vector<size_t> result;
+        synapse_block.for_each_postsynaptic(
+            neuron, first, last, [&result](size_t synapse_index, size_t, size_t) { result.push_back(synapse_index); });
+        return result;
+    };
+    const knc::DenseBlock dense_block{3, 4};
+    for (const auto &synapse_block : std::vector<knc::SynapseBlock>{block, dense_block})
+    {
+        std::visit(
+            [&get_range_synapses](const auto &typed_block)
+            {
+                const size_t synapse_count = typed_block.get_synapse_count();
+                for (size_t neuron = 0; neuron < 12; ++neuron)
+                {
+                    std::vector<size_t> all_synapses;
+                    typed_block.for_each_postsynaptic(
+                        neuron, [&all_synapses](size_t synapse_index, size_t, size_t)
+                        { all_synapses.push_back(synapse_index); });
+                    for (size_t first = 0; first <= synapse_count; ++first)
+                    {
+                        for (size_t last = first; last <= synapse_count + 1; ++last)
+                        {
+                            std::vector<size_t> expected;
+                            std::copy_if(
+                                all_synapses.begin(), all_synapses.end(), std::back_inserter(expected),
+                                [first, last](size_t index) { return index >= first && index < last; });
+                            ASSERT_EQ(get_range_synapses(typed_block, neuron, first, last), expected);
+                        }
+                    }
+                }
+            },
+            synapse_block);
+    }
+
+    ASSERT_THROW(  //!OCLINT(False positive)
+        DeltaProjection::make_kernel(knc::UID{}, knc::UID{}, {3, 4, 2, 2, 0}, kernel), std::invalid_argument);
+    ASSERT_THROW(  //!OCLINT(False positive)
+        DeltaProjection::make_kernel(knc::UID{}, knc::UID{}, block, kernel, {1}), std::invalid_argument);
+}
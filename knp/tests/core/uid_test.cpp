@@ -19,10 +19,15 @@
  * limitations under the License.
  */
 
+#include <knp/core/messaging/messaging.h>
+#include <knp/core/subscription.h>
 #include <knp/core/uid.h>
+#include <knp/core/uid_registry.h>
 
 #include <tests_common.h>
 
+#include <memory>
+
 
 TEST(UidSuite, UidGenerator)
 {
@@ -87,3 +92,72 @@ TEST(UidSuite, UidHash)
     uid_container[uid1] = uid1;
     ASSERT_EQ(uid_container[uid1], uid1);
 }
+
+
+
+TEST(UidSuite, UidRegistry)
+{
+    knp::core::UIDRegistry registry;
+    const knp::core::UID uid1, uid2;
+
+    ASSERT_EQ(registry.find(uid1), knp::core::UIDRegistry::invalid_handle);
+
+    // Handles are dense and don't change when a UID is registered again.
+    ASSERT_EQ(registry.intern(uid1), 0);
+    ASSERT_EQ(registry.intern(uid2), 1);
+    ASSERT_EQ(registry.intern(uid1), 0);
+    ASSERT_EQ(registry.size(), 2);
+
+    ASSERT_EQ(registry.find(uid2), 1);
+    ASSERT_EQ(registry.get_uid(1), uid2);
+    EXPECT_THROW(std::ignore = registry.get_uid(2), std::out_of_range);  //!OCLINT(False positive)
+
+    // The UID is removed after it is released as many times as it was registered.
+    const auto version = registry.get_version();
+    registry.release(0);
+    ASSERT_EQ(registry.find(uid1), 0);
+    registry.release(0);
+    ASSERT_EQ(registry.find(uid1), knp::core::UIDRegistry::invalid_handle);
+    ASSERT_EQ(registry.size(), 1);
+    ASSERT_NE(registry.get_version(), version);
+    EXPECT_THROW(registry.release(0), std::out_of_range);  //!OCLINT(False positive)
+
+    // Handles of removed UIDs are reused.
+    const knp::core::UID uid3;
+    ASSERT_EQ(registry.intern(uid3), 0);
+}
+
+
+TEST(UidSuite, UidRegistryShrinksWithSubscriptions)
+{
+    auto registry = std::make_shared<knp::core::UIDRegistry>();
+    const knp::core::UID receiver, sender1, sender2;
+    {
+        knp::core::Subscription<knp::core::messaging::SpikeMessage> subscription{registry, receiver, {sender1}};
+        subscription.add_sender(sender2);
+        ASSERT_EQ(registry->size(), 3);
+
+        const auto copy = subscription;
+        subscription.remove_sender(sender1);
+        // The copy still has the removed sender.
+        ASSERT_EQ(registry->size(), 3);
+    }
+    ASSERT_EQ(registry->size(), 0);
+}
+
+
+TEST(UidSuite, SubscriptionsShareRegistry)
+{
+    // Subscriptions created outside endpoints don't allocate a registry each.
+    const auto registry = knp::core::UIDRegistry::get_shared();
+    const size_t initial_size = registry->size();
+    const knp::core::UID receiver1, receiver2, sender;
+    {
+        const knp::core::Subscription<knp::core::messaging::SpikeMessage> subscription1{receiver1, {sender}};
+        const knp::core::Subscription<knp::core::messaging::SpikeMessage> subscription2{receiver2, {sender}};
+        ASSERT_EQ(registry->size(), initial_size + 3);
+        ASSERT_NE(subscription1.get_receiver_handle(), subscription2.get_receiver_handle());
+        ASSERT_EQ(registry->find(receiver2), subscription2.get_receiver_handle());
+    }
+    ASSERT_EQ(registry->size(), initial_size);
+}
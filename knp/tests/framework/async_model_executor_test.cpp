@@ -0,0 +1,169 @@
+/**
+ * @file async_model_executor_test.cpp
+ * @brief Asynchronous model executor testing.
+ * @kaspersky_support Artiom N.
+ * @date 18.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <knp/backends/cpu-single-threaded/backend.h>
+#include <knp/framework/async_model_executor.h>
+#include <knp/framework/network.h>
+
+#include <generators.h>
+#include <tests_common.h>
+
+#include <thread>
+#include <vector>
+
+
+TEST(FrameworkSuite, SpikeInputQueue)
+{
+    knp::framework::io::SpikeInputQueue queue(64);
+    constexpr size_t threads_count = 4;
+    constexpr size_t pushes_count = 16;
+
+    std::vector<std::thread> threads;
+    for (size_t thread_index = 0; thread_index < threads_count; ++thread_index)
+    {
+        threads.emplace_back(
+            [&queue, thread_index]()
+            {
+                for (size_t push_index = 0; push_index < pushes_count; ++push_index)
+                {
+                    ASSERT_TRUE(queue.push(push_index, {static_cast<knp::core::messaging::SpikeIndex>(thread_index)}));
+                }
+            });
+    }
+    for (auto &thread : threads) thread.join();
+    // The queue is full.
+    ASSERT_FALSE(queue.push(0, {}));
+
+    std::vector<size_t> pushed_by_thread(threads_count);
+    knp::core::Step step = 0;
+    knp::core::messaging::SpikeData spikes;
+    while (queue.pop(step, spikes))
+    {
+        ASSERT_EQ(spikes.size(), 1);
+        // Spikes of a thread are popped in the order they were pushed.
+        ASSERT_EQ(step, pushed_by_thread[spikes[0]]++);
+    }
+    ASSERT_EQ(pushed_by_thread, std::vector<size_t>(threads_count, pushes_count));
+    ASSERT_TRUE(queue.push(0, {}));
+}
+
+
+TEST(FrameworkSuite, SpikeOutputRing)
+{
+    const knp::core::UID sender_uid;
+    knp::framework::io::SpikeOutputRing ring({sender_uid}, 3, 2);
+    auto slow_reader = ring.create_reader();
+
+    for (knp::core::Step step = 0; step < 3; ++step) ring.write({{sender_uid, step}, {1, 2}});
+    EXPECT_THROW(ring.write({{knp::core::UID{}, 3}, {1}}), std::logic_error);
+    EXPECT_THROW(ring.write({{sender_uid, 3}, {1, 2, 3, 4}}), std::logic_error);
+
+    auto late_reader = ring.create_reader();
+    knp::core::messaging::SpikeMessage message;
+    ASSERT_FALSE(late_reader.read(message));
+
+    // The first message was overwritten.
+    std::vector<knp::core::Step> steps;
+    while (slow_reader.read(message))
+    {
+        ASSERT_EQ(message.header_.sender_uid_, sender_uid);
+        ASSERT_EQ(message.neuron_indexes_, knp::core::messaging::SpikeData({1, 2}));
+        steps.push_back(message.header_.send_time_);
+    }
+    ASSERT_EQ(steps, std::vector<knp::core::Step>({1, 2}));
+    ASSERT_EQ(slow_reader.get_lost_count(), 1);
+
+    ring.write({{sender_uid, 3}, {}});
+    ASSERT_TRUE(late_reader.read(message));
+    ASSERT_EQ(message.header_.send_time_, 3);
+    ASSERT_TRUE(message.neuron_indexes_.empty());
+}
+
+
+TEST(FrameworkSuite, AsyncModelExecutor)
+{
+    namespace kt = knp::testing;
+
+    kt::BLIFATPopulation population{kt::neuron_generator, 1};
+    kt::DeltaProjection loop_projection =
+        kt::DeltaProjection{population.get_uid(), population.get_uid(), kt::synapse_generator, 1};
+    kt::DeltaProjection input_projection =
+        kt::DeltaProjection{knp::core::UID{false}, population.get_uid(), kt::input_projection_gen, 1};
+
+    const knp::core::UID input_uid = input_projection.get_uid();
+    const knp::core::UID output_uid = population.get_uid();
+
+    knp::framework::Network network;
+    network.add_population(std::move(population));
+    network.add_projection<kt::DeltaProjection>(std::move(input_projection));
+    network.add_projection<kt::DeltaProjection>(std::move(loop_projection));
+
+    const knp::core::UID i_channel_uid, o_channel_uid;
+    knp::framework::Model model(std::move(network));
+    model.add_input_channel(i_channel_uid, input_uid);
+    model.add_output_channel(o_channel_uid, output_uid);
+
+    knp::framework::AsyncModelExecutor executor(
+        model, knp::backends::single_threaded_cpu::SingleThreadedCPUBackend::create());
+    auto reader = executor.create_output_reader(o_channel_uid);
+    EXPECT_THROW(executor.step_n(1), std::logic_error);
+
+    executor.start(true);
+    ASSERT_TRUE(executor.is_paused());
+
+    // Sensor threads push spikes for future steps while the executor waits.
+    std::thread first_sensor(
+        [&executor, &i_channel_uid]()
+        {
+            executor.push_spikes(i_channel_uid, 0, {0});
+            executor.push_spikes(i_channel_uid, 10, {0});
+        });
+    std::thread second_sensor(
+        [&executor, &i_channel_uid]()
+        {
+            executor.push_spikes(i_channel_uid, 5, {0});
+            executor.push_spikes(i_channel_uid, 15, {0});
+        });
+    first_sensor.join();
+    second_sensor.join();
+
+    executor.step_n(12);
+    ASSERT_TRUE(executor.is_paused());
+    // Spikes pushed for a step that has already started are counted as late.
+    executor.push_spikes(i_channel_uid, 3, {});
+    executor.set_step_period(std::chrono::milliseconds(1));
+    executor.step_n(8);
+    executor.stop();
+
+    std::vector<knp::core::Step> results;
+    knp::core::messaging::SpikeMessage message;
+    while (reader.read(message)) results.push_back(message.header_.send_time_);
+
+    const std::vector<knp::core::Step> expected_results = {1, 6, 7, 11, 12, 13, 16, 17, 18, 19};
+    ASSERT_EQ(results, expected_results);
+    ASSERT_EQ(reader.get_lost_count(), 0);
+    ASSERT_EQ(executor.get_backend()->get_step(), 20);
+
+    const auto statistics = executor.get_pacing_statistics();
+    ASSERT_EQ(statistics.steps_, 20);
+    ASSERT_EQ(statistics.late_inputs_, 1);
+    ASSERT_LE(statistics.max_overrun_, statistics.total_overrun_);
+}
@@ -0,0 +1,176 @@
+/**
+ * @file checkpoint_test.cpp
+ * @brief Checkpoint tests.
+ * @kaspersky_support Artiom N.
+ * @date 18.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <knp/backends/cpu-single-threaded/backend.h>
+#include <knp/framework/checkpoint.h>
+
+#include <generators.h>
+#include <tests_common.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <vector>
+
+
+namespace knp::testing
+{
+class STestingBack : public knp::backends::single_threaded_cpu::SingleThreadedCPUBackend
+{
+public:
+    STestingBack() = default;
+    void _init() override { knp::backends::single_threaded_cpu::SingleThreadedCPUBackend::_init(); }
+};
+}  // namespace knp::testing
+
+
+namespace
+{
+void expect_equal_states(
+    const std::vector<knp::core::EntityState> &first, const std::vector<knp::core::EntityState> &second)
+{
+    ASSERT_EQ(first.size(), second.size());
+    for (const auto &state : first)
+    {
+        const auto other = std::find_if(
+            second.begin(), second.end(), [&state](const auto &other_state) { return other_state.uid_ == state.uid_; });
+        ASSERT_NE(other, second.end());
+        ASSERT_EQ(state.values_, other->values_);
+        ASSERT_EQ(state.pending_impacts_.size(), other->pending_impacts_.size());
+        for (size_t i = 0; i < state.pending_impacts_.size(); ++i)
+        {
+            ASSERT_EQ(state.pending_impacts_[i].first, other->pending_impacts_[i].first);
+            ASSERT_EQ(state.pending_impacts_[i].second, other->pending_impacts_[i].second);
+        }
+    }
+}
+}  // namespace
+
+
+TEST(CheckpointSuite, IncrementalCheckpoints)
+{
+    const std::filesystem::path directory = "checkpoints";
+    std::filesystem::remove_all(directory);
+
+    // Create a single-neuron neural network: input -> input_projection -> population <=> loop_projection.
+    knp::testing::BLIFATPopulation population{knp::testing::neuron_generator, 1};
+    const knp::testing::DeltaProjection loop_projection{
+        population.get_uid(), population.get_uid(), knp::testing::synapse_generator, 1};
+    const knp::testing::DeltaProjection input_projection{
+        knp::core::UID{false}, population.get_uid(), knp::testing::input_projection_gen, 1};
+
+    knp::testing::STestingBack backend;
+    backend.load_populations({population});
+    backend.load_projections({input_projection, loop_projection});
+    backend._init();
+    // Loop impacts are sent through the message queue.
+    backend.require_bus_messages({loop_projection.get_uid()});
+
+    auto endpoint = backend.get_message_bus().create_endpoint();
+    const knp::core::UID in_channel_uid;
+    backend.subscribe<knp::core::messaging::SpikeMessage>(input_projection.get_uid(), {in_channel_uid});
+
+    knp::core::DynamicState last_state;
+    {
+        knp::framework::CheckpointWriter writer{directory};
+        for (knp::core::Step step = 0; step < 9; ++step)
+        {
+            if (step % 5 == 0) endpoint.send_message(knp::core::messaging::SpikeMessage{{in_channel_uid, step}, {0}});
+            backend._step();
+            if (0 == (step + 1) % 3) writer.save(backend);
+        }
+        writer.wait();
+        last_state = backend.get_dynamic_state();
+    }
+
+    // The first checkpoint is full, next ones are incremental.
+    ASSERT_TRUE(std::filesystem::is_regular_file(directory / "checkpoint_3.h5"));
+    ASSERT_TRUE(std::filesystem::is_regular_file(directory / "checkpoint_9.h5"));
+
+    const auto state = knp::framework::read_checkpoint(directory);
+    ASSERT_EQ(state.step_, 9);
+    expect_equal_states(state.populations_, last_state.populations_);
+    expect_equal_states(state.projections_, last_state.projections_);
+    // Loop projection has pending impacts of spikes at steps 6 and 7.
+    const auto loop_uid = loop_projection.get_uid();
+    const auto loop_state = std::find_if(
+        state.projections_.begin(), state.projections_.end(),
+        [&loop_uid](const auto &projection_state) { return projection_state.uid_ == loop_uid; });
+    ASSERT_NE(loop_state, state.projections_.end());
+    ASSERT_FALSE(loop_state->pending_impacts_.empty());
+
+    ASSERT_EQ(knp::framework::read_checkpoint(directory, 6).step_, 6);
+    ASSERT_THROW(knp::framework::read_checkpoint(directory, 5), std::runtime_error);
+
+    knp::testing::STestingBack restored_backend;
+    restored_backend.load_populations({population});
+    restored_backend.load_projections({input_projection, loop_projection});
+    knp::framework::restore_checkpoint(restored_backend, directory);
+    ASSERT_EQ(restored_backend.get_step(), 9);
+    const auto restored_state = restored_backend.get_dynamic_state();
+    expect_equal_states(restored_state.populations_, last_state.populations_);
+    expect_equal_states(restored_state.projections_, last_state.projections_);
+
+    std::filesystem::remove_all(directory);
+}
+
+
+TEST(CheckpointSuite, IncrementalCheckpointsOfChangedValues)
+{
+    const std::filesystem::path directory = "changed_value_checkpoints";
+    std::filesystem::remove_all(directory);
+
+    // Only the first neuron of the population receives input, so incremental checkpoints write some values of
+    // parameters together with their indexes.
+    knp::testing::BLIFATPopulation population{knp::testing::neuron_generator, 16};
+    const knp::testing::DeltaProjection input_projection{
+        knp::core::UID{false}, population.get_uid(), knp::testing::input_projection_gen, 1};
+
+    knp::testing::STestingBack backend;
+    backend.load_populations({population});
+    backend.load_projections({input_projection});
+    backend._init();
+
+    auto endpoint = backend.get_message_bus().create_endpoint();
+    const knp::core::UID in_channel_uid;
+    backend.subscribe<knp::core::messaging::SpikeMessage>(input_projection.get_uid(), {in_channel_uid});
+
+    std::vector<knp::core::DynamicState> states;
+    {
+        knp::framework::CheckpointWriter writer{directory};
+        for (knp::core::Step step = 0; step < 8; ++step)
+        {
+            if (step % 3 == 0) endpoint.send_message(knp::core::messaging::SpikeMessage{{in_channel_uid, step}, {0}});
+            backend._step();
+            if (step % 2) continue;
+            writer.save(backend);
+            states.push_back(backend.get_dynamic_state());
+        }
+    }
+
+    for (const auto &expected_state : states)
+    {
+        const auto state = knp::framework::read_checkpoint(directory, expected_state.step_);
+        expect_equal_states(state.populations_, expected_state.populations_);
+        expect_equal_states(state.projections_, expected_state.projections_);
+    }
+
+    std::filesystem::remove_all(directory);
+}
@@ -20,6 +20,7 @@
  */
 
 #include <knp/core/messaging/messaging.h>
+#include <knp/framework/io/storage/native/data_storage_binary.h>
 #include <knp/framework/io/storage/native/data_storage_hdf5.h>
 #include <knp/framework/io/storage/native/data_storage_json.h>
 
@@ -90,6 +91,52 @@ TEST_F(SaveLoadDataSuite, Hdf5Test)
 }
 
 
+TEST_F(SaveLoadDataSuite, BinaryTest)
+{
+    file_path_ = "data.bin";
+    knp::framework::io::storage::native::save_messages_to_binary(messages_, file_path_);
+    ASSERT_EQ(messages_, knp::framework::io::storage::native::load_messages_from_binary(file_path_, uid_));
+}
+
+
+TEST_F(SaveLoadDataSuite, BinaryWrongSizeTest)
+{
+    file_path_ = "data.bin";
+    knp::framework::io::storage::native::save_messages_to_binary({}, file_path_);
+
+    // Counts are chosen so that the file size computed from them overflows and matches the real size.
+    const auto write_counts = [this](uint64_t steps_count, uint64_t spikes_count)
+    {
+        std::fstream file(file_path_, std::ios::in | std::ios::out | std::ios::binary);
+        // Counts follow the magic number, the version and the byte order mark.
+        file.seekp(16);
+        file.write(reinterpret_cast<const char *>(&steps_count), sizeof(steps_count));
+        file.write(reinterpret_cast<const char *>(&spikes_count), sizeof(spikes_count));
+    };
+    write_counts((uint64_t{1} << 61) - 1, 2);
+    ASSERT_THROW(
+        knp::framework::io::storage::native::load_messages_from_binary(file_path_, uid_), std::runtime_error);
+    write_counts(0, uint64_t{1} << 62);
+    ASSERT_THROW(
+        knp::framework::io::storage::native::load_messages_from_binary(file_path_, uid_), std::runtime_error);
+    write_counts(0, 0);
+    ASSERT_TRUE(knp::framework::io::storage::native::load_messages_from_binary(file_path_, uid_).empty());
+}
+
+
+TEST_F(SaveLoadDataSuite, ConvertToBinaryTest)
+{
+    const std::filesystem::path h5_path = "data.h5";
+    file_path_ = "data.bin";
+    knp::framework::io::storage::native::save_messages_to_h5(messages_, h5_path);
+    knp::framework::io::storage::native::convert_messages_to_binary(h5_path, file_path_);
+    std::filesystem::remove(h5_path);
+    ASSERT_EQ(messages_, knp::framework::io::storage::native::load_messages_from_binary(file_path_, uid_));
+    ASSERT_THROW(
+        knp::framework::io::storage::native::convert_messages_to_binary("data.txt", file_path_), std::runtime_error);
+}
+
+
 class WrongMagicNumberJsonSuite : public ::testing::Test
 {
 protected:
@@ -23,11 +23,16 @@
 #include <knp/core/messaging/messaging.h>
 #include <knp/framework/io/in_converters/index_converter.h>
 #include <knp/framework/io/in_converters/sequence_converter.h>
+#include <knp/framework/io/in_converters/spike_train_reader.h>
 #include <knp/framework/io/input_channel.h>
 #include <knp/framework/io/input_interpreters.h>
+#include <knp/framework/io/storage/native/data_storage_binary.h>
 
 #include <tests_common.h>
 
+#include <filesystem>
+#include <vector>
+
 
 TEST(InputSuite, SequenceConverterTest)
 {
@@ -97,3 +102,45 @@ TEST(InputSuite, ChannelTest)
     ASSERT_EQ(message.header_.send_time_, send_time);
     ASSERT_EQ(message.neuron_indexes_, expected_indexes);
 }
+
+
+TEST(InputSuite, SpikeTrainReaderTest)
+{
+    using knp::core::messaging::SpikeData;
+    using knp::core::messaging::SpikeMessage;
+
+    const std::filesystem::path file_path = "spike_train.bin";
+    const knp::core::UID uid;
+    knp::framework::io::storage::native::save_messages_to_binary(
+        {SpikeMessage{{uid, 1}, {3, 5}}, SpikeMessage{{uid, 4}, {0}}, SpikeMessage{{uid, 1}, {7}}}, file_path);
+
+    const knp::framework::io::input::SpikeTrainReader reader{file_path};
+    ASSERT_EQ(reader.get_steps_count(), 5);
+    ASSERT_EQ(reader(1), (SpikeData{3, 5, 7}));
+    ASSERT_TRUE(reader(2).empty());
+    ASSERT_EQ(reader(4), SpikeData{0});
+    ASSERT_TRUE(reader(5).empty());
+    const knp::framework::io::input::SpikeTrainReader loop_reader{file_path, true};
+    ASSERT_EQ(loop_reader(6), (SpikeData{3, 5, 7}));
+
+    // Messages with the same step are merged.
+    const std::vector<SpikeMessage> expected_messages{SpikeMessage{{uid, 1}, {3, 5, 7}}, SpikeMessage{{uid, 4}, {0}}};
+    ASSERT_EQ(knp::framework::io::storage::native::load_messages_from_binary(file_path, uid), expected_messages);
+
+    // Reader is a data generator of an input channel.
+    knp::core::MessageBus bus = knp::core::MessageBus::construct_bus();
+    auto endpoint = bus.create_endpoint();
+    knp::framework::io::input::InputChannel channel{knp::core::UID(), bus.create_endpoint(), reader};
+    knp::core::UID output_uid;
+    knp::framework::io::input::connect_input(channel, endpoint, output_uid);
+    ASSERT_FALSE(channel.send(3));
+    ASSERT_TRUE(channel.send(4));
+    bus.route_messages();
+    endpoint.receive_all_messages();
+    const auto messages = endpoint.unload_messages<SpikeMessage>(output_uid);
+    ASSERT_EQ(messages.size(), 1);
+    ASSERT_EQ(messages[0].neuron_indexes_, SpikeData{0});
+
+    std::filesystem::remove(file_path);
+    ASSERT_THROW(knp::framework::io::input::SpikeTrainReader{file_path}, std::runtime_error);
+}
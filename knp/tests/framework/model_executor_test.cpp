@@ -100,3 +100,232 @@ TEST(FrameworkSuite, ModelExecutorLoad)
     ASSERT_EQ(pop_tag, knp::core::tags::IOType::output);
     ASSERT_EQ(proj_tag, knp::core::tags::IOType::input);
 }
+
+
+TEST(FrameworkSuite, ModelExecutorBatchedObserver)
+{
+    namespace kt = knp::testing;
+
+    kt::BLIFATPopulation population{kt::neuron_generator, 1};
+    kt::DeltaProjection loop_projection =
+        kt::DeltaProjection{population.get_uid(), population.get_uid(), kt::synapse_generator, 1};
+    kt::DeltaProjection input_projection =
+        kt::DeltaProjection{knp::core::UID{false}, population.get_uid(), kt::input_projection_gen, 1};
+
+    const knp::core::UID input_uid = input_projection.get_uid();
+    const knp::core::UID output_uid = population.get_uid();
+
+    knp::framework::Network network;
+    network.add_population(std::move(population));
+    network.add_projection<kt::DeltaProjection>(std::move(input_projection));
+    network.add_projection<kt::DeltaProjection>(std::move(loop_projection));
+
+    const knp::core::UID i_channel_uid;
+    knp::framework::Model model(std::move(network));
+    model.add_input_channel(i_channel_uid, input_uid);
+
+    auto input_gen = [](knp::core::Step step)
+    { return step % 5 == 0 ? knp::core::messaging::SpikeData{0} : knp::core::messaging::SpikeData{}; };
+
+    knp::framework::ModelExecutor model_executor(
+        model, knp::backends::single_threaded_cpu::SingleThreadedCPUBackend::create(), {{i_channel_uid, input_gen}});
+
+    std::vector<knp::core::Step> every_step_results, batched_results;
+    size_t batched_calls = 0;
+    model_executor.add_observer<knp::core::messaging::SpikeMessage>(
+        [&every_step_results](const std::vector<knp::core::messaging::SpikeMessage> &messages)
+        {
+            for (const auto &message : messages) every_step_results.push_back(message.header_.send_time_);
+        },
+        {output_uid});
+    model_executor.add_observer<knp::core::messaging::SpikeMessage>(
+        [&batched_results, &batched_calls](const std::vector<knp::core::messaging::SpikeMessage> &messages)
+        {
+            ++batched_calls;
+            for (const auto &message : messages) batched_results.push_back(message.header_.send_time_);
+        },
+        {output_uid}, 8);
+
+    model_executor.start([](size_t step) { return step < 20; });
+
+    const std::vector<knp::core::Step> expected_results = {1, 6, 7, 11, 12, 13, 16, 17, 18, 19};
+    ASSERT_EQ(every_step_results, expected_results);
+    ASSERT_EQ(batched_results, expected_results);
+    // 20 steps are processed in two full batches and the remainder flushed at stop.
+    ASSERT_EQ(batched_calls, 3);
+}
+
+
+TEST(FrameworkSuite, ModelExecutorBulkInput)
+{
+    namespace kt = knp::testing;
+
+    kt::BLIFATPopulation population{kt::neuron_generator, 1};
+    kt::DeltaProjection loop_projection =
+        kt::DeltaProjection{population.get_uid(), population.get_uid(), kt::synapse_generator, 1};
+    kt::DeltaProjection input_projection =
+        kt::DeltaProjection{knp::core::UID{false}, population.get_uid(), kt::input_projection_gen, 1};
+
+    const knp::core::UID input_uid = input_projection.get_uid();
+    const knp::core::UID output_uid = population.get_uid();
+
+    knp::framework::Network network;
+    network.add_population(std::move(population));
+    network.add_projection<kt::DeltaProjection>(std::move(input_projection));
+    network.add_projection<kt::DeltaProjection>(std::move(loop_projection));
+
+    const knp::core::UID i_channel_uid;
+    knp::framework::Model model(std::move(network));
+    model.add_input_channel(i_channel_uid, input_uid);
+
+    size_t generator_calls = 0;
+    auto input_gen =
+        [&generator_calls](knp::core::Step first_step, std::vector<knp::core::messaging::SpikeData> &window)
+    {
+        ++generator_calls;
+        for (size_t i = 0; i < window.size(); ++i)
+        {
+            if ((first_step + i) % 5 == 0) window[i].push_back(0);
+        }
+    };
+
+    knp::framework::ModelExecutor model_executor(
+        model, knp::backends::single_threaded_cpu::SingleThreadedCPUBackend::create(), {},
+        {{i_channel_uid, knp::core::BulkSpikeInput{input_gen, 8}}});
+    // Bulk inputs don't have input channels.
+    ASSERT_TRUE(model_executor.get_loader().get_inputs().empty());
+
+    std::vector<knp::core::Step> results;
+    model_executor.add_observer<knp::core::messaging::SpikeMessage>(
+        [&results](const std::vector<knp::core::messaging::SpikeMessage> &messages)
+        {
+            for (const auto &message : messages) results.push_back(message.header_.send_time_);
+        },
+        {output_uid});
+    // Bulk input spikes are local to the backend and don't reach observers through the message bus.
+    size_t observed_inputs = 0;
+    model_executor.add_observer<knp::core::messaging::SpikeMessage>(
+        [&observed_inputs](const std::vector<knp::core::messaging::SpikeMessage> &messages)
+        { observed_inputs += messages.size(); },
+        {i_channel_uid});
+
+    model_executor.start([](size_t step) { return step < 20; });
+
+    const std::vector<knp::core::Step> expected_results = {1, 6, 7, 11, 12, 13, 16, 17, 18, 19};
+    ASSERT_EQ(results, expected_results);
+    ASSERT_EQ(observed_inputs, 0);
+    // Inputs of 20 steps are generated by windows of 8 steps.
+    ASSERT_EQ(generator_calls, 3);
+}
+
+
+TEST(FrameworkSuite, ModelExecutorFastForward)
+{
+    namespace kt = knp::testing;
+
+    kt::BLIFATPopulation population{kt::neuron_generator, 1};
+    kt::DeltaProjection loop_projection =
+        kt::DeltaProjection{population.get_uid(), population.get_uid(), kt::synapse_generator, 1};
+    kt::DeltaProjection input_projection =
+        kt::DeltaProjection{knp::core::UID{false}, population.get_uid(), kt::input_projection_gen, 1};
+
+    const knp::core::UID input_uid = input_projection.get_uid();
+    const knp::core::UID output_uid = population.get_uid();
+
+    knp::framework::Network network;
+    network.add_population(std::move(population));
+    network.add_projection<kt::DeltaProjection>(std::move(input_projection));
+    network.add_projection<kt::DeltaProjection>(std::move(loop_projection));
+
+    const knp::core::UID i_channel_uid;
+    knp::framework::Model model(std::move(network));
+    model.add_input_channel(i_channel_uid, input_uid);
+
+    std::vector<knp::core::Step> input_steps;
+    auto input_gen = [&input_steps](knp::core::Step step)
+    {
+        input_steps.push_back(step);
+        return step % 5 == 0 ? knp::core::messaging::SpikeData{0} : knp::core::messaging::SpikeData{};
+    };
+
+    knp::framework::ModelExecutor model_executor(
+        model, knp::backends::single_threaded_cpu::SingleThreadedCPUBackend::create(), {{i_channel_uid, input_gen}});
+
+    std::vector<knp::core::Step> results;
+    size_t observer_calls = 0;
+    model_executor.add_observer<knp::core::messaging::SpikeMessage>(
+        [&results, &observer_calls](const std::vector<knp::core::messaging::SpikeMessage> &messages)
+        {
+            ++observer_calls;
+            for (const auto &message : messages) results.push_back(message.header_.send_time_);
+        },
+        {output_uid});
+
+    // Inputs are needed only at steps with spikes. Steps out of range are ignored.
+    model_executor.fast_forward(12, {10, 0, 5, 15});
+    ASSERT_EQ(model_executor.get_backend()->get_step(), 12);
+    model_executor.fast_forward(8, {15});
+    ASSERT_EQ(model_executor.get_backend()->get_step(), 20);
+
+    const std::vector<knp::core::Step> expected_results = {1, 6, 7, 11, 12, 13, 16, 17, 18, 19};
+    ASSERT_EQ(results, expected_results);
+    ASSERT_EQ(input_steps, std::vector<knp::core::Step>({0, 5, 10, 15}));
+    // Observer runs after synchronization steps and after the last step of every call.
+    ASSERT_EQ(observer_calls, 6);
+}
+
+
+TEST(FrameworkSuite, ModelExecutorFastForwardStop)
+{
+    namespace kt = knp::testing;
+
+    kt::BLIFATPopulation population{kt::neuron_generator, 1};
+    kt::DeltaProjection loop_projection =
+        kt::DeltaProjection{population.get_uid(), population.get_uid(), kt::synapse_generator, 1};
+    kt::DeltaProjection input_projection =
+        kt::DeltaProjection{knp::core::UID{false}, population.get_uid(), kt::input_projection_gen, 1};
+
+    const knp::core::UID input_uid = input_projection.get_uid();
+    const knp::core::UID output_uid = population.get_uid();
+
+    knp::framework::Network network;
+    network.add_population(std::move(population));
+    network.add_projection<kt::DeltaProjection>(std::move(input_projection));
+    network.add_projection<kt::DeltaProjection>(std::move(loop_projection));
+
+    const knp::core::UID i_channel_uid;
+    knp::framework::Model model(std::move(network));
+    model.add_input_channel(i_channel_uid, input_uid);
+
+    std::vector<knp::core::Step> input_steps;
+    auto input_gen = [&input_steps](knp::core::Step step)
+    {
+        input_steps.push_back(step);
+        return step % 5 == 0 ? knp::core::messaging::SpikeData{0} : knp::core::messaging::SpikeData{};
+    };
+
+    knp::framework::ModelExecutor model_executor(
+        model, knp::backends::single_threaded_cpu::SingleThreadedCPUBackend::create(), {{i_channel_uid, input_gen}});
+
+    bool stop_requested = false;
+    model_executor.add_observer<knp::core::messaging::SpikeMessage>(
+        [&model_executor, &stop_requested](const std::vector<knp::core::messaging::SpikeMessage> &messages)
+        {
+            if (messages.empty() || stop_requested) return;
+            stop_requested = true;
+            model_executor.stop();
+        },
+        {output_uid});
+
+    // The first spike is observed at the synchronization step 5, and the observer stops execution there.
+    model_executor.fast_forward(12, {0, 5, 10});
+    ASSERT_TRUE(stop_requested);
+    ASSERT_FALSE(model_executor.get_backend()->running());
+    ASSERT_EQ(model_executor.get_backend()->get_step(), 6);
+    ASSERT_EQ(input_steps, std::vector<knp::core::Step>({0, 5}));
+
+    // The next call continues execution.
+    model_executor.fast_forward(6, {10});
+    ASSERT_EQ(model_executor.get_backend()->get_step(), 12);
+    ASSERT_EQ(input_steps, std::vector<knp::core::Step>({0, 5, 10}));
+}
@@ -71,3 +71,45 @@ TEST(FrameworkSuite, ModelWithIncorrectInputChannel)
 
     EXPECT_THROW(mld.load(model), std::logic_error);  //!OCLINT(False positive)
 }
+
+
+TEST(FrameworkSuite, ModelMoveLoad)
+{
+    namespace kt = knp::testing;
+
+    auto input_gen = [](knp::core::Step step) -> knp::core::messaging::SpikeData { return {}; };
+
+    const knp::core::UID i_channel_uid;
+
+    knp::framework::Model model(std::move(knp::framework::Network()));
+
+    kt::BLIFATPopulation population{kt::neuron_generator, 1};
+    kt::DeltaProjection input_projection =
+        kt::DeltaProjection{knp::core::UID(false), population.get_uid(), kt::synapse_generator, 1};
+
+    const auto proj_uid = input_projection.get_uid();
+
+    model.get_network().add_population(population);
+    model.get_network().add_projection(input_projection);
+    model.add_input_channel(i_channel_uid, proj_uid);
+
+    auto backend = knp::backends::single_threaded_cpu::SingleThreadedCPUBackend::create();
+    knp::framework::ModelLoader mld(backend, {{i_channel_uid, input_gen}});
+
+    mld.load(std::move(model));
+
+    // The network was moved to the backend.
+    ASSERT_EQ(model.get_network().populations_count(), 0);  //!OCLINT(False positive)
+    ASSERT_EQ(model.get_network().projections_count(), 0);  //!OCLINT(False positive)
+
+    auto &st_backend = dynamic_cast<knp::backends::single_threaded_cpu::SingleThreadedCPUBackend &>(*backend);
+    ASSERT_EQ(std::distance(st_backend.begin_populations(), st_backend.end_populations()), 1);
+    ASSERT_EQ(std::distance(st_backend.begin_projections(), st_backend.end_projections()), 1);
+
+    // Tags added by the loader were moved together with the projection.
+    auto &loaded_projection = std::get<kt::DeltaProjection>(st_backend.begin_projections()->arg_);
+    ASSERT_EQ(loaded_projection.get_uid(), proj_uid);
+    ASSERT_EQ(
+        loaded_projection.get_tags().get_tag<knp::core::tags::IOType>(knp::core::tags::io_type_tag),
+        knp::core::tags::IOType::input);
+}
@@ -26,6 +26,7 @@
 
 #include <exception>
 #include <tuple>
+#include <vector>
 
 
 using BLIFATParams = knp::neuron_traits::neuron_parameters<knp::neuron_traits::BLIFATNeuron>;
@@ -134,6 +135,73 @@ TEST(FrameworkSuite, NetworkRemoveEntities)  //!OCLINT(False positive)
 }
 
 
+TEST(FrameworkSuite, NetworkRemoveNeurons)  //!OCLINT(False positive)
+{
+    knp::framework::Network network;
+
+    auto [population, projection] = create_entities();
+    const auto population_uid = population.get_uid();
+    const DeltaProjection loop_projection{
+        population_uid, population_uid,
+        [](size_t index) -> std::optional<Synapse>
+        { return Synapse{{}, static_cast<uint32_t>(index), static_cast<uint32_t>(index)}; },
+        neurons_count};
+
+    network.add_population(std::move(population));
+    network.add_projection(std::move(projection));
+    network.add_projection(loop_projection);
+
+    // Every removed neuron has an input and an output synapse.
+    ASSERT_EQ(network.remove_neurons(population_uid, {0, 5}), 2);
+    ASSERT_EQ(network.get_population<knp::neuron_traits::BLIFATNeuron>(population_uid).size(), neurons_count - 2);
+
+    const auto &remaining = network.get_projection<knp::synapse_traits::DeltaSynapse>(loop_projection.get_uid());
+    ASSERT_EQ(remaining.size(), neurons_count - 2);
+    ASSERT_EQ(std::get<knp::core::source_neuron_id>(remaining[4]), 4);
+    ASSERT_EQ(std::get<knp::core::target_neuron_id>(remaining[4]), 4);
+
+    // Indexes out of range are ignored.
+    ASSERT_EQ(network.remove_neurons(population_uid, {neurons_count - 2, neurons_count + 10}), 0);
+    ASSERT_EQ(network.get_population<knp::neuron_traits::BLIFATNeuron>(population_uid).size(), neurons_count - 2);
+
+    EXPECT_THROW(network.remove_neurons(knp::core::UID{}, {0}), std::logic_error);  //!OCLINT(False positive)
+}
+
+
+TEST(FrameworkSuite, NetworkHandles)  //!OCLINT(False positive)
+{
+    knp::framework::Network network;
+    std::vector<knp::core::UID> population_uids;
+
+    for (size_t i = 0; i < 3; ++i)
+    {
+        auto population = std::get<0>(create_entities());
+        population_uids.push_back(population.get_uid());
+        network.add_population(std::move(population));
+    }
+
+    auto duplicate = network.get_population<knp::neuron_traits::BLIFATNeuron>(population_uids[1]);
+    EXPECT_THROW(network.add_population(std::move(duplicate)), std::logic_error);  //!OCLINT(False positive)
+    ASSERT_EQ(network.populations_count(), 3);
+
+    const auto handle = network.get_population_handle(population_uids[2]);
+    ASSERT_EQ(handle.get_uid(), population_uids[2]);
+
+    // The last population takes the place of the removed one, the handle still refers to it.
+    network.remove_population(population_uids[0]);
+    ASSERT_EQ(network.populations_count(), 2);
+    ASSERT_EQ(network.get_population<knp::neuron_traits::BLIFATNeuron>(handle).get_uid(), population_uids[2]);
+    ASSERT_EQ(
+        network.get_population<knp::neuron_traits::BLIFATNeuron>(population_uids[1]).get_uid(), population_uids[1]);
+    ASSERT_FALSE(network.is_population_exists(population_uids[0]));
+
+    network.remove_population(population_uids[2]);
+    EXPECT_THROW(std::ignore = network.get_population(handle), std::logic_error);  //!OCLINT(False positive)
+    EXPECT_THROW(  //!OCLINT(False positive)
+        std::ignore = network.get_population_handle(population_uids[0]), std::logic_error);
+}
+
+
 TEST(FrameworkSuite, NetworkConnectPopulations)
 {
     constexpr auto src_neurons_count = 5;
@@ -0,0 +1,152 @@
+/**
+ * @file partitioned_model_executor_test.cpp
+ * @brief Partitioned model executor testing.
+ * @kaspersky_support Artiom N.
+ * @date 18.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <knp/backends/cpu-multi-threaded/backend.h>
+#include <knp/backends/cpu-single-threaded/backend.h>
+#include <knp/framework/model_executor.h>
+#include <knp/framework/network.h>
+#include <knp/framework/partitioned_model_executor.h>
+
+#include <generators.h>
+#include <tests_common.h>
+
+#include <vector>
+
+
+namespace
+{
+namespace kt = knp::testing;
+
+constexpr size_t neurons_count = 4;
+
+
+kt::DeltaProjection make_all_to_all(const knp::core::UID &pre_uid, const knp::core::UID &post_uid)
+{
+    return kt::DeltaProjection{
+        pre_uid, post_uid,
+        [](size_t index) -> std::optional<kt::DeltaProjection::Synapse>
+        {
+            return kt::DeltaProjection::Synapse{
+                {1.0, 1, knp::synapse_traits::OutputType::EXCITATORY},
+                static_cast<uint32_t>(index / neurons_count),
+                static_cast<uint32_t>(index % neurons_count)};
+        },
+        neurons_count * neurons_count};
+}
+
+
+std::vector<std::pair<knp::core::Step, knp::core::messaging::SpikeData>> get_spikes(
+    knp::framework::io::output::OutputChannel &channel)
+{
+    std::vector<std::pair<knp::core::Step, knp::core::messaging::SpikeData>> result;
+    for (const auto &message : channel.update())
+    {
+        result.emplace_back(message.header_.send_time_, message.neuron_indexes_);
+    }
+    return result;
+}
+
+
+auto input_gen(knp::core::Step step)
+{
+    return step % 5 == 0 ? knp::core::messaging::SpikeData{0} : knp::core::messaging::SpikeData{};
+}
+}  // namespace
+
+
+TEST(FrameworkSuite, PartitionedModelExecutorMatchesSingleBackend)
+{
+    // Two clusters of populations connected by a single synapse.
+    std::vector<kt::BLIFATPopulation> populations;
+    for (size_t index = 0; index < 4; ++index) populations.emplace_back(kt::neuron_generator, neurons_count);
+
+    const auto uid_a = populations[0].get_uid(), uid_b = populations[1].get_uid();
+    const auto uid_c = populations[2].get_uid(), uid_d = populations[3].get_uid();
+
+    kt::DeltaProjection input_projection{
+        knp::core::UID{false}, uid_a,
+        [](size_t index) -> std::optional<kt::DeltaProjection::Synapse> {
+            return kt::DeltaProjection::Synapse{
+                {1.0, 1, knp::synapse_traits::OutputType::EXCITATORY}, 0, static_cast<uint32_t>(index)};
+        },
+        neurons_count};
+    kt::DeltaProjection bridge_projection{
+        uid_b, uid_c,
+        [](size_t) -> std::optional<kt::DeltaProjection::Synapse> {
+            return kt::DeltaProjection::Synapse{{1.0, 2, knp::synapse_traits::OutputType::EXCITATORY}, 0, 0};
+        },
+        1};
+    const auto input_uid = input_projection.get_uid();
+
+    knp::framework::Network network;
+    for (auto &population : populations) network.add_population(std::move(population));
+    network.add_projection(std::move(input_projection));
+    network.add_projection(make_all_to_all(uid_a, uid_b));
+    network.add_projection(std::move(bridge_projection));
+    network.add_projection(make_all_to_all(uid_c, uid_d));
+
+    const knp::core::UID i_channel_uid;
+    const std::vector<knp::core::UID> population_uids = {uid_a, uid_b, uid_c, uid_d};
+    std::vector<knp::core::UID> o_channel_uids(population_uids.size());
+
+    auto make_model = [&]()
+    {
+        knp::framework::Model model(knp::framework::Network{network});
+        model.add_input_channel(i_channel_uid, input_uid);
+        for (size_t index = 0; index < population_uids.size(); ++index)
+        {
+            model.add_output_channel(o_channel_uids[index], population_uids[index]);
+        }
+        return model;
+    };
+
+    auto run_predicate = [](knp::core::Step step) { return step < 30; };
+
+    auto model = make_model();
+    knp::framework::ModelExecutor model_executor(
+        model, knp::backends::single_threaded_cpu::SingleThreadedCPUBackend::create(), {{i_channel_uid, input_gen}});
+    model_executor.start(run_predicate);
+
+    auto partitioned_model = make_model();
+    knp::framework::PartitionedModelExecutor partitioned_executor(
+        partitioned_model,
+        {knp::backends::single_threaded_cpu::SingleThreadedCPUBackend::create(),
+         knp::backends::multi_threaded_cpu::MultiThreadedCPUBackend::create()},
+        {{i_channel_uid, input_gen}});
+
+    const auto &partitions = partitioned_executor.get_partitions().population_partitions_;
+    ASSERT_EQ(partitions.at(uid_a), partitions.at(uid_b));
+    ASSERT_EQ(partitions.at(uid_c), partitions.at(uid_d));
+    ASSERT_NE(partitions.at(uid_a), partitions.at(uid_c));
+    ASSERT_EQ(partitioned_executor.get_partitions().cut_synapse_count_, 1);
+
+    partitioned_executor.start(run_predicate);
+
+    ASSERT_EQ(partitioned_executor.get_backend(0)->get_step(), model_executor.get_backend()->get_step());
+    // Synapse weights are integers, so the impact summation order doesn't change the spikes.
+    for (const auto &o_channel_uid : o_channel_uids)
+    {
+        const auto expected = get_spikes(model_executor.get_loader().get_output_channel(o_channel_uid));
+        ASSERT_EQ(get_spikes(partitioned_executor.get_output_channel(o_channel_uid)), expected);
+    }
+    // Spikes must pass through the cut projection.
+    ASSERT_FALSE(get_spikes(partitioned_executor.get_output_channel(o_channel_uids.back())).empty());
+}
@@ -55,6 +55,31 @@ TEST(ProjectionConnectors, AllToAll)
 }
 
 
+TEST(ProjectionConnectors, DenseAllToAll)
+{
+    constexpr size_t src_pop_size = 3;
+    constexpr size_t dest_pop_size = 2;
+    using SynapseParameters = knp::synapse_traits::synapse_parameters<knp::synapse_traits::DeltaSynapse>;
+
+    auto proj = knp::framework::projection::creators::dense_all_to_all<typename knp::synapse_traits::DeltaSynapse>(
+        knp::core::UID(), knp::core::UID(), src_pop_size, dest_pop_size,
+        [](size_t source, size_t target)
+        {
+            return SynapseParameters{
+                static_cast<float>(source * 10 + target), 1, knp::synapse_traits::OutputType::EXCITATORY};
+        });
+
+    ASSERT_TRUE(proj.is_compact());
+    ASSERT_EQ(proj.size(), src_pop_size * dest_pop_size);
+    ASSERT_TRUE(proj.get_block_delays().empty());
+    for (size_t index = 0; index < proj.size(); ++index)
+    {
+        const auto [params, source, target] = proj.get_synapse(index);
+        ASSERT_EQ(params.weight_, static_cast<float>(source * 10 + target));
+    }
+}
+
+
 TEST(ProjectionConnectors, OneToOne)
 {
     constexpr size_t pop_size = 5;
@@ -0,0 +1,114 @@
+/**
+ * @file reordering_test.cpp
+ * @brief Network reordering tests.
+ * @kaspersky_support Artiom N.
+ * @date 18.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <knp/core/message_bus.h>
+#include <knp/framework/reordering.h>
+
+#include <tests_common.h>
+
+#include <cstdlib>
+#include <tuple>
+#include <vector>
+
+
+using BLIFATPopulation = knp::core::Population<knp::neuron_traits::BLIFATNeuron>;
+using DeltaProjection = knp::core::Projection<knp::synapse_traits::DeltaSynapse>;
+using Synapse = DeltaProjection::Synapse;
+
+
+TEST(ReorderingSuite, OptimizeLocality)
+{
+    // Neurons form a chain in the shuffled order.
+    const std::vector<size_t> chain{3, 0, 5, 1, 4, 2};
+    BLIFATPopulation population(
+        [](size_t index)
+        {
+            knp::neuron_traits::neuron_parameters<knp::neuron_traits::BLIFATNeuron> neuron;
+            neuron.potential_ = static_cast<double>(index);
+            return neuron;
+        },
+        chain.size());
+    const auto population_uid = population.get_uid();
+
+    std::vector<Synapse> synapses;
+    for (size_t index = 0; index + 1 < chain.size(); ++index)
+    {
+        const uint32_t delay = index % 2 + 1;
+        synapses.push_back(
+            Synapse{{1.F, delay, knp::synapse_traits::OutputType::EXCITATORY}, chain[index + 1], chain[index]});
+    }
+    const DeltaProjection loop_projection{population_uid, population_uid, synapses};
+    const DeltaProjection input_projection{
+        knp::core::UID{false}, population_uid, std::vector<Synapse>{{{}, 0, 5}, {{}, 0, 0}}};
+
+    knp::framework::Network network;
+    network.add_population(population);
+    network.add_projection(loop_projection);
+    network.add_projection(input_projection);
+
+    const auto index_map = knp::framework::reordering::optimize_locality(network);
+    const auto &new_indexes = index_map.new_indexes_.at(population_uid);
+    const auto &original_indexes = index_map.original_indexes_.at(population_uid);
+    ASSERT_EQ(original_indexes.size(), chain.size());
+
+    // Neurons are moved with their parameters.
+    const auto &reordered = network.get_population<knp::neuron_traits::BLIFATNeuron>(population_uid);
+    for (size_t index = 0; index < chain.size(); ++index)
+    {
+        ASSERT_EQ(new_indexes[original_indexes[index]], index);
+        ASSERT_EQ(reordered[index].potential_, static_cast<double>(original_indexes[index]));
+    }
+
+    // Neighbor neurons of the chain get neighbor indexes, synapses are sorted by delay and neuron indexes.
+    const auto &loop = network.get_projection<knp::synapse_traits::DeltaSynapse>(loop_projection.get_uid());
+    for (size_t index = 0; index < loop.size(); ++index)
+    {
+        const auto &[params, source, target] = loop[index];
+        ASSERT_EQ(std::abs(static_cast<int>(source) - static_cast<int>(target)), 1);
+        if (index == 0) continue;
+        const auto &[prev_params, prev_source, prev_target] = loop[index - 1];
+        ASSERT_LE(std::make_tuple(prev_params.delay_, prev_source), std::make_tuple(params.delay_, source));
+    }
+
+    // Only postsynaptic indexes of the input projection are changed.
+    const auto &input = network.get_projection<knp::synapse_traits::DeltaSynapse>(input_projection.get_uid());
+    ASSERT_EQ(input.find_synapses(0, DeltaProjection::Search::by_presynaptic).size(), 2);
+    ASSERT_EQ(input.find_synapses(new_indexes[5], DeltaProjection::Search::by_postsynaptic).size(), 1);
+
+    // Output channels report original indexes.
+    knp::core::MessageBus bus = knp::core::MessageBus::construct_bus();
+    auto endpoint = bus.create_endpoint();
+    auto channel_endpoint = bus.create_endpoint();
+    const knp::core::UID channel_uid;
+    channel_endpoint.subscribe<knp::core::messaging::SpikeMessage>(channel_uid, {population_uid});
+    knp::framework::io::output::OutputChannel channel{channel_uid, std::move(channel_endpoint)};
+    knp::framework::reordering::restore_original_indexes(channel, index_map);
+
+    endpoint.send_message(knp::core::messaging::SpikeMessage{
+        {population_uid, 1},
+        {static_cast<knp::core::messaging::SpikeIndex>(new_indexes[4]),
+         static_cast<knp::core::messaging::SpikeIndex>(new_indexes[1])}});
+    bus.route_messages();
+    channel.update();
+    const auto messages = channel.read_some_from_buffer(0, 1);
+    ASSERT_EQ(messages.size(), 1);
+    ASSERT_EQ(messages[0].neuron_indexes_, (knp::core::messaging::SpikeData{1, 4}));
+}
@@ -21,10 +21,13 @@
 
 #include <knp/core/projection.h>
 #include <knp/framework/sonata/network_io.h>
+#include <knp/framework/sonata/network_reader.h>
 
 #include <generators.h>
 #include <tests_common.h>
 
+#include <highfive/highfive.hpp>
+
 
 knp::framework::Network make_simple_network()
 {
@@ -130,3 +133,179 @@ TEST_F(SaveLoadNetworkSuite, SaveLoadTest)
     auto network_loaded = knp::framework::sonata::load_network(path_to_network_);
     ASSERT_TRUE(are_networks_similar(network, network_loaded));
 }
+
+TEST_F(SaveLoadNetworkSuite, LoadLargeProjections)
+{
+    using DeltaProjection = knp::core::Projection<knp::synapse_traits::DeltaSynapse>;
+    path_to_network_ = ".";
+    // Projections are larger than a read chunk, so they are loaded by several chunks.
+    constexpr size_t population_size = 300;
+    knp::testing::BLIFATPopulation population{knp::testing::neuron_generator, population_size};
+    knp::framework::Network network;
+    network.add_population(population);
+    std::vector<knp::core::UID> projection_uids;
+    for (uint32_t delay = 1; delay <= 3; ++delay)
+    {
+        DeltaProjection projection{
+            population.get_uid(), population.get_uid(),
+            [delay](size_t index) -> std::optional<DeltaProjection::Synapse>
+            {
+                return DeltaProjection::Synapse{
+                    {static_cast<float>(index), delay, knp::synapse_traits::OutputType::EXCITATORY},
+                    index / population_size,
+                    index % population_size};
+            },
+            population_size * population_size};
+        projection_uids.push_back(projection.get_uid());
+        network.add_projection(std::move(projection));
+    }
+
+    knp::framework::sonata::save_network(network, path_to_network_);
+    auto network_loaded = knp::framework::sonata::load_network(path_to_network_);
+    ASSERT_TRUE(are_networks_similar(network, network_loaded));
+    for (uint32_t delay = 1; delay <= 3; ++delay)
+    {
+        const auto &projection =
+            network_loaded.get_projection<knp::synapse_traits::DeltaSynapse>(projection_uids[delay - 1]);
+        ASSERT_EQ(projection.size(), population_size * population_size);
+        for (const size_t index : {size_t{0}, size_t{65535}, size_t{65536}, population_size * population_size - 1})
+        {
+            const auto &[params, source, target] = projection[index];
+            ASSERT_EQ(params.weight_, static_cast<float>(index));
+            ASSERT_EQ(params.delay_, delay);
+            ASSERT_EQ(source, index / population_size);
+            ASSERT_EQ(target, index % population_size);
+        }
+        ASSERT_EQ(projection.find_synapses(1, DeltaProjection::Search::by_presynaptic).size(), population_size);
+    }
+}
+
+TEST_F(SaveLoadNetworkSuite, NetworkReader)
+{
+    path_to_network_ = ".";
+    auto network = make_simple_network();
+    knp::framework::sonata::save_network(network, path_to_network_);
+
+    const knp::framework::sonata::NetworkReader reader{path_to_network_};
+    ASSERT_EQ(reader.get_network_uid(), network.get_uid());
+    ASSERT_EQ(reader.get_populations().size(), 1);
+    ASSERT_EQ(reader.get_projections().size(), 2);
+
+    const auto &population_info = reader.get_populations()[0];
+    ASSERT_EQ(population_info.type_name_, "knp:BLIFATNeuron");
+    ASSERT_EQ(population_info.size_, 1);
+
+    // Load only a projection, its population is not loaded.
+    const auto &projection_info = reader.get_projections()[0];
+    ASSERT_EQ(projection_info.type_name_, "knp:DeltaSynapse");
+    const auto partial_network = reader.load_network({projection_info.uid_});
+    ASSERT_EQ(partial_network.get_uid(), network.get_uid());
+    ASSERT_EQ(partial_network.populations_count(), 0);
+    ASSERT_EQ(partial_network.projections_count(), 1);
+    const auto &projection =
+        partial_network.get_projection<knp::synapse_traits::DeltaSynapse>(projection_info.uid_);
+    ASSERT_EQ(projection.get_presynaptic(), projection_info.presynaptic_uid_);
+    ASSERT_EQ(projection.get_postsynaptic(), projection_info.postsynaptic_uid_);
+
+    // Synapse arrays are read without loading the projection.
+    auto arrays = reader.get_projection_arrays(projection_info.uid_);
+    ASSERT_EQ(arrays.get_weights().size(), projection_info.size_);
+    ASSERT_EQ(arrays.get_weights()[0], std::get<knp::core::synapse_data>(projection[0]).weight_);
+    ASSERT_EQ(arrays.get_delays()[0], std::get<knp::core::synapse_data>(projection[0]).delay_);
+    ASSERT_EQ(arrays.get_source_ids()[0], std::get<knp::core::source_neuron_id>(projection[0]));
+    ASSERT_EQ(arrays.get_target_ids()[0], std::get<knp::core::target_neuron_id>(projection[0]));
+
+    ASSERT_THROW(static_cast<void>(reader.load_population(knp::core::UID{})), std::logic_error);
+    ASSERT_TRUE(std::holds_alternative<knp::core::Population<knp::neuron_traits::BLIFATNeuron>>(
+        reader.load_population(population_info.uid_)));
+}
+
+TEST_F(SaveLoadNetworkSuite, SaveDefaultLayout)
+{
+    path_to_network_ = ".";
+    const auto network = make_simple_network();
+    const auto &population = std::get<knp::core::Population<knp::neuron_traits::BLIFATNeuron>>(
+        *network.begin_populations());
+
+    // Without options, every parameter is a dataset, as in files saved by previous versions.
+    knp::framework::sonata::save_network(network, path_to_network_);
+    {
+        const HighFive::File projections_file((path_to_network_ / "network" / "projections.h5").string());
+        for (auto proj_iter = network.begin_projections(); proj_iter != network.end_projections(); ++proj_iter)
+        {
+            const auto uid = std::visit([](const auto &proj) { return proj.get_uid(); }, *proj_iter);
+            const auto group = projections_file.getGroup("edges/" + std::string(uid) + "/0");
+            for (const auto *name : {"syn_weight", "delay", "output_type_"})
+            {
+                ASSERT_TRUE(group.exist(name));
+                ASSERT_FALSE(group.hasAttribute(name));
+                ASSERT_EQ(group.getDataSet(name).getElementCount(), 1);
+            }
+        }
+        const HighFive::File populations_file((path_to_network_ / "network" / "populations.h5").string());
+        const auto group = populations_file.getGroup("nodes/" + std::string(population.get_uid()) + "/0");
+        ASSERT_TRUE(group.exist("activation_threshold_"));
+        ASSERT_FALSE(group.hasAttribute("activation_threshold_"));
+    }
+
+    // Uniform parameters are collapsed to attributes only if the option is enabled.
+    knp::framework::sonata::SaveOptions options;
+    options.collapse_uniform_parameters_ = true;
+    knp::framework::sonata::save_network(network, path_to_network_, options);
+    {
+        const HighFive::File populations_file((path_to_network_ / "network" / "populations.h5").string());
+        const auto group = populations_file.getGroup("nodes/" + std::string(population.get_uid()) + "/0");
+        ASSERT_FALSE(group.exist("activation_threshold_"));
+        ASSERT_TRUE(group.hasAttribute("activation_threshold_"));
+    }
+    ASSERT_TRUE(are_networks_similar(network, knp::framework::sonata::load_network(path_to_network_)));
+}
+
+
+TEST_F(SaveLoadNetworkSuite, SaveCompressed)
+{
+    using DeltaProjection = knp::core::Projection<knp::synapse_traits::DeltaSynapse>;
+    path_to_network_ = ".";
+    constexpr size_t population_size = 100;
+    knp::testing::BLIFATPopulation population{knp::testing::neuron_generator, population_size};
+    // Delays are the same for all synapses, so they are saved as an attribute.
+    DeltaProjection projection{
+        population.get_uid(), population.get_uid(),
+        [](size_t index) -> std::optional<DeltaProjection::Synapse>
+        {
+            return DeltaProjection::Synapse{
+                {static_cast<float>(index % 7), 2, knp::synapse_traits::OutputType::EXCITATORY},
+                index % population_size,
+                index / population_size};
+        },
+        population_size * population_size};
+    knp::framework::Network network;
+    network.add_population(population);
+    network.add_projection(projection);
+
+    knp::framework::sonata::SaveOptions options;
+    options.chunk_size_ = 1000;
+    options.deflate_level_ = 6;
+    options.shuffle_ = true;
+    options.collapse_uniform_parameters_ = true;
+    knp::framework::sonata::save_network(network, path_to_network_, options);
+
+    auto network_loaded = knp::framework::sonata::load_network(path_to_network_);
+    ASSERT_TRUE(are_networks_similar(network, network_loaded));
+    const auto &loaded = network_loaded.get_projection<knp::synapse_traits::DeltaSynapse>(projection.get_uid());
+    ASSERT_EQ(loaded.size(), projection.size());
+    for (size_t index = 0; index < loaded.size(); ++index)
+    {
+        const auto &[params, source, target] = loaded[index];
+        const auto &[expected_params, expected_source, expected_target] = projection[index];
+        ASSERT_EQ(params.weight_, expected_params.weight_);
+        ASSERT_EQ(params.delay_, expected_params.delay_);
+        ASSERT_EQ(source, expected_source);
+        ASSERT_EQ(target, expected_target);
+    }
+
+    const auto &loaded_population =
+        network_loaded.get_population<knp::neuron_traits::BLIFATNeuron>(population.get_uid());
+    ASSERT_EQ(loaded_population.size(), population_size);
+    ASSERT_EQ(loaded_population[0].activation_threshold_, population[0].activation_threshold_);
+}
@@ -28,6 +28,11 @@
 #include <spdlog/spdlog.h>
 #include <tests_common.h>
 
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <utility>
 #include <vector>
 
 
@@ -101,3 +106,92 @@ TEST(SynchronizationSuite, MultiThreadCpuTest)
     ASSERT_EQ(proj1.size(), 1);
     ASSERT_EQ(pop.size(), 1);
 }
+
+
+TEST(SynchronizationSuite, ParameterViews)
+{
+    // Create a single-neuron neural network: input -> input_projection -> population <=> loop_projection.
+    knp::testing::STestingBack backend;
+    knp::testing::BLIFATPopulation population{knp::testing::neuron_generator, 1};
+    auto loop_projection =
+        knp::testing::DeltaProjection{population.get_uid(), population.get_uid(), knp::testing::synapse_generator, 1};
+    auto input_projection = knp::testing::DeltaProjection{
+        knp::core::UID{false}, population.get_uid(), knp::testing::input_projection_gen, 1};
+
+    backend.load_populations({population});
+    backend.load_projections({input_projection, loop_projection});
+    backend._init();
+
+    using knp::neuron_traits::BLIFATNeuron;
+    using knp::synapse_traits::DeltaSynapse;
+    namespace sync = knp::framework::synchronization;
+
+    const auto weights = sync::get_weights_view(backend, loop_projection.get_uid());
+    ASSERT_EQ(weights.size(), 1);
+    ASSERT_EQ(weights[0], std::get<knp::core::synapse_data>(loop_projection[0]).weight_);
+    const auto delays = sync::get_synapse_parameter_view<DeltaSynapse>(
+        backend, loop_projection.get_uid(), &knp::synapse_traits::synapse_parameters<DeltaSynapse>::delay_);
+    ASSERT_EQ(delays.size(), 1);
+    ASSERT_EQ(delays[0], std::get<knp::core::synapse_data>(loop_projection[0]).delay_);
+    const auto potentials = sync::get_neuron_parameter_view<BLIFATNeuron>(
+        backend, population.get_uid(), &knp::neuron_traits::neuron_parameters<BLIFATNeuron>::potential_);
+    ASSERT_EQ(potentials.size(), 1);
+
+    auto endpoint = backend.get_message_bus().create_endpoint();
+    const knp::core::UID in_channel_uid;
+    backend.subscribe<knp::core::messaging::SpikeMessage>(input_projection.get_uid(), {in_channel_uid});
+    endpoint.send_message(knp::core::messaging::SpikeMessage{{in_channel_uid, 0}, {0}});
+    ASSERT_EQ(backend.get_update_sequence(), 0);
+    backend._step();
+    // Every step increases the sequence number twice.
+    ASSERT_EQ(backend.get_update_sequence(), 2);
+
+    // Views refer to backend storage, so they show the state after the step.
+    const auto network = sync::get_network_copy(backend);
+    const auto &network_population = std::get<knp::testing::BLIFATPopulation>(network.get_populations()[0]);
+    const auto values = sync::read_between_steps(
+        backend, [&potentials]() { return std::vector<double>(potentials.begin(), potentials.end()); });
+    ASSERT_EQ(values, std::vector<double>{network_population[0].potential_});
+
+    using knp::neuron_traits::AltAILIF;
+    ASSERT_THROW(
+        sync::get_neuron_parameter_view<AltAILIF>(
+            backend, population.get_uid(), &knp::neuron_traits::neuron_parameters<AltAILIF>::potential_),
+        std::logic_error);
+    ASSERT_THROW(sync::get_weights_view(backend, knp::core::UID{}), std::logic_error);
+}
+
+TEST(SynchronizationSuite, ReadBetweenBackToBackSteps)
+{
+    // Create a single-neuron neural network: population <=> loop_projection.
+    knp::testing::STestingBack backend;
+    knp::testing::BLIFATPopulation population{knp::testing::neuron_generator, 1};
+    auto loop_projection =
+        knp::testing::DeltaProjection{population.get_uid(), population.get_uid(), knp::testing::synapse_generator, 1};
+
+    backend.load_populations({population});
+    backend.load_projections({loop_projection});
+    backend._init();
+
+    // Steps are much shorter than reading, so optimistic reading can't finish between them.
+    std::atomic<bool> stop = false;
+    std::thread stepping_thread(
+        [&backend, &stop]()
+        {
+            while (!stop) backend._step();
+        });
+
+    const auto steps = knp::framework::synchronization::read_between_steps(
+        backend,
+        [&backend]()
+        {
+            const auto first_step = backend.get_step();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            return std::make_pair(first_step, backend.get_step());
+        });
+    stop = true;
+    stepping_thread.join();
+
+    ASSERT_EQ(steps.first, steps.second);
+    ASSERT_GE(backend.get_step(), steps.second);
+}